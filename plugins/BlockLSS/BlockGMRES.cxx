@@ -0,0 +1,285 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <cmath>
+
+#include "Common/CFLog.hh"
+#include "Common/PE.hh"
+#include "Common/MPI/MPIStructDef.hh"
+
+#include "BlockLSS/BlockGMRES.hh"
+#include "BlockLSS/BlockOperator.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockGMRES::BlockGMRES() :
+  Common::NonCopyable<BlockGMRES>(),
+  m_nbOwned(0),
+  m_nbKsp(0),
+  m_rTol(1e-5),
+  m_aTol(1e-30),
+  m_maxIter(100),
+  m_output(false),
+  m_residual(0.),
+  m_krylov(),
+  m_precVec(),
+  m_work(),
+  m_hessenberg(),
+  m_cos(),
+  m_sin(),
+  m_g(),
+  m_dots(),
+  m_globalDots()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockGMRES::~BlockGMRES()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockGMRES::setup(const CFuint nbOwned, const CFuint nbKrylovSpaces)
+{
+  cf_assert(nbKrylovSpaces > 0);
+
+  m_nbOwned = nbOwned;
+  m_nbKsp = nbKrylovSpaces;
+
+  const CFuint m = m_nbKsp;
+  m_krylov.resize((m+1)*m_nbOwned);
+  m_precVec.resize(m_nbOwned);
+  m_work.resize(m_nbOwned);
+  m_hessenberg.resize(m*(m+1));
+  m_cos.resize(m);
+  m_sin.resize(m);
+  m_g.resize(m+1);
+  m_dots.resize(m+2);
+  m_globalDots.resize(m+2);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockGMRES::setTolerances(const CFreal relTolerance,
+			       const CFreal absTolerance,
+			       const CFuint maxIter)
+{
+  m_rTol = relTolerance;
+  m_aTol = absTolerance;
+  m_maxIter = maxIter;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint BlockGMRES::solve(const BlockLSSMatrix& mat,
+			 ParVector<CFreal>& halo,
+			 BlockOperator& op,
+			 const CFreal* b,
+			 CFreal* x)
+{
+  const CFuint m = m_nbKsp;
+  const CFuint n = m_nbOwned;
+  const CFuint hSize = m+1;
+
+  vector<CFreal*> v(m+1);
+  vector<const CFreal*> vDots(m+2);
+  for (CFuint i = 0; i <= m; ++i) {
+    v[i] = &m_krylov[i*n];
+    vDots[i] = v[i];
+  }
+  CFreal *const z = &m_precVec[0];
+  CFreal *const work = &m_work[0];
+
+  for (CFuint i = 0; i < n; ++i) {
+    x[i] = 0.;
+  }
+
+  CFreal bNorm = 0.;
+  dotProducts(1, &b, b, &bNorm);
+  bNorm = std::sqrt(bNorm);
+  const CFreal tolerance = std::max(m_rTol*bNorm, m_aTol);
+  m_residual = bNorm;
+
+  CFuint iter = 0;
+  bool converged = (bNorm <= tolerance);
+  while (!converged && iter < m_maxIter) {
+    // the initial guess is zero: the first residual is the rhs
+    if (iter == 0) {
+      for (CFuint i = 0; i < n; ++i) {
+	v[0][i] = b[i];
+      }
+    }
+    else {
+      op.multiply(mat, halo, x, v[0]);
+      for (CFuint i = 0; i < n; ++i) {
+	v[0][i] = b[i] - v[0][i];
+      }
+    }
+
+    CFreal beta = 0.;
+    dotProducts(1, &vDots[0], v[0], &beta);
+    beta = std::sqrt(beta);
+    m_residual = beta;
+    if (beta <= tolerance) break;
+
+    for (CFuint i = 0; i < n; ++i) {
+      v[0][i] /= beta;
+    }
+    m_g.assign(m+1, 0.);
+    m_g[0] = beta;
+
+    CFuint k = 0;
+    while (k < m && iter < m_maxIter) {
+      ++iter;
+      CFreal *const h = &m_hessenberg[k*hSize];
+      CFreal *const w = v[k+1];
+
+      // w = A M^-1 v_k
+      op.applyPreconditioner(v[k], z);
+      op.multiply(mat, halo, z, w);
+
+      // classical Gram-Schmidt, the norm of w being reduced together
+      // with the projections
+      vDots[k+1] = w;
+      dotProducts(k+2, &vDots[0], w, &m_globalDots[0]);
+      CFreal wNorm2 = m_globalDots[k+1];
+      CFreal hNorm2 = wNorm2;
+      for (CFuint j = 0; j <= k; ++j) {
+	h[j] = m_globalDots[j];
+	hNorm2 -= h[j]*h[j];
+	const CFreal *const vj = v[j];
+	for (CFuint i = 0; i < n; ++i) {
+	  w[i] -= h[j]*vj[i];
+	}
+      }
+
+      // the orthogonalization is repeated if w has lost more than
+      // half of its squared norm
+      if (hNorm2 < 0.5*wNorm2) {
+	dotProducts(k+2, &vDots[0], w, &m_globalDots[0]);
+	hNorm2 = m_globalDots[k+1];
+	for (CFuint j = 0; j <= k; ++j) {
+	  const CFreal c = m_globalDots[j];
+	  h[j] += c;
+	  hNorm2 -= c*c;
+	  const CFreal *const vj = v[j];
+	  for (CFuint i = 0; i < n; ++i) {
+	    w[i] -= c*vj[i];
+	  }
+	}
+      }
+      h[k+1] = std::sqrt(std::max(hNorm2, 0.));
+
+      // apply the previous rotations and compute the new one
+      for (CFuint j = 0; j < k; ++j) {
+	const CFreal hj = m_cos[j]*h[j] + m_sin[j]*h[j+1];
+	h[j+1] = -m_sin[j]*h[j] + m_cos[j]*h[j+1];
+	h[j] = hj;
+      }
+      const CFreal denom = std::sqrt(h[k]*h[k] + h[k+1]*h[k+1]);
+      m_cos[k] = (denom > 0.) ? h[k]/denom : 1.;
+      m_sin[k] = (denom > 0.) ? h[k+1]/denom : 0.;
+      const CFreal hNext = h[k+1];
+      h[k] = denom;
+      h[k+1] = 0.;
+      m_g[k+1] = -m_sin[k]*m_g[k];
+      m_g[k] *= m_cos[k];
+
+      m_residual = std::abs(m_g[k+1]);
+      if (m_output) {
+	CFLog(INFO, "GMRES iteration " << iter << ", residual norm = " << m_residual << "\n");
+      }
+
+      ++k;
+      if (m_residual <= tolerance || hNext <= 0.) {
+	converged = true;
+	break;
+      }
+
+      for (CFuint i = 0; i < n; ++i) {
+	w[i] /= hNext;
+      }
+    }
+
+    // solve the triangular system and update x += M^-1 V y
+    for (CFuint jj = k; jj > 0; --jj) {
+      const CFuint j = jj-1;
+      CFreal yj = m_g[j];
+      for (CFuint l = j+1; l < k; ++l) {
+	yj -= m_hessenberg[l*hSize + j]*m_g[l];
+      }
+      m_g[j] = yj/m_hessenberg[j*hSize + j];
+    }
+
+    for (CFuint i = 0; i < n; ++i) {
+      work[i] = 0.;
+    }
+    for (CFuint j = 0; j < k; ++j) {
+      const CFreal *const vj = v[j];
+      const CFreal yj = m_g[j];
+      for (CFuint i = 0; i < n; ++i) {
+	work[i] += yj*vj[i];
+      }
+    }
+    op.applyPreconditioner(work, z);
+    for (CFuint i = 0; i < n; ++i) {
+      x[i] += z[i];
+    }
+  }
+
+  return iter;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockGMRES::dotProducts(const CFuint nbVectors,
+			     const CFreal *const * vectors,
+			     const CFreal* v,
+			     CFreal* dots)
+{
+  const CFuint n = m_nbOwned;
+  for (CFuint j = 0; j < nbVectors; ++j) {
+    const CFreal *const vj = vectors[j];
+    CFreal sum = 0.;
+    for (CFuint i = 0; i < n; ++i) {
+      sum += vj[i]*v[i];
+    }
+    m_dots[j] = sum;
+  }
+
+  if (PE::GetPE().IsParallel()) {
+    MPI_Allreduce(&m_dots[0], dots, nbVectors,
+		  MPIStructDef::getMPIType(&m_dots[0]), MPI_SUM,
+		  PE::GetPE().GetCommunicator());
+  }
+  else {
+    for (CFuint j = 0; j < nbVectors; ++j) {
+      dots[j] = m_dots[j];
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,145 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_BlockLSS_BlockGMRES_hh
+#define COOLFluiD_BlockLSS_BlockGMRES_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+#include "Common/NonCopyable.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common { template <typename T> class ParVector; }
+
+  namespace BlockLSS {
+
+    class BlockLSSMatrix;
+    class BlockOperator;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class solves a block sparse linear system with the restarted GMRES
+/// method, right preconditioned with the given BlockOperator. The
+/// orthogonalization is the classical Gram-Schmidt, so that each iteration
+/// needs a single global reduction, repeated only when a loss of
+/// orthogonality is detected.
+/// @author Andrea Lani
+class BlockGMRES : public Common::NonCopyable<BlockGMRES> {
+public:
+
+  /// Constructor
+  BlockGMRES();
+
+  /// Destructor
+  ~BlockGMRES();
+
+  /// Allocates the work vectors
+  /// @param nbOwned         number of owned entries of the vectors
+  /// @param nbKrylovSpaces  number of Krylov spaces before restarting
+  void setup(const CFuint nbOwned, const CFuint nbKrylovSpaces);
+
+  /// Sets the stopping criteria
+  /// @param relTolerance  tolerance on the residual norm relative to the rhs one
+  /// @param absTolerance  tolerance on the residual norm
+  /// @param maxIter       maximum number of iterations
+  void setTolerances(const CFreal relTolerance,
+		     const CFreal absTolerance,
+		     const CFuint maxIter);
+
+  /// Sets the flag telling to print the residual norm at each iteration
+  void setOutput(const bool output) {m_output = output;}
+
+  /// Solves A x = b, starting from x = 0
+  /// @param halo  vector of the owned and ghost blocks used by the products
+  /// @param b     rhs, on the owned entries
+  /// @param x     solution, on the owned entries
+  /// @return the number of iterations
+  /// @pre the preconditioner of the operator has been computed
+  CFuint solve(const BlockLSSMatrix& mat,
+	       Common::ParVector<CFreal>& halo,
+	       BlockOperator& op,
+	       const CFreal* b,
+	       CFreal* x);
+
+  /// Gets the norm of the residual estimated at the last iteration
+  CFreal getResidualNorm() const {return m_residual;}
+
+private: // helper functions
+
+  /// Computes the dot products of the given vectors with v, in a single
+  /// global reduction
+  void dotProducts(const CFuint nbVectors,
+		   const CFreal *const * vectors,
+		   const CFreal* v,
+		   CFreal* dots);
+
+private: // data
+
+  /// number of owned entries of the vectors
+  CFuint m_nbOwned;
+
+  /// number of Krylov spaces
+  CFuint m_nbKsp;
+
+  /// relative tolerance
+  CFreal m_rTol;
+
+  /// absolute tolerance
+  CFreal m_aTol;
+
+  /// maximum number of iterations
+  CFuint m_maxIter;
+
+  /// flag telling to print the residual norm at each iteration
+  bool m_output;
+
+  /// norm of the residual estimated at the last iteration
+  CFreal m_residual;
+
+  /// basis of the Krylov space, one vector after the other
+  std::vector< CFreal > m_krylov;
+
+  /// preconditioned vector
+  std::vector< CFreal > m_precVec;
+
+  /// work vector
+  std::vector< CFreal > m_work;
+
+  /// Hessenberg matrix, stored by columns
+  std::vector< CFreal > m_hessenberg;
+
+  /// cosines of the Givens rotations
+  std::vector< CFreal > m_cos;
+
+  /// sines of the Givens rotations
+  std::vector< CFreal > m_sin;
+
+  /// rotated residual vector
+  std::vector< CFreal > m_g;
+
+  /// local dot products
+  std::vector< CFreal > m_dots;
+
+  /// global dot products
+  std::vector< CFreal > m_globalDots;
+
+}; // end of class BlockGMRES
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_BlockLSS_BlockGMRES_hh
@@ -0,0 +1,186 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_BlockLSS_BlockKernels_hh
+#define COOLFluiD_BlockLSS_BlockKernels_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include "Common/COOLFluiD.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class gives the size of the blocks, known at compile time if N > 0
+/// and at run time if N = 0
+/// @author Andrea Lani
+template <CFuint N>
+struct BlockSize {
+  static CFuint get(const CFuint nb) {return N;}
+};
+
+template <>
+struct BlockSize<0> {
+  static CFuint get(const CFuint nb) {return nb;}
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class provides the dense kernels on the square blocks of a block
+/// sparse matrix, stored row by row. With N > 0 the loops have a constant
+/// trip count and are unrolled and vectorized by the compiler.
+/// The products with a vector accept blocks stored in single precision,
+/// the sums being always accumulated in double precision.
+/// @author Andrea Lani
+template <CFuint N>
+class BlockKernels {
+public:
+
+  /// y = a*x
+  template <typename T>
+  static void mult(const CFuint nb, const T* a, const CFreal* x, CFreal* y)
+  {
+    const CFuint n = BlockSize<N>::get(nb);
+    for (CFuint i = 0; i < n; ++i) {
+      CFreal sum = 0.;
+      for (CFuint j = 0; j < n; ++j) {
+	sum += a[i*n + j]*x[j];
+      }
+      y[i] = sum;
+    }
+  }
+
+  /// y += a*x
+  template <typename T>
+  static void multAdd(const CFuint nb, const T* a, const CFreal* x, CFreal* y)
+  {
+    const CFuint n = BlockSize<N>::get(nb);
+    for (CFuint i = 0; i < n; ++i) {
+      CFreal sum = 0.;
+      for (CFuint j = 0; j < n; ++j) {
+	sum += a[i*n + j]*x[j];
+      }
+      y[i] += sum;
+    }
+  }
+
+  /// y -= a*x
+  template <typename T>
+  static void multSub(const CFuint nb, const T* a, const CFreal* x, CFreal* y)
+  {
+    const CFuint n = BlockSize<N>::get(nb);
+    for (CFuint i = 0; i < n; ++i) {
+      CFreal sum = 0.;
+      for (CFuint j = 0; j < n; ++j) {
+	sum += a[i*n + j]*x[j];
+      }
+      y[i] -= sum;
+    }
+  }
+
+  /// c = a*b
+  static void multMat(const CFuint nb, const CFreal* a, const CFreal* b, CFreal* c)
+  {
+    const CFuint n = BlockSize<N>::get(nb);
+    for (CFuint i = 0; i < n; ++i) {
+      for (CFuint j = 0; j < n; ++j) {
+	c[i*n + j] = 0.;
+      }
+      for (CFuint k = 0; k < n; ++k) {
+	const CFreal aik = a[i*n + k];
+	for (CFuint j = 0; j < n; ++j) {
+	  c[i*n + j] += aik*b[k*n + j];
+	}
+      }
+    }
+  }
+
+  /// c -= a*b
+  static void multSubMat(const CFuint nb, const CFreal* a, const CFreal* b, CFreal* c)
+  {
+    const CFuint n = BlockSize<N>::get(nb);
+    for (CFuint i = 0; i < n; ++i) {
+      for (CFuint k = 0; k < n; ++k) {
+	const CFreal aik = a[i*n + k];
+	for (CFuint j = 0; j < n; ++j) {
+	  c[i*n + j] -= aik*b[k*n + j];
+	}
+      }
+    }
+  }
+
+  /// Inverts the block in place by Gauss-Jordan elimination with
+  /// partial pivoting
+  /// @param perm  work array of nb entries
+  /// @return false if the block is singular
+  static bool invert(const CFuint nb, CFreal* a, CFuint* perm)
+  {
+    const CFuint n = BlockSize<N>::get(nb);
+    for (CFuint k = 0; k < n; ++k) {
+      CFuint p = k;
+      for (CFuint i = k+1; i < n; ++i) {
+	if (std::abs(a[i*n + k]) > std::abs(a[p*n + k])) p = i;
+      }
+      if (a[p*n + k] == 0.) return false;
+
+      perm[k] = p;
+      if (p != k) {
+	for (CFuint j = 0; j < n; ++j) {
+	  const CFreal tmp = a[k*n + j];
+	  a[k*n + j] = a[p*n + j];
+	  a[p*n + j] = tmp;
+	}
+      }
+
+      const CFreal pivot = 1./a[k*n + k];
+      a[k*n + k] = 1.;
+      for (CFuint j = 0; j < n; ++j) {
+	a[k*n + j] *= pivot;
+      }
+
+      for (CFuint i = 0; i < n; ++i) {
+	if (i != k) {
+	  const CFreal factor = a[i*n + k];
+	  a[i*n + k] = 0.;
+	  for (CFuint j = 0; j < n; ++j) {
+	    a[i*n + j] -= factor*a[k*n + j];
+	  }
+	}
+      }
+    }
+
+    // the row permutations become column permutations of the inverse
+    for (CFuint k = n; k > 0; --k) {
+      const CFuint p = perm[k-1];
+      if (p != k-1) {
+	for (CFuint i = 0; i < n; ++i) {
+	  const CFreal tmp = a[i*n + k-1];
+	  a[i*n + k-1] = a[i*n + p];
+	  a[i*n + p] = tmp;
+	}
+      }
+    }
+    return true;
+  }
+
+}; // end of class BlockKernels
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_BlockLSS_BlockKernels_hh
@@ -0,0 +1,136 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/BadValueException.hh"
+#include "Common/CFLog.hh"
+
+#include "Framework/MethodCommandProvider.hh"
+
+#include "BlockLSS/BlockLSSData.hh"
+#include "BlockLSS/BlockLSSModule.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider<NullMethodCommand<BlockLSSData>, BlockLSSData, BlockLSSModule>
+nullBlockLSSComProvider("Null");
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSData::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< CFuint >("NbKrylovSpaces","Number of Krylov spaces before restarting GMRES (default = 30).");
+  options.addConfigOption< CFuint >("ILULevels","Levels of fill for the ILU preconditioner (default = 0).");
+  options.addConfigOption< std::string >("PCType","Preconditioner type: PCILU, PCBJACOBI (ILU on each partition), PCPBJACOBI or PCNONE (default = PCILU).");
+  options.addConfigOption< bool >("SinglePrecisionPC","Store the factors of the preconditioner in single precision (default = false).");
+  options.addConfigOption< CFreal >("RelativeTolerance","Relative tolerance for control of iterative solver convergence.");
+  options.addConfigOption< CFreal >("AbsoluteTolerance","Absolute tolerance for control of iterative solver convergence.");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockLSSData::BlockLSSData(Common::SafePtr<std::valarray<bool> > maskArray,
+			   CFuint& nbSysEquations,
+			   Common::SafePtr<Framework::Method> owner) :
+  LSSData(maskArray, nbSysEquations, owner),
+  m_mat(),
+  m_sol(),
+  m_rhs(),
+  m_halo(),
+  m_operator()
+{
+  addConfigOptionsTo(this);
+
+  m_nbKsp = 30;
+  setParameter("NbKrylovSpaces",&m_nbKsp);
+
+  m_ilulevels = 0;
+  setParameter("ILULevels",&m_ilulevels);
+
+  m_pcTypeStr = "PCILU";
+  setParameter("PCType",&m_pcTypeStr);
+
+  m_singlePrecisionPC = false;
+  setParameter("SinglePrecisionPC",&m_singlePrecisionPC);
+
+  m_rTol = 1e-5;
+  setParameter("RelativeTolerance",&m_rTol);
+
+  m_aTol = 1e-30;
+  setParameter("AbsoluteTolerance",&m_aTol);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockLSSData::~BlockLSSData()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSData::configure ( Config::ConfigArgs& args )
+{
+  LSSData::configure(args);
+
+  // check the preconditioner type as early as possible
+  getPreconditionerType();
+
+  CFLog(VERBOSE, "BlockLSS PCType = " << m_pcTypeStr << "\n");
+  CFLog(VERBOSE, "BlockLSS Nb KSP spaces = " << m_nbKsp << "\n");
+  CFLog(VERBOSE, "BlockLSS ILU levels = " << m_ilulevels << "\n");
+  CFLog(VERBOSE, "BlockLSS single precision PC = " << m_singlePrecisionPC << "\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockOperator::PreconditionerType BlockLSSData::getPreconditionerType() const
+{
+  if (m_pcTypeStr == "PCILU" || m_pcTypeStr == "PCBJACOBI") {
+    return BlockOperator::PC_ILU;
+  }
+  if (m_pcTypeStr == "PCPBJACOBI") {
+    return BlockOperator::PC_PBJACOBI;
+  }
+  if (m_pcTypeStr == "PCNONE") {
+    return BlockOperator::PC_NONE;
+  }
+
+  throw Common::BadValueException
+    (FromHere(), "BlockLSSData: unknown PCType " + m_pcTypeStr);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSData::printToFile(const std::string& prefix, const std::string& suffix)
+{
+  CFAUTOTRACE;
+
+  const string matStr = prefix + "mat" + suffix;
+  const string rhsStr = prefix + "rhs" + suffix;
+  const string solStr = prefix + "sol" + suffix;
+
+  m_mat.printToFile(matStr.c_str());
+  m_rhs.printToFile(rhsStr.c_str());
+  m_sol.printToFile(solStr.c_str());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,157 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_BlockLSS_BlockLSSData_hh
+#define COOLFluiD_BlockLSS_BlockLSSData_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <memory>
+
+#include "Common/MPI/ParVector.hh"
+#include "Framework/LSSData.hh"
+
+#include "BlockLSS/BlockLSSMatrix.hh"
+#include "BlockLSS/BlockLSSVector.hh"
+#include "BlockLSS/BlockOperator.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a data object that is accessed by the different
+/// BlockLSSCom's that compose the BlockLSS
+/// @author Andrea Lani
+class BlockLSSData : public Framework::LSSData {
+public:
+
+  /// Defines the Config Option's of this class
+  /// @param options a OptionList where to add the Option's
+  static void defineConfigOptions(Config::OptionList& options);
+
+  /// Constructor
+  BlockLSSData(Common::SafePtr<std::valarray<bool> > maskArray,
+	       CFuint& nbSysEquations,
+	       Common::SafePtr<Framework::Method> owner);
+
+  /// Destructor
+  ~BlockLSSData();
+
+  /// Configure the data from the supplied arguments
+  virtual void configure ( Config::ConfigArgs& args );
+
+  /// Gets the matrix
+  BlockLSSMatrix& getMatrix() {return m_mat;}
+
+  /// Gets the solution vector
+  BlockLSSVector& getSolVector() {return m_sol;}
+
+  /// Gets the rhs vector
+  BlockLSSVector& getRhsVector() {return m_rhs;}
+
+  /// Sets the vector exchanging the ghost blocks of the products
+  void setHaloVector(Common::ParVector<CFreal>* halo) {m_halo.reset(halo);}
+
+  /// Gets the vector exchanging the ghost blocks of the products
+  Common::ParVector<CFreal>& getHaloVector()
+  {
+    cf_assert(m_halo.get() != CFNULL);
+    return *m_halo;
+  }
+
+  /// Sets the operator applying the matrix and the preconditioner
+  void setOperator(BlockOperator* op) {m_operator.reset(op);}
+
+  /// Gets the operator applying the matrix and the preconditioner
+  BlockOperator& getOperator()
+  {
+    cf_assert(m_operator.get() != CFNULL);
+    return *m_operator;
+  }
+
+  /// Gets the number of Krylov spaces before restarting GMRES
+  CFuint getNbKrylovSpaces() const {return m_nbKsp;}
+
+  /// Gets the levels of fill of the ILU preconditioner
+  CFuint getILULevels() const {return m_ilulevels;}
+
+  /// Gets the type of preconditioner
+  BlockOperator::PreconditionerType getPreconditionerType() const;
+
+  /// Tells if the factors of the preconditioner are stored in single precision
+  bool isSinglePrecisionPC() const {return m_singlePrecisionPC;}
+
+  /// Gets the relative tolerance
+  CFreal getRelativeTolerance() const {return m_rTol;}
+
+  /// Gets the absolute tolerance
+  CFreal getAbsoluteTolerance() const {return m_aTol;}
+
+  /// Prints the linear system to files
+  void printToFile(const std::string& prefix, const std::string& suffix);
+
+  /// Gets the Class name
+  static std::string getClassName() {return "BlockLSS";}
+
+private: // data
+
+  /// matrix of the linear system
+  BlockLSSMatrix m_mat;
+
+  /// solution vector
+  BlockLSSVector m_sol;
+
+  /// rhs vector
+  BlockLSSVector m_rhs;
+
+  /// vector of the owned and ghost blocks, exchanging the ghost blocks
+  /// of the products
+  std::auto_ptr<Common::ParVector<CFreal> > m_halo;
+
+  /// operator applying the matrix and the preconditioner
+  std::auto_ptr<BlockOperator> m_operator;
+
+  /// number of Krylov spaces
+  CFuint m_nbKsp;
+
+  /// levels of fill of the ILU preconditioner
+  CFuint m_ilulevels;
+
+  /// type of preconditioner
+  std::string m_pcTypeStr;
+
+  /// flag telling to store the factors of the preconditioner in single precision
+  bool m_singlePrecisionPC;
+
+  /// relative tolerance
+  CFreal m_rTol;
+
+  /// absolute tolerance
+  CFreal m_aTol;
+
+}; // end of class BlockLSSData
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Definition of a command for BlockLSS
+typedef Framework::MethodCommand<BlockLSSData> BlockLSSCom;
+
+/// Definition of a command provider for BlockLSS
+typedef Framework::MethodCommand<BlockLSSData>::PROVIDER BlockLSSComProvider;
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_BlockLSS_BlockLSSData_hh
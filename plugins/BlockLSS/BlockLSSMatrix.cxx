@@ -0,0 +1,467 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <fstream>
+
+#include "Common/BadValueException.hh"
+#include "Common/CFLog.hh"
+#include "Common/StringOps.hh"
+#include "Framework/BlockAccumulator.hh"
+#include "Framework/LSSVector.hh"
+
+#include "BlockLSS/BlockLSSMatrix.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockLSSMatrix::BlockLSSMatrix() :
+  Framework::LSSMatrix(),
+  m_nb(0),
+  m_nbRows(0),
+  m_nbCols(0),
+  m_rowStart(),
+  m_rowSize(),
+  m_colIDs(),
+  m_diagPos(),
+  m_ghostStart(),
+  m_values(),
+  m_isCompressed(false),
+  m_name()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockLSSMatrix::~BlockLSSMatrix()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::createSeqAIJ(const CFint m,
+				  const CFint n,
+				  const CFint nz,
+				  const CFint* nnz,
+				  const char* name)
+{
+  createSeqBAIJ(1, m, n, nz, nnz, name);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::createSeqBAIJ(const CFuint blockSize,
+				   const CFint m,
+				   const CFint n,
+				   const CFint nz,
+				   const CFint* nnz,
+				   const char* name)
+{
+  CFAUTOTRACE;
+
+  cf_assert(blockSize > 0);
+  m_name = (name != CFNULL) ? string(name) : string();
+  m_nb = blockSize;
+  m_nbRows = m/blockSize;
+  m_nbCols = n/blockSize;
+  m_isCompressed = false;
+
+  // each row starts with its diagonal block and has room for the
+  // expected number of blocks
+  m_rowStart.resize(m_nbRows+1);
+  m_rowSize.assign(m_nbRows, 1);
+  m_rowStart[0] = 0;
+  for (CFuint r = 0; r < m_nbRows; ++r) {
+    const CFint expected = (nnz != CFNULL) ? nnz[r] : nz;
+    m_rowStart[r+1] = m_rowStart[r] + max<CFint>(expected, 1);
+  }
+
+  m_colIDs.assign(m_rowStart[m_nbRows], 0);
+  m_values.assign(m_rowStart[m_nbRows]*m_nb*m_nb, 0.);
+  for (CFuint r = 0; r < m_nbRows; ++r) {
+    m_colIDs[m_rowStart[r]] = r;
+  }
+
+  m_diagPos.clear();
+  m_ghostStart.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+#ifdef CF_HAVE_MPI
+void BlockLSSMatrix::createParAIJ(MPI_Comm comm,
+				  const CFint m,
+				  const CFint n,
+				  const CFint M,
+				  const CFint N,
+				  const CFint dnz,
+				  const CFint* dnnz,
+				  const CFint onz,
+				  const CFint* onnz,
+				  const char* name)
+{
+  createParBAIJ(comm, 1, m, n, M, N, dnz, dnnz, onz, onnz, name);
+}
+#endif // CF_HAVE_MPI
+
+//////////////////////////////////////////////////////////////////////////////
+
+#ifdef CF_HAVE_MPI
+void BlockLSSMatrix::createParBAIJ(MPI_Comm comm,
+				   const CFuint blockSize,
+				   const CFint m,
+				   const CFint n,
+				   const CFint M,
+				   const CFint N,
+				   const CFint dnz,
+				   const CFint* dnnz,
+				   const CFint onz,
+				   const CFint* onnz,
+				   const char* name)
+{
+  const CFuint nbRows = m/blockSize;
+  vector<CFint> nnz(nbRows);
+  for (CFuint r = 0; r < nbRows; ++r) {
+    nnz[r] = ((dnnz != CFNULL) ? dnnz[r] : dnz) + ((onnz != CFNULL) ? onnz[r] : onz);
+  }
+  createSeqBAIJ(blockSize, m, n, dnz + onz, (nbRows > 0) ? &nnz[0] : CFNULL, name);
+}
+#endif // CF_HAVE_MPI
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal* BlockLSSMatrix::getBlock(const CFuint row, const CFuint col, const bool insert)
+{
+  cf_assert(row < m_nbRows);
+  cf_assert(col < m_nbCols);
+
+  const CFuint begin = m_rowStart[row];
+  const CFuint end = (m_isCompressed) ? m_rowStart[row+1] : begin + m_rowSize[row];
+  const CFuint pos = lower_bound(m_colIDs.begin() + begin, m_colIDs.begin() + end, col) -
+    m_colIDs.begin();
+  const CFuint nb2 = m_nb*m_nb;
+  if (pos < end && m_colIDs[pos] == col) return &m_values[pos*nb2];
+
+  if (!insert) return CFNULL;
+
+  // a block outside of the frozen structure would be lost
+  if (m_isCompressed) {
+    throw Common::BadValueException
+      (FromHere(), "BlockLSSMatrix " + m_name + ": block (" +
+       Common::StringOps::to_str(row) + ", " + Common::StringOps::to_str(col) +
+       ") is not in the frozen non zero structure");
+  }
+
+  if (end == m_rowStart[row+1]) growRow(row);
+
+  // shift the following blocks of the row to keep the columns sorted
+  for (CFuint k = end; k > pos; --k) {
+    m_colIDs[k] = m_colIDs[k-1];
+    for (CFuint i = 0; i < nb2; ++i) {
+      m_values[k*nb2 + i] = m_values[(k-1)*nb2 + i];
+    }
+  }
+  m_colIDs[pos] = col;
+  for (CFuint i = 0; i < nb2; ++i) {
+    m_values[pos*nb2 + i] = 0.;
+  }
+  ++m_rowSize[row];
+  return &m_values[pos*nb2];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::growRow(const CFuint row)
+{
+  // the number of expected blocks was too small: this should happen
+  // only for a few rows, as the whole storage is moved
+  const CFuint capacity = m_rowStart[row+1] - m_rowStart[row];
+  const CFuint extra = max<CFuint>(capacity/2, 4);
+  const CFuint nb2 = m_nb*m_nb;
+
+  CFLog(VERBOSE, "BlockLSSMatrix::growRow() => row " << row << " grows by "
+	<< extra << " blocks\n");
+
+  m_colIDs.insert(m_colIDs.begin() + m_rowStart[row+1], extra, 0);
+  m_values.insert(m_values.begin() + m_rowStart[row+1]*nb2, extra*nb2, 0.);
+  for (CFuint r = row+1; r <= m_nbRows; ++r) {
+    m_rowStart[r] += extra;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::compressStructure()
+{
+  CFAUTOTRACE;
+
+  const CFuint nb2 = m_nb*m_nb;
+  CFuint nbBlocks = 0;
+  for (CFuint r = 0; r < m_nbRows; ++r) {
+    const CFuint begin = m_rowStart[r];
+    const CFuint size = m_rowSize[r];
+    m_rowStart[r] = nbBlocks;
+    for (CFuint k = begin; k < begin + size; ++k, ++nbBlocks) {
+      m_colIDs[nbBlocks] = m_colIDs[k];
+      for (CFuint i = 0; i < nb2; ++i) {
+	m_values[nbBlocks*nb2 + i] = m_values[k*nb2 + i];
+      }
+    }
+  }
+  m_rowStart[m_nbRows] = nbBlocks;
+
+  vector<CFuint>(m_colIDs.begin(), m_colIDs.begin() + nbBlocks).swap(m_colIDs);
+  vector<CFreal>(m_values.begin(), m_values.begin() + nbBlocks*nb2).swap(m_values);
+  vector<CFuint>().swap(m_rowSize);
+
+  m_diagPos.resize(m_nbRows);
+  m_ghostStart.resize(m_nbRows);
+  for (CFuint r = 0; r < m_nbRows; ++r) {
+    vector<CFuint>::const_iterator begin = m_colIDs.begin() + m_rowStart[r];
+    vector<CFuint>::const_iterator end = m_colIDs.begin() + m_rowStart[r+1];
+    m_diagPos[r] = lower_bound(begin, end, r) - m_colIDs.begin();
+    m_ghostStart[r] = lower_bound(begin, end, m_nbRows) - m_colIDs.begin();
+    cf_assert(m_colIDs[m_diagPos[r]] == r);
+  }
+
+  m_isCompressed = true;
+
+  CFLog(VERBOSE, "BlockLSSMatrix::compressStructure() => " << nbBlocks
+	<< " blocks in " << m_nbRows << " rows\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::printToScreen() const
+{
+  CFout << "BlockLSSMatrix \"" << m_name << "\":\n";
+  const CFuint nb2 = m_nb*m_nb;
+  for (CFuint r = 0; r < m_nbRows; ++r) {
+    const CFuint end = (m_isCompressed) ? m_rowStart[r+1] : m_rowStart[r] + m_rowSize[r];
+    for (CFuint k = m_rowStart[r]; k < end; ++k) {
+      for (CFuint i = 0; i < nb2; ++i) {
+	CFout << r*m_nb + i/m_nb << " " << m_colIDs[k]*m_nb + i%m_nb << " "
+	      << m_values[k*nb2 + i] << "\n";
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::printToFile(const char* fileName) const
+{
+  ofstream fout(fileName);
+  fout.precision(16);
+  const CFuint nb2 = m_nb*m_nb;
+  for (CFuint r = 0; r < m_nbRows; ++r) {
+    const CFuint end = (m_isCompressed) ? m_rowStart[r+1] : m_rowStart[r] + m_rowSize[r];
+    for (CFuint k = m_rowStart[r]; k < end; ++k) {
+      for (CFuint i = 0; i < nb2; ++i) {
+	fout << r*m_nb + i/m_nb << " " << m_colIDs[k]*m_nb + i%m_nb << " "
+	     << m_values[k*nb2 + i] << "\n";
+      }
+    }
+  }
+  fout.close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::setValue(const CFint im, const CFint in, const CFreal value)
+{
+  if (im < 0 || in < 0) return;
+  const CFuint row = im/m_nb;
+  const CFuint col = in/m_nb;
+  if (row >= m_nbRows || col >= m_nbCols) return;
+  CFreal *const block = getBlock(row, col, true);
+  block[(im%m_nb)*m_nb + in%m_nb] = value;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::setValues(const CFuint m,
+			       const CFint* im,
+			       const CFuint n,
+			       const CFint* in,
+			       const CFreal* values)
+{
+  for (CFuint i = 0; i < m; ++i) {
+    for (CFuint j = 0; j < n; ++j) {
+      setValue(im[i], in[j], values[i*n + j]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::addValue(const CFint im, const CFint in, const CFreal value)
+{
+  if (im < 0 || in < 0) return;
+  const CFuint row = im/m_nb;
+  const CFuint col = in/m_nb;
+  if (row >= m_nbRows || col >= m_nbCols) return;
+  CFreal *const block = getBlock(row, col, true);
+  block[(im%m_nb)*m_nb + in%m_nb] += value;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::addValues(const CFuint m,
+			       const CFint* im,
+			       const CFuint n,
+			       const CFint* in,
+			       const CFreal* values)
+{
+  for (CFuint i = 0; i < m; ++i) {
+    for (CFuint j = 0; j < n; ++j) {
+      addValue(im[i], in[j], values[i*n + j]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::getValue(const CFint im, const CFint in, CFreal& value)
+{
+  value = 0.;
+  if (im < 0 || in < 0) return;
+  const CFuint row = im/m_nb;
+  const CFuint col = in/m_nb;
+  if (row >= m_nbRows || col >= m_nbCols) return;
+  const CFreal *const block = getBlock(row, col, false);
+  if (block != CFNULL) value = block[(im%m_nb)*m_nb + in%m_nb];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::getValues(const CFuint m,
+			       const CFint* im,
+			       const CFuint n,
+			       const CFint* in,
+			       CFreal* values)
+{
+  for (CFuint i = 0; i < m; ++i) {
+    for (CFuint j = 0; j < n; ++j) {
+      getValue(im[i], in[j], values[i*n + j]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::setRow(const CFuint row, CFreal diagval, CFreal offdiagval)
+{
+  const CFuint blockRow = row/m_nb;
+  if (blockRow >= m_nbRows) return;
+  const CFuint r = row%m_nb;
+  const CFuint end = (m_isCompressed) ?
+    m_rowStart[blockRow+1] : m_rowStart[blockRow] + m_rowSize[blockRow];
+  for (CFuint k = m_rowStart[blockRow]; k < end; ++k) {
+    CFreal *const blockRowValues = &m_values[(k*m_nb + r)*m_nb];
+    for (CFuint c = 0; c < m_nb; ++c) {
+      blockRowValues[c] = (m_colIDs[k] == blockRow && c == r) ? diagval : offdiagval;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::setDiagonal(Framework::LSSVector& diag)
+{
+  CFreal value = 0.;
+  for (CFuint r = 0; r < m_nbRows; ++r) {
+    CFreal *const block = getBlock(r, r, true);
+    for (CFuint i = 0; i < m_nb; ++i) {
+      const CFint idx = r*m_nb + i;
+      diag.getValues(1, &idx, &value);
+      block[i*m_nb + i] = value;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::addToDiagonal(Framework::LSSVector& diag)
+{
+  CFreal value = 0.;
+  for (CFuint r = 0; r < m_nbRows; ++r) {
+    CFreal *const block = getBlock(r, r, true);
+    for (CFuint i = 0; i < m_nb; ++i) {
+      const CFint idx = r*m_nb + i;
+      diag.getValues(1, &idx, &value);
+      block[i*m_nb + i] += value;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::resetToZeroEntries()
+{
+  for (CFuint i = 0; i < m_values.size(); ++i) {
+    m_values[i] = 0.;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::setValues(const Framework::BlockAccumulator& acc)
+{
+  cf_assert(acc.getNB() == m_nb);
+  const vector<CFint>& im = acc.getIM();
+  const vector<CFint>& in = acc.getIN();
+  for (CFuint i = 0; i < acc.getM(); ++i) {
+    if (im[i] < 0 || static_cast<CFuint>(im[i]) >= m_nbRows) continue;
+    for (CFuint j = 0; j < acc.getN(); ++j) {
+      if (in[j] < 0 || static_cast<CFuint>(in[j]) >= m_nbCols) continue;
+      CFreal *const block = getBlock(im[i], in[j], true);
+      for (CFuint ib = 0; ib < m_nb; ++ib) {
+	for (CFuint jb = 0; jb < m_nb; ++jb) {
+	  block[ib*m_nb + jb] = acc.getValue(i,j,ib,jb);
+	}
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSMatrix::addValues(const Framework::BlockAccumulator& acc)
+{
+  cf_assert(acc.getNB() == m_nb);
+  const vector<CFint>& im = acc.getIM();
+  const vector<CFint>& in = acc.getIN();
+  for (CFuint i = 0; i < acc.getM(); ++i) {
+    if (im[i] < 0 || static_cast<CFuint>(im[i]) >= m_nbRows) continue;
+    for (CFuint j = 0; j < acc.getN(); ++j) {
+      if (in[j] < 0 || static_cast<CFuint>(in[j]) >= m_nbCols) continue;
+      CFreal *const block = getBlock(im[i], in[j], true);
+      for (CFuint ib = 0; ib < m_nb; ++ib) {
+	for (CFuint jb = 0; jb < m_nb; ++jb) {
+	  block[ib*m_nb + jb] += acc.getValue(i,j,ib,jb);
+	}
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
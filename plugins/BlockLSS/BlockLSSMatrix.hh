@@ -0,0 +1,247 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_BlockLSS_BlockLSSMatrix_hh
+#define COOLFluiD_BlockLSS_BlockLSSMatrix_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Framework/LSSMatrix.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a matrix in block compressed row (BCSR) format.
+/// The rows are the locally updatable states, the columns all the local
+/// states, the ghost states being numbered after the updatable ones, so
+/// that in each row the columns of the ghost states come last.
+/// Until the first final assembly each row has some free room and new
+/// blocks are inserted when first accessed. The structure is then
+/// compressed and frozen: blocks outside of it are ignored afterwards.
+/// @author Andrea Lani
+class BlockLSSMatrix : public Framework::LSSMatrix {
+public:
+
+  /// Default constructor without arguments
+  BlockLSSMatrix();
+
+  /// Destructor
+  ~BlockLSSMatrix();
+
+  /// Create a sequential sparse matrix
+  void createSeqAIJ(const CFint m,
+		    const CFint n,
+		    const CFint nz,
+		    const CFint* nnz,
+		    const char* name = CFNULL);
+
+  /// Create a block sparse matrix
+  /// @param m    number of rows (updatable states times block size)
+  /// @param n    number of columns (local states times block size)
+  /// @param nz   expected number of blocks in each block row if nnz is null
+  /// @param nnz  expected number of blocks in each block row
+  void createSeqBAIJ(const CFuint blockSize,
+		     const CFint m,
+		     const CFint n,
+		     const CFint nz,
+		     const CFint* nnz,
+		     const char* name = CFNULL);
+
+#ifdef CF_HAVE_MPI
+  /// Create a parallel sparse matrix
+  void createParAIJ(MPI_Comm comm,
+		    const CFint m,
+		    const CFint n,
+		    const CFint M,
+		    const CFint N,
+		    const CFint dnz,
+		    const CFint* dnnz,
+		    const CFint onz,
+		    const CFint* onnz,
+		    const char* name = CFNULL);
+
+  /// Create a parallel block sparse matrix, the local columns
+  /// including the ghost states
+  void createParBAIJ(MPI_Comm comm,
+		     const CFuint blockSize,
+		     const CFint m,
+		     const CFint n,
+		     const CFint M,
+		     const CFint N,
+		     const CFint dnz,
+		     const CFint* dnnz,
+		     const CFint onz,
+		     const CFint* onnz,
+		     const char* name = CFNULL);
+#endif // CF_HAVE_MPI
+
+  /// Start to assemble the matrix
+  void beginAssembly(LSSMatrixAssemblyType assemblyType) {}
+
+  /// Finish to assemble the matrix, compressing the structure
+  /// at the first final assembly
+  void endAssembly(LSSMatrixAssemblyType assemblyType)
+  {
+    if (assemblyType == FINAL_ASSEMBLY && !m_isCompressed) compressStructure();
+  }
+
+  /// Print this matrix
+  void printToScreen() const;
+
+  /// Print this matrix to a file
+  void printToFile(const char* fileName) const;
+
+  /// Set one value
+  void setValue(const CFint im, const CFint in, const CFreal value);
+
+  /// Set a list of values
+  void setValues(const CFuint m,
+		 const CFint* im,
+		 const CFuint n,
+		 const CFint* in,
+		 const CFreal* values);
+
+  /// Add one value
+  void addValue(const CFint im, const CFint in, const CFreal value);
+
+  /// Add a list of values
+  void addValues(const CFuint m,
+		 const CFint* im,
+		 const CFuint n,
+		 const CFint* in,
+		 const CFreal* values);
+
+  /// Get one value
+  void getValue(const CFint im, const CFint in, CFreal& value);
+
+  /// Get a list of values
+  void getValues(const CFuint m,
+		 const CFint* im,
+		 const CFuint n,
+		 const CFint* in,
+		 CFreal* values);
+
+  /// Set a row, diagonal and off-diagonals
+  void setRow(const CFuint row, CFreal diagval, CFreal offdiagval);
+
+  /// Set the diagonal
+  void setDiagonal(Framework::LSSVector& diag);
+
+  /// Add to the diagonal
+  void addToDiagonal(Framework::LSSVector& diag);
+
+  /// Reset to 0 all the non-zero elements of the matrix
+  void resetToZeroEntries();
+
+  /// Set the blocks of the accumulator
+  void setValues(const Framework::BlockAccumulator& acc);
+
+  /// Add the blocks of the accumulator
+  void addValues(const Framework::BlockAccumulator& acc);
+
+  /// Freeze the matrix structure concerning the non zero locations
+  void freezeNonZeroStructure()
+  {
+    if (!m_isCompressed) compressStructure();
+  }
+
+  /// Tells if the structure has been compressed and frozen
+  bool isCompressed() const {return m_isCompressed;}
+
+  /// Get the size of the blocks
+  CFuint getBlockSize() const {return m_nb;}
+
+  /// Get the number of block rows
+  CFuint getNbBlockRows() const {return m_nbRows;}
+
+  /// Get the number of block columns
+  CFuint getNbBlockCols() const {return m_nbCols;}
+
+  /// Get the position of the first block of each row, followed by
+  /// the total number of blocks
+  const std::vector<CFuint>& getRowStart() const {return m_rowStart;}
+
+  /// Get the block column of each block, sorted in each row
+  const std::vector<CFuint>& getColIDs() const {return m_colIDs;}
+
+  /// Get the position of the diagonal block of each row
+  const std::vector<CFuint>& getDiagPos() const {return m_diagPos;}
+
+  /// Get the position of the first block of each row in a ghost column
+  const std::vector<CFuint>& getGhostStart() const {return m_ghostStart;}
+
+  /// Get the values of the blocks, stored row by row
+  const CFreal* getBlockValues() const {return &m_values[0];}
+
+private: // helper functions
+
+  /// Gets the values of the block (row, col), inserting it if the
+  /// structure is not yet compressed
+  /// @return null if the block is not in the structure and insert is false
+  /// @throw Common::BadValueException if the block has to be inserted in
+  ///        the compressed structure
+  CFreal* getBlock(const CFuint row, const CFuint col, const bool insert);
+
+  /// Adds free room at the end of the given row
+  void growRow(const CFuint row);
+
+  /// Removes the free room of the rows and computes the position of
+  /// the diagonal blocks and of the first ghost blocks
+  void compressStructure();
+
+private: // data
+
+  /// size of the blocks
+  CFuint m_nb;
+
+  /// number of block rows
+  CFuint m_nbRows;
+
+  /// number of block columns
+  CFuint m_nbCols;
+
+  /// position of the first block of each row, followed by the total number of blocks
+  std::vector<CFuint> m_rowStart;
+
+  /// number of blocks used in each row before the compression
+  std::vector<CFuint> m_rowSize;
+
+  /// block column of each block
+  std::vector<CFuint> m_colIDs;
+
+  /// position of the diagonal block of each row
+  std::vector<CFuint> m_diagPos;
+
+  /// position of the first ghost block of each row
+  std::vector<CFuint> m_ghostStart;
+
+  /// values of the blocks
+  std::vector<CFreal> m_values;
+
+  /// flag telling if the structure has been compressed
+  bool m_isCompressed;
+
+  /// name of the matrix
+  std::string m_name;
+
+}; // end of class BlockLSSMatrix
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_BlockLSS_BlockLSSMatrix_hh
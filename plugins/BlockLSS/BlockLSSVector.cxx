@@ -0,0 +1,87 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <fstream>
+
+#include "Common/CFLog.hh"
+
+#include "BlockLSS/BlockLSSVector.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockLSSVector::BlockLSSVector() :
+  Framework::LSSVector(),
+  m_values(),
+  m_globalSize(0),
+  m_name()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockLSSVector::~BlockLSSVector()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSVector::create(MPI_Comm comm,
+			    const CFint m,
+			    const CFint M,
+			    const char* name)
+{
+  CFAUTOTRACE;
+
+  m_name = (name != CFNULL) ? std::string(name) : std::string();
+  m_values.assign(m, 0.);
+  m_globalSize = M;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSVector::destroy()
+{
+  CFAUTOTRACE;
+
+  std::vector<CFreal>().swap(m_values);
+  m_globalSize = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSVector::printToScreen() const
+{
+  CFout << "BlockLSSVector \"" << m_name << "\":\n";
+  for (CFuint i = 0; i < m_values.size(); ++i) {
+    CFout << m_values[i] << "\n";
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockLSSVector::printToFile(const char* fileName) const
+{
+  std::ofstream fout(fileName);
+  fout.precision(16);
+  for (CFuint i = 0; i < m_values.size(); ++i) {
+    fout << m_values[i] << "\n";
+  }
+  fout.close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
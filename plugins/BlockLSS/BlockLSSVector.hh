@@ -0,0 +1,140 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_BlockLSS_BlockLSSVector_hh
+#define COOLFluiD_BlockLSS_BlockLSSVector_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Framework/LSSVector.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a vector of the native block sparse linear system.
+/// The locally owned entries come first, followed by the entries of the
+/// ghost states, which the solver does not use: the ghost blocks of the
+/// products go through the halo ParVector of BlockLSSData.
+/// @author Andrea Lani
+class BlockLSSVector : public Framework::LSSVector {
+public:
+
+  /// Default constructor without arguments
+  BlockLSSVector();
+
+  /// Destructor
+  ~BlockLSSVector();
+
+  /// Create a vector
+  /// @param m  local size, including the ghost entries
+  /// @param M  global size
+  void create(MPI_Comm comm, const CFint m, const CFint M, const char* name);
+
+  /// Initialize a vector
+  void initialize(MPI_Comm comm, const CFreal value) {setValue(value);}
+
+  /// Start to assemble the vector
+  void beginAssembly() {}
+
+  /// Finish to assemble the vector
+  void endAssembly() {}
+
+  /// Print this vector
+  void printToScreen() const;
+
+  /// Print this vector to a file
+  void printToFile(const char* fileName) const;
+
+  /// Destroy this vector
+  void destroy();
+
+  /// Set a value at the specified position in the vector
+  void setValue(const CFint idx, const CFreal value) {m_values[idx] = value;}
+
+  /// Set all the entries equal to the given value
+  void setValue(const CFreal value)
+  {
+    for (CFuint i = 0; i < m_values.size(); ++i) m_values[i] = value;
+  }
+
+  /// Set a list of values
+  void setValues(const CFuint nbValues, const CFint* idx, const CFreal* values)
+  {
+    for (CFuint i = 0; i < nbValues; ++i) m_values[idx[i]] = values[i];
+  }
+
+  /// Add a value in the vector at the given location
+  void addValue(const CFint idx, const CFreal value) {m_values[idx] += value;}
+
+  /// Add a list of values at the given locations
+  void addValues(const CFuint nbValues, const CFint* idx, const CFreal* values)
+  {
+    for (CFuint i = 0; i < nbValues; ++i) m_values[idx[i]] += values[i];
+  }
+
+  /// Get one value
+  /// @warning the value is passed by value by the interface and is not returned
+  void getValue(const CFint idx, CFreal value) {value = m_values[idx];}
+
+  /// Get a list of values
+  void getValues(const CFuint m, const CFint* im, CFreal* values)
+  {
+    for (CFuint i = 0; i < m; ++i) values[i] = m_values[im[i]];
+  }
+
+  /// Gets the local size of the vector, including the ghost entries
+  CFuint getLocalSize() const {return m_values.size();}
+
+  /// Gets the global size of the vector
+  CFuint getGlobalSize() const {return m_globalSize;}
+
+  /// Copy the raw data of this vector to a given array
+  void copy(CFreal *const other, const CFuint size) const
+  {
+    for (CFuint i = 0; i < size; ++i) other[i] = m_values[i];
+  }
+
+  /// Copy the raw data of this vector to the given positions of an array
+  void copy(CFreal *const other, CFint *const localIDs, const CFuint size) const
+  {
+    for (CFuint i = 0; i < size; ++i) other[localIDs[i]] = m_values[i];
+  }
+
+  /// Get the internal array
+  CFreal* getArray() {return &m_values[0];}
+
+  /// Get the internal array
+  const CFreal* getArray() const {return &m_values[0];}
+
+private:
+
+  /// entries of the vector
+  std::vector<CFreal> m_values;
+
+  /// global size of the vector
+  CFuint m_globalSize;
+
+  /// name of the vector
+  std::string m_name;
+
+}; // end of class BlockLSSVector
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_BlockLSS_BlockLSSVector_hh
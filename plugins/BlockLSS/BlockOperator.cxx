@@ -0,0 +1,180 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <map>
+
+#include "Common/CFLog.hh"
+
+#include "BlockLSS/BlockOperatorT.hh"
+#include "BlockLSS/BlockLSSMatrix.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockOperator* BlockOperator::create(const CFuint blockSize)
+{
+  switch (blockSize) {
+  case 1:
+    return new BlockOperatorT<1>(blockSize);
+  case 2:
+    return new BlockOperatorT<2>(blockSize);
+  case 3:
+    return new BlockOperatorT<3>(blockSize);
+  case 4:
+    return new BlockOperatorT<4>(blockSize);
+  case 5:
+    return new BlockOperatorT<5>(blockSize);
+  case 6:
+    return new BlockOperatorT<6>(blockSize);
+  case 7:
+    return new BlockOperatorT<7>(blockSize);
+  case 11:
+    return new BlockOperatorT<11>(blockSize);
+  default:
+    return new BlockOperatorT<0>(blockSize);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockOperator::BlockOperator() :
+  Common::NonCopyable<BlockOperator>(),
+  m_pcType(PC_NONE),
+  m_singlePrecision(false),
+  m_isSetup(false),
+  m_nbRows(0),
+  m_luRowStart(),
+  m_luColIDs(),
+  m_luDiagPos(),
+  m_matToLU(),
+  m_luValues(),
+  m_luValuesSP()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockOperator::~BlockOperator()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockOperator::setupPreconditioner(const BlockLSSMatrix& mat,
+					const PreconditionerType type,
+					const CFuint fillLevels,
+					const bool singlePrecision)
+{
+  CFAUTOTRACE;
+
+  cf_assert(mat.isCompressed());
+
+  m_pcType = type;
+  m_singlePrecision = singlePrecision;
+  m_isSetup = true;
+  m_nbRows = mat.getNbBlockRows();
+  if (m_pcType == PC_NONE) return;
+
+  const CFuint nb = mat.getBlockSize();
+  const CFuint nbRows = m_nbRows;
+  const vector<CFuint>& rowStart = mat.getRowStart();
+  const vector<CFuint>& ghostStart = mat.getGhostStart();
+  const vector<CFuint>& diagPos = mat.getDiagPos();
+  const vector<CFuint>& colIDs = mat.getColIDs();
+  const CFuint maxLevel = (m_pcType == PC_ILU) ? fillLevels : 0;
+
+  // symbolic factorization: the level of each block of the row is the
+  // minimum over the paths through the previous rows, the blocks of the
+  // matrix having level 0. Only the owned columns are kept.
+  m_luRowStart.assign(1, 0);
+  m_luColIDs.clear();
+  m_luDiagPos.resize(nbRows);
+  vector<CFuint> luLevels;
+  map<CFuint, CFuint> rowLevels;
+  for (CFuint i = 0; i < nbRows; ++i) {
+    rowLevels.clear();
+    if (m_pcType == PC_PBJACOBI) {
+      rowLevels[i] = 0;
+    }
+    else {
+      for (CFuint p = rowStart[i]; p < ghostStart[i]; ++p) {
+	rowLevels[colIDs[p]] = 0;
+      }
+    }
+
+    if (maxLevel > 0) {
+      for (map<CFuint, CFuint>::iterator ik = rowLevels.begin();
+	   ik != rowLevels.end() && ik->first < i; ++ik) {
+	const CFuint k = ik->first;
+	for (CFuint q = m_luDiagPos[k]+1; q < m_luRowStart[k+1]; ++q) {
+	  const CFuint level = ik->second + luLevels[q] + 1;
+	  if (level <= maxLevel) {
+	    map<CFuint, CFuint>::iterator ij = rowLevels.find(m_luColIDs[q]);
+	    if (ij == rowLevels.end()) {
+	      rowLevels[m_luColIDs[q]] = level;
+	    }
+	    else if (level < ij->second) {
+	      ij->second = level;
+	    }
+	  }
+	}
+      }
+    }
+
+    for (map<CFuint, CFuint>::const_iterator ij = rowLevels.begin();
+	 ij != rowLevels.end(); ++ij) {
+      if (ij->first == i) {
+	m_luDiagPos[i] = m_luColIDs.size();
+      }
+      m_luColIDs.push_back(ij->first);
+      luLevels.push_back(ij->second);
+    }
+    m_luRowStart.push_back(m_luColIDs.size());
+  }
+
+  // position of the blocks of the matrix in the factors, the columns of
+  // both being sorted in each row
+  m_matToLU.assign(colIDs.size(), -1);
+  for (CFuint i = 0; i < nbRows; ++i) {
+    if (m_pcType == PC_PBJACOBI) {
+      m_matToLU[diagPos[i]] = m_luDiagPos[i];
+      continue;
+    }
+
+    CFuint q = m_luRowStart[i];
+    for (CFuint p = rowStart[i]; p < ghostStart[i]; ++p) {
+      while (m_luColIDs[q] < colIDs[p]) ++q;
+      cf_assert(m_luColIDs[q] == colIDs[p]);
+      m_matToLU[p] = q;
+    }
+  }
+
+  if (!m_singlePrecision) {
+    m_luValues.assign(m_luColIDs.size()*nb*nb, 0.);
+  }
+
+  CFLog(VERBOSE, "BlockOperator::setupPreconditioner() => "
+	<< m_luColIDs.size() << " blocks in the factors of "
+	<< nbRows << " block rows"
+	<< (m_singlePrecision ? " (single precision)" : "") << "\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,128 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_BlockLSS_BlockOperator_hh
+#define COOLFluiD_BlockLSS_BlockOperator_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+#include "Common/NonCopyable.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common { template <typename T> class ParVector; }
+
+  namespace BlockLSS {
+
+    class BlockLSSMatrix;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class applies a block sparse matrix and its preconditioner to the
+/// vectors of the linear system. The concrete classes are specialized on
+/// the size of the blocks, so that there is one virtual call per operation
+/// on the whole matrix and none per block.
+/// The preconditioner is an incomplete block factorization restricted to
+/// the locally owned rows and columns: ILU(k) on the pattern of the matrix
+/// extended with the fill of level up to k, or the inverse of the diagonal
+/// blocks (point-block Jacobi). The factors can be kept in single
+/// precision, halving the memory traffic of the triangular solves, while
+/// the factorization and the solves are computed in double precision.
+/// @author Andrea Lani
+class BlockOperator : public Common::NonCopyable<BlockOperator> {
+public:
+
+  /// types of preconditioners
+  enum PreconditionerType {PC_NONE, PC_PBJACOBI, PC_ILU};
+
+  /// Creates an operator specialized on the given block size
+  /// @post the operator has to be deleted outside
+  static BlockOperator* create(const CFuint blockSize);
+
+  /// Constructor
+  BlockOperator();
+
+  /// Destructor
+  virtual ~BlockOperator();
+
+  /// Computes y = A*x
+  /// @param halo  vector of the owned and ghost blocks, whose ghost
+  ///              entries give the ones of x
+  /// @param x     vector of the owned entries
+  /// @param y     vector of the owned entries
+  virtual void multiply(const BlockLSSMatrix& mat,
+			Common::ParVector<CFreal>& halo,
+			const CFreal* x,
+			CFreal* y) = 0;
+
+  /// Computes the numerical factorization of the preconditioner
+  virtual void computePreconditioner(const BlockLSSMatrix& mat) = 0;
+
+  /// Computes x = M^-1 b, on the owned entries
+  virtual void applyPreconditioner(const CFreal* b, CFreal* x) = 0;
+
+  /// Computes the structure of the preconditioner
+  /// @param singlePrecision  flag telling to store the factors in single precision
+  /// @pre the structure of the matrix is compressed
+  void setupPreconditioner(const BlockLSSMatrix& mat,
+			   const PreconditionerType type,
+			   const CFuint fillLevels,
+			   const bool singlePrecision);
+
+  /// Tells if the structure of the preconditioner has been computed
+  bool isPreconditionerSetup() const {return m_isSetup;}
+
+protected: // data
+
+  /// type of preconditioner
+  PreconditionerType m_pcType;
+
+  /// flag telling if the factors are stored in single precision
+  bool m_singlePrecision;
+
+  /// flag telling if the structure of the preconditioner has been computed
+  bool m_isSetup;
+
+  /// number of block rows
+  CFuint m_nbRows;
+
+  /// position of the first block of each row of the factors, followed
+  /// by the total number of blocks
+  std::vector<CFuint> m_luRowStart;
+
+  /// block column of each block of the factors
+  std::vector<CFuint> m_luColIDs;
+
+  /// position of the diagonal block of each row of the factors
+  std::vector<CFuint> m_luDiagPos;
+
+  /// position in the factors of each block of the matrix,
+  /// -1 if the block is dropped
+  std::vector<CFint> m_matToLU;
+
+  /// values of the factors, the diagonal blocks being stored inverted
+  /// (only during the factorization if stored in single precision)
+  std::vector<CFreal> m_luValues;
+
+  /// values of the factors in single precision
+  std::vector<float> m_luValuesSP;
+
+}; // end of class BlockOperator
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_BlockLSS_BlockOperator_hh
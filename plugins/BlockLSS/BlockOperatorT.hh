@@ -0,0 +1,82 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_BlockLSS_BlockOperatorT_hh
+#define COOLFluiD_BlockLSS_BlockOperatorT_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "BlockLSS/BlockOperator.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class implements the BlockOperator for blocks of size N,
+/// N = 0 standing for a size known only at run time
+/// @author Andrea Lani
+template <CFuint N>
+class BlockOperatorT : public BlockOperator {
+public:
+
+  /// Constructor
+  /// @param blockSize  size of the blocks, equal to N if N > 0
+  explicit BlockOperatorT(const CFuint blockSize);
+
+  /// Destructor
+  ~BlockOperatorT();
+
+  /// Computes y = A*x
+  void multiply(const BlockLSSMatrix& mat,
+		Common::ParVector<CFreal>& halo,
+		const CFreal* x,
+		CFreal* y);
+
+  /// Computes the numerical factorization of the preconditioner
+  void computePreconditioner(const BlockLSSMatrix& mat);
+
+  /// Computes x = M^-1 b
+  void applyPreconditioner(const CFreal* b, CFreal* x);
+
+private: // helper functions
+
+  /// Computes x = (LU)^-1 b with the factors stored in the given precision
+  template <typename T>
+  void solveFactors(const T* lu, const CFreal* b, CFreal* x);
+
+private: // data
+
+  /// size of the blocks
+  CFuint m_nb;
+
+  /// position in the current row of the factors of each block column
+  std::vector<CFint> m_colPos;
+
+  /// work block
+  std::vector<CFreal> m_work;
+
+  /// pivots of the inversion of the diagonal blocks
+  std::vector<CFuint> m_perm;
+
+}; // end of class BlockOperatorT
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "BlockLSS/BlockOperatorT.ci"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_BlockLSS_BlockOperatorT_hh
@@ -0,0 +1,131 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/PE.hh"
+#include "Common/MPI/ParVector.hh"
+
+#include "Framework/GlobalJacobianSparsity.hh"
+#include "Framework/MethodCommandProvider.hh"
+#include "Framework/LSSIdxMapping.hh"
+#include "Framework/SpaceMethod.hh"
+#include "Framework/State.hh"
+
+#include "BlockLSS/StdSetup.hh"
+#include "BlockLSS/BlockLSSModule.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider< StdSetup,BlockLSSData,BlockLSSModule >
+  stdSetupProvider("StdSetup");
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSetup::execute()
+{
+  CFAUTOTRACE;
+
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  const CFuint nbStates = states.size();
+  const CFuint nbEqs = getMethodData().getNbSysEquations();
+  const CFuint nbGlobal = states.getGlobalSize();
+  const bool isParallel = PE::GetPE().IsParallel();
+
+  // count the number of updatable states
+  CFuint nbLocal = 0;
+  for (CFuint iL = 0; iL < nbStates; ++iL) {
+    if (!isParallel || states[iL]->isParUpdatable()) {
+      ++nbLocal;
+    }
+  }
+
+  // local to LSS mapping: the updatable states come first, the ghost
+  // states last, each group keeping the local ordering
+  std::valarray< CFuint > L2S(nbStates);
+  std::valarray< bool > ghosts(nbStates);
+  CFuint iu = 0;
+  CFuint ig = nbLocal;
+  for (CFuint iL = 0; iL < nbStates; ++iL) {
+    if (!isParallel || states[iL]->isParUpdatable()) {
+      L2S[iL] = iu++;
+      ghosts[iL] = false;
+    }
+    else {
+      L2S[iL] = ig++;
+      ghosts[iL] = true;
+    }
+  }
+  cf_assert(iu == nbLocal);
+  getMethodData().getLocalToGlobalMapping().createMapping(L2S,ghosts);
+
+  // setup vectors, with room for the ghost entries
+  BlockLSSVector& sol = getMethodData().getSolVector();
+  sol.create(PE::GetPE().GetCommunicator(),nbStates*nbEqs,nbGlobal*nbEqs,"sol");
+
+  BlockLSSVector& rhs = getMethodData().getRhsVector();
+  rhs.create(PE::GetPE().GetCommunicator(),nbStates*nbEqs,nbGlobal*nbEqs,"rhs");
+
+  // expected number of blocks in each row, the actual structure being
+  // built during the first assembly
+  std::valarray<CFint> allNonZero(nbStates);
+  allNonZero = 0;
+  std::valarray<CFint> outDiagNonZero(nbStates);
+  outDiagNonZero = 0;
+
+  SelfRegistPtr<GlobalJacobianSparsity> sparsity =
+    getMethodData().getCollaborator<SpaceMethod>()->createJacobianSparsity();
+  sparsity->setDataSockets(socket_states, socket_nodes, socket_bStatesNeighbors);
+  sparsity->computeNNz(allNonZero, outDiagNonZero);
+
+  std::vector<CFint> nnz(nbLocal);
+  for (CFuint iL = 0; iL < nbStates; ++iL) {
+    if (!ghosts[iL]) {
+      nnz[L2S[iL]] = allNonZero[iL] + outDiagNonZero[iL];
+    }
+  }
+
+  BlockLSSMatrix& mat = getMethodData().getMatrix();
+  mat.createSeqBAIJ(nbEqs,nbLocal*nbEqs,nbStates*nbEqs,0,&nnz[0],"mat");
+
+  // halo of the products, with the blocks in the LSS ordering: the
+  // ghost blocks come after the owned ones and are synchronized by the
+  // comm pattern of the ParVector
+  std::vector< CFuint > lssToLocal(nbStates);
+  for (CFuint iL = 0; iL < nbStates; ++iL) {
+    lssToLocal[L2S[iL]] = iL;
+  }
+  ParVector<CFreal>* halo = new ParVector<CFreal>(0., 0, nbEqs*sizeof(CFreal));
+  getMethodData().setHaloVector(halo);
+  halo->reserve(nbStates, nbEqs*sizeof(CFreal));
+  for (CFuint i = 0; i < nbStates; ++i) {
+    const CFuint globalID = states[lssToLocal[i]]->getGlobalID();
+    if (i < nbLocal) {
+      halo->AddLocalPoint(globalID);
+    }
+    else {
+      halo->AddGhostPoint(globalID);
+    }
+  }
+  halo->BuildGhostMap();
+
+  getMethodData().setOperator(BlockOperator::create(nbEqs));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  }  // namespace BlockLSS
+}  // namespace COOLFluiD
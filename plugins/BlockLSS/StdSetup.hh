@@ -0,0 +1,72 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_BlockLSS_StdSetup_hh
+#define COOLFluiD_BlockLSS_StdSetup_hh
+
+#include "BlockLSS/BlockLSSData.hh"
+#include "Framework/DataSocketSink.hh"
+
+namespace COOLFluiD {
+
+  namespace Framework { class Node; }
+
+  namespace BlockLSS {
+
+/// This is a standard command to setup the BlockLSS method.
+/// The updatable states are numbered first and the ghost states last, so
+/// that the matrix rows are the updatable states and its columns are all
+/// the local states.
+/// @author Andrea Lani
+class StdSetup : public BlockLSSCom {
+
+public:
+
+  /// Constructor
+  explicit StdSetup(const std::string& name) :
+    BlockLSSCom(name),
+    socket_bStatesNeighbors("bStatesNeighbors"),
+    socket_states("states"),
+    socket_nodes("nodes") {}
+
+  /// Destructor
+  ~StdSetup() {}
+
+  /// Execute processing actions
+  void execute();
+
+  /**
+   * Returns the DataSockets that this command needs as sinks
+   * @return vector of SafePtr with the DataSockets
+   */
+  std::vector< Common::SafePtr< Framework::BaseDataSocketSink > >
+    needsSockets() {
+    std::vector< Common::SafePtr< Framework::BaseDataSocketSink > > result;
+    result.push_back(&socket_states);
+    result.push_back(&socket_nodes);
+    result.push_back(&socket_bStatesNeighbors);
+    return result;
+  }
+
+protected:
+
+  /// socket for bStatesNeighbors
+  /// It's a list of neighbor states for the boundary states (to avoid matrix
+  /// reallocations when applying boundary conditions)
+  Framework::DataSocketSink< std::valarray<Framework::State*> > socket_bStatesNeighbors;
+
+  /// socket for states
+  Framework::DataSocketSink< Framework::State*,Framework::GLOBAL >  socket_states;
+
+  /// socket for nodes
+  Framework::DataSocketSink< Framework::Node*,Framework::GLOBAL >  socket_nodes;
+
+}; // class StdSetup
+
+  }  // namespace BlockLSS
+}  // namespace COOLFluiD
+
+#endif // COOLFluiD_BlockLSS_StdSetup_hh
@@ -0,0 +1,152 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/CFLog.hh"
+
+#include "Framework/MethodCommandProvider.hh"
+#include "Framework/SubSystemStatus.hh"
+#include "Framework/LSSIdxMapping.hh"
+#include "Framework/PhysicalModel.hh"
+#include "Framework/State.hh"
+
+#include "BlockLSS/StdSolveSys.hh"
+#include "BlockLSS/BlockLSSModule.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace BlockLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider< StdSolveSys,BlockLSSData,BlockLSSModule >
+  stdSolveSysProvider("StdSolveSys");
+
+//////////////////////////////////////////////////////////////////////////////
+
+StdSolveSys::StdSolveSys(const std::string& name) :
+  BlockLSSCom(name),
+  socket_states("states"),
+  socket_rhs("rhs"),
+  _upLocalIDs(),
+  _upStatesGlobalIDs(),
+  m_gmres()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+StdSolveSys::~StdSolveSys()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSolveSys::setup()
+{
+  CFAUTOTRACE;
+
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  const CFuint nbStates = states.size();
+  const CFuint nbEqs = getMethodData().getNbSysEquations();
+  const LSSIdxMapping& idxMapping = getMethodData().getLocalToGlobalMapping();
+  const CFuint totalNbEqs = PhysicalModelStack::getActive()->getNbEq();
+  const std::valarray<bool>& maskArray = *getMethodData().getMaskArray();
+
+  // positions of the entries of the updatable states in the rhs and
+  // in the linear system
+  _upLocalIDs.clear();
+  _upStatesGlobalIDs.clear();
+  for (CFuint i = 0; i < nbStates; ++i) {
+    const CFint rowID = idxMapping.getRowID(states[i]->getLocalID());
+    if (rowID >= 0) {
+      const CFuint localID = i*totalNbEqs;
+      CFint globalID = rowID*static_cast<CFint>(nbEqs);
+      for (CFuint iEq = 0; iEq < totalNbEqs; ++iEq) {
+	if (maskArray[iEq]) {
+	  _upStatesGlobalIDs.push_back(globalID++);
+	  _upLocalIDs.push_back(static_cast<CFint>(localID + iEq));
+	}
+      }
+    }
+  }
+
+  m_gmres.setup(_upLocalIDs.size(), getMethodData().getNbKrylovSpaces());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSolveSys::execute()
+{
+  CFAUTOTRACE;
+
+  DataHandle< CFreal> rhs = socket_rhs.getDataHandle();
+  cf_assert(_upLocalIDs.size() == _upStatesGlobalIDs.size());
+  const CFuint vecSize = _upLocalIDs.size();
+
+  BlockLSSMatrix& mat = getMethodData().getMatrix();
+  BlockLSSVector& rhsVec = getMethodData().getRhsVector();
+  BlockLSSVector& solVec = getMethodData().getSolVector();
+  BlockOperator& op = getMethodData().getOperator();
+
+  // assemble the matrix
+  mat.finalAssembly();
+
+  // freeze the non zero structure of the matrix at the first solve,
+  // which is not the first iteration after a restart
+  if (!mat.isCompressed()) {
+    mat.freezeNonZeroStructure();
+  }
+
+  if (!op.isPreconditionerSetup()) {
+    op.setupPreconditioner(mat, getMethodData().getPreconditionerType(),
+			   getMethodData().getILULevels(),
+			   getMethodData().isSinglePrecisionPC());
+  }
+  op.computePreconditioner(mat);
+
+  for (CFuint i = 0; i < vecSize; ++i) {
+    rhsVec.setValue(_upStatesGlobalIDs[i], rhs[_upLocalIDs[i]]);
+  }
+
+  m_gmres.setTolerances(getMethodData().getRelativeTolerance(),
+			getMethodData().getAbsoluteTolerance(),
+			getMethodData().getMaxIterations());
+  m_gmres.setOutput(getMethodData().isOutput());
+  const CFuint iter = m_gmres.solve(mat, getMethodData().getHaloVector(), op,
+				    rhsVec.getArray(), solVec.getArray());
+
+  CFLog(INFO, "GMRES convergence reached at iteration: " << iter << "\n");
+
+  const CFreal *const sol = solVec.getArray();
+  for (CFuint i = 0; i < vecSize; ++i) {
+    rhs[_upLocalIDs[i]] = sol[_upStatesGlobalIDs[i]];
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+vector<SafePtr<BaseDataSocketSink> > StdSolveSys::needsSockets()
+{
+  vector<SafePtr<BaseDataSocketSink> > result;
+
+  result.push_back(&socket_states);
+  result.push_back(&socket_rhs);
+
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  }  // namespace BlockLSS
+}  // namespace COOLFluiD
@@ -0,0 +1,69 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_BlockLSS_StdSolveSys_hh
+#define COOLFluiD_BlockLSS_StdSolveSys_hh
+
+#include "BlockLSS/BlockLSSData.hh"
+#include "BlockLSS/BlockGMRES.hh"
+#include "Framework/DataSocketSink.hh"
+
+namespace COOLFluiD {
+
+  namespace Framework { class State; }
+
+  namespace BlockLSS {
+
+/// This is a standard command to solve the linear system with the
+/// restarted GMRES method, right preconditioned with the operator of
+/// BlockLSSData
+/// @author Andrea Lani
+class StdSolveSys : public BlockLSSCom {
+
+public:
+
+  /// Constructor
+  explicit StdSolveSys(const std::string& name);
+
+  /// Destructor
+  virtual ~StdSolveSys();
+
+  /// Set up private data before the processing phase
+  virtual void setup();
+
+  /// Execute processing actions
+  void execute();
+
+  /**
+   * Returns the DataSocket's that this command needs as sinks
+   * @return a vector of SafePtr with the DataSockets
+   */
+  virtual std::vector< Common::SafePtr< Framework::BaseDataSocketSink > >
+    needsSockets();
+
+private: // data
+
+  /// socket for states
+  Framework::DataSocketSink< Framework::State*,Framework::GLOBAL > socket_states;
+
+  /// socket for rhs
+  Framework::DataSocketSink< CFreal > socket_rhs;
+
+  /// positions in the rhs of the entries of the updatable states
+  std::vector< CFint > _upLocalIDs;
+
+  /// positions in the linear system of the entries of the updatable states
+  std::vector< CFint > _upStatesGlobalIDs;
+
+  /// GMRES solver
+  BlockGMRES m_gmres;
+
+}; // class StdSolveSys
+
+  }  // namespace BlockLSS
+}  // namespace COOLFluiD
+
+#endif // COOLFluiD_BlockLSS_StdSolveSys_hh
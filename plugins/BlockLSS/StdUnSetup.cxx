@@ -0,0 +1,31 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "BlockLSS/StdUnSetup.hh"
+#include "BlockLSS/BlockLSSModule.hh"
+#include "Framework/MethodCommandProvider.hh"
+
+namespace COOLFluiD {
+  namespace BlockLSS {
+
+Framework::MethodCommandProvider< StdUnSetup,BlockLSSData,BlockLSSModule >
+  stdUnSetupProvider("StdUnSetup");
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdUnSetup::execute()
+{
+  CFAUTOTRACE;
+  getMethodData().getSolVector().destroy();
+  getMethodData().getRhsVector().destroy();
+  getMethodData().setHaloVector(CFNULL);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace BlockLSS
+} // namespace COOLFluiD
+
@@ -0,0 +1,34 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_BlockLSS_StdUnSetup_hh
+#define COOLFluiD_BlockLSS_StdUnSetup_hh
+
+#include "BlockLSS/BlockLSSData.hh"
+
+namespace COOLFluiD {
+  namespace BlockLSS {
+
+/// This is a standard command to deallocate data specific to BlockLSS method
+class StdUnSetup : public BlockLSSCom {
+
+public:
+
+  /// Constructor
+  explicit StdUnSetup(const std::string& name) : BlockLSSCom(name) {}
+
+  /// Destructor
+  ~StdUnSetup() {}
+
+  /// Execute processing actions
+  void execute();
+
+}; // class StdUnSetup
+
+  } // namespace BlockLSS
+} // namespace COOLFluiD
+
+#endif // COOLFluiD_BlockLSS_StdUnSetup_hh
@@ -0,0 +1,240 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the GMRES solver of BlockLSS"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <map>
+#include <memory>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/PE.hh"
+#include "Common/MPI/ParVector.hh"
+#include "BlockLSS/BlockGMRES.hh"
+#include "BlockLSS/BlockLSSMatrix.hh"
+#include "BlockLSS/BlockOperator.hh"
+#include "UnitTests/PEFixture.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::BlockLSS;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct BlockGMRESFixture
+{
+  /// size of the blocks
+  static const CFuint NB = 3;
+
+  /// number of points of the grid along x
+  static const CFuint NX = 30;
+
+  /// number of points of the grid along y
+  static const CFuint NY = 24;
+
+  /// The grid is split in slabs of rows, one for each rank. The owned
+  /// points come first in the local numbering, followed by the points
+  /// of the neighbor slabs coupled to them.
+  BlockGMRESFixture()
+  {
+    const CFuint rank = PE::GetPE().GetRank();
+    const CFuint nbProcs = PE::GetPE().GetProcessorCount();
+    const CFuint jStart = rank*NY/nbProcs;
+    const CFuint jEnd = (rank+1)*NY/nbProcs;
+
+    for (CFuint j = jStart; j < jEnd; ++j) {
+      for (CFuint i = 0; i < NX; ++i) {
+	globalIDs.push_back(j*NX + i);
+      }
+    }
+    nbOwned = globalIDs.size();
+    for (CFuint i = 0; i < NX; ++i) {
+      if (jStart > 0) globalIDs.push_back((jStart-1)*NX + i);
+      if (jEnd < NY) globalIDs.push_back(jEnd*NX + i);
+    }
+
+    halo.reset(new ParVector<CFreal>(0., 0, NB*sizeof(CFreal)));
+    halo->reserve(globalIDs.size(), NB*sizeof(CFreal));
+    for (CFuint p = 0; p < globalIDs.size(); ++p) {
+      localIDs[globalIDs[p]] = p;
+      if (p < nbOwned) {
+	halo->AddLocalPoint(globalIDs[p]);
+      }
+      else {
+	halo->AddGhostPoint(globalIDs[p]);
+      }
+    }
+    halo->BuildGhostMap();
+
+    // convection-diffusion blocks on a 5-point stencil, the equations
+    // being coupled in the diagonal blocks
+    const CFuint n = globalIDs.size();
+    mat.createSeqBAIJ(NB, nbOwned*NB, n*NB, 5, CFNULL, "grid");
+    for (CFuint p = 0; p < nbOwned; ++p) {
+      const CFuint g = globalIDs[p];
+      const CFuint i = g % NX;
+      const CFuint j = g / NX;
+      const CFint neighbors[4] = {(i > 0)    ? CFint(g-1)  : -1,
+				  (i+1 < NX) ? CFint(g+1)  : -1,
+				  (j > 0)    ? CFint(g-NX) : -1,
+				  (j+1 < NY) ? CFint(g+NX) : -1};
+      for (CFuint e = 0; e < NB; ++e) {
+	for (CFuint f = 0; f < NB; ++f) {
+	  mat.setValue(p*NB + e, p*NB + f, diagonal(e, f));
+	}
+	for (CFuint k = 0; k < 4; ++k) {
+	  if (neighbors[k] >= 0) {
+	    const CFuint q = localIDs[neighbors[k]];
+	    mat.setValue(p*NB + e, q*NB + e, offDiagonal(k, e));
+	  }
+	}
+      }
+    }
+    mat.endAssembly(LSSMatrix::FINAL_ASSEMBLY);
+
+    // rhs of the known solution, computed from the global numbering
+    exact.resize(nbOwned*NB);
+    b.resize(nbOwned*NB);
+    for (CFuint p = 0; p < nbOwned; ++p) {
+      const CFuint g = globalIDs[p];
+      const CFuint i = g % NX;
+      const CFuint j = g / NX;
+      const CFint neighbors[4] = {(i > 0)    ? CFint(g-1)  : -1,
+				  (i+1 < NX) ? CFint(g+1)  : -1,
+				  (j > 0)    ? CFint(g-NX) : -1,
+				  (j+1 < NY) ? CFint(g+NX) : -1};
+      for (CFuint e = 0; e < NB; ++e) {
+	exact[p*NB + e] = solution(g, e);
+	CFreal sum = 0.;
+	for (CFuint f = 0; f < NB; ++f) {
+	  sum += diagonal(e, f)*solution(g, f);
+	}
+	for (CFuint k = 0; k < 4; ++k) {
+	  if (neighbors[k] >= 0) {
+	    sum += offDiagonal(k, e)*solution(neighbors[k], e);
+	  }
+	}
+	b[p*NB + e] = sum;
+      }
+    }
+  }
+
+  ~BlockGMRESFixture()
+  {
+    // the comm pattern is freed before the parallel environment
+    halo.reset();
+  }
+
+  /// entry of the diagonal blocks
+  static CFreal diagonal(const CFuint e, const CFuint f)
+  {
+    return (e == f) ? 4.1 + 0.1*e : 0.3/(1. + e + 2.*f);
+  }
+
+  /// coupling of an equation to a neighbor, upwinded along x
+  static CFreal offDiagonal(const CFuint k, const CFuint e)
+  {
+    return (k == 0) ? -1.3 - 0.1*e : (k == 1) ? -0.7 + 0.1*e : -1.;
+  }
+
+  /// known solution
+  static CFreal solution(const CFuint g, const CFuint e)
+  {
+    return std::sin(0.05*g + e) + 0.001*g;
+  }
+
+  /// Solves the system with the given preconditioner and checks the solution
+  /// @return the number of iterations
+  CFuint solve(const BlockOperator::PreconditionerType pcType, const CFuint maxIter)
+  {
+    auto_ptr<BlockOperator> op(BlockOperator::create(NB));
+    op->setupPreconditioner(mat, pcType, 1, false);
+    op->computePreconditioner(mat);
+
+    BlockGMRES gmres;
+    gmres.setup(nbOwned*NB, 30);
+    gmres.setTolerances(1e-10, 1e-30, maxIter);
+
+    vector<CFreal> x(nbOwned*NB);
+    const CFuint nbIter = gmres.solve(mat, *halo, *op, &b[0], &x[0]);
+
+    CFuint nbWrong = 0;
+    for (CFuint i = 0; i < x.size(); ++i) {
+      if (std::abs(x[i] - exact[i]) > 1e-7) {++nbWrong;}
+    }
+    BOOST_CHECK_EQUAL(nbWrong, 0u);
+    BOOST_CHECK_LT(nbIter, maxIter);
+    return nbIter;
+  }
+
+  /// global index of each local point
+  vector<CFuint> globalIDs;
+
+  /// local index of each global point
+  map<CFuint, CFuint> localIDs;
+
+  /// number of owned points
+  CFuint nbOwned;
+
+  /// vector exchanging the ghost blocks of the products
+  auto_ptr<ParVector<CFreal> > halo;
+
+  /// matrix of the owned rows
+  BlockLSSMatrix mat;
+
+  /// rhs, on the owned entries
+  vector<CFreal> b;
+
+  /// known solution, on the owned entries
+  vector<CFreal> exact;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( BlockGMRESSuite, BlockGMRESFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( MultiplyMatchesRhs )
+{
+  // the product with the known solution needs the ghost blocks
+  auto_ptr<BlockOperator> op(BlockOperator::create(NB));
+  vector<CFreal> y(nbOwned*NB);
+  op->multiply(mat, *halo, &exact[0], &y[0]);
+  for (CFuint i = 0; i < y.size(); ++i) {
+    BOOST_CHECK_CLOSE(y[i], b[i], 1e-10);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( SolveILU )
+{
+  const CFuint nbIterILU = solve(BlockOperator::PC_ILU, 300);
+  const CFuint nbIterNone = solve(BlockOperator::PC_NONE, 300);
+  BOOST_CHECK_LT(nbIterILU, nbIterNone);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( SolvePointBlockJacobi )
+{
+  solve(BlockOperator::PC_PBJACOBI, 300);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
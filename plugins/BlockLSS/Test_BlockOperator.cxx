@@ -0,0 +1,225 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the block operator of BlockLSS"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <memory>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/BadValueException.hh"
+#include "Common/PE.hh"
+#include "Common/MPI/ParVector.hh"
+#include "BlockLSS/BlockLSSMatrix.hh"
+#include "BlockLSS/BlockOperator.hh"
+#include "UnitTests/PEFixture.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::BlockLSS;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct BlockOperatorFixture
+{
+  /// Fill the matrix of a 5-point stencil on a nx*ny grid with blocks of
+  /// size 2, coupled inside the diagonal blocks
+  void fillGrid(const CFuint nx, const CFuint ny)
+  {
+    const CFuint nb = 2;
+    const CFuint n = nx*ny;
+    mat.createSeqBAIJ(nb, n*nb, n*nb, 5, CFNULL, "grid");
+    for (CFuint j = 0; j < ny; ++j) {
+      for (CFuint i = 0; i < nx; ++i) {
+	const CFint r = (j*nx + i)*nb;
+	mat.setValue(r,   r,   4.05);
+	mat.setValue(r,   r+1, 0.02);
+	mat.setValue(r+1, r,   0.01);
+	mat.setValue(r+1, r+1, 4.05);
+	const CFint neighbors[4] = {(i > 0)    ? r - CFint(nb)    : -1,
+				    (i+1 < nx) ? r + CFint(nb)    : -1,
+				    (j > 0)    ? r - CFint(nx*nb) : -1,
+				    (j+1 < ny) ? r + CFint(nx*nb) : -1};
+	for (CFuint k = 0; k < 4; ++k) {
+	  if (neighbors[k] >= 0) {
+	    mat.setValue(r,   neighbors[k],   -1.);
+	    mat.setValue(r+1, neighbors[k]+1, -1.);
+	  }
+	}
+      }
+    }
+    mat.endAssembly(LSSMatrix::FINAL_ASSEMBLY);
+    buildHalo();
+  }
+
+  /// Fill the matrix of a chain of pairs of rows, strongly coupled inside
+  /// each pair
+  void fillPairs(const CFuint nbPairs)
+  {
+    const CFuint n = 2*nbPairs;
+    mat.createSeqBAIJ(1, n, n, 3, CFNULL, "pairs");
+    for (CFuint k = 0; k < nbPairs; ++k) {
+      const CFint r = 2*k;
+      mat.setValue(r,   r,    2.);
+      mat.setValue(r,   r+1, -1.);
+      mat.setValue(r+1, r,   -3.);
+      mat.setValue(r+1, r+1,  2.);
+      if (k > 0) {
+	mat.setValue(r, r-1, 0.01);
+      }
+      if (k+1 < nbPairs) {
+	mat.setValue(r+1, r+2, 0.01);
+      }
+    }
+    mat.endAssembly(LSSMatrix::FINAL_ASSEMBLY);
+    buildHalo();
+  }
+
+  /// Build the vector of the blocks of the matrix, all owned
+  void buildHalo()
+  {
+    const CFuint nb = mat.getBlockSize();
+    const CFuint nbRows = mat.getNbBlockRows();
+    const CFuint start = PE::GetPE().GetRank()*nbRows;
+    halo.reset(new ParVector<CFreal>(0., 0, nb*sizeof(CFreal)));
+    halo->reserve(nbRows, nb*sizeof(CFreal));
+    for (CFuint i = 0; i < nbRows; ++i) {
+      halo->AddLocalPoint(start + i);
+    }
+    halo->BuildGhostMap();
+  }
+
+  /// Solve A x = b, b being the product of the matrix with a known
+  /// solution, by iterating x += M^-1 (b - A x)
+  /// @return the number of iterations to reduce the residual by the
+  ///         given factor, or maxIter+1 if not reached
+  CFuint solve(BlockOperator& op, const CFuint maxIter, const CFreal reduction)
+  {
+    const CFuint n = mat.getNbBlockRows()*mat.getBlockSize();
+    vector<CFreal> exact(n);
+    for (CFuint i = 0; i < n; ++i) {
+      exact[i] = std::sin(0.1*i) + 0.01*i;
+    }
+    vector<CFreal> b(n);
+    op.multiply(mat, *halo, &exact[0], &b[0]);
+
+    vector<CFreal> x(n, 0.);
+    vector<CFreal> r(n);
+    vector<CFreal> dx(n);
+    const CFreal bNorm = norm(b);
+    for (CFuint iter = 1; iter <= maxIter; ++iter) {
+      op.multiply(mat, *halo, &x[0], &r[0]);
+      for (CFuint i = 0; i < n; ++i) {
+	r[i] = b[i] - r[i];
+      }
+      op.applyPreconditioner(&r[0], &dx[0]);
+      for (CFuint i = 0; i < n; ++i) {
+	x[i] += dx[i];
+      }
+
+      op.multiply(mat, *halo, &x[0], &r[0]);
+      for (CFuint i = 0; i < n; ++i) {
+	r[i] = b[i] - r[i];
+      }
+      if (norm(r) <= reduction*bNorm) {
+	for (CFuint i = 0; i < n; ++i) {
+	  BOOST_CHECK_SMALL(x[i] - exact[i], 1e-6);
+	}
+	return iter;
+      }
+    }
+    return maxIter+1;
+  }
+
+  static CFreal norm(const vector<CFreal>& v)
+  {
+    CFreal sum = 0.;
+    for (CFuint i = 0; i < v.size(); ++i) {
+      sum += v[i]*v[i];
+    }
+    return std::sqrt(sum);
+  }
+
+  ~BlockOperatorFixture()
+  {
+    // the comm pattern is freed before the parallel environment
+    halo.reset();
+  }
+
+  BlockLSSMatrix mat;
+  auto_ptr<ParVector<CFreal> > halo;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( BlockOperatorSuite, BlockOperatorFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( FillLevelsReduceIterations )
+{
+  fillGrid(24, 20);
+
+  CFuint nbIter[3];
+  const BlockOperator::PreconditionerType types[3] =
+    {BlockOperator::PC_PBJACOBI, BlockOperator::PC_ILU, BlockOperator::PC_ILU};
+  for (CFuint k = 0; k < 3; ++k) {
+    auto_ptr<BlockOperator> op(BlockOperator::create(mat.getBlockSize()));
+    op->setupPreconditioner(mat, types[k], (k == 2) ? 1 : 0, false);
+    op->computePreconditioner(mat);
+    nbIter[k] = solve(*op, 2000, 1e-10);
+    BOOST_CHECK_LE(nbIter[k], 2000u);
+  }
+
+  // ILU(0) beats the block diagonal, ILU(1) beats ILU(0)
+  BOOST_CHECK_LT(nbIter[1], nbIter[0]);
+  BOOST_CHECK_LT(nbIter[2], nbIter[1]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( SinglePrecisionFactorsKeepAccuracy )
+{
+  fillGrid(24, 20);
+
+  // the residual is computed in double precision, so the float factors
+  // still reach the same accuracy, in a few more iterations at most
+  CFuint nbIter[2];
+  for (CFuint k = 0; k < 2; ++k) {
+    auto_ptr<BlockOperator> op(BlockOperator::create(mat.getBlockSize()));
+    op->setupPreconditioner(mat, BlockOperator::PC_ILU, 1, (k == 1));
+    op->computePreconditioner(mat);
+    nbIter[k] = solve(*op, 2000, 1e-10);
+    BOOST_CHECK_LE(nbIter[k], 2000u);
+  }
+  BOOST_CHECK_LE(nbIter[1], nbIter[0] + nbIter[0]/10 + 2);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( FrozenStructure )
+{
+  // the blocks of the structure can still be changed, the others are rejected
+  fillPairs(4);
+  BOOST_CHECK(mat.isCompressed());
+  BOOST_CHECK_NO_THROW(mat.addValue(0, 1, 1.));
+  BOOST_CHECK_THROW(mat.addValue(0, 5, 1.), BadValueException);
+  BOOST_CHECK_THROW(mat.setValue(7, 0, 1.), BadValueException);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -26,6 +26,7 @@
 #include "Framework/MeshPartitioner.hh"
 
 #include "CFmeshFileReader/ParCFmeshFileReader.hh"
+#include "CFmeshFileReader/ParCFmeshSectionReader.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -39,6 +40,16 @@ namespace COOLFluiD {
 
     namespace CFmeshFileReader {
 
+/// Copies the beginning of a row received from the I/O ranks in the given
+/// vector and returns the rest of the row
+static const CFreal* copyRow(const CFreal* row, RealVector& v)
+{
+  for (CFuint i = 0; i < v.size(); ++i) {
+    v[i] = row[i];
+  }
+  return row + v.size();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 ParCFmeshFileReader::ParCFmeshFileReader() :
@@ -93,6 +104,9 @@ ParCFmeshFileReader::ParCFmeshFileReader() :
   
   m_inputToUpdateVecStr = "Identity";
   setParameter("InputToUpdate",&m_inputToUpdateVecStr);
+
+  m_nbIORanks = 0;
+  setParameter("NbIORanks",&m_nbIORanks);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -112,6 +126,8 @@ void ParCFmeshFileReader::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< std::vector<std::string> > ("MergeTRS", "Topological regions sets to be merged");
 
   options.addConfigOption< std::string >("InputToUpdate", "Transformer from input to update variables");
+
+  options.addConfigOption< CFuint >("NbIORanks", "Number of ranks reading the node, state and element lists and sending them to the others (0 means that each rank reads the whole file)");
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -805,22 +821,54 @@ void ParCFmeshFileReader::readNodeList(ifstream& fin)
 
   getReadData().prepareNodalExtraVars();
 
+  // with the I/O ranks, only the local and ghost nodes are received,
+  // in the same increasing global ID order as in the whole list
+  const bool isCooperative = (m_nbIORanks > 0);
+  const CFuint rowSize = tmpNode.size() + extraVars.size() +
+    (m_hasPastNodes ? tmpPastNode.size() : 0) + (m_hasInterNodes ? tmpInterNode.size() : 0);
+  vector<CFuint> nodeIDs;
+  vector<CFreal> nodeRows;
+  if (isCooperative) {
+    nodeIDs.resize(nbLocalNodes);
+    merge(m_localNodeIDs.begin(), m_localNodeIDs.end(),
+	  m_ghostNodeIDs.begin(), m_ghostNodeIDs.end(), nodeIDs.begin());
+
+    ParCFmeshSectionReader<CFreal> reader(m_comm, m_nbIORanks);
+    reader.addRowBlock(m_totNbNodes, rowSize);
+    readListCooperative(fin, reader, nodeIDs, nodeRows);
+  }
+
+  const CFuint nbRows = (isCooperative) ? nodeIDs.size() : m_totNbNodes;
   CFuint countLocals = 0;
-  for (CFuint iNode = 0; iNode < m_totNbNodes; ++iNode) {
+  for (CFuint iRow = 0; iRow < nbRows; ++iRow) {
+    const CFuint iNode = (isCooperative) ? nodeIDs[iRow] : iRow;
 
     // read the node
-    fin >> tmpNode;
-
-    if (m_hasPastNodes) {
-      fin >> tmpPastNode;
+    if (isCooperative) {
+      const CFreal* row = &nodeRows[iRow*rowSize];
+      row = copyRow(row, tmpNode);
+      if (m_hasPastNodes) {
+	row = copyRow(row, tmpPastNode);
+      }
+      if (m_hasInterNodes) {
+	row = copyRow(row, tmpInterNode);
+      }
+      copyRow(row, extraVars);
     }
+    else {
+      fin >> tmpNode;
 
-    if (m_hasInterNodes) {
-      fin >> tmpInterNode;
-    }
+      if (m_hasPastNodes) {
+	fin >> tmpPastNode;
+      }
 
-    if (nbExtraVars > 0) {
-      fin >> extraVars;
+      if (m_hasInterNodes) {
+	fin >> tmpInterNode;
+      }
+
+      if (nbExtraVars > 0) {
+	fin >> extraVars;
+      }
     }
 
     CFuint localID = 0;
@@ -911,6 +959,12 @@ void ParCFmeshFileReader::emptyNodeListRead(ifstream& fin)
 
   getReadData().prepareNodalExtraVars();
 
+  if (m_nbIORanks > 0) {
+    skipListCooperative(fin);
+    CFLogDebugMin( "ParCFmeshFileReader::emptyNodeListRead() end" << "\n");
+    return;
+  }
+
   for (CFuint n = 0; n < m_totNbNodes; ++n) {
     fin >> node;
 
@@ -1047,15 +1101,50 @@ void ParCFmeshFileReader::readStateList(ifstream& fin)
     m_inputToUpdateVecTrans->setup(1);
   }
 
+  // with the I/O ranks, only the local and ghost states are received,
+  // in the same increasing global ID order as in the whole list
+  const bool isCooperative = useCooperativeStateRead(nbEqs);
+  const CFuint rowSize = readState.size() + extraVars.size() +
+    (m_hasPastStates ? tmpPastState.size() : 0) + (m_hasInterStates ? tmpInterState.size() : 0);
+  vector<CFuint> stateIDs;
+  vector<CFreal> stateRows;
+  if (isCooperative) {
+    stateIDs.resize(nbLocalStates);
+    merge(m_localStateIDs.begin(), m_localStateIDs.end(),
+	  m_ghostStateIDs.begin(), m_ghostStateIDs.end(), stateIDs.begin());
+
+    if (isWithSolution) {
+      ParCFmeshSectionReader<CFreal> reader(m_comm, m_nbIORanks);
+      reader.addRowBlock(m_totNbStates, rowSize);
+      readListCooperative(fin, reader, stateIDs, stateRows);
+    }
+  }
+
+  const CFuint nbRows = (isCooperative) ? stateIDs.size() : m_totNbStates;
   CFuint countLocals = 0;
-  for (CFuint iState = 0; iState < m_totNbStates; ++iState)
+  for (CFuint iRow = 0; iRow < nbRows; ++iRow)
   {
+    const CFuint iState = (isCooperative) ? stateIDs[iRow] : iRow;
+
     // read the state
     if (isWithSolution) 
     {
+      if (isCooperative) {
+	const CFreal* row = &stateRows[iRow*rowSize];
+	row = copyRow(row, readState);
+	if (m_hasPastStates) {
+	  row = copyRow(row, tmpPastState);
+	}
+	if (m_hasInterStates) {
+	  row = copyRow(row, tmpInterState);
+	}
+	copyRow(row, extraVars);
+      }
+
       // no init values were used
       if (m_useInitValues.size() == 0)
       {
+        if (!isCooperative) {
   fin >> readState;
 
         if (m_hasPastStates) 
@@ -1070,6 +1159,7 @@ void ParCFmeshFileReader::readStateList(ifstream& fin)
         if (nbExtraVars > 0) {
           fin >> extraVars;
         }
+        }
 
         if (!hasTransformer) {
           const CFuint currNbEqs = std::min(nbEqs,m_originalNbEqs); // AL: why min????
@@ -1089,6 +1179,7 @@ void ParCFmeshFileReader::readStateList(ifstream& fin)
       else {
 
         cf_assert(m_useInitValues.size() == nbEqs);
+        if (!isCooperative) {
       fin >> readState;
 
             if (m_hasPastStates) {
@@ -1102,6 +1193,7 @@ void ParCFmeshFileReader::readStateList(ifstream& fin)
             if (nbExtraVars > 0) {
               fin >> extraVars;
             }
+        }
 
 
       for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
@@ -1215,6 +1307,12 @@ void ParCFmeshFileReader::emptyStateListRead(ifstream& fin)
 
   getReadData().prepareStateExtraVars();
 
+  if (isWithSolution && useCooperativeStateRead(nbEqs)) {
+    skipListCooperative(fin);
+    CFLogDebugMin( "ParCFmeshFileReader::emptyStateListRead() end" << "\n");
+    return;
+  }
+
   if (isWithSolution) {
     for (CFuint s = 0; s < m_totNbStates; ++s) {
       // read the state values if they exist
@@ -1381,6 +1479,46 @@ void ParCFmeshFileReader::readElemListRank(PartitionerData& pdata,
   CFuint nodeID = 0;
   CFuint stateID = 0;
   
+  // with the I/O ranks, only the elements of this rank are received
+  if (m_nbIORanks > 0) {
+    ParCFmeshSectionReader<CFuint> reader(m_comm, m_nbIORanks);
+    for (CFuint iType = 0; iType < m_totNbElemTypes; ++iType) {
+      reader.addRowBlock((*elementType)[iType].getNbElems(),
+			 (*elementType)[iType].getNbNodes() + (*elementType)[iType].getNbStates());
+    }
+    
+    vector<CFuint> elemIDs(ne);
+    for (CFuint i = 0; i < ne; ++i) {
+      elemIDs[i] = start + i;
+    }
+    vector<CFuint> elemRows;
+    readListCooperative(fin, reader, elemIDs, elemRows);
+    
+    const CFuint* row = (elemRows.size() > 0) ? &elemRows[0] : CFNULL;
+    for (CFuint iType = 0; iType < m_totNbElemTypes; ++iType) {
+      const CFuint nbNodesInElem  = (*elementType)[iType].getNbNodes();
+      const CFuint nbStatesInElem = (*elementType)[iType].getNbStates();
+      const CFuint iElemEnd = iElemBegin + (*elementType)[iType].getNbElems();
+      const CFuint typeEnd = std::min(iElemEnd, end);
+      for (CFuint iElem = std::max(iElemBegin, start); iElem < typeEnd; ++iElem, ++ipos) {
+	eptrn[ipos] = ncount;
+	eptrs[ipos] = scount;
+	for (CFuint j = 0; j < nbNodesInElem; ++j, ++ncount, ++row) {
+	  eNode[ncount] = *row;
+	  checkDofID(eNode[ncount], m_totNbNodes);
+	}
+	for (CFuint j = 0; j < nbStatesInElem; ++j, ++scount, ++row) {
+	  eState[scount] = *row;
+	  checkDofID(eState[scount], m_totNbStates);
+	}
+      }
+      iElemBegin = iElemEnd;
+    }
+    eptrn[nbEEminProc] = ncount;
+    eptrs[nbEEminProc] = scount;
+    return;
+  }
+  
   for (CFuint iType = 0; iType < m_totNbElemTypes; ++iType) {
     const CFuint nbNodesInElem  = (*elementType)[iType].getNbNodes();
     const CFuint nbStatesInElem = (*elementType)[iType].getNbStates();
@@ -1429,6 +1567,35 @@ void ParCFmeshFileReader::readElemListRank(PartitionerData& pdata,
 
 //////////////////////////////////////////////////////////////////////////////
 
+template <typename T>
+void ParCFmeshFileReader::readListCooperative(ifstream& fin,
+					      ParCFmeshSectionReader<T>& reader,
+					      const vector<CFuint>& rowIDs,
+					      vector<T>& rows)
+{
+  const long unsigned int begin = fin.tellg();
+  const long unsigned int end = reader.findSectionEnd(fin, begin);
+  reader.read(fin, begin, end);
+  reader.gather(rowIDs, rows);
+
+  fin.clear();
+  fin.seekg(end);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshFileReader::skipListCooperative(ifstream& fin)
+{
+  ParCFmeshSectionReader<CFreal> reader(m_comm, m_nbIORanks);
+  const long unsigned int begin = fin.tellg();
+  const long unsigned int end = reader.findSectionEnd(fin, begin);
+
+  fin.clear();
+  fin.seekg(end);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void ParCFmeshFileReader::readNbTRSs(ifstream& fin)
 {
   CFLogDebugMin( "ParCFmeshFileReader::readNbTRSs() start\n");
@@ -32,6 +32,8 @@ namespace COOLFluiD {
 
   namespace CFmeshFileReader {
 
+    template <typename T> class ParCFmeshSectionReader;
+
 //////////////////////////////////////////////////////////////////////////////
 
 /// This class represents a parallel CFmesh format reader.
@@ -332,6 +334,30 @@ return (globalElemID - count);
   /// Ineffective reading of the state list
   void emptyStateListRead(std::ifstream& fin);
 
+  /// Reads the list starting at the current position of the file with the
+  /// I/O ranks and gets the given rows of it, leaving the file at the end
+  /// of the list
+  /// @param rowIDs  global IDs of the rows, sorted in ascending order
+  /// @param rows    values of the rows, one row after the other
+  template <typename T>
+  void readListCooperative(std::ifstream& fin,
+			   ParCFmeshSectionReader<T>& reader,
+			   const std::vector<CFuint>& rowIDs,
+			   std::vector<T>& rows);
+
+  /// Moves the file at the end of the list starting at its current
+  /// position, letting only the I/O ranks look for it
+  void skipListCooperative(std::ifstream& fin);
+
+  /// Tells if the state list is read by the I/O ranks. When initial values
+  /// are used and the file has more equations than the physical model, the
+  /// extra values are read after the whole state, which does not allow to
+  /// split the list in rows of known size.
+  bool useCooperativeStateRead(const CFuint nbEqs) const
+  {
+    return (m_nbIORanks > 0) && !(m_useInitValues.size() > 0 && m_originalNbEqs > nbEqs);
+  }
+
  protected:
   
   /// Set the element distribution array
@@ -536,6 +562,10 @@ return (globalElemID - count);
   /// partitioner name
   std::string m_partitionerName;
 
+  /// number of ranks reading the node, state and element lists for all
+  /// the others (0 if each rank reads the whole file)
+  CFuint m_nbIORanks;
+
   /// config option for merging th TRS's
   std::vector<std::string> m_merge_trs;
 
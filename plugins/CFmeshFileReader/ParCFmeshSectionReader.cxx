@@ -0,0 +1,133 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <limits>
+#include <locale>
+#include <sstream>
+
+#include "CFmeshFileReader/ParCFmeshSectionReader.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+    namespace CFmeshFileReader {
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool parseNumber(const char*& p, const char* end, CFuint& value)
+{
+  const char* c = p;
+  if (c < end && *c == '+') ++c;
+  if (c == end || *c < '0' || *c > '9') return false;
+
+  static const CFuint maxValue = std::numeric_limits<CFuint>::max();
+  CFuint v = 0;
+  for (; c < end && *c >= '0' && *c <= '9'; ++c) {
+    const CFuint digit = *c - '0';
+    if (v > (maxValue - digit)/10) return false;
+    v = 10*v + digit;
+  }
+
+  value = v;
+  p = c;
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool parseNumber(const char*& p, const char* end, CFreal& value)
+{
+  // powers of ten exactly representable in double precision
+  static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+				 1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+				 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  static const unsigned long long maxExactMantissa = 1ULL << 53;
+
+  const char* c = p;
+  bool negative = false;
+  if (c < end && (*c == '-' || *c == '+')) {
+    negative = (*c == '-');
+    ++c;
+  }
+
+  // mantissa, keeping up to 19 significant digits
+  unsigned long long mantissa = 0;
+  int nbDigits = 0;
+  int exponent = 0;
+  bool hasDigits = false;
+  bool isExact = true;
+  for (; c < end && *c >= '0' && *c <= '9'; ++c) {
+    hasDigits = true;
+    if (nbDigits < 19) {
+      mantissa = 10*mantissa + (*c - '0');
+      if (mantissa > 0) ++nbDigits;
+    }
+    else {
+      ++exponent;
+      isExact = false;
+    }
+  }
+  if (c < end && *c == '.') {
+    for (++c; c < end && *c >= '0' && *c <= '9'; ++c) {
+      hasDigits = true;
+      if (nbDigits < 19) {
+	mantissa = 10*mantissa + (*c - '0');
+	if (mantissa > 0) ++nbDigits;
+	--exponent;
+      }
+      else {
+	isExact = false;
+      }
+    }
+  }
+  if (!hasDigits) return false;
+
+  if (c < end && (*c == 'e' || *c == 'E')) {
+    const char* e = c + 1;
+    bool negativeExp = false;
+    if (e < end && (*e == '-' || *e == '+')) {
+      negativeExp = (*e == '-');
+      ++e;
+    }
+    if (e < end && *e >= '0' && *e <= '9') {
+      int exp = 0;
+      for (; e < end && *e >= '0' && *e <= '9'; ++e) {
+	if (exp < 100000) exp = 10*exp + (*e - '0');
+      }
+      exponent += negativeExp ? -exp : exp;
+      c = e;
+    }
+  }
+
+  // the result is correctly rounded if both the mantissa and the power of
+  // ten are exact doubles, otherwise let the standard library convert the
+  // text in the classic locale
+  if (isExact && mantissa <= maxExactMantissa && exponent >= -22 && exponent <= 22) {
+    double v = static_cast<double>(mantissa);
+    v = (exponent < 0) ? v/pow10[-exponent] : v*pow10[exponent];
+    value = negative ? -v : v;
+  }
+  else {
+    std::istringstream in(std::string(p, c));
+    in.imbue(std::locale::classic());
+    double v = 0.;
+    in >> v;
+    if (in.fail()) return false;
+    value = v;
+  }
+
+  p = c;
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace CFmeshFileReader
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,164 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_CFmeshFileReader_ParCFmeshSectionReader_hh
+#define COOLFluiD_CFmeshFileReader_ParCFmeshSectionReader_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+#include "Common/NonCopyable.hh"
+#include "Common/MPI/MPIStructDef.hh"
+
+#include "CFmeshFileReader/CFmeshFileReaderAPI.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace CFmeshFileReader {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Parses an unsigned integer in [p, end) without using the locale.
+/// On success p is moved after the last digit.
+/// @return false if [p, end) does not start with a digit or if the number
+///         does not fit in a CFuint
+CFmeshFileReader_API bool parseNumber(const char*& p, const char* end, CFuint& value);
+
+/// Parses a real number in [p, end) without using the locale and without
+/// allocating memory, except for the rare numbers with more than 19
+/// significant digits or a large exponent.
+/// On success p is moved after the last character of the number.
+/// @return false if [p, end) does not start with a number
+CFmeshFileReader_API bool parseNumber(const char*& p, const char* end, CFreal& value);
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class reads one list (nodes, states or elements) of an ASCII CFmesh
+/// file cooperatively: a few I/O ranks read disjoint byte ranges of the list,
+/// parse them and then send each rank only the rows it asks for.
+/// The list is seen as a sequence of rows, made of a known number of values
+/// each, separated by any blank character, so that it does not depend on
+/// how the rows have been split in lines by the writer.
+/// @author Tiago Quintino
+template <typename T>
+class ParCFmeshSectionReader : public Common::NonCopyable<ParCFmeshSectionReader<T> > {
+public:
+
+  /// Constructor
+  /// @param comm       communicator of all the ranks reading the mesh
+  /// @param nbIORanks  maximum number of ranks reading the file
+  ParCFmeshSectionReader(MPI_Comm comm, const CFuint nbIORanks);
+
+  /// Destructor
+  ~ParCFmeshSectionReader();
+
+  /// Appends a block of rows with the same number of values
+  void addRowBlock(const CFuint nbRows, const CFuint rowSize);
+
+  /// Gets the total number of rows
+  CFuint getNbRows() const;
+
+  /// Gets the number of values in the given row
+  CFuint getRowSize(const CFuint row) const;
+
+  /// Finds the end of the list starting at the given position, that is
+  /// the position of the next "!" keyword or the end of the file.
+  /// This is a collective call.
+  long unsigned int findSectionEnd(std::ifstream& fin,
+				   const long unsigned int begin);
+
+  /// Reads and parses the list in [begin, end), each I/O rank keeping
+  /// the rows starting in its byte range.
+  /// This is a collective call.
+  void read(std::ifstream& fin,
+	    const long unsigned int begin,
+	    const long unsigned int end);
+
+  /// Gets the values of the given rows, one row after the other.
+  /// This is a collective call.
+  /// @param rows  global IDs of the rows, sorted in ascending order
+  /// @param data  values of the rows
+  void gather(const std::vector<CFuint>& rows, std::vector<T>& data) const;
+
+private: // helper functions
+
+  /// Gets the position of the first value of the given row in the list
+  CFuint getRowStart(const CFuint row) const;
+
+  /// Gets the first row starting at or after the given value
+  CFuint getFirstRowFrom(const CFuint value) const;
+
+  /// Gets the rank of the given I/O rank in the communicator
+  CFuint getIORank(const CFuint io) const
+  {
+    return (io*m_nbProc)/m_nbIO;
+  }
+
+  /// Sets the number of I/O ranks and the index of this rank among them
+  void setIORanks(const CFuint nbIO);
+
+  /// Throws a BadFormatException on all the ranks if any of them found an
+  /// error, with the message of the first of them.
+  /// This is a collective call.
+  /// @param error  message of the error found by this rank, empty if none
+  void checkErrors(const std::string& error) const;
+
+private: // data
+
+  /// communicator
+  MPI_Comm m_comm;
+
+  /// rank of this processor
+  CFuint m_myRank;
+
+  /// number of processors
+  CFuint m_nbProc;
+
+  /// maximum number of I/O ranks
+  CFuint m_maxNbIO;
+
+  /// number of I/O ranks used for the current list
+  CFuint m_nbIO;
+
+  /// index of this rank among the I/O ranks
+  CFuint m_myIO;
+
+  /// flag telling if this rank is an I/O rank
+  bool m_isIO;
+
+  /// number of rows in each block
+  std::vector<CFuint> m_blockNbRows;
+
+  /// number of values in the rows of each block
+  std::vector<CFuint> m_blockRowSize;
+
+  /// first row kept by each I/O rank, followed by the total number of rows
+  std::vector<CFuint> m_firstRow;
+
+  /// values of the rows kept by this rank
+  std::vector<T> m_data;
+
+}; // class ParCFmeshSectionReader
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace CFmeshFileReader
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "CFmeshFileReader/ParCFmeshSectionReader.ci"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_CFmeshFileReader_ParCFmeshSectionReader_hh
@@ -0,0 +1,395 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the cooperative reader of the CFmesh lists"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/PE.hh"
+#include "Framework/BadFormatException.hh"
+#include "CFmeshFileReader/ParCFmeshSectionReader.hh"
+#include "UnitTests/PEFixture.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::CFmeshFileReader;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Parses the whole text as a real number
+/// @return false if the text is not a number or has trailing characters
+static bool parseReal(const string& text, CFreal& value)
+{
+  const char* p = text.c_str();
+  const char* end = p + text.size();
+  return parseNumber(p, end, value) && p == end;
+}
+
+/// Parses the whole text as an unsigned integer
+/// @return false if the text is not a number or has trailing characters
+static bool parseUInt(const string& text, CFuint& value)
+{
+  const char* p = text.c_str();
+  const char* end = p + text.size();
+  return parseNumber(p, end, value) && p == end;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ParseNumberSuite )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( UnsignedIntegers )
+{
+  CFuint value = 0;
+  BOOST_CHECK(parseUInt("0", value));
+  BOOST_CHECK_EQUAL(value, 0u);
+  BOOST_CHECK(parseUInt("1234567", value));
+  BOOST_CHECK_EQUAL(value, 1234567u);
+  BOOST_CHECK(parseUInt("+42", value));
+  BOOST_CHECK_EQUAL(value, 42u);
+  BOOST_CHECK(parseUInt("007", value));
+  BOOST_CHECK_EQUAL(value, 7u);
+
+  // the largest value, and one digit more
+  ostringstream max;
+  max << numeric_limits<CFuint>::max();
+  BOOST_CHECK(parseUInt(max.str(), value));
+  BOOST_CHECK_EQUAL(value, numeric_limits<CFuint>::max());
+  value = 5;
+  BOOST_CHECK(!parseUInt(max.str() + "0", value));
+  BOOST_CHECK_EQUAL(value, 5u);
+
+  // malformed tokens
+  BOOST_CHECK(!parseUInt("", value));
+  BOOST_CHECK(!parseUInt("-3", value));
+  BOOST_CHECK(!parseUInt("+", value));
+  BOOST_CHECK(!parseUInt(" 3", value));
+  BOOST_CHECK(!parseUInt("x3", value));
+  BOOST_CHECK(!parseUInt("3.5", value));
+  BOOST_CHECK(!parseUInt("3e2", value));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( UnsignedIntegerStopsAtFirstNonDigit )
+{
+  const string text = "815\t16";
+  const char* p = text.c_str();
+  CFuint value = 0;
+  BOOST_CHECK(parseNumber(p, text.c_str() + text.size(), value));
+  BOOST_CHECK_EQUAL(value, 815u);
+  BOOST_CHECK_EQUAL(p - text.c_str(), 3);
+
+  // the end of the range stops the number
+  p = text.c_str();
+  BOOST_CHECK(parseNumber(p, text.c_str() + 2, value));
+  BOOST_CHECK_EQUAL(value, 81u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( RealsMatchStrtod )
+{
+  const char* texts[] = {
+    "0", "-0", "1", "+1", "-1", "0.5", ".5", "5.", "-.25", "3.14159265358979",
+    "1e10", "1E10", "1e+10", "1e-10", "-2.5e-3", "+6.02214076e23", "1.7976931348623157e308",
+    "4.9406564584124654e-324", "2.2250738585072014e-308", "123456789012345678901234567890",
+    "0.000000000000000000000000000001234", "9007199254740993", "1e22", "1e23", "1e-22",
+    "1e-23", "0.1", "0.3", "1234.5678e-2", "00012.5000", "1.0000000000000000000001",
+    "-9.999999999999999999999999e-99"};
+  const CFuint nbTexts = sizeof(texts)/sizeof(texts[0]);
+  for (CFuint i = 0; i < nbTexts; ++i) {
+    CFreal value = 0.;
+    BOOST_CHECK_MESSAGE(parseReal(texts[i], value), texts[i]);
+    BOOST_CHECK_MESSAGE(value == strtod(texts[i], CFNULL), texts[i]);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( RandomRealsRoundTrip )
+{
+  // numbers written with 17 significant digits, as by the CFmesh writer,
+  // are read back exactly
+  unsigned int seed = 4321;
+  for (CFuint i = 0; i < 20000; ++i) {
+    seed = seed*1103515245u + 12345u;
+    const double mantissa = (seed % 2000001)/1000000. - 1.;
+    seed = seed*1103515245u + 12345u;
+    const int exponent = static_cast<int>(seed % 61) - 30;
+    const double v = mantissa*std::pow(10., exponent);
+
+    char text[64];
+    sprintf(text, "%.17g", v);
+    CFreal value = 0.;
+    BOOST_CHECK_MESSAGE(parseReal(text, value) && value == v, text);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( RealExponentNeedsDigits )
+{
+  // an "e" without digits does not belong to the number
+  const string text = "2.5e+x";
+  const char* p = text.c_str();
+  CFreal value = 0.;
+  BOOST_CHECK(parseNumber(p, text.c_str() + text.size(), value));
+  BOOST_CHECK_EQUAL(value, 2.5);
+  BOOST_CHECK_EQUAL(p - text.c_str(), 3);
+
+  BOOST_CHECK(!parseReal("1e", value));
+  BOOST_CHECK(!parseReal("1e-", value));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( MalformedReals )
+{
+  // no number at all: the value is left untouched
+  CFreal value = 7.;
+  BOOST_CHECK(!parseReal("", value));
+  BOOST_CHECK(!parseReal("-", value));
+  BOOST_CHECK(!parseReal("+", value));
+  BOOST_CHECK(!parseReal(".", value));
+  BOOST_CHECK(!parseReal("-.", value));
+  BOOST_CHECK(!parseReal("e5", value));
+  BOOST_CHECK(!parseReal("nan", value));
+  BOOST_CHECK(!parseReal("inf", value));
+  BOOST_CHECK(!parseReal("--1", value));
+
+  // the blanks are skipped by the reader, not by the parser
+  BOOST_CHECK(!parseReal(" 1.5", value));
+  BOOST_CHECK(!parseReal("\t1.5", value));
+  BOOST_CHECK_EQUAL(value, 7.);
+
+  // a number followed by other characters, rejected by the reader
+  BOOST_CHECK(!parseReal("1.2.3", value));
+  BOOST_CHECK(!parseReal("1,5", value));
+  BOOST_CHECK(!parseReal("0x10", value));
+  BOOST_CHECK(!parseReal("1.5 ", value));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct SectionReaderFixture
+{
+  SectionReaderFixture() :
+    comm(PE::GetPE().GetCommunicator()),
+    rank(PE::GetPE().GetRank()),
+    nbProcs(PE::GetPE().GetProcessorCount())
+  {
+    ostringstream name;
+    name << "parcfmeshsectionreader-np" << nbProcs << ".CFmesh";
+    fileName = name.str();
+  }
+
+  ~SectionReaderFixture()
+  {
+    MPI_Barrier(comm);
+    if (rank == 0) {
+      remove(fileName.c_str());
+    }
+  }
+
+  /// Writes the file on rank 0, with a header before the list and a
+  /// keyword after it
+  void writeFile(const string& list)
+  {
+    if (rank == 0) {
+      FILE* file = fopen(fileName.c_str(), "wb");
+      fputs("!COOLFLUID_VERSION 2013.9\n!LIST_START\n", file);
+      fputs(list.c_str(), file);
+      fputs("!END\n", file);
+      fclose(file);
+    }
+    MPI_Barrier(comm);
+  }
+
+  /// Position of the list in the file
+  static long unsigned int listBegin()
+  {
+    return strlen("!COOLFLUID_VERSION 2013.9\n!LIST_START\n");
+  }
+
+  /// Rows requested by this rank: an interleaved subset of all the rows,
+  /// some of them also requested by the other ranks
+  vector<CFuint> requestedRows(const CFuint nbRows) const
+  {
+    vector<CFuint> rows;
+    for (CFuint r = 0; r < nbRows; ++r) {
+      if (r % nbProcs == rank || r % 997 == 0 || r == nbRows-1) {
+	rows.push_back(r);
+      }
+    }
+    return rows;
+  }
+
+  MPI_Comm comm;
+  CFuint rank;
+  CFuint nbProcs;
+  string fileName;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( SectionReaderSuite, SectionReaderFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( ReadRealsOnAllRanks )
+{
+  // a few MB, so that every rank takes part in the reading; the rows are
+  // split in lines differently from the rows, with various blanks
+  const CFuint nbRows = 120000;
+  const CFuint rowSize = 3;
+  const char* blanks[] = {" ", "  ", "\t", "\n", "\r\n", " \n "};
+  vector<CFreal> values(nbRows*rowSize);
+  string list;
+  char text[64];
+  for (CFuint i = 0; i < values.size(); ++i) {
+    values[i] = (i % 2 == 0) ? 0.001*i - 7.5 : -1./(i + 3.);
+    sprintf(text, (i % 5 == 0) ? "%.17e" : "%.17g", values[i]);
+    list += text;
+    list += blanks[(i*7) % 6];
+  }
+  list += "\n";
+  writeFile(list);
+
+  ifstream fin(fileName.c_str(), ios::binary);
+  ParCFmeshSectionReader<CFreal> reader(comm, nbProcs);
+  reader.addRowBlock(nbRows, rowSize);
+  BOOST_CHECK_EQUAL(reader.getNbRows(), nbRows);
+
+  const long unsigned int begin = listBegin();
+  const long unsigned int end = reader.findSectionEnd(fin, begin);
+  BOOST_CHECK_EQUAL(end, begin + list.size());
+  reader.read(fin, begin, end);
+
+  const vector<CFuint> rows = requestedRows(nbRows);
+  vector<CFreal> data;
+  reader.gather(rows, data);
+  BOOST_REQUIRE_EQUAL(data.size(), rows.size()*rowSize);
+  CFuint nbWrong = 0;
+  for (CFuint i = 0; i < rows.size(); ++i) {
+    for (CFuint j = 0; j < rowSize; ++j) {
+      if (data[i*rowSize + j] != values[rows[i]*rowSize + j]) ++nbWrong;
+    }
+  }
+  BOOST_CHECK_EQUAL(nbWrong, 0u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( ReadRowBlocksOfDifferentSizes )
+{
+  // element lists with blocks of triangles and quadrilaterals
+  const CFuint nbRows[2] = {50000, 150000};
+  const CFuint rowSize[2] = {3, 4};
+  vector<CFuint> values;
+  vector<CFuint> rowStart;
+  string list;
+  char text[32];
+  for (CFuint b = 0; b < 2; ++b) {
+    for (CFuint r = 0; r < nbRows[b]; ++r) {
+      rowStart.push_back(values.size());
+      for (CFuint j = 0; j < rowSize[b]; ++j) {
+	values.push_back((rowStart.size()*31 + j*7) % 100003);
+	sprintf(text, (j == 0 && r % 3 == 0) ? "+%u" : "%u", static_cast<unsigned int>(values.back()));
+	list += text;
+	list += (j+1 == rowSize[b]) ? "\n" : " ";
+      }
+    }
+  }
+  writeFile(list);
+
+  ifstream fin(fileName.c_str(), ios::binary);
+  ParCFmeshSectionReader<CFuint> reader(comm, nbProcs);
+  reader.addRowBlock(nbRows[0], rowSize[0]);
+  reader.addRowBlock(nbRows[1], rowSize[1]);
+  const CFuint totNbRows = nbRows[0] + nbRows[1];
+  BOOST_CHECK_EQUAL(reader.getRowSize(nbRows[0]-1), 3u);
+  BOOST_CHECK_EQUAL(reader.getRowSize(nbRows[0]), 4u);
+
+  const long unsigned int begin = listBegin();
+  reader.read(fin, begin, reader.findSectionEnd(fin, begin));
+
+  const vector<CFuint> rows = requestedRows(totNbRows);
+  vector<CFuint> data;
+  reader.gather(rows, data);
+  CFuint pos = 0;
+  CFuint nbWrong = 0;
+  for (CFuint i = 0; i < rows.size(); ++i) {
+    const CFuint size = reader.getRowSize(rows[i]);
+    BOOST_REQUIRE(pos + size <= data.size());
+    for (CFuint j = 0; j < size; ++j, ++pos) {
+      if (data[pos] != values[rowStart[rows[i]] + j]) ++nbWrong;
+    }
+  }
+  BOOST_CHECK_EQUAL(pos, data.size());
+  BOOST_CHECK_EQUAL(nbWrong, 0u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( BadValueThrowsOnAllRanks )
+{
+  const CFuint nbRows = 100000;
+  string list;
+  char text[32];
+  for (CFuint i = 0; i < 2*nbRows; ++i) {
+    sprintf(text, "%.6f", 0.5*i);
+    list += (i == 2*nbRows - 100) ? "1.5.0" : text;
+    list += "\n";
+  }
+  writeFile(list);
+
+  ifstream fin(fileName.c_str(), ios::binary);
+  ParCFmeshSectionReader<CFreal> reader(comm, nbProcs);
+  reader.addRowBlock(nbRows, 2);
+  const long unsigned int begin = listBegin();
+  BOOST_CHECK_THROW(reader.read(fin, begin, reader.findSectionEnd(fin, begin)),
+		    Framework::BadFormatException);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( WrongNumberOfValuesThrows )
+{
+  writeFile("1 2 3\n4 5 6\n7 8\n");
+
+  ifstream fin(fileName.c_str(), ios::binary);
+  ParCFmeshSectionReader<CFuint> reader(comm, nbProcs);
+  reader.addRowBlock(3, 3);
+  const long unsigned int begin = listBegin();
+  BOOST_CHECK_THROW(reader.read(fin, begin, reader.findSectionEnd(fin, begin)),
+		    Framework::BadFormatException);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -6,8 +6,10 @@
 
 #include <iomanip>
 #include <numeric>
+#include <sstream>
 
 #include "ParCFmeshFileWriter.hh"
+#include "ParLineWriter.hh"
 #include "Framework/ElementTypeData.hh"
 #include "Framework/PhysicalModel.hh"
 #include "Framework/MeshData.hh"
@@ -62,6 +64,9 @@ ParCFmeshFileWriter::ParCFmeshFileWriter() :
   _nbProc(0),
   _ioRank(0),
   _isNewFile(0),
+  _fh(),
+  _collectiveIO(false),
+  _nbWriters(0),
   _writeData(),
   _fileList(),
   _mapFileToStartNodeList()
@@ -72,6 +77,12 @@ ParCFmeshFileWriter::ParCFmeshFileWriter() :
   _myRank = PE::GetPE().GetRank();
   _nbProc = PE::GetPE().GetProcessorCount();
   cf_assert(_nbProc > 0);
+
+  _collectiveIO = false;
+  setParameter("CollectiveIO",&_collectiveIO);
+
+  _nbWriters = 0;
+  setParameter("NbWriters",&_nbWriters);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -84,6 +95,8 @@ ParCFmeshFileWriter::~ParCFmeshFileWriter()
 
 void ParCFmeshFileWriter::defineConfigOptions(Config::OptionList& options)
 {
+  options.addConfigOption< bool >("CollectiveIO", "Write the lists with two-phase collective MPI-IO");
+  options.addConfigOption< CFuint >("NbWriters", "Number of writers with CollectiveIO (0 for all the processes)");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -127,8 +140,19 @@ void ParCFmeshFileWriter::writeToFile(const boost::filesystem::path& filepath)
   // communicate to all the processors about the status of the current file
   MPI_Bcast(&_isNewFile, 1, MPIStructDef::getMPIType(&_isNewFile), _ioRank, _comm);
 
+  // the file has been created by the I/O rank, which keeps writing the
+  // headers while the lists are written by all the processes together
+  if (_collectiveIO) {
+    MPI_File_open(_comm, const_cast<char*>(filepath.string().c_str()),
+		  MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &_fh);
+  }
+
   writeToFileStream(filepath, file);
 
+  if (_collectiveIO) {
+    MPI_File_close(&_fh);
+  }
+
   if (_myRank == _ioRank) {
     fhandle->close();
   }
@@ -401,6 +425,55 @@ void ParCFmeshFileWriter::writeElementList(std::ofstream *const fout)
   const CFuint nbElementTypes = me.size();
   const CFuint nbLocalElements = getWriteData().getNbElements();
 
+  if (_collectiveIO) {
+    Common::SafePtr< vector<CFuint> > globalElementIDs =
+      MeshDataStack::getActive()->getGlobalElementIDs();
+    cf_assert(globalElementIDs->size() == nbLocalElements);
+
+    SafePtr< vector<ElementTypeData> > et =
+      MeshDataStack::getActive()->getElementTypeData();
+
+    SafePtr<TopologicalRegionSet> elements =
+      MeshDataStack::getActive()->getTrs("InnerCells");
+
+    DataHandle < Framework::Node*, Framework::GLOBAL > nodes =
+      MeshDataStack::getActive()->getNodeDataSocketSink().getDataHandle();
+
+    DataHandle < Framework::State*, Framework::GLOBAL > states =
+      MeshDataStack::getActive()->getStateDataSocketSink().getDataHandle();
+
+    // each element type is written as a separate list
+    CFuint elemID = 0;
+    for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
+      const CFuint nbNodesInType  = me[iType].elementNodes;
+      const CFuint nbStatesInType = me[iType].elementStates;
+      const CFuint nbLocalElementsInType = (*et)[iType].getNbElems();
+
+      ostringstream out;
+      vector<CFuint> ids(nbLocalElementsInType);
+      vector<size_t> lineStart(nbLocalElementsInType);
+      for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem, ++elemID) {
+	ids[iElem] = (*globalElementIDs)[elemID];
+	lineStart[iElem] = out.tellp();
+	for (CFuint in = 0; in < nbNodesInType; ++in) {
+	  out << nodes[elements->getNodeID(elemID, in)]->getGlobalID()
+	      << ((in+1 < nbNodesInType + nbStatesInType) ? " " : "\n");
+	}
+	for (CFuint in = 0; in < nbStatesInType; ++in) {
+	  out << states[elements->getStateID(elemID, in)]->getGlobalID()
+	      << ((in+1 < nbStatesInType) ? " " : "\n");
+	}
+      }
+
+      const string lines = out.str();
+      lineStart.push_back(lines.size());
+      writeLinesCollective(fout, me[iType].elementCount, ids, lines, lineStart);
+    }
+
+    CFLogInfo("Element written \n");
+    return;
+  }
+
   WriteListMap elementList;
   elementList.reserve(nbElementTypes, nSend, nbLocalElements);
 
@@ -658,6 +731,54 @@ void ParCFmeshFileWriter::writeNodeList(std::ofstream *const fout)
     nodesStride += dim;
   }
 
+  if (_collectiveIO) {
+    ostringstream out;
+    out.precision(14);
+    out.setf(ios::scientific,ios::floatfield);
+
+    // each node is written by the process owning it
+    RealVector values(nodesStride);
+    vector<CFuint> ids;
+    vector<size_t> lineStart;
+    for (CFuint iNode = 0; iNode < nbLocalElements; ++iNode) {
+      if (!nodes[iNode]->isParUpdatable()) continue;
+      ids.push_back(nodes[iNode]->getGlobalID());
+      lineStart.push_back(out.tellp());
+
+      CFuint iv = 0;
+      for (CFuint in = 0; in < dim; ++in, ++iv) {
+	values[iv] = (*nodes[iNode])[in]*refL;
+      }
+
+      if (storePastNodes) {
+	const RealVector* pastNodesValues = getWriteData().getPastNode(iNode);
+	for (CFuint in = 0; in < pastNodesValues->size(); ++in, ++iv) {
+	  values[iv] = (*pastNodesValues)[in];
+	}
+      }
+
+      if (nbExtraNodalVars > 0) {
+	const RealVector& extraNodalValues = getWriteData().getExtraNodalValues(iNode);
+	cf_assert(extraNodalValues.size() == totalNbExtraNodalVars);
+	for (CFuint in = 0; in < totalNbExtraNodalVars; ++in, ++iv) {
+	  values[iv] = extraNodalValues[in];
+	}
+      }
+      cf_assert(iv == nodesStride);
+
+      for (CFuint i = 0; i < nodesStride; ++i) {
+	out << values[i] << ((i+1 < nodesStride) ? " " : "\n");
+      }
+    }
+
+    const string lines = out.str();
+    lineStart.push_back(lines.size());
+    writeLinesCollective(fout, totNbNodes, ids, lines, lineStart);
+
+    CFLogInfo("Nodes written \n");
+    return;
+  }
+
   const CFuint maxElemSize = (totNbNodes/nSend + totNbNodes%nSend)*nodesStride;
   const CFuint minElemSize = (totNbNodes/nSend)*nodesStride;
   // update the maximum possible element-list size to send
@@ -840,6 +961,62 @@ void ParCFmeshFileWriter::writeStateList(std::ofstream *const fout)
       statesStride += dim;
     }
 
+    if (_collectiveIO) {
+      ostringstream out;
+      out.precision(16);
+      out.setf(ios::scientific,ios::floatfield);
+
+      // each state is written by the process owning it, the ghost ones
+      // being possibly out of date
+      RealVector values(statesStride);
+      vector<CFuint> ids;
+      vector<size_t> lineStart;
+      for (CFuint iState = 0; iState < nbLocalElements; ++iState) {
+	if (!states[iState]->isParUpdatable()) continue;
+	ids.push_back(states[iState]->getGlobalID());
+	lineStart.push_back(out.tellp());
+
+	CFuint iv = 0;
+	for (CFuint in = 0; in < dim; ++in, ++iv) {
+	  values[iv] = (*states[iState])[in];
+	}
+
+	if (storePastStates) {
+	  const RealVector* pastStatesValues = getWriteData().getPastState(iState);
+	  for (CFuint in = 0; in < pastStatesValues->size(); ++in, ++iv) {
+	    values[iv] = (*pastStatesValues)[in];
+	  }
+	}
+
+	if (storeInterStates) {
+	  const RealVector* interStatesValues = getWriteData().getInterState(iState);
+	  for (CFuint in = 0; in < interStatesValues->size(); ++in, ++iv) {
+	    values[iv] = (*interStatesValues)[in];
+	  }
+	}
+
+	if (nbExtraStateVars > 0) {
+	  const RealVector& extraStateValues = getWriteData().getExtraStateValues(iState);
+	  cf_assert(extraStateValues.size() == totalNbExtraStateVars);
+	  for (CFuint in = 0; in < totalNbExtraStateVars; ++in, ++iv) {
+	    values[iv] = extraStateValues[in];
+	  }
+	}
+	cf_assert(iv == statesStride);
+
+	for (CFuint i = 0; i < statesStride; ++i) {
+	  out << values[i] << ((i+1 < statesStride) ? " " : "\n");
+	}
+      }
+
+      const string lines = out.str();
+      lineStart.push_back(lines.size());
+      writeLinesCollective(fout, totNbStates, ids, lines, lineStart);
+
+      CFLogInfo("States written \n");
+      return;
+    }
+
     const CFuint maxElemSize = (totNbStates/nSend + totNbStates%nSend)*statesStride;
     const CFuint minElemSize = (totNbStates/nSend)*statesStride;
     // update the maximum possible element-list size to send
@@ -1047,6 +1224,49 @@ void ParCFmeshFileWriter::writeGeoList(CFuint iTRS, ofstream *const fout)
   const CFuint nbElementTypes = nbTRsInTRS;
   const CFuint nbLocalElements = trs->getLocalNbGeoEnts();
 
+  if (_collectiveIO) {
+    DataHandle < Framework::Node*, Framework::GLOBAL > nodes =
+      MeshDataStack::getActive()->getNodeDataSocketSink().getDataHandle();
+
+    DataHandle < Framework::State*, Framework::GLOBAL > states =
+      MeshDataStack::getActive()->getStateDataSocketSink().getDataHandle();
+
+    // each TR is written as a separate list, with the same layout as the
+    // one assembled from the padded rows below
+    for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
+      const CFuint nbLocalElementsInType = (*trs)[iType]->getLocalNbGeoEnts();
+
+      ostringstream out;
+      vector<CFuint> ids(nbLocalElementsInType);
+      vector<size_t> lineStart(nbLocalElementsInType);
+      for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem) {
+	ids[iElem] = (*globalGeoIDS)[iTRS][iType][iElem];
+	lineStart[iElem] = out.tellp();
+
+	const CFuint nbNodesInTRGeo  = (*trs)[iType]->getNbNodesInGeo(iElem);
+	const CFuint nbStatesInTRGeo = (isFVMCC) ? 1 : (*trs)[iType]->getNbStatesInGeo(iElem);
+	out << nbNodesInTRGeo << " " << nbStatesInTRGeo;
+	for (CFuint in = 0; in < nbNodesInTRGeo; ++in) {
+	  out << " " << nodes[(*trs)[iType]->getNodeID(iElem, in)]->getGlobalID();
+	}
+	for (CFuint in = 0; in < nbStatesInTRGeo; ++in) {
+	  out << " " << states[(*trs)[iType]->getStateID(iElem, in)]->getGlobalID();
+	}
+
+	// the padded rows end with a space unless their last entry is set
+	const CFuint maxNbStatesInType = nbNodesStatesInTRGeo(iType, 1);
+	const bool isFullRow = (maxNbStatesInType > 0) ?
+	  (nbStatesInTRGeo == maxNbStatesInType) : (nbNodesInTRGeo == nbNodesStatesInTRGeo(iType, 0));
+	out << ((isFullRow) ? "\n" : " \n");
+      }
+
+      const string lines = out.str();
+      lineStart.push_back(lines.size());
+      writeLinesCollective(fout, trsInfo[iTRS][iType], ids, lines, lineStart);
+    }
+    return;
+  }
+
   WriteListMap elementList;
   elementList.reserve(nbElementTypes, nSend, nbLocalElements);
 
@@ -1219,6 +1439,35 @@ void ParCFmeshFileWriter::writeGeoList(CFuint iTRS, ofstream *const fout)
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshFileWriter::writeLinesCollective(std::ofstream *const fout,
+					       const CFuint nbGlobalLines,
+					       const vector<CFuint>& globalIDs,
+					       const string& lines,
+					       const vector<size_t>& lineStart)
+{
+  CFLogDebugMin( "ParCFmeshFileWriter::writeLinesCollective() start\n");
+
+  long position = 0;
+  if (_myRank == _ioRank) {
+    cf_assert(fout != CFNULL);
+    fout->flush();
+    position = fout->tellp();
+  }
+  MPI_Bcast(&position, 1, MPI_LONG, _ioRank, _comm);
+
+  ParLineWriter writer(_comm, _nbWriters);
+  const MPI_Offset totalSize =
+    writer.write(_fh, position, nbGlobalLines, globalIDs, lines, lineStart);
+
+  if (_myRank == _ioRank) {
+    fout->seekp(position + totalSize, ios::beg);
+  }
+
+  CFLogDebugMin( "ParCFmeshFileWriter::writeLinesCollective() end\n");
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
     } // namespace CFmeshFileWriter
@@ -117,6 +117,19 @@ private: // helper functions
   /// Writes the all the geometric entities for the given TRS
   void writeGeoList(CFuint iTRS, std::ofstream *const fout);
 
+  /// Writes a list of lines sorted by global ID with two-phase collective
+  /// MPI-IO, starting from the current position of the I/O rank in the file
+  /// @param nbGlobalLines  number of lines in the whole list
+  /// @param globalIDs      global ID of each local line
+  /// @param lines          local lines, one after the other
+  /// @param lineStart      position of each local line in lines, plus the end
+  /// @see ParLineWriter
+  void writeLinesCollective(std::ofstream *const fout,
+			    const CFuint nbGlobalLines,
+			    const std::vector<CFuint>& globalIDs,
+			    const std::string& lines,
+			    const std::vector<std::size_t>& lineStart);
+
 protected: // data
 
   /// communicator
@@ -134,6 +147,15 @@ protected: // data
   /// flag telling if the file is a new one
   CFuint _isNewFile;
 
+  /// file handle for the collective writing
+  MPI_File _fh;
+
+  /// flag telling to write the lists with collective MPI-IO
+  bool _collectiveIO;
+
+  /// number of writers in the collective writing (0 for all the processes)
+  CFuint _nbWriters;
+
   /// acquaintance of the data present in the CFmesh file
   Common::SafePtr<Framework::CFmeshWriterSource> _writeData;
 
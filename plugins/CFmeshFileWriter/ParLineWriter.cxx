@@ -0,0 +1,238 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/MPI/MPIHelper.hh"
+
+#include "CFmeshFileWriter/ParLineWriter.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+    namespace CFmeshFileWriter {
+
+//////////////////////////////////////////////////////////////////////////////
+
+ParLineWriter::ParLineWriter(MPI_Comm comm, const CFuint nbWriters) :
+  m_comm(comm),
+  m_myRank(0),
+  m_nbProc(0),
+  m_nbWriters(0),
+  m_maxChunkSize(1u << 30)
+{
+  int rank = 0;
+  int nbProc = 0;
+  CheckMPIStatus(MPI_Comm_rank(m_comm, &rank));
+  CheckMPIStatus(MPI_Comm_size(m_comm, &nbProc));
+  m_myRank = rank;
+  m_nbProc = nbProc;
+  m_nbWriters = (nbWriters == 0) ? m_nbProc : min(nbWriters, m_nbProc);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+ParLineWriter::~ParLineWriter()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+MPI_Offset ParLineWriter::write(MPI_File fh,
+				const MPI_Offset position,
+				const CFuint nbGlobalLines,
+				const vector<CFuint>& globalIDs,
+				const string& lines,
+				const vector<size_t>& lineStart)
+{
+  const CFuint nbLocalLines = globalIDs.size();
+  cf_assert(lineStart.size() == nbLocalLines+1);
+
+  // the global IDs are split in contiguous blocks, one per writer, the first
+  // nbGlobalLines%nbWriters blocks having one more line
+  const CFuint blockSize = nbGlobalLines/m_nbWriters;
+  const CFuint nbLargerBlocks = nbGlobalLines%m_nbWriters;
+  const CFuint largerBlocksEnd = nbLargerBlocks*(blockSize+1);
+
+  // number of bytes of the entries (global ID and length of each line) and
+  // of the lines to send to each process
+  vector<long long> sendInfoSize(m_nbProc, 0);
+  vector<long long> sendTextSize(m_nbProc, 0);
+  vector<CFuint> destRank(nbLocalLines);
+  for (CFuint i = 0; i < nbLocalLines; ++i) {
+    const CFuint id = globalIDs[i];
+    cf_assert(id < nbGlobalLines);
+    const CFuint iWriter = (id < largerBlocksEnd) ?
+      id/(blockSize+1) : nbLargerBlocks + (id - largerBlocksEnd)/blockSize;
+    destRank[i] = getWriterRank(iWriter, m_nbWriters);
+    sendInfoSize[destRank[i]] += 2*sizeof(CFuint);
+    sendTextSize[destRank[i]] += lineStart[i+1] - lineStart[i];
+  }
+
+  vector<long long> recvInfoSize(m_nbProc, 0);
+  vector<long long> recvTextSize(m_nbProc, 0);
+  exchangeSizes(sendInfoSize, recvInfoSize);
+  exchangeSizes(sendTextSize, recvTextSize);
+
+  // entries and lines ordered by destination
+  vector<size_t> infoPos(m_nbProc, 0);
+  vector<size_t> textPos(m_nbProc, 0);
+  for (CFuint p = 1; p < m_nbProc; ++p) {
+    infoPos[p] = infoPos[p-1] + sendInfoSize[p-1]/sizeof(CFuint);
+    textPos[p] = textPos[p-1] + sendTextSize[p-1];
+  }
+
+  vector<CFuint> sendInfo(2*nbLocalLines + 1);
+  vector<char> sendText(lines.size() + 1);
+  for (CFuint i = 0; i < nbLocalLines; ++i) {
+    const CFuint r = destRank[i];
+    const size_t length = lineStart[i+1] - lineStart[i];
+    sendInfo[infoPos[r]++] = globalIDs[i];
+    sendInfo[infoPos[r]++] = length;
+    copy(lines.begin() + lineStart[i], lines.begin() + lineStart[i+1], sendText.begin() + textPos[r]);
+    textPos[r] += length;
+  }
+
+  long long totalRecvInfoSize = 0;
+  long long totalRecvTextSize = 0;
+  for (CFuint p = 0; p < m_nbProc; ++p) {
+    totalRecvInfoSize += recvInfoSize[p];
+    totalRecvTextSize += recvTextSize[p];
+  }
+
+  const CFuint nbRecvLines = totalRecvInfoSize/(2*sizeof(CFuint));
+  vector<CFuint> recvInfo(2*nbRecvLines + 1);
+  vector<char> recvText(totalRecvTextSize + 1);
+  exchange(reinterpret_cast<const char*>(&sendInfo[0]), sendInfoSize,
+	   reinterpret_cast<char*>(&recvInfo[0]), recvInfoSize);
+  exchange(&sendText[0], sendTextSize, &recvText[0], recvTextSize);
+
+  // the received lines are sorted by global ID, those coming from more
+  // processes (the elements and the boundary faces of the overlap) being
+  // kept once
+  vector<pair<CFuint, CFuint> > order(nbRecvLines);
+  vector<size_t> recvStart(nbRecvLines + 1, 0);
+  for (CFuint k = 0; k < nbRecvLines; ++k) {
+    order[k] = make_pair(recvInfo[2*k], k);
+    recvStart[k+1] = recvStart[k] + recvInfo[2*k+1];
+  }
+  sort(order.begin(), order.end());
+
+  string block;
+  block.reserve(totalRecvTextSize);
+  for (CFuint k = 0; k < nbRecvLines; ++k) {
+    if (k > 0 && order[k].first == order[k-1].first) continue;
+    const CFuint l = order[k].second;
+    block.append(&recvText[recvStart[l]], recvStart[l+1] - recvStart[l]);
+  }
+
+  // the blocks follow each other in the order of the ranks of the writers
+  long long localSize = block.size();
+  long long offset = 0;
+  long long totalSize = 0;
+  CheckMPIStatus(MPI_Exscan(&localSize, &offset, 1, MPI_LONG_LONG, MPI_SUM, m_comm));
+  if (m_myRank == 0) {
+    offset = 0;
+  }
+  CheckMPIStatus(MPI_Allreduce(&localSize, &totalSize, 1, MPI_LONG_LONG, MPI_SUM, m_comm));
+
+  // every process takes part in each collective write, with an empty chunk
+  // once its block is over
+  const long long chunkSize = m_maxChunkSize;
+  long long nbLocalChunks = (localSize + chunkSize - 1)/chunkSize;
+  long long nbChunks = 0;
+  CheckMPIStatus(MPI_Allreduce(&nbLocalChunks, &nbChunks, 1, MPI_LONG_LONG, MPI_MAX, m_comm));
+
+  char *const data = const_cast<char*>(block.data());
+  for (long long c = 0; c < nbChunks; ++c) {
+    const long long start = min(c*chunkSize, localSize);
+    const long long count = min(chunkSize, localSize - start);
+    MPI_Status status;
+    CheckMPIStatus(MPI_File_write_at_all(fh, static_cast<MPI_Offset>(position + offset + start),
+					 data + start, static_cast<int>(count),
+					 MPI_CHAR, &status));
+  }
+
+  return static_cast<MPI_Offset>(totalSize);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParLineWriter::exchangeSizes(const vector<long long>& sendSize,
+				  vector<long long>& recvSize)
+{
+  cf_assert(sendSize.size() == m_nbProc);
+  recvSize.resize(m_nbProc);
+  CheckMPIStatus(MPI_Alltoall(const_cast<long long*>(&sendSize[0]), 1, MPI_LONG_LONG,
+			      &recvSize[0], 1, MPI_LONG_LONG, m_comm));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParLineWriter::exchange(const char* sendBuf,
+			     const vector<long long>& sendSize,
+			     char* recvBuf,
+			     const vector<long long>& recvSize)
+{
+  const long long chunkSize = m_maxChunkSize;
+
+  // the messages between two processes arrive in the order they are sent,
+  // so that the chunks can share the same tag
+  vector<MPI_Request> requests;
+  long long recvPos = 0;
+  for (CFuint p = 0; p < m_nbProc; ++p) {
+    if (p != m_myRank) {
+      for (long long start = 0; start < recvSize[p]; start += chunkSize) {
+	const long long count = min(chunkSize, recvSize[p] - start);
+	MPI_Request request;
+	CheckMPIStatus(MPI_Irecv(recvBuf + recvPos + start, static_cast<int>(count),
+				 MPI_CHAR, p, 0, m_comm, &request));
+	requests.push_back(request);
+      }
+    }
+    recvPos += recvSize[p];
+  }
+
+  long long sendPos = 0;
+  recvPos = 0;
+  for (CFuint p = 0; p < m_nbProc; ++p) {
+    if (p != m_myRank) {
+      for (long long start = 0; start < sendSize[p]; start += chunkSize) {
+	const long long count = min(chunkSize, sendSize[p] - start);
+	MPI_Request request;
+	CheckMPIStatus(MPI_Isend(const_cast<char*>(sendBuf + sendPos + start), static_cast<int>(count),
+				 MPI_CHAR, p, 0, m_comm, &request));
+	requests.push_back(request);
+      }
+    }
+    else {
+      cf_assert(sendSize[p] == recvSize[p]);
+      memcpy(recvBuf + recvPos, sendBuf + sendPos, sendSize[p]);
+    }
+    sendPos += sendSize[p];
+    recvPos += recvSize[p];
+  }
+
+  if (!requests.empty()) {
+    vector<MPI_Status> status(requests.size());
+    CheckMPIStatus(MPI_Waitall(requests.size(), &requests[0], &status[0]));
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace CFmeshFileWriter
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
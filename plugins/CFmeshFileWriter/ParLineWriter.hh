@@ -0,0 +1,114 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_CFmeshFileWriter_ParLineWriter_hh
+#define COOLFluiD_CFmeshFileWriter_ParLineWriter_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+#include "Common/COOLFluiD.hh"
+#include "CFmeshFileWriter/CFmeshFileWriterAPI.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+    namespace CFmeshFileWriter {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class writes a list of text lines sorted by global ID with two-phase
+/// collective MPI-IO. Every line is sent to the writer in charge of the block
+/// of global IDs including it, then each writer puts its sorted block at its
+/// own offset in the file. The messages and the writes are split in chunks,
+/// so that no count passed to MPI goes beyond the range of an int.
+/// @author Andrea Lani
+class CFmeshFileWriter_API ParLineWriter {
+public:
+
+  /// Constructor
+  /// @param comm       communicator of the processes writing the file
+  /// @param nbWriters  number of writers (0 for all the processes)
+  ParLineWriter(MPI_Comm comm, const CFuint nbWriters);
+
+  /// Destructor
+  ~ParLineWriter();
+
+  /// Sets the maximum number of bytes in a message or in a write
+  void setMaxChunkSize(const CFuint maxChunkSize)
+  {
+    cf_assert(maxChunkSize > 0);
+    m_maxChunkSize = maxChunkSize;
+  }
+
+  /// Writes the lines, collectively over all the processes. A line given by
+  /// more processes is written once: the copies must be identical.
+  /// @param fh             file opened on the communicator
+  /// @param position       position of the list in the file
+  /// @param nbGlobalLines  number of lines in the whole list
+  /// @param globalIDs      global ID of each local line
+  /// @param lines          local lines, one after the other
+  /// @param lineStart      position of each local line in lines, plus the end
+  /// @return the size of the whole list in the file
+  MPI_Offset write(MPI_File fh,
+		   const MPI_Offset position,
+		   const CFuint nbGlobalLines,
+		   const std::vector<CFuint>& globalIDs,
+		   const std::string& lines,
+		   const std::vector<std::size_t>& lineStart);
+
+private: // helper functions
+
+  /// Get the rank of the given writer
+  CFuint getWriterRank(const CFuint iWriter, const CFuint nbWriters) const
+  {
+    return (iWriter*m_nbProc)/nbWriters;
+  }
+
+  /// Sends to each process the number of bytes it receives from this one
+  void exchangeSizes(const std::vector<long long>& sendSize,
+		     std::vector<long long>& recvSize);
+
+  /// Sends the bytes of each process, packed one after the other, in
+  /// messages of at most m_maxChunkSize bytes
+  void exchange(const char* sendBuf,
+		const std::vector<long long>& sendSize,
+		char* recvBuf,
+		const std::vector<long long>& recvSize);
+
+private: // data
+
+  /// communicator
+  MPI_Comm m_comm;
+
+  /// rank of this process
+  CFuint m_myRank;
+
+  /// number of processes
+  CFuint m_nbProc;
+
+  /// number of writers
+  CFuint m_nbWriters;
+
+  /// maximum number of bytes in a message or in a write
+  CFuint m_maxChunkSize;
+
+}; // end of class ParLineWriter
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace CFmeshFileWriter
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_CFmeshFileWriter_ParLineWriter_hh
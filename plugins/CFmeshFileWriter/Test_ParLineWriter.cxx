@@ -0,0 +1,184 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the collective line writer of CFmeshFileWriter"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/PE.hh"
+#include "CFmeshFileWriter/ParLineWriter.hh"
+#include "UnitTests/PEFixture.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::CFmeshFileWriter;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct ParLineWriterFixture
+{
+  /// number of lines of the list
+  static const CFuint NBLINES = 500;
+
+  ParLineWriterFixture() :
+    comm(PE::GetPE().GetCommunicator()),
+    rank(PE::GetPE().GetRank()),
+    nbProcs(PE::GetPE().GetProcessorCount())
+  {
+    ostringstream name;
+    name << "parlinewriter-np" << nbProcs << ".txt";
+    fileName = name.str();
+  }
+
+  ~ParLineWriterFixture()
+  {
+    MPI_Barrier(comm);
+    if (rank == 0) {
+      remove(fileName.c_str());
+    }
+  }
+
+  /// line of the given global ID, of varying length
+  static string line(const CFuint g)
+  {
+    ostringstream out;
+    out << g << " " << string(g%7 + 1, char('a' + g%26)) << " " << 0.5*g << "\n";
+    return out.str();
+  }
+
+  /// Writes the list collectively between a header and a trailer written by
+  /// rank 0, each process giving the lines it owns in reverse order plus, if
+  /// overlap is set, copies of some lines owned by the others
+  /// @return the content of the file
+  string writeCollective(const CFuint nbWriters,
+			 const CFuint maxChunkSize,
+			 const CFuint nbOwners,
+			 const bool overlap)
+  {
+    vector<CFuint> ids;
+    string lines;
+    vector<size_t> lineStart;
+    for (CFuint gg = NBLINES; gg > 0; --gg) {
+      const CFuint g = gg-1;
+      const bool isOwned = owner(g, nbOwners) == rank;
+      const bool isOverlap = overlap && owner((g+1)%NBLINES, nbOwners) == rank;
+      if (isOwned || isOverlap) {
+	ids.push_back(g);
+	lineStart.push_back(lines.size());
+	lines += line(g);
+      }
+    }
+    lineStart.push_back(lines.size());
+
+    MPI_File fh;
+    MPI_File_open(comm, const_cast<char*>(fileName.c_str()),
+		  MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &fh);
+    MPI_File_set_size(fh, 0);
+
+    const string header = "!LIST_START\n";
+    MPI_Status status;
+    if (rank == 0) {
+      MPI_File_write_at(fh, 0, const_cast<char*>(header.c_str()), header.size(), MPI_CHAR, &status);
+    }
+
+    ParLineWriter writer(comm, nbWriters);
+    writer.setMaxChunkSize(maxChunkSize);
+    const MPI_Offset size = writer.write(fh, header.size(), NBLINES, ids, lines, lineStart);
+
+    const string trailer = "!END\n";
+    if (rank == 0) {
+      MPI_File_write_at(fh, header.size() + size, const_cast<char*>(trailer.c_str()), trailer.size(), MPI_CHAR, &status);
+    }
+    MPI_File_close(&fh);
+
+    ifstream in(fileName.c_str());
+    ostringstream content;
+    content << in.rdbuf();
+    return content.str();
+  }
+
+  /// content of the file written by the I/O rank alone, sorted by global
+  /// ID, as without CollectiveIO
+  static string writeSerial()
+  {
+    string content = "!LIST_START\n";
+    for (CFuint g = 0; g < NBLINES; ++g) {
+      content += line(g);
+    }
+    content += "!END\n";
+    return content;
+  }
+
+  /// rank owning the given line
+  CFuint owner(const CFuint g, const CFuint nbOwners) const
+  {
+    return ((g*7 + 3)/5) % min(nbOwners, nbProcs);
+  }
+
+  MPI_Comm comm;
+  CFuint rank;
+  CFuint nbProcs;
+  string fileName;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( ParLineWriterSuite, ParLineWriterFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( AllWriters )
+{
+  BOOST_CHECK(writeCollective(0, 1u << 30, nbProcs, false) == writeSerial());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( OneWriter )
+{
+  BOOST_CHECK(writeCollective(1, 1u << 30, nbProcs, false) == writeSerial());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( OverlapWrittenOnce )
+{
+  BOOST_CHECK(writeCollective(0, 1u << 30, nbProcs, true) == writeSerial());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( SmallChunks )
+{
+  // the messages and the writes are split in many pieces, with blocks of
+  // different sizes on the writers
+  BOOST_CHECK(writeCollective(2, 7, nbProcs, true) == writeSerial());
+  BOOST_CHECK(writeCollective(0, 1, nbProcs, false) == writeSerial());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( SingleOwner )
+{
+  // the other processes have no line to send
+  BOOST_CHECK(writeCollective(0, 64, 1, false) == writeSerial());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -8,12 +8,13 @@
 #include "Framework/DataSocketSink.hh"
 #include "FiniteVolume/CellCenterFVMData.hh"
 
-#ifdef CF_HAVE_CUDA
 #include "FiniteVolume/CellData.hh"
 #include "FiniteVolume/FluxData.hh"
 #include "FiniteVolume/KernelData.hh"
-#include "Common/CUDA/CudaEnv.hh"
 #include "Common/CUDA/CFVec.hh"
+
+#ifdef CF_HAVE_CUDA
+#include "Common/CUDA/CudaEnv.hh"
 #endif
 
 //////////////////////////////////////////////////////////////////////////////
@@ -40,7 +41,6 @@ namespace COOLFluiD {
 class BarthJesp : public Framework::Limiter<CellCenterFVMData> {
 public:
   
-#ifdef CF_HAVE_CUDA
   /**
    * This nested class holds configurable options for this object
    *
@@ -93,12 +93,14 @@ public:
     DeviceConfigOptions<NOTYPE>* m_dco;
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the Framework::DEVICE
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
     CudaEnv::copyHost2Dev(&dco->alpha, &m_alpha, 1);
     CudaEnv::copyHost2Dev(&dco->useFullStencil, &m_useFullStencil, 1);
   } 
+#endif
   
   /// copy the local configuration options to the Framework::DEVICE
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
@@ -106,8 +108,6 @@ public:
     dco->useFullStencil = m_useFullStencil;
     dco->alpha = m_alpha;
   }
-  
-#endif
     
   /**
    * Constructor
@@ -163,8 +163,6 @@ private:
 
 //////////////////////////////////////////////////////////////////////////////
 
-#ifdef CF_HAVE_CUDA
-
 template <typename PHYS>
 void BarthJesp::DeviceFunc<PHYS>::limit(const KernelData<CFreal>* kd, 
 					const CellData::Itr* cell,
@@ -228,8 +226,6 @@ void BarthJesp::DeviceFunc<PHYS>::limit(const KernelData<CFreal>* kd,
     limiterValue[iVar] = psimin;
   }
 }
-      
-#endif   
 
 //////////////////////////////////////////////////////////////////////////////
       
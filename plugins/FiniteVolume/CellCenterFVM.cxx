@@ -530,6 +530,11 @@ Common::Signal::return_t CellCenterFVM::afterMeshUpdateActionImpl(Common::Signal
   CFAUTOTRACE;
 
   _afterMeshUpdate->execute();
+  
+  // the mesh connectivity may have changed
+  if (_data->compileFaceStencils()) {
+    _data->getFaceCellTrsGeoBuilder()->getGeoBuilder()->compileStencils();
+  }
 
   return Common::Signal::return_t ();
 }
@@ -46,6 +46,7 @@ void CellCenterFVMData::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< bool >("ReconstructSolutionVars", "Reconstruct the solution variables instead of the update ones");
   options.addConfigOption< std::string >("IntegratorOrder","Order of the Integration to be used for numerical quadrature.");
   options.addConfigOption< std::string >("IntegratorQuadrature","Type of Quadrature to be used in the Integration.");
+  options.addConfigOption< bool >("CompileFaceStencils","Compile the face-cell connectivity in flat arrays once, instead of querying the TRSs for every face.");
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -132,6 +133,9 @@ CellCenterFVMData::CellCenterFVMData(Common::SafePtr<Framework::Method> owner) :
 
   _reconstructSolVars = false;
   setParameter("ReconstructSolutionVars",&_reconstructSolVars);
+  
+  _compileFaceStencils = false;
+  setParameter("CompileFaceStencils",&_compileFaceStencils);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -596,6 +600,10 @@ void CellCenterFVMData::setup()
   _cellTrsGeoBuilder.setup();
   _geoWithNodesBuilder.setup();
   
+  if (_compileFaceStencils) {
+    _faceCellTrsGeoBuilder.getGeoBuilder()->compileStencils();
+  }
+  
   _unitNormal.resize(dim);
   
   _volumeIntegrator.setup();
@@ -607,6 +615,7 @@ void CellCenterFVMData::unsetup()
 {
   SpaceMethodData::unsetup(); 
   
+  _faceCellTrsGeoBuilder.getGeoBuilder()->clearStencils();
   _faceTrsGeoBuilder.unsetup();
   _cellTrsGeoBuilder.unsetup();
   _geoWithNodesBuilder.unsetup();
@@ -196,6 +196,14 @@ public:
     return _reconstructSolVars;
   }
 
+  /**
+   * Flag telling if the face-cell stencils are compiled in flat arrays
+   */
+  bool compileFaceStencils() const
+  {
+    return _compileFaceStencils;
+  }
+
   /**
    * Use the analytical jacobian for the convective fluxes
    */
@@ -619,6 +627,9 @@ private:
   /// reconstruct the solution (conservative) variables
   bool _reconstructSolVars;
   
+  /// compile the face-cell stencils in flat arrays
+  bool _compileFaceStencils;
+  
   /// GhostStates / IDs Map
   Common::CFMap<Framework::State*, CFuint> _mapGhostStateIDs;
 
@@ -2,6 +2,8 @@
 #include "FVMCC_ComputeRHS.hh"
 #include "Framework/MethodCommandProvider.hh"
 #include "Framework/MeshData.hh"
+#include "Common/CommPatternManager.hh"
+#include "Common/PE.hh"
 #include "MathTools/MatrixInverter.hh"
 #include "FiniteVolume/FVMCC_BC.hh"
 #include "FiniteVolume/DerivativeComputer.hh"
@@ -77,7 +79,11 @@ FVMCC_ComputeRHS::FVMCC_ComputeRHS(const std::string& name) :
   _fluxData(CFNULL),
   _tempUnitNormal(),
   _rExtraVars(),
-  _inverter(CFNULL)  
+  _inverter(CFNULL),
+  _overlapGhostSync(false),
+  _splitFaces(),
+  _nbInnerFaces(),
+  _ghostNodes()
 {
   addConfigOptionsTo(this);
 
@@ -92,6 +98,8 @@ FVMCC_ComputeRHS::FVMCC_ComputeRHS(const std::string& name) :
   
   _useAnalyticalMatrix = true;
   setParameter("useAnalyticalMatrix",&_useAnalyticalMatrix);
+  
+  setParameter("OverlapGhostSync",&_overlapGhostSync);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -110,6 +118,10 @@ void FVMCC_ComputeRHS::unsetup()
     deletePtr(_rExtraVars[i]);
   }
   
+  _splitFaces.clear();
+  _nbInnerFaces.clear();
+  _ghostNodes.clear();
+  
   CellCenterFVMCom::unsetup();
 }
 
@@ -128,6 +140,9 @@ void FVMCC_ComputeRHS::defineConfigOptions(Config::OptionList& options)
 
   options.addConfigOption< bool >
     ("useAnalyticalMatrix", "Flag telling if to use analytical matrix."); 
+  
+  options.addConfigOption< bool >
+    ("OverlapGhostSync", "Synchronize the ghost states while processing the faces which don't depend on them."); 
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -153,8 +168,54 @@ void FVMCC_ComputeRHS::execute()
   //     std::cout.precision(12); std::cout << i << " => "<< *socket_states.getDataHandle()[i] <<"\n";
   // }
   
+  // with the overlapped synchronization, the ghost states are received 
+  // while the faces which don't depend on them are processed
+  const bool overlapSync = _overlapGhostSync && PE::GetPE().IsParallel();
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  if (overlapSync) {
+    getMethodData().setSyncStatesInResidual(true);
+    states.beginSync();
+  }
+  
   initializeComputationRHS();
   
+  if (!overlapSync) {
+    computeFacesRHS(ALL_FACES);
+  }
+  else {
+    computeFacesRHS(INNER_FACES);
+    
+    states.endSync();
+    
+    // gradients and nodal values next to the ghost states are up to date only now
+    _polyRec->computeGradientSubset();
+    _nodalExtrapolator->extrapolateInNodes(_ghostNodes);
+    
+    computeFacesRHS(GHOST_FACES);
+  }
+  
+  finalizeComputationRHS();
+  
+  
+//   const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+//   DataHandle<CFreal> rhs = socket_rhs.getDataHandle();
+//   DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+//   for (CFuint iState = 0; iState < states.size(); ++iState) {
+//     for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+//       cout.precision(14); cout.setf(ios::scientific,ios::floatfield); cout << rhs(iState, iEq, nbEqs) << " ";
+//     }
+//     cout << endl;
+//   }
+ 
+  CFLog(VERBOSE, "FVMCC_ComputeRHS::execute() END\n");
+  
+  CFTRACEEND;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRHS::computeFacesRHS(const FaceSet faceSet)
+{
   // set the list of faces
   vector<SafePtr<TopologicalRegionSet> > trs = MeshDataStack::getActive()->getTrsList();
   const CFuint nbTRSs = trs.size();
@@ -206,7 +267,12 @@ void FVMCC_ComputeRHS::execute()
       geoData.faces = currTrs;
       
       const CFuint nbTrsFaces = currTrs->getLocalNbGeoEnts();
-      for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace, ++_faceIdx) {
+      const CFuint faceStart = _faceIdx;
+      const CFuint jStart = (faceSet == GHOST_FACES) ? _nbInnerFaces[iTRS] : 0;
+      const CFuint jEnd = (faceSet == INNER_FACES) ? _nbInnerFaces[iTRS] : nbTrsFaces;
+      for (CFuint jFace = jStart; jFace < jEnd; ++jFace) {
+	const CFuint iFace = getTrsFaceIdx(iTRS, jFace);
+	_faceIdx = faceStart + iFace;
         CFLogDebugMed( "iFace = " << iFace << "\n");
 	
     	// reset the equation subsystem descriptor
@@ -298,25 +364,9 @@ void FVMCC_ComputeRHS::execute()
 	
 	geoBuilder->releaseGE(); 
       }
+      _faceIdx = faceStart + nbTrsFaces;
     }
   }
-    
-  finalizeComputationRHS();
-  
-  
-//   const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
-//   DataHandle<CFreal> rhs = socket_rhs.getDataHandle();
-//   DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
-//   for (CFuint iState = 0; iState < states.size(); ++iState) {
-//     for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
-//       cout.precision(14); cout.setf(ios::scientific,ios::floatfield); cout << rhs(iState, iEq, nbEqs) << " ";
-//     }
-//     cout << endl;
-//   }
- 
-  CFLog(VERBOSE, "FVMCC_ComputeRHS::execute() END\n");
-  
-  CFTRACEEND;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -435,11 +485,115 @@ void FVMCC_ComputeRHS::setup()
   CellTrsGeoBuilder::GeoData& cellGeoData = getMethodData().getCellTrsGeoBuilder()->getDataGE();
   cellGeoData.trs = cells;
   
+  if (_overlapGhostSync && PE::GetPE().IsParallel() && 
+      !CommPatternManager::getInstance().PersistentGhostSync) {
+    // the ghost states must not be written before endSync(), while the
+    // gradients and the nodal values are computed
+    CFLog(WARN, "FVMCC_ComputeRHS::setup() => OverlapGhostSync needs CFEnv.PersistentGhostSync = true: disabled\n");
+    _overlapGhostSync = false;
+  }
+  
+  if (_overlapGhostSync) {
+    buildFaceSplit();
+  }
+  
   CFLog(VERBOSE, "FVMCC_ComputeRHS::setup() END\n");
 }
       
 //////////////////////////////////////////////////////////////////////////////
 
+void FVMCC_ComputeRHS::buildFaceSplit()
+{
+  CFAUTOTRACE;
+  
+  DataHandle<State*, GLOBAL> states = socket_states.getDataHandle();
+  SafePtr<TopologicalRegionSet> cells = MeshDataStack::getActive()->getTrs("InnerCells");
+  const CFuint nbCells = cells->getLocalNbGeoEnts();
+  const CFuint nbNodes = socket_nodes.getDataHandle().size();
+  
+  // nodes of the cells with a ghost state
+  vector<bool> isGhostNode(nbNodes, false);
+  for (CFuint iCell = 0; iCell < nbCells; ++iCell) {
+    if (!states[cells->getStateID(iCell, 0)]->isParUpdatable()) {
+      const CFuint nbNodesInCell = cells->getNbNodesInGeo(iCell);
+      for (CFuint i = 0; i < nbNodesInCell; ++i) {
+	isGhostNode[cells->getNodeID(iCell, i)] = true;
+      }
+    }
+  }
+  
+  // the gradient and the nodal values of a cell sharing a node with a 
+  // ghost cell depend on the ghost states
+  vector<bool> isGhostDependent(states.size(), false);
+  vector<CFuint> ghostDependentStates;
+  for (CFuint iCell = 0; iCell < nbCells; ++iCell) {
+    const CFuint nbNodesInCell = cells->getNbNodesInGeo(iCell);
+    for (CFuint i = 0; i < nbNodesInCell; ++i) {
+      if (isGhostNode[cells->getNodeID(iCell, i)]) {
+	const CFuint stateID = cells->getStateID(iCell, 0);
+	isGhostDependent[stateID] = true;
+	ghostDependentStates.push_back(stateID);
+	break;
+      }
+    }
+  }
+  
+  // only these are recomputed once the ghost states have been received
+  _polyRec->setGradientSubset(ghostDependentStates);
+  DataHandle<Node*, GLOBAL> nodes = socket_nodes.getDataHandle();
+  _ghostNodes.clear();
+  for (CFuint iNode = 0; iNode < nbNodes; ++iNode) {
+    if (isGhostNode[iNode]) {
+      _ghostNodes.push_back(nodes[iNode]);
+    }
+  }
+  
+  vector<SafePtr<TopologicalRegionSet> > trs = MeshDataStack::getActive()->getTrsList();
+  const CFuint nbTRSs = trs.size();
+  _splitFaces.resize(nbTRSs);
+  _nbInnerFaces.assign(nbTRSs, 0);
+  
+  CFuint nbInnerFaces = 0;
+  CFuint nbFaces = 0;
+  for (CFuint iTRS = 0; iTRS < nbTRSs; ++iTRS) {
+    SafePtr<TopologicalRegionSet> currTrs = trs[iTRS];
+    if (currTrs->getName() != "PartitionFaces" && currTrs->getName() != "InnerCells") {
+      // ghost states on boundary faces are computed by the BC, only the inner state counts
+      const CFuint nbFaceStates = (currTrs->hasTag("writable")) ? 1 : 2;
+      const CFuint nbTrsFaces = currTrs->getLocalNbGeoEnts();
+      vector<CFuint>& split = _splitFaces[iTRS];
+      split.clear();
+      split.reserve(nbTrsFaces);
+      
+      vector<CFuint> ghostFaces;
+      for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
+	bool isInner = true;
+	for (CFuint i = 0; i < nbFaceStates; ++i) {
+	  isInner = isInner && !isGhostDependent[currTrs->getStateID(iFace, i)];
+	}
+	if (isInner) {
+	  split.push_back(iFace);
+	}
+	else {
+	  ghostFaces.push_back(iFace);
+	}
+      }
+      _nbInnerFaces[iTRS] = split.size();
+      split.insert(split.end(), ghostFaces.begin(), ghostFaces.end());
+      
+      nbInnerFaces += _nbInnerFaces[iTRS];
+      nbFaces += nbTrsFaces;
+    }
+  }
+  
+  CFLog(INFO, "FVMCC_ComputeRHS::buildFaceSplit() => " << nbInnerFaces << "/" << nbFaces 
+	<< " faces processed while synchronizing the ghost states, " 
+	<< ghostDependentStates.size() << "/" << states.size() << " gradients and "
+	<< _ghostNodes.size() << "/" << nbNodes << " nodal states recomputed after it\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void FVMCC_ComputeRHS::updateRHS()
 {
   if (getMethodData().isAxisymmetric()) {
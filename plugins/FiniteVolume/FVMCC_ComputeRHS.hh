@@ -207,6 +207,22 @@ protected:
   /// Compute the transformation matrix dP/dU numerically
   RealMatrix& computeNumericalTransMatrix(Framework::State& state);
   
+  /// Split the faces of each TRS into the ones not depending on ghost states,
+  /// which come first in the processing order, and the other ones
+  void buildFaceSplit();
+  
+  /// Get the index in the TRS of the given face in the processing order
+  CFuint getTrsFaceIdx(CFuint iTRS, CFuint iFace) const
+  {
+    return (_overlapGhostSync) ? _splitFaces[iTRS][iFace] : iFace;
+  }
+  
+  /// Sets of faces processed by computeFacesRHS()
+  enum FaceSet {ALL_FACES=0, INNER_FACES=1, GHOST_FACES=2};
+  
+  /// Compute the flux and the jacobian contributions of the given set of faces
+  void computeFacesRHS(const FaceSet faceSet);
+  
 protected:
   
   /// flags for cells
@@ -365,6 +381,19 @@ protected:
   /// flag telling if to use analytical transformation matrix
   bool _useAnalyticalMatrix;
   
+  /// flag telling if to process the faces not depending on the ghost states
+  /// while these are being synchronized
+  bool _overlapGhostSync;
+  
+  /// for each TRS, face indices with the ones not depending on the ghost states first
+  std::vector<std::vector<CFuint> > _splitFaces;
+  
+  /// for each TRS, number of faces not depending on the ghost states
+  std::vector<CFuint> _nbInnerFaces;
+  
+  /// nodes whose nodal states depend on the ghost states
+  std::vector<Framework::Node*> _ghostNodes;
+  
 }; // class FVMCC_ComputeRHS
 
 //////////////////////////////////////////////////////////////////////////////
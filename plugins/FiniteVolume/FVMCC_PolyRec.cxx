@@ -39,7 +39,8 @@ FVMCC_PolyRec::FVMCC_PolyRec(const std::string& name) :
   _quadPointCoord(),
   _tmpLimiter(), 
   _gradientCoeff(),
-  _vFunction()
+  _vFunction(),
+  _gradientSubset()
 {
   addConfigOptionsTo(this);
   
@@ -71,6 +71,22 @@ public:
    */
   virtual void computeGradients() = 0;
   
+  /**
+   * Set the states whose gradients are updated by computeGradientSubset()
+   * @param stateIDs local IDs of the states
+   */
+  virtual void setGradientSubset(const std::vector<CFuint>& stateIDs)
+  {
+    _gradientSubset = stateIDs;
+  }
+  
+  /**
+   * Recompute only the gradients of the states given to setGradientSubset(),
+   * after some states of their stencils have changed.
+   * By default all the gradients are recomputed.
+   */
+  virtual void computeGradientSubset() {computeGradients();}
+  
   /// Get the current left state
   Framework::State& getCurrLeftState()
   {
@@ -190,6 +206,9 @@ protected:
   /// a vector of string to hold the functions
   std::vector<std::string> _vars;
   
+  /// local IDs of the states whose gradients are updated by computeGradientSubset()
+  std::vector<CFuint> _gradientSubset;
+  
 }; // end of class FVMCC_PolyRec
 
 //////////////////////////////////////////////////////////////////////////////
@@ -8,11 +8,12 @@
 
 #include "FiniteVolume/FVMCC_FluxSplitter.hh"
 
-#ifdef CF_HAVE_CUDA
-#include "Common/CUDA/CudaEnv.hh"
 #include "Framework/MathTypes.hh"
 #include "Framework/VarSetTransformerT.hh"
 #include "FiniteVolume/FluxData.hh"
+
+#ifdef CF_HAVE_CUDA
+#include "Common/CUDA/CudaEnv.hh"
 #endif
 
 //////////////////////////////////////////////////////////////////////////////
@@ -35,7 +36,6 @@ namespace COOLFluiD {
 class LaxFriedFlux : public FVMCC_FluxSplitter {
 public:
   
-#ifdef CF_HAVE_CUDA
   /// nested class defining local options
   template <typename P = NOTYPE>
   class DeviceConfigOptions {
@@ -77,6 +77,7 @@ public:
     typename MathTypes<CFreal, DT, VS::DIM>::VEC m_tempUnitNormal;
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the device
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
@@ -84,6 +85,7 @@ public:
     CFreal currentDiffRedCoeff = getReductionCoeff(); 
     CudaEnv::copyHost2Dev(&dco->currentDiffRedCoeff, &currentDiffRedCoeff, 1);
   }  
+#endif
   
   /// copy the local configuration options to the device
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
@@ -91,7 +93,6 @@ public:
     // consider to copy to constant memory
     dco->currentDiffRedCoeff = getReductionCoeff();
   }   
-#endif
   
   /// Defines the Config Option's of this class
   /// @param options a OptionList where to add the Option's
@@ -156,7 +157,6 @@ protected:
 
 //////////////////////////////////////////////////////////////////////////////
 
-#ifdef CF_HAVE_CUDA
 /// nested class defining the flux
 template <DeviceType DT, typename VS>
 void LaxFriedFlux::DeviceFunc<DT, VS>::operator()(FluxData<VS>* data, VS* model) 
@@ -176,7 +176,7 @@ void LaxFriedFlux::DeviceFunc<DT, VS>::operator()(FluxData<VS>* data, VS* model)
   updateVS->computeEigenValues(&m_pdata[0], &m_tempUnitNormal[0], &m_tmp[0]);
   CFreal aR = 0.0;
   for (CFuint i = 0; i < VS::NBEQS; ++i) {
-    aR = max(aR, abs(m_tmp[i]));
+    aR = fmax(aR, fabs(m_tmp[i]));
   }
   
   // left physical data, flux and eigenvalues
@@ -188,13 +188,13 @@ void LaxFriedFlux::DeviceFunc<DT, VS>::operator()(FluxData<VS>* data, VS* model)
     
   // compute update coefficient
   if (!data->isPerturb()) {    
-    const CFreal k = max(m_tmp.max(), 0.)*data->getFaceArea();
+    const CFreal k = fmax(m_tmp.max(), 0.)*data->getFaceArea();
     data->setUpdateCoeff(k);
   }
   
   CFreal aL = 0.0;
   for (CFuint i = 0; i < VS::NBEQS; ++i) {
-    aL = max(aL, abs(m_tmp[i]));
+    aL = fmax(aL, fabs(m_tmp[i]));
   }
   
   const CFreal a = fmax(aR,aL);
@@ -215,7 +215,6 @@ void LaxFriedFlux::DeviceFunc<DT, VS>::operator()(FluxData<VS>* data, VS* model)
   // NOTE THE AREA HERE !!!!!!!!!!!!!!!!
   flux *= data->getFaceArea();
 }
-#endif
   
 //////////////////////////////////////////////////////////////////////////////
 
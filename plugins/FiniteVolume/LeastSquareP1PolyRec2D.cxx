@@ -40,7 +40,9 @@ LeastSquareP1PolyRec2D::LeastSquareP1PolyRec2D(const std::string& name) :
   _l12(),
   _l22(),
   _lf1(),
-  _lf2()
+  _lf2(),
+  _subsetEdges(),
+  _subsetEdgesBuilt(false)
 {
 }
 
@@ -151,6 +153,114 @@ void LeastSquareP1PolyRec2D::computeGradients()
 
 //////////////////////////////////////////////////////////////////////////////
 
+void LeastSquareP1PolyRec2D::setGradientSubset(const std::vector<CFuint>& stateIDs)
+{
+  FVMCC_PolyRec::setGradientSubset(stateIDs);
+  
+  // the stencils could be not available yet: the edges are collected 
+  // at the first computation
+  _subsetEdges.clear();
+  _subsetEdgesBuilt = false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void LeastSquareP1PolyRec2D::buildSubsetEdges()
+{
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle<vector<State*> > stencil = socket_stencil.getDataHandle();
+  
+  const CFuint nbStates = states.size();
+  vector<bool> inSubset(nbStates, false);
+  for (CFuint i = 0; i < _gradientSubset.size(); ++i) {
+    inSubset[_gradientSubset[i]] = true;
+  }
+  
+  // same traversal as in computeGradients(), to get the index of the weights
+  _subsetEdges.clear();
+  CFuint iEdge = 0;
+  for(CFuint iState = 0; iState < nbStates; ++iState) {
+    const CFuint stencilSize = stencil[iState].size();
+    for(CFuint in = 0; in < stencilSize; ++in) {
+      const State* const last = stencil[iState][in];
+      const CFuint lastID = (!last->isGhost()) ? last->getLocalID() : 
+	numeric_limits<CFuint>::max();
+      if (lastID > iState) {
+	if (inSubset[iState] || (!last->isGhost() && inSubset[lastID])) {
+	  _subsetEdges.push_back(iEdge);
+	  _subsetEdges.push_back(iState);
+	  _subsetEdges.push_back(in);
+	}
+	++iEdge;
+      }
+    }
+  }
+  
+  _subsetEdgesBuilt = true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void LeastSquareP1PolyRec2D::computeGradientSubset()
+{
+  if (!_subsetEdgesBuilt) {
+    buildSubsetEdges();
+  }
+  
+  prepareReconstruction();
+  
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle<vector<State*> > stencil = socket_stencil.getDataHandle();
+  DataHandle<CFreal> weights = socket_weights.getDataHandle();
+  DataHandle<CFreal> uX = socket_uX.getDataHandle();
+  DataHandle<CFreal> uY = socket_uY.getDataHandle();
+  
+  const CFuint nbSubsetStates = _gradientSubset.size();
+  const CFuint nbSubsetEdges = _subsetEdges.size()/3;
+  const CFuint nbEquations = PhysicalModelStack::getActive()->getNbEq();
+  
+  for(CFuint iVar = 0; iVar < nbEquations; ++iVar) {
+    for (CFuint i = 0; i < nbSubsetStates; ++i) {
+      _lf1[_gradientSubset[i]] = 0.0;
+      _lf2[_gradientSubset[i]] = 0.0;
+    }
+    
+    // the sums of the states outside the subset are not used
+    for (CFuint e = 0; e < nbSubsetEdges; ++e) {
+      const CFuint iEdge = _subsetEdges[e*3];
+      const CFuint firstID = _subsetEdges[e*3+1];
+      const State* const first = states[firstID];
+      const State* const last = stencil[firstID][_subsetEdges[e*3+2]];
+      const RealVector& nodeFirst = first->getCoordinates();
+      const RealVector& nodeLast = last->getCoordinates();
+      const CFreal weig = weights[iEdge];
+      const CFreal dx = weig*(nodeLast[0] - nodeFirst[0]);
+      const CFreal dy = weig*(nodeLast[1] - nodeFirst[1]);
+      const CFreal du = weig*((*last)[iVar] - (*first)[iVar]);
+      const CFreal dxdu = dx*du;
+      const CFreal dydu = dy*du;
+      
+      _lf1[firstID] += dxdu;
+      _lf2[firstID] += dydu;
+      
+      if (!last->isGhost()) {
+	const CFuint lastID = last->getLocalID();
+	_lf1[lastID] += dxdu;
+	_lf2[lastID] += dydu;
+      }
+    }
+    
+    for (CFuint i = 0; i < nbSubsetStates; ++i) {
+      const CFuint iState = _gradientSubset[i];
+      const CFreal invDet = 1./(_l11[iState]*_l22[iState] - _l12[iState]*_l12[iState]);
+      uX(iState,iVar,nbEquations) = (_l22[iState]*_lf1[iState] - _l12[iState]*_lf2[iState])*invDet;
+      uY(iState,iVar,nbEquations) = (_l11[iState]*_lf2[iState] - _l12[iState]*_lf1[iState])*invDet;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void LeastSquareP1PolyRec2D::extrapolateImpl(GeometricEntity* const face)
 {
   FVMCC_PolyRec::baseExtrapolateImpl(face);
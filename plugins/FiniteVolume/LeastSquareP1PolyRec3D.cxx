@@ -42,7 +42,9 @@ LeastSquareP1PolyRec3D::LeastSquareP1PolyRec3D(const std::string& name) :
   _l33(),
   _lf1(),
   _lf2(),
-  _lf3()
+  _lf3(),
+  _subsetEdges(),
+  _subsetEdgesBuilt(false)
 {
 }
 
@@ -139,61 +141,7 @@ void LeastSquareP1PolyRec3D::computeGradients()
     }
 
     for(CFuint iState = 0; iState < nbStates; ++iState) {
-
-      const CFreal det = _l11[iState]*_l22[iState]*_l33[iState]
-	- _l11[iState]*_l23[iState]*_l23[iState]
-	- _l12[iState]*_l12[iState]*_l33[iState]
-	+ _l12[iState]*_l13[iState]*_l23[iState]
-	+ _l13[iState]*_l12[iState]*_l23[iState]
-	- _l13[iState]*_l13[iState]*_l22[iState];
-
-      if (!(std::abs(det) > MathTools::MathConsts::CFrealEps())) {
-	CFout << "Det is zero."<<"\n";
-      }
-
-      const CFreal linv11 = _l22[iState]*_l33[iState] - _l23[iState]*_l23[iState];
-      const CFreal linv22 = _l11[iState]*_l33[iState] - _l13[iState]*_l13[iState];
-      const CFreal linv33 = _l11[iState]*_l22[iState] - _l12[iState]*_l12[iState];
-      const CFreal linv12 = -(_l12[iState]*_l33[iState] - _l13[iState]*_l23[iState]);
-      const CFreal linv13 = _l12[iState]*_l23[iState] - _l13[iState]*_l22[iState];
-      const CFreal linv23 = -(_l11[iState]*_l23[iState] - _l13[iState]*_l12[iState]);
-
-      // A cure to the singularites in calculating the determinant
-      if (!MathChecks::isZero(det)) {
-	uX(iState,iVar,nbEquations) = (linv11*_lf1[iState] +
-				       linv12*_lf2[iState] +
-				       linv13*_lf3[iState])/det;
-	uY(iState,iVar,nbEquations) = (linv12*_lf1[iState] +
-				       linv22*_lf2[iState] +
-				       linv23*_lf3[iState])/det;
-	uZ(iState,iVar,nbEquations) = (linv13*_lf1[iState] +
-				       linv23*_lf2[iState] +
-				       linv33*_lf3[iState])/det;
-	
-	// if (std::abs(_uX(iState,iVar,nbEquations)) > 0.) CFout << "ux = " << _uX(iState,iVar,nbEquations) << "\n";
-	// if (std::abs(_uY(iState,iVar,nbEquations)) > 0.) CFout << "uy = " << _uY(iState,iVar,nbEquations) << "\n";
-	// if (std::abs(_uZ(iState,iVar,nbEquations)) > 0.) CFout << "uz = " << _uZ(iState,iVar,nbEquations) << "\n";
-      }
-      else {
-	uX(iState,iVar,nbEquations) = 0.0;
-	uY(iState,iVar,nbEquations) = 0.0;
-	uZ(iState,iVar,nbEquations) = 0.0;
-      }
-
-      CFLogDebugMed( "det = " << det
-		     << ", l11 = " << _l11[iState]
-		     << ", l12 = " << _l12[iState]
-		     << ", l13 = " << _l13[iState]
-		     << ", l22 = " << _l22[iState]
-		     << ", l23 = " << _l23[iState]
-		     << ", l33 = " << _l33[iState]
-		     <<", lf1 = " << _lf1[iState]
-		     <<", lf2 = " << _lf2[iState]
-		     <<", lf3 = " << _lf3[iState]
-		     << ", uX =" << uX(iState,iVar,nbEquations)
-		     << ", uY =" << uY(iState,iVar,nbEquations)
-		     << ", uZ =" << uZ(iState,iVar,nbEquations)
-		     << "\n");
+      computeStateGradient(iState, iVar, uX, uY, uZ);
     }
   }
   
@@ -213,6 +161,179 @@ void LeastSquareP1PolyRec3D::computeGradients()
 
 //////////////////////////////////////////////////////////////////////////////
 
+void LeastSquareP1PolyRec3D::computeStateGradient(const CFuint iState, 
+						  const CFuint iVar,
+						  DataHandle<CFreal>& uX,
+						  DataHandle<CFreal>& uY,
+						  DataHandle<CFreal>& uZ)
+{
+  const CFuint nbEquations = PhysicalModelStack::getActive()->getNbEq();
+  
+  const CFreal det = _l11[iState]*_l22[iState]*_l33[iState]
+    - _l11[iState]*_l23[iState]*_l23[iState]
+    - _l12[iState]*_l12[iState]*_l33[iState]
+    + _l12[iState]*_l13[iState]*_l23[iState]
+    + _l13[iState]*_l12[iState]*_l23[iState]
+    - _l13[iState]*_l13[iState]*_l22[iState];
+
+  if (!(std::abs(det) > MathTools::MathConsts::CFrealEps())) {
+    CFout << "Det is zero."<<"\n";
+  }
+
+  const CFreal linv11 = _l22[iState]*_l33[iState] - _l23[iState]*_l23[iState];
+  const CFreal linv22 = _l11[iState]*_l33[iState] - _l13[iState]*_l13[iState];
+  const CFreal linv33 = _l11[iState]*_l22[iState] - _l12[iState]*_l12[iState];
+  const CFreal linv12 = -(_l12[iState]*_l33[iState] - _l13[iState]*_l23[iState]);
+  const CFreal linv13 = _l12[iState]*_l23[iState] - _l13[iState]*_l22[iState];
+  const CFreal linv23 = -(_l11[iState]*_l23[iState] - _l13[iState]*_l12[iState]);
+
+  // A cure to the singularites in calculating the determinant
+  if (!MathChecks::isZero(det)) {
+    uX(iState,iVar,nbEquations) = (linv11*_lf1[iState] +
+				   linv12*_lf2[iState] +
+				   linv13*_lf3[iState])/det;
+    uY(iState,iVar,nbEquations) = (linv12*_lf1[iState] +
+				   linv22*_lf2[iState] +
+				   linv23*_lf3[iState])/det;
+    uZ(iState,iVar,nbEquations) = (linv13*_lf1[iState] +
+				   linv23*_lf2[iState] +
+				   linv33*_lf3[iState])/det;
+    
+    // if (std::abs(_uX(iState,iVar,nbEquations)) > 0.) CFout << "ux = " << _uX(iState,iVar,nbEquations) << "\n";
+    // if (std::abs(_uY(iState,iVar,nbEquations)) > 0.) CFout << "uy = " << _uY(iState,iVar,nbEquations) << "\n";
+    // if (std::abs(_uZ(iState,iVar,nbEquations)) > 0.) CFout << "uz = " << _uZ(iState,iVar,nbEquations) << "\n";
+  }
+  else {
+    uX(iState,iVar,nbEquations) = 0.0;
+    uY(iState,iVar,nbEquations) = 0.0;
+    uZ(iState,iVar,nbEquations) = 0.0;
+  }
+
+  CFLogDebugMed( "det = " << det
+		 << ", l11 = " << _l11[iState]
+		 << ", l12 = " << _l12[iState]
+		 << ", l13 = " << _l13[iState]
+		 << ", l22 = " << _l22[iState]
+		 << ", l23 = " << _l23[iState]
+		 << ", l33 = " << _l33[iState]
+		 <<", lf1 = " << _lf1[iState]
+		 <<", lf2 = " << _lf2[iState]
+		 <<", lf3 = " << _lf3[iState]
+		 << ", uX =" << uX(iState,iVar,nbEquations)
+		 << ", uY =" << uY(iState,iVar,nbEquations)
+		 << ", uZ =" << uZ(iState,iVar,nbEquations)
+		 << "\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void LeastSquareP1PolyRec3D::setGradientSubset(const std::vector<CFuint>& stateIDs)
+{
+  FVMCC_PolyRec::setGradientSubset(stateIDs);
+  
+  // the stencils could be not available yet: the edges are collected 
+  // at the first computation
+  _subsetEdges.clear();
+  _subsetEdgesBuilt = false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void LeastSquareP1PolyRec3D::buildSubsetEdges()
+{
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle<vector<State*> > stencil = socket_stencil.getDataHandle();
+  
+  const CFuint nbStates = states.size();
+  vector<bool> inSubset(nbStates, false);
+  for (CFuint i = 0; i < _gradientSubset.size(); ++i) {
+    inSubset[_gradientSubset[i]] = true;
+  }
+  
+  // same traversal as in computeGradients(), to get the index of the weights
+  _subsetEdges.clear();
+  CFuint iEdge = 0;
+  for(CFuint iState = 0; iState < nbStates; ++iState) {
+    const CFuint stencilSize = stencil[iState].size();
+    for(CFuint in = 0; in < stencilSize; ++in) {
+      const State* const last = stencil[iState][in];
+      const CFuint lastID = (!last->isGhost()) ? last->getLocalID() : 
+	numeric_limits<CFuint>::max();
+      if (lastID > iState) {
+	if (inSubset[iState] || (!last->isGhost() && inSubset[lastID])) {
+	  _subsetEdges.push_back(iEdge);
+	  _subsetEdges.push_back(iState);
+	  _subsetEdges.push_back(in);
+	}
+	++iEdge;
+      }
+    }
+  }
+  
+  _subsetEdgesBuilt = true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void LeastSquareP1PolyRec3D::computeGradientSubset()
+{
+  if (!_subsetEdgesBuilt) {
+    buildSubsetEdges();
+  }
+  
+  prepareReconstruction();
+  
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle<vector<State*> > stencil = socket_stencil.getDataHandle();
+  DataHandle<CFreal> weights = socket_weights.getDataHandle();
+  DataHandle<CFreal> uX = socket_uX.getDataHandle();
+  DataHandle<CFreal> uY = socket_uY.getDataHandle();
+  DataHandle<CFreal> uZ = socket_uZ.getDataHandle();
+  
+  const CFuint nbSubsetStates = _gradientSubset.size();
+  const CFuint nbSubsetEdges = _subsetEdges.size()/3;
+  const CFuint nbEquations = PhysicalModelStack::getActive()->getNbEq();
+  
+  for(CFuint iVar = 0; iVar < nbEquations; ++iVar) {
+    for (CFuint i = 0; i < nbSubsetStates; ++i) {
+      _lf1[_gradientSubset[i]] = 0.0;
+      _lf2[_gradientSubset[i]] = 0.0;
+      _lf3[_gradientSubset[i]] = 0.0;
+    }
+    
+    // the sums of the states outside the subset are not used
+    for (CFuint e = 0; e < nbSubsetEdges; ++e) {
+      const CFuint iEdge = _subsetEdges[e*3];
+      const CFuint firstID = _subsetEdges[e*3+1];
+      const State* const first = states[firstID];
+      const State* const last = stencil[firstID][_subsetEdges[e*3+2]];
+      const RealVector& nodeFirst = first->getCoordinates();
+      const RealVector& nodeLast = last->getCoordinates();
+      const CFreal dx = weights[iEdge]*(nodeLast[0] - nodeFirst[0]);
+      const CFreal dy = weights[iEdge]*(nodeLast[1] - nodeFirst[1]);
+      const CFreal dz = weights[iEdge]*(nodeLast[2] - nodeFirst[2]);
+      const CFreal du = weights[iEdge]*((*last)[iVar] - (*first)[iVar]);
+      
+      _lf1[firstID] += dx*du;
+      _lf2[firstID] += dy*du;
+      _lf3[firstID] += dz*du;
+      
+      if (!last->isGhost()) {
+	const CFuint lastID = last->getLocalID();
+	_lf1[lastID] += dx*du;
+	_lf2[lastID] += dy*du;
+	_lf3[lastID] += dz*du;
+      }
+    }
+    
+    for (CFuint i = 0; i < nbSubsetStates; ++i) {
+      computeStateGradient(_gradientSubset[i], iVar, uX, uY, uZ);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void LeastSquareP1PolyRec3D::extrapolateImpl(GeometricEntity* const face)
 {
   FVMCC_PolyRec::baseExtrapolateImpl(face);
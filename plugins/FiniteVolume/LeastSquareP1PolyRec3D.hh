@@ -5,12 +5,13 @@
 
 #include "FiniteVolume/FVMCC_PolyRec.hh"
 
-#ifdef CF_HAVE_CUDA
 #include "FiniteVolume/FluxData.hh"
 #include "FiniteVolume/KernelData.hh"
 #include "FiniteVolume/CellData.hh"
-#include "Common/CUDA/CudaEnv.hh"
 #include "Framework/SubSystemStatus.hh"
+
+#ifdef CF_HAVE_CUDA
+#include "Common/CUDA/CudaEnv.hh"
 #endif
 
 //////////////////////////////////////////////////////////////////////////////
@@ -32,7 +33,6 @@ namespace COOLFluiD {
 class LeastSquareP1PolyRec3D : public FVMCC_PolyRec {
 public:
 
-#ifdef CF_HAVE_CUDA
   /// nested class defining local options
   template <typename P = NOTYPE>
   class DeviceConfigOptions {
@@ -100,6 +100,7 @@ public:
     DeviceConfigOptions<NOTYPE>* m_dco;
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the device
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
@@ -116,6 +117,7 @@ public:
     CudaEnv::copyHost2Dev(&dco->currIter, &iter, 1);
     CudaEnv::copyHost2Dev(&dco->currRes, &res, 1);
   }   
+#endif
   
   /// copy the local configuration options to the device
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
@@ -129,7 +131,6 @@ public:
     dco->currIter = Framework::SubSystemStatusStack::getActive()->getNbIter();
     dco->currRes = Framework::SubSystemStatusStack::getActive()->getResidual();
   }   
-#endif
 
   /**
    * Constructor
@@ -157,6 +158,16 @@ public:
    * Compute the gradients
    */
   virtual void computeGradients();
+  
+  /**
+   * Set the states whose gradients are updated by computeGradientSubset()
+   */
+  virtual void setGradientSubset(const std::vector<CFuint>& stateIDs);
+  
+  /**
+   * Recompute only the gradients of the states given to setGradientSubset()
+   */
+  virtual void computeGradientSubset();
 
   /**
    * Set up the private data
@@ -181,6 +192,19 @@ protected:
   virtual void extrapolateImpl(Framework::GeometricEntity* const face,
                                CFuint iVar, CFuint leftOrRight);
 
+  /**
+   * Solve the least square system of a state for one variable
+   */
+  void computeStateGradient(const CFuint iState, const CFuint iVar,
+			    Framework::DataHandle<CFreal>& uX,
+			    Framework::DataHandle<CFreal>& uY,
+			    Framework::DataHandle<CFreal>& uZ);
+  
+  /**
+   * Collect the edges touching the states of the gradient subset
+   */
+  void buildSubsetEdges();
+
 protected:
 
   /// socket for stencil
@@ -216,12 +240,17 @@ protected:
 
   RealVector  _lf3;
 
+  /// edges touching the states of the gradient subset, as triplets
+  /// (index of the weight, first state, index of the last state in the stencil)
+  std::vector<CFuint> _subsetEdges;
+
+  /// flag telling if the edges of the gradient subset have been collected
+  bool _subsetEdgesBuilt;
+
 }; // end of class LeastSquareP1PolyRec3D
 
 //////////////////////////////////////////////////////////////////////////////
 
-#ifdef CF_HAVE_CUDA
-
 template <typename PHYS>
 void LeastSquareP1PolyRec3D::DeviceFunc<PHYS>::computeGradients
 (const CFreal* state,  const CFreal* node, KernelData<CFreal> *const kd, CellData::Itr* cell)
@@ -291,7 +320,7 @@ void LeastSquareP1PolyRec3D::DeviceFunc<PHYS>::computeGradients
 
   // A cure to the singularites in calculating the determinant
   const CFuint starts = cell->getCellID()*PHYS::NBEQS;
-  if (abs(det) > 1e-16) { // maybe 1e-12 would be more conservative...
+  if (fabs(det) > 1e-16) { // maybe 1e-12 would be more conservative...
     const CFreal invDet = 1./det;
     for (CFuint i = 0; i < PHYS::NBEQS; ++i) {
       const CFuint gradx = starts + i;
@@ -375,8 +404,6 @@ inline void LeastSquareP1PolyRec3D::DeviceFunc<PHYS>::extrapolateOnFace
   currFd->getRstate(LEFT)[iVar] = currFd->getState(LEFT)[iVar];
   currFd->getRstate(LEFT)[iVar] += m_dco->gradientFactor*limiter[sL]*duTotL; 
 }
-
-#endif
       
 //////////////////////////////////////////////////////////////////////////////
       
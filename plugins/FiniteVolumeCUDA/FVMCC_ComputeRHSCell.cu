@@ -2,9 +2,11 @@
 #include "Framework/MeshData.hh"
 #include "Framework/CellConn.hh"
 #include "Config/ConfigOptionPtr.hh"
-#include "Common/CUDA/CudaDeviceManager.hh"
 #include "Common/CUDA/CFVec.hh"
+#ifdef CF_HAVE_CUDA
+#include "Common/CUDA/CudaDeviceManager.hh"
 #include "Common/CUDA/CudaTimer.hh"
+#endif
 #include "FiniteVolume/FluxData.hh"
 #include "FiniteVolume/KernelData.hh"
 #include "FiniteVolume/CellData.hh"
@@ -154,6 +156,8 @@ HOST_DEVICE void computeFaceCentroid(const CellData::Itr* cell, const CFuint fac
 
 //////////////////////////////////////////////////////////////////////////////
 
+#ifdef CF_HAVE_CUDA
+
 template <typename PHYS, typename POLYREC>
 __global__ void computeGradientsKernel(typename POLYREC::BASE::template DeviceConfigOptions<NOTYPE>* dcor,
 				       const CFuint nbCells,
@@ -357,6 +361,8 @@ __global__ void computeFluxKernel(typename SCHEME::BASE::template DeviceConfigOp
     }
   }
 }
+
+#endif
   
 //////////////////////////////////////////////////////////////////////////////
 
@@ -388,85 +394,107 @@ void computeFluxCPU(typename SCHEME::BASE::template DeviceConfigOptions<NOTYPE>*
 { 
   typedef typename SCHEME::MODEL PHYS;
   
-  FluxData<PHYS> fd; fd.initialize();
-  FluxData<PHYS>* currFd = &fd;
-  cf_assert(currFd != CFNULL);
-  SCHEME fluxScheme(dcof);
-  POLYREC polyRec(dcor);
-  LIMITER limt(dcol);
-  PHYS pmodel(dcop);
-  
   CellData cells(nbCells, cellInfo, cellStencil, cellFaces, cellNodes, neighborTypes, cellConn);
   KernelData<CFreal> kd(nbCells, states, nodes, centerNodes, ghostStates, ghostNodes, updateCoeff, 
 			rhs, normals, uX, uY, uZ, isOutward);
   
-  CFreal midFaceCoord[PHYS::DIM*PHYS::DIM*2];
-  CudaEnv::CFVec<CFreal,PHYS::NBEQS> tmpLimiter;
-  
-  // compute the cell-based gradients
-  for (CFuint cellID = 0; cellID < nbCells; ++cellID) {
-    CellData::Itr cell = cells.getItr(cellID);
-    polyRec.computeGradients(&states[cellID*PHYS::NBEQS], &centerNodes[cellID*PHYS::DIM], &kd, &cell);
-  }
-  
-  // compute the cell based limiter
-  // for (CFuint cellID = 0; cellID < nbCells; ++cellID) {
-  for (CellData::Itr cell = cells.begin(); cell <= cells.end(); ++cell) {
-    // compute all cell quadrature points at once (size of this array is overestimated)
-    const CFuint nbFacesInCell = cell.getNbFacesInCell();
-    for (CFuint f = 0; f < nbFacesInCell; ++f) { 
-      computeFaceCentroid<PHYS>(&cell, f, nodes, &midFaceCoord[f*PHYS::DIM]);
-    }
+  // each phase writes only in the entries of the cell being processed, 
+  // therefore the cell loops can be shared among threads as they are on the GPU:
+  // every thread owns its flux data, functors and temporary storage
+#ifdef CF_HAVE_OMP
+#pragma omp parallel
+#endif
+  {
+    FluxData<PHYS> fd; fd.initialize();
+    FluxData<PHYS>* currFd = &fd;
+    cf_assert(currFd != CFNULL);
+    SCHEME fluxScheme(dcof);
+    POLYREC polyRec(dcor);
+    LIMITER limt(dcol);
+    PHYS pmodel(dcop);
     
-    const CFuint cellID = cell.getCellID();
-    if (dcor->currRes > dcor->limitRes && (dcor->limitIter > 0 && dcor->currIter < dcor->limitIter)) {	
-      // compute cell-based limiter
-      limt.limit(&kd, &cell, &midFaceCoord[0], &limiter[cellID*PHYS::NBEQS]);
+    CFreal midFaceCoord[PHYS::DIM*PHYS::DIM*2];
+    CudaEnv::CFVec<CFreal,PHYS::NBEQS> tmpLimiter;
+    
+    // compute the cell-based gradients
+#ifdef CF_HAVE_OMP
+#pragma omp for
+#endif
+    for (CFuint cellID = 0; cellID < nbCells; ++cellID) {
+      CellData::Itr cell = cells.getItr(cellID);
+      polyRec.computeGradients(&states[cellID*PHYS::NBEQS], &centerNodes[cellID*PHYS::DIM], &kd, &cell);
     }
-    else {
-      if (!dcor->freezeLimiter) {
-	// historical modification of the limiter
-	limt.limit(&kd, &cell, &midFaceCoord[0], &tmpLimiter[0]);
-	CFuint currID = cellID*PHYS::NBEQS;
-	for (CFuint iVar = 0; iVar < PHYS::NBEQS; ++iVar, ++currID) {
-	  limiter[currID] = min(tmpLimiter[iVar],limiter[currID]);
+    
+    // compute the cell based limiter
+#ifdef CF_HAVE_OMP
+#pragma omp for
+#endif
+    for (CFuint cellID = 0; cellID < nbCells; ++cellID) {
+      CellData::Itr cell = cells.getItr(cellID);
+      
+      // compute all cell quadrature points at once (size of this array is overestimated)
+      const CFuint nbFacesInCell = cell.getNbFacesInCell();
+      for (CFuint f = 0; f < nbFacesInCell; ++f) { 
+	computeFaceCentroid<PHYS>(&cell, f, nodes, &midFaceCoord[f*PHYS::DIM]);
+      }
+      
+      if (dcor->currRes > dcor->limitRes && (dcor->limitIter > 0 && dcor->currIter < dcor->limitIter)) {	
+	// compute cell-based limiter
+	limt.limit(&kd, &cell, &midFaceCoord[0], &limiter[cellID*PHYS::NBEQS]);
+      }
+      else {
+	if (!dcor->freezeLimiter) {
+	  // historical modification of the limiter
+	  limt.limit(&kd, &cell, &midFaceCoord[0], &tmpLimiter[0]);
+	  CFuint currID = cellID*PHYS::NBEQS;
+	  for (CFuint iVar = 0; iVar < PHYS::NBEQS; ++iVar, ++currID) {
+	    limiter[currID] = std::min(tmpLimiter[iVar],limiter[currID]);
+	  }
 	}
       }
     }
-  }
-  
-  // compute the fluxes
-  for (CellData::Itr cell = cells.begin(); cell <= cells.end(); ++cell) {
-    // reset the rhs and update coefficients to 0
-    const CFuint cellID = cell.getCellID();
-    CudaEnv::CFVecSlice<CFreal,PHYS::NBEQS> res(&rhs[cellID*PHYS::NBEQS]);
-    res = 0.;
-    updateCoeff[cellID] = 0.;
     
-    const CFuint nbFacesInCell = cell.getNbActiveFacesInCell();
-    for (CFuint f = 0; f < nbFacesInCell; ++f) { 
-      const CFint stype = cell.getNeighborType(f);
+    // compute the fluxes
+#ifdef CF_HAVE_OMP
+#pragma omp for
+#endif
+    for (CFuint cellID = 0; cellID < nbCells; ++cellID) {
+      CellData::Itr cell = cells.getItr(cellID);
       
-      if (stype != 0) { // skip all partition faces
-	const CFuint stateID =  cell.getNeighborID(f);
-	setFluxData(f, stype, stateID, cellID, &kd, currFd, cellFaces);
-	
-	// compute face quadrature points (centroid)
-	CFreal* faceCenters = &midFaceCoord[f*PHYS::DIM];
-	computeFaceCentroid<PHYS>(&cell, f, nodes, faceCenters);
-	
-	// extrapolate solution on quadrature points on both sides of the face
-	polyRec.extrapolateOnFace(currFd, faceCenters, uX, uY, uZ, limiter);
-	fluxScheme(currFd, &pmodel); // compute the convective flux across the face
+      // reset the rhs and update coefficients to 0
+      CFreal* cf_restrict res = &rhs[cellID*PHYS::NBEQS];
+      for (CFuint iEq = 0; iEq < PHYS::NBEQS; ++iEq) {
+	res[iEq] = 0.;
+      }
+      CFreal cellUpdateCoeff = 0.;
+      
+      const CFuint nbFacesInCell = cell.getNbActiveFacesInCell();
+      for (CFuint f = 0; f < nbFacesInCell; ++f) { 
+	const CFint stype = cell.getNeighborType(f);
 	
-	for (CFuint iEq = 0; iEq < PHYS::NBEQS; ++iEq) {
-	  const CFreal value = currFd->getResidual()[iEq];
-	  res[iEq] -= value;  // update the residual 
+	if (stype != 0) { // skip all partition faces
+	  const CFuint stateID =  cell.getNeighborID(f);
+	  setFluxData(f, stype, stateID, cellID, &kd, currFd, cellFaces);
+	  
+	  // compute face quadrature points (centroid)
+	  CFreal* faceCenters = &midFaceCoord[f*PHYS::DIM];
+	  computeFaceCentroid<PHYS>(&cell, f, nodes, faceCenters);
+	  
+	  // extrapolate solution on quadrature points on both sides of the face
+	  polyRec.extrapolateOnFace(currFd, faceCenters, uX, uY, uZ, limiter);
+	  fluxScheme(currFd, &pmodel); // compute the convective flux across the face
+	  
+	  // update the residual (fixed size loop, unrolled/vectorized by the compiler)
+	  const CFreal* cf_restrict faceRes = currFd->getResidual();
+	  for (CFuint iEq = 0; iEq < PHYS::NBEQS; ++iEq) {
+	    res[iEq] -= faceRes[iEq];
+	  }
+	  
+	  // update the update coefficient
+	  cellUpdateCoeff += currFd->getUpdateCoeff();
 	}
-	
-	// update the update coefficient
-	updateCoeff[cellID] += currFd->getUpdateCoeff();
       }
+      updateCoeff[cellID] = cellUpdateCoeff;
     }
   }
 }
@@ -498,10 +526,15 @@ void FVMCC_ComputeRHSCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>::exec
   SafePtr<typename PHYSICS::PTERM> phys = PhysicalModelStack::getActive()->getImplementor()->
     getConvectiveTerm().d_castTo<typename PHYSICS::PTERM>();
   
+#ifdef CF_HAVE_CUDA
   typedef typename SCHEME::template DeviceFunc<GPU, PHYSICS> FluxScheme;  
+#else
+  typedef typename SCHEME::template DeviceFunc<CPU, PHYSICS> FluxScheme;  
+#endif
   typedef typename POLYREC::template DeviceFunc<PHYSICS> PolyRec;  
   typedef typename LIMITER::template DeviceFunc<PHYSICS> Limiter;  
   
+#ifdef CF_HAVE_CUDA
   if (m_onGPU) {
 
     CudaEnv::CudaTimer& timer = CudaEnv::CudaTimer::getInstance();
@@ -621,7 +654,9 @@ void FVMCC_ComputeRHSCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>::exec
     updateCoeff.getLocalArray()->get();
     CFLog(INFO, "FVMCC_ComputeRHSCell::execute() => GPU-->CPU data transfer took " << timer.elapsed() << " s\n");
   }
-  else {
+  else
+#endif
+  {
     // AL: useful fo debugging
     // for (CFuint i = 0; i <  m_ghostStates.size()/9; ++i) {
     //   std::cout.precision(12); std::cout << "g" << i << " => ";
@@ -639,6 +674,11 @@ void FVMCC_ComputeRHSCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>::exec
     ConfigOptionPtr<LIMITER> dcol(lm);
     ConfigOptionPtr<typename PHYSICS::PTERM> dcop(phys);
     
+    DataHandle<CFreal> uX = socket_uX.getDataHandle();
+    DataHandle<CFreal> uY = socket_uY.getDataHandle();
+    DataHandle<CFreal> uZ = socket_uZ.getDataHandle();
+    DataHandle<CFreal> limiter = socket_limiter.getDataHandle();
+    
     computeFluxCPU<FluxScheme, PolyRec, Limiter>
       (dcof.getPtr(),
        dcor.getPtr(),
@@ -647,23 +687,23 @@ void FVMCC_ComputeRHSCell<SCHEME,PHYSICS,POLYREC,LIMITER,NB_BLOCK_THREADS>::exec
        nbCells,
        socket_states.getDataHandle().getGlobalArray()->ptr(), 
        socket_nodes.getDataHandle().getGlobalArray()->ptr(),
-       m_centerNodes.ptr(), 
-       m_ghostStates.ptr(),
-       m_ghostNodes.ptr(),
-       socket_uX.getDataHandle().getLocalArray()->ptr(),
-       socket_uY.getDataHandle().getLocalArray()->ptr(),
-       socket_uZ.getDataHandle().getLocalArray()->ptr(),
-       socket_limiter.getDataHandle().getLocalArray()->ptr(),
-       updateCoeff.getLocalArray()->ptr(), 
-       rhs.getLocalArray()->ptr(),
-       normals.getLocalArray()->ptr(),
-       isOutward.getLocalArray()->ptr(),
-       m_cellInfo.ptr(),
-       m_cellStencil.ptr(),
-       m_cellFaces->getPtr()->ptr(),
-       m_cellNodes->getPtr()->ptr(),
-       m_neighborTypes.ptr(),
-       m_cellConn.ptr());
+       &m_centerNodes[0], 
+       &m_ghostStates[0],
+       &m_ghostNodes[0],
+       &uX[0],
+       &uY[0],
+       (uZ.size() > 0) ? &uZ[0] : CFNULL,
+       &limiter[0],
+       &updateCoeff[0], 
+       &rhs[0],
+       &normals[0],
+       &isOutward[0],
+       &m_cellInfo[0],
+       &m_cellStencil[0],
+       &(*m_cellFaces)(0,0),
+       &(*m_cellNodes)(0,0),
+       &m_neighborTypes[0],
+       &m_cellConn[0]);
   }
   
 // for (int i = 0; i < updateCoeff.size(); ++i) {
@@ -5,15 +5,16 @@
 
 #include "FiniteVolume/FVMCC_ComputeRHS.hh"
 #include "FiniteVolume/KernelData.hh"
+#include "Framework/CellConn.hh"
+
+#ifdef CF_HAVE_CUDA
+#include "Common/CUDA/CudaVector.hh"
+#endif
 
 //////////////////////////////////////////////////////////////////////////////
 
 namespace COOLFluiD {
 
-  namespace Framework {
-    class CellConn;
-  }
-  
   namespace Numerics {
 
     namespace FiniteVolume {
@@ -22,7 +23,9 @@ namespace COOLFluiD {
 
 /**
  * This class represent a command that computes the RHS using
- * standard cell center FVM schemes with CUDA bindings
+ * standard cell center FVM schemes with CUDA bindings.
+ * Without CUDA the same cell-based kernels are compiled as plain C++
+ * and run on the host, multithreaded over the cells if OpenMP is enabled.
  *
  * @author Andrea Lani
  *
@@ -77,6 +80,18 @@ public:
 
 protected:
   
+#ifdef CF_HAVE_CUDA
+  typedef CudaEnv::CudaVector<CFreal> RealArray;
+  typedef CudaEnv::CudaVector<CFuint, CudaEnv::MallocHostAlloc> UintArray;
+  typedef CudaEnv::CudaVector<CFint, CudaEnv::MallocHostAlloc> IntArray;
+  typedef CudaEnv::CudaVector<Framework::CellConn, CudaEnv::MallocHostAlloc> CellConnArray;
+#else
+  typedef std::vector<CFreal> RealArray;
+  typedef std::vector<CFuint> UintArray;
+  typedef std::vector<CFint> IntArray;
+  typedef std::vector<Framework::CellConn> CellConnArray;
+#endif
+  
   /// Initialize the computation of RHS
   virtual void initializeComputationRHS();
   
@@ -107,13 +122,13 @@ protected:
   Common::SafePtr< Common::ConnectivityTable<CFuint> > m_cellNodes;
   
   /// storage of the cell centers (AL: temporary solution) 
-  CudaEnv::CudaVector<CFreal> m_centerNodes;
+  RealArray m_centerNodes;
   
   /// storage of the ghost states (AL: temporary solution) 
-  CudaEnv::CudaVector<CFreal> m_ghostStates;
+  RealArray m_ghostStates;
   
   /// storage of the ghost nodes (AL: temporary solution) 
-  CudaEnv::CudaVector<CFreal> m_ghostNodes;
+  RealArray m_ghostNodes;
   
   /// storage of useful cell info: 
   /// in [cellID*5+0] - ptr to corresponding stencil
@@ -121,22 +136,22 @@ protected:
   /// in [cellID*5+2] - number of cell faces
   /// in [cellID*5+3] - cell geoshape
   /// in [cellID*5+4] - number of active cell faces (partition faces are excluded)  
-  CudaEnv::CudaVector<CFuint, CudaEnv::MallocHostAlloc> m_cellInfo;
+  UintArray m_cellInfo;
   
   /// stencil connectivity for cellID: 
   /// starts at m_cellInfo[cellID*5]
   /// its size is given by m_cellInfo[cellID*5+1]
   /// first m_cellInfo[cellID*5+2] are faces
-  CudaEnv::CudaVector<CFuint, CudaEnv::MallocHostAlloc> m_cellStencil;
+  UintArray m_cellStencil;
   
   /// storage of flags for neighbors (1: internal, 0:partition, <0: boundary)
   /// starts at m_cellInfo[cellID*5]
   /// its size is given by m_cellInfo[cellID*5+1]
   /// first m_cellInfo[cellID*5+2] are faces
-  CudaEnv::CudaVector<CFint, CudaEnv::MallocHostAlloc> m_neighborTypes;
+  IntArray m_neighborTypes;
   
   // cell connectivity
-  CudaEnv::CudaVector<Framework::CellConn, CudaEnv::MallocHostAlloc> m_cellConn;
+  CellConnArray m_cellConn;
     
   /// number of blocks in x 
   CFuint m_nbBlocksPerGridX;
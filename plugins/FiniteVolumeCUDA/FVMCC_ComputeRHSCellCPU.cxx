@@ -0,0 +1,10 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+// Without CUDA the cell-based RHS kernels are compiled by the C++ compiler
+// from the same source as the device build and run on the host.
+
+#include "FiniteVolumeCUDA/FVMCC_ComputeRHSCell.cu"
@@ -29,7 +29,6 @@ template <typename UPDATEVAR>
 class LaxFriedFluxTanaka : public LaxFriedFlux {
 public:
   
-#ifdef CF_HAVE_CUDA
   /// nested class defining a functor
   template <DeviceType DT, typename VS>
   class DeviceFunc {
@@ -58,7 +57,7 @@ public:
       updateVS->computeEigenValues(&m_pdata[0], &m_tempUnitNormal[0], &m_tmp[0]);
       CFreal aR = 0.0;
       for (CFuint i = 0; i < VS::NBEQS; ++i) {
-    	aR = max(aR, abs(m_tmp[i]));
+    	aR = fmax(aR, fabs(m_tmp[i]));
       }
       
       // left physical data, flux and eigenvalues
@@ -70,13 +69,13 @@ public:
       
       // compute update coefficient
       if (!data->isPerturb()) {    
-    	const CFreal k = max(m_tmp.max(), 0.)*data->getFaceArea();
+    	const CFreal k = fmax(m_tmp.max(), 0.)*data->getFaceArea();
     	data->setUpdateCoeff(k);
       }
       
       CFreal aL = 0.0;
       for (CFuint i = 0; i < VS::NBEQS; ++i) {
-    	aL = max(aL, abs(m_tmp[i]));
+    	aL = fmax(aL, fabs(m_tmp[i]));
       }
       
       const CFreal a = fmax(aR,aL);
@@ -105,7 +104,6 @@ public:
     typename MathTypes<CFreal, DT, VS::DATASIZE>::VEC m_pdata;
     typename MathTypes<CFreal, DT, VS::DIM>::VEC m_tempUnitNormal;
   };
-#endif
   
   /// Defines the Config Option's of this class
   /// @param options a OptionList where to add the Option's
@@ -45,6 +45,12 @@ public:
    * Compute the gradients
    */
   virtual void computeGradients();
+  
+  /**
+   * Recompute the gradients: the correction on the subsonic outlets
+   * needs all of them
+   */
+  virtual void computeGradientSubset() {computeGradients();}
 
   /**
    * Set up the private data
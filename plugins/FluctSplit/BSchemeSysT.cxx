@@ -0,0 +1,60 @@
+#include "BSchemeSysT.hh"
+#include "Framework/MethodStrategyProvider.hh"
+#include "FluctSplit/FluctSplitSystem.hh"
+#include "FluctSplit/FluctuationSplitData.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::MathTools;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+
+
+    namespace FluctSplit {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodStrategyProvider<BSchemeSysT<4>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+bSchemeSys4Provider("SysB4");
+
+MethodStrategyProvider<BSchemeSysT<5>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+bSchemeSys5Provider("SysB5");
+
+MethodStrategyProvider<BSchemeSysT<6>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+bSchemeSys6Provider("SysB6");
+
+MethodStrategyProvider<BSchemeSysT<8>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+bSchemeSys8Provider("SysB8");
+
+MethodStrategyProvider<BSchemeSysT<9>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+bSchemeSys9Provider("SysB9");
+
+//////////////////////////////////////////////////////////////////////////////
+
+     } // namespace FluctSplit
+
+
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,89 @@
+#ifndef COOLFluiD_Numerics_FluctSplit_BSchemeSysT_hh
+#define COOLFluiD_Numerics_FluctSplit_BSchemeSysT_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "FluctSplit/RDS_SplitterSys.hh"
+#include "FluctSplit/BSchemeBase.hh"
+#include "MathTools/LUInverterT.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+    namespace FluctSplit {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class represents the B scheme for RDS space discretization, with
+ * the number of equations N fixed at compile time
+ *
+ * @author Andrea Lani
+ */
+template <CFuint N>
+class BSchemeSysT : public BSchemeBase<RDS_SplitterSys> {
+public:
+  typedef BSchemeSysT<N> SELF;
+  
+  /// Constructor
+  explicit BSchemeSysT(const std::string& name);
+
+  /// Destructor
+  virtual ~BSchemeSysT();
+
+  /// Setup this object with data depending on the mesh
+  virtual void setup();
+
+  /// Distribute the residual
+  virtual void distribute(std::vector<RealVector>& residual);
+  
+  /// Compute all the contributions for the Picard jacobian
+  virtual void computePicardJacob(std::vector<RealMatrix*>& jacob);
+  
+protected: // functions
+
+  /// Compute the blending coefficients
+  virtual void computeBlendingCoeff();
+  
+protected:
+  
+  MathTools::CFVec<CFreal,N> _sumKminU;
+  
+  MathTools::CFMat<CFreal,N,N> _sumKmin;
+  
+  MathTools::CFMat<CFreal,N,N> _sumKplus;
+  
+  MathTools::CFMat<CFreal,N,N> _k;
+  
+  MathTools::CFMat<CFreal,N,N> _invKmin;
+  
+  MathTools::CFMat<CFreal,N,N> _invKplus;
+  
+  MathTools::CFVec<CFreal,N> _uInflow;
+  
+  MathTools::CFVec<CFreal,N> _uLDA;
+  
+  MathTools::CFVec<CFreal,N> _phi;
+  
+  MathTools::CFVec<CFreal,N> _phiLDA;
+  
+  MathTools::CFMat<CFreal,N,N> _tempMat;
+  
+  MathTools::LUInverterT<N> _inverterT;
+  
+}; // end of class BSchemeSysT
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FluctSplit
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "BSchemeSysT.ci"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_FluctSplit_BSchemeSysT_hh
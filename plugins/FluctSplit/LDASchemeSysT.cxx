@@ -0,0 +1,60 @@
+#include "LDASchemeSysT.hh"
+#include "Framework/MethodStrategyProvider.hh"
+#include "FluctSplit/FluctSplitSystem.hh"
+#include "FluctSplit/FluctuationSplitData.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::MathTools;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+
+
+    namespace FluctSplit {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodStrategyProvider<LDASchemeSysT<4>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+ldaSchemeSys4Provider("SysLDA4");
+
+MethodStrategyProvider<LDASchemeSysT<5>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+ldaSchemeSys5Provider("SysLDA5");
+
+MethodStrategyProvider<LDASchemeSysT<6>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+ldaSchemeSys6Provider("SysLDA6");
+
+MethodStrategyProvider<LDASchemeSysT<8>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+ldaSchemeSys8Provider("SysLDA8");
+
+MethodStrategyProvider<LDASchemeSysT<9>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+ldaSchemeSys9Provider("SysLDA9");
+
+//////////////////////////////////////////////////////////////////////////////
+
+     } // namespace FluctSplit
+
+
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
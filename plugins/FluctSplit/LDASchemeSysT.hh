@@ -0,0 +1,84 @@
+#ifndef COOLFluiD_Numerics_FluctSplit_LDASchemeSysT_hh
+#define COOLFluiD_Numerics_FluctSplit_LDASchemeSysT_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "RDS_SplitterSys.hh"
+#include "MathTools/LUInverterT.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+    namespace FluctSplit {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class represents the LDA scheme for RDS space discretization, with
+ * the number of equations N fixed at compile time
+ *
+ * @author Andrea Lani
+ *
+ */
+template <CFuint N>
+class LDASchemeSysT : public RDS_SplitterSys {
+public:
+  typedef LDASchemeSysT<N> SELF;
+  
+  /**
+   * Default constructor.
+   */
+  LDASchemeSysT(const std::string& name);
+
+  /**
+   * Default destructor
+   */
+  ~LDASchemeSysT();
+
+  /**
+   * Set up
+   */
+  virtual void setup();
+
+  /**
+   * Distribute the residual
+   */
+  void distribute(std::vector<RealVector>& residual);
+  
+  /**
+   * Compute all the contributions for the Picard jacobian
+   */
+  void computePicardJacob(std::vector<RealMatrix*>& jacob);
+  
+private:
+  
+  MathTools::CFVec<CFreal,N> _phi;
+  
+  MathTools::CFVec<CFreal,N> _uTemp;
+  
+  MathTools::CFMat<CFreal,N,N> _sumKplus;
+  
+  MathTools::CFMat<CFreal,N,N> _k;
+  
+  MathTools::CFMat<CFreal,N,N> _invK;
+  
+  MathTools::CFMat<CFreal,N,N> _beta;
+  
+  MathTools::LUInverterT<N> _inverterT;
+  
+}; // end of class LDASchemeSysT
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FluctSplit
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "LDASchemeSysT.ci"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_FluctSplit_LDASchemeSysT_hh
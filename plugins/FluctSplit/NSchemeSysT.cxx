@@ -37,12 +37,24 @@ MethodStrategyProvider<NSchemeSysT<5>,
                        FluctSplitSystemModule>
 nSchemeSys5Provider("SysN5");
 
+MethodStrategyProvider<NSchemeSysT<6>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+nSchemeSys6Provider("SysN6");
+
 MethodStrategyProvider<NSchemeSysT<8>,
 		       FluctuationSplitData,
 		       Splitter,
                        FluctSplitSystemModule>
 nSchemeSys8Provider("SysN8");
 
+MethodStrategyProvider<NSchemeSysT<9>,
+		       FluctuationSplitData,
+		       Splitter,
+                       FluctSplitSystemModule>
+nSchemeSys9Provider("SysN9");
+
 //////////////////////////////////////////////////////////////////////////////
 
      } // namespace FluctSplit
@@ -4,6 +4,7 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "RDS_SplitterSys.hh"
+#include "MathTools/LUInverterT.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -14,7 +15,9 @@ namespace COOLFluiD {
 //////////////////////////////////////////////////////////////////////////////
 
 /**
- * This class represents the N scheme for RDS space discretization
+ * This class represents the N scheme for RDS space discretization, with
+ * the number of equations N fixed at compile time, so that the K matrices
+ * are summed, inverted and multiplied with stack allocated storage
  *
  * @author Andrea Lani
  *
@@ -60,8 +63,11 @@ private:
   
   MathTools::CFMat<CFreal,N,N> _betaLDA;
   
-  RealMatrix  _sumKmin;
-  RealMatrix  _invK;
+  MathTools::CFMat<CFreal,N,N> _sumKmin;
+  
+  MathTools::CFMat<CFreal,N,N> _invK;
+  
+  MathTools::LUInverterT<N> _inverterT;
   
 }; // end of class NSchemeSysT
 
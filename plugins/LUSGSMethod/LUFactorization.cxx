@@ -48,8 +48,12 @@ void LUFactorization::execute()
   // get isStatesSetParUpdatable data handle
   DataHandle< bool > isStatesSetParUpdatable = socket_isStatesSetParUpdatable.getDataHandle();
 
-  // Loops over the states sets
-  for (CFuint iSet = 0; iSet < nbrStatesSets; ++iSet)
+  // Loops over the states sets, each one being factorized by one thread
+  const CFint nbrSets = nbrStatesSets;
+#ifdef CF_HAVE_OMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+  for (CFint iSet = 0; iSet < nbrSets; ++iSet)
   {
     if (isStatesSetParUpdatable[iSet])
     {
@@ -82,6 +82,16 @@ public:
 
    inline bool sincronizeParticles(std::vector< Particle<UserData> >&particleBuffer, bool isLastPhoton);
 
+   /// starts sending the committed particles, new particles can be tracked
+   /// and committed before finishSincronizeParticles() is called
+   inline void startSincronizeParticles(bool isLastPhoton){ m_sendBuffer.startSincronize(isLastPhoton); }
+
+   /// receives the particles sent by startSincronizeParticles()
+   /// @return true if there are no more particles to track
+   inline bool finishSincronizeParticles(std::vector< Particle<UserData> >&particleBuffer){
+     return m_sendBuffer.finishSincronize(particleBuffer);
+   }
+
    void setupParticleDatatype(MPI_Datatype ptrDatatype );
 
    inline MPI_Datatype getParticleDataType(){return m_particleDataType; }
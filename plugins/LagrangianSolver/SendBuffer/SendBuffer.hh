@@ -23,6 +23,9 @@ private:
     std::vector<int>  m_sendCounts;
     std::vector<CFint> m_sendRanks;
     std::vector<T    > m_sendBufferOrdered;
+    std::vector<T    > m_recvBuffer;
+    std::vector<MPI_Request> m_requests;
+    bool                m_isLastPhoton;
     CFuint              m_nbProcesses;
     MPI_Comm            m_comm;
     MPI_Datatype        m_MPIdatatype;
@@ -31,6 +34,12 @@ public:
     SendBuffer();
     void reserve(CFuint nCells);
     bool sincronize(std::vector<T> &recvBuffer, bool isLastPhoton);
+    /// starts sending the buffered particles, new particles can be buffered
+    /// before the exchange is completed by finishSincronize()
+    void startSincronize(bool isLastPhoton);
+    /// waits for the particles started by startSincronize()
+    /// @return true if there are no more particles anywhere
+    bool finishSincronize(std::vector<T> &recvBuffer);
     void push_back(const T &a, const CFuint &rank);
     MPI_Datatype getMPIdatatype() const{ return m_MPIdatatype; }
     void setMPIdatatype(const MPI_Datatype MPIdatatype){ m_MPIdatatype = MPIdatatype; }
@@ -40,7 +49,10 @@ template<typename T>
 SendBuffer<T>::SendBuffer():
   m_sendBuffer(),
   m_sendCounts(),
-  m_sendBufferOrdered()
+  m_sendBufferOrdered(),
+  m_recvBuffer(),
+  m_requests(),
+  m_isLastPhoton(false)
 {
     m_comm = Common::PE::GetPE().GetCommunicator();
     m_nbProcesses= Common::PE::GetPE().GetProcessorCount();
@@ -65,6 +77,13 @@ void SendBuffer<T>::push_back( const T &a, const CFuint &rank){
 
 template<typename T>
 bool SendBuffer<T>::sincronize( std::vector<T> &recvBuffer, bool isLastPhoton)
+{
+  startSincronize(isLastPhoton);
+  return finishSincronize(recvBuffer);
+}
+
+template<typename T>
+void SendBuffer<T>::startSincronize(bool isLastPhoton)
 {
   //get the number of photons to send and the displacements
   
@@ -89,7 +108,7 @@ bool SendBuffer<T>::sincronize( std::vector<T> &recvBuffer, bool isLastPhoton)
     nbPhotonsRecv += recvCounts[i];
   }
   
-  recvBuffer.resize(nbPhotonsRecv);
+  m_recvBuffer.resize(nbPhotonsRecv);
   
   //copy and organize the data into the new buffer
   //TODO: let's look for a way to do it without an extra buffer!
@@ -101,27 +120,52 @@ bool SendBuffer<T>::sincronize( std::vector<T> &recvBuffer, bool isLastPhoton)
     ++ *tempDisp;
   }
   
-  //CFLog(INFO,"Start sincronize!\n");
-  MPI_Alltoallv(&m_sendBufferOrdered[0], &m_sendCounts[0], &displacements[0],
-		m_MPIdatatype, &recvBuffer[0], &recvCounts[0],
-		&recvDisps[0], m_MPIdatatype, m_comm );
+  //post the point to point exchanges, that are completed in finishSincronize()
+  const int tag = 0;
+  m_requests.clear();
+  for(CFuint i=0; i< m_nbProcesses ; ++i ){
+    if (recvCounts[i] > 0) {
+      m_requests.push_back(MPI_Request());
+      MPI_Irecv(&m_recvBuffer[recvDisps[i]], recvCounts[i], m_MPIdatatype,
+		i, tag, m_comm, &m_requests.back());
+    }
+  }
+  for(CFuint i=0; i< m_nbProcesses ; ++i ){
+    if (m_sendCounts[i] > 0) {
+      m_requests.push_back(MPI_Request());
+      MPI_Isend(&m_sendBufferOrdered[displacements[i]], m_sendCounts[i], m_MPIdatatype,
+		i, tag, m_comm, &m_requests.back());
+    }
+  }
   
-  //CFLog(INFO,"End sincronize!\n");
-  //clear the sendbuffers
+  //clear the sendbuffers, the ordered copy is kept until the end of the exchange
   m_sendBuffer.clear();
   m_sendRanks.clear();
   for(CFuint i=0; i<m_sendCounts.size(); ++i){
     m_sendCounts[i]=0;
   }
+  m_isLastPhoton = isLastPhoton;
+}
+
+template<typename T>
+bool SendBuffer<T>::finishSincronize(std::vector<T> &recvBuffer)
+{
+  if (m_requests.size() > 0) {
+    MPI_Waitall(m_requests.size(), &m_requests[0], MPI_STATUSES_IGNORE);
+  }
+  m_requests.clear();
+  recvBuffer.swap(m_recvBuffer);
   
   //check finish condition (all buffers have zero size and all partitions have generated all photons)
+  CFuint nbPhotonsRecv = recvBuffer.size();
   CFuint totalPhotonsRecv;
-  nbPhotonsRecv += (isLastPhoton)? 0 : 1 ;
+  nbPhotonsRecv += (m_isLastPhoton)? 0 : 1 ;
   
   MPI_Allreduce(&nbPhotonsRecv, &totalPhotonsRecv, 1, 
 		Common::MPIStructDef::getMPIType(&nbPhotonsRecv), MPI_SUM, m_comm);
   return (totalPhotonsRecv == 0);
-}  
+}
+  
   
 }
   
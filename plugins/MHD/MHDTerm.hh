@@ -34,7 +34,6 @@ public:
    */
   enum PotentialBType {NONE=0, DIPOLE=1, PFSS=2};
   
-#ifdef CF_HAVE_CUDA
   /// nested class defining local options
   template <typename P = NOTYPE>
   class DeviceConfigOptions {
@@ -75,6 +74,7 @@ public:
     CFreal mZ;
   };
   
+#ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the Framework::DEVICE
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
@@ -85,6 +85,7 @@ public:
     CudaEnv::copyHost2Dev(&dco->mY, &_mY, 1);
     CudaEnv::copyHost2Dev(&dco->mZ, &_mZ, 1);
   }  
+#endif
   
   /// copy the local configuration options to the Framework::DEVICE
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
@@ -96,7 +97,6 @@ public:
     dco->mY = _mY;
     dco->mZ = _mZ;
   }     
-#endif
   
   /**
    * Defines the Config Option's of this class
@@ -15,18 +15,18 @@
 
 namespace COOLFluiD {
       
-  namespace Framework {
-    class TRSDistributeData;
-  }
-  
   namespace MeshTools {
       
+    class WallFaceTree;
+      
 //////////////////////////////////////////////////////////////////////////////
 
 /**
  *
  * This class computes the distance from the states to the wall
- * and outputs to a file
+ * and outputs to a file.
+ * The wall faces of all the processors are gathered in a bounding volume
+ * hierarchy which gives the exact distance to the closest face.
  *
  * @author Andrea Lani
  * @author Thomas Wuilbaut
@@ -35,6 +35,12 @@ namespace COOLFluiD {
 class ComputeWallDistanceVector2CCMPI : public ComputeWallDistance {
 public:
 
+  /**
+   * Defines the Config Option's of this class
+   * @param options a OptionList where to add the Option's
+   */
+  static void defineConfigOptions(Config::OptionList& options);
+
   /**
    * Constructor.
    */
@@ -65,24 +71,18 @@ public:
 private:
   
   /**
-   * Execute on a set of dofs
-   */
-  void execute2D();
-
-  /**
-   * Execute on a set of dofs
-   */
-  void execute3D();
-  
-  /**
-   * Compute the wall distance (more complex but more accurate)
+   * Gathers the coordinates of the nodes of the wall faces of all the
+   * processors, or of their centroids
+   * @param faceNodes      coordinates of the nodes, one face after the other
+   * @param nbNodesInFace  number of nodes in each face
    */
-  void computeWallDistance2D(Framework::TRSDistributeData& data);
+  void gatherWallFaces(std::vector<CFreal>& faceNodes,
+		       std::vector<CFuint>& nbNodesInFace);
   
   /**
-   * Compute the wall distance
+   * Compute the wall distance of all the local states
    */
-  void computeWallDistance3D(std::vector<CFreal>& data);
+  void computeWallDistance(const WallFaceTree& wallFaces);
   
 private:
   
@@ -121,6 +121,9 @@ private:
   /// number for processors
   CFuint m_nbProc;
   
+  /// flag telling to compute the distance to the face centroids
+  bool m_useCentroids;
+  
 }; // end of class ComputeWallDistanceVector2CCMPI
 
 //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,281 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the wall face tree of the wall distance"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+
+#include "MathTools/MathConsts.hh"
+#include "MeshTools/WallFaceTree.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::MeshTools;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct WallFaceTreeFixture
+{
+  WallFaceTreeFixture() : seed(12345), dim(DIM_2D) {}
+
+  /// Deterministic pseudo-random number in [0, 1)
+  CFreal random()
+  {
+    seed = (seed*1103515245u + 12345u) % 2147483648u;
+    return seed/2147483648.;
+  }
+
+  /// Adds a face with the given nodes
+  void addFace(const CFuint nbNodes, const CFreal* coord)
+  {
+    faceNodes.insert(faceNodes.end(), coord, coord + nbNodes*dim);
+    nbNodesInFace.push_back(nbNodes);
+  }
+
+  /// Segments along a wavy curve, with a few points, duplicated segments
+  /// and P2 faces, whose middle node is ignored
+  void makeCurve()
+  {
+    dim = DIM_2D;
+    const CFuint nbSegments = 400;
+    vector<CFreal> nodes(2*(nbSegments + 1));
+    for (CFuint i = 0; i <= nbSegments; ++i) {
+      const CFreal x = static_cast<CFreal>(i)/nbSegments;
+      nodes[2*i]     = x;
+      nodes[2*i + 1] = 0.2*std::sin(20.*x) + 0.01*random();
+    }
+    for (CFuint i = 0; i < nbSegments; ++i) {
+      const CFreal* a = &nodes[2*i];
+      if (i % 53 == 0) {
+	const CFreal p2[6] = {a[0], a[1], a[2], a[3], a[0] + 0.5, a[1] + 0.5};
+	addFace(3, p2);
+	continue;
+      }
+      addFace(2, a);
+      if (i % 97 == 0) addFace(2, a);
+      if (i % 131 == 0) addFace(1, a);
+    }
+  }
+
+  /// Triangles and quadrilaterals on a bumpy surface, with a few
+  /// degenerate triangles, segments and points
+  void makeSurface()
+  {
+    dim = DIM_3D;
+    const CFuint n = 30;
+    vector<CFreal> nodes(3*(n + 1)*(n + 1));
+    for (CFuint j = 0; j <= n; ++j) {
+      for (CFuint i = 0; i <= n; ++i) {
+	CFreal* x = &nodes[3*(j*(n + 1) + i)];
+	x[0] = static_cast<CFreal>(i)/n;
+	x[1] = static_cast<CFreal>(j)/n;
+	x[2] = 0.1*std::sin(7.*x[0])*std::cos(5.*x[1]) + 0.005*random();
+      }
+    }
+    for (CFuint j = 0; j < n; ++j) {
+      for (CFuint i = 0; i < n; ++i) {
+	const CFreal* c[4] = {&nodes[3*(j*(n + 1) + i)], &nodes[3*(j*(n + 1) + i + 1)],
+			      &nodes[3*((j + 1)*(n + 1) + i + 1)], &nodes[3*((j + 1)*(n + 1) + i)]};
+	CFreal coord[12];
+	if ((i + j) % 2 == 0) {
+	  for (CFuint v = 0; v < 4; ++v) std::copy(c[v], c[v] + 3, coord + 3*v);
+	  addFace(4, coord);
+	}
+	else {
+	  for (CFuint v = 0; v < 3; ++v) std::copy(c[v], c[v] + 3, coord + 3*v);
+	  addFace(3, coord);
+	  for (CFuint v = 0; v < 3; ++v) std::copy(c[(v + 2) % 4], c[(v + 2) % 4] + 3, coord + 3*v);
+	  addFace(3, coord);
+	}
+	if ((i*n + j) % 41 == 0) {
+	  // triangle with a repeated node and one with aligned nodes
+	  for (CFuint v = 0; v < 3; ++v) std::copy(c[v/2], c[v/2] + 3, coord + 3*v);
+	  addFace(3, coord);
+	  for (CFuint v = 0; v < 3; ++v) coord[3 + v] = 0.5*(c[0][v] + c[1][v]);
+	  std::copy(c[1], c[1] + 3, coord + 6);
+	  addFace(3, coord);
+	}
+	if ((i*n + j) % 67 == 0) {
+	  addFace(2, c[1]);
+	  addFace(1, c[2]);
+	}
+      }
+    }
+  }
+
+  /// Distance from the point to the segment
+  static CFreal segmentDistance(const CFreal* p, const CFreal* a, const CFreal* b)
+  {
+    CFreal ab2 = 0.;
+    CFreal abap = 0.;
+    for (CFuint i = 0; i < 3; ++i) {
+      ab2  += (b[i] - a[i])*(b[i] - a[i]);
+      abap += (b[i] - a[i])*(p[i] - a[i]);
+    }
+    const CFreal t = (ab2 > 0.) ? std::min(std::max(abap/ab2, 0.), 1.) : 0.;
+    CFreal d2 = 0.;
+    for (CFuint i = 0; i < 3; ++i) {
+      const CFreal d = a[i] + t*(b[i] - a[i]) - p[i];
+      d2 += d*d;
+    }
+    return std::sqrt(d2);
+  }
+
+  /// Distance from the point to the triangle: to its plane when the
+  /// projection falls inside, otherwise to its closest edge
+  static CFreal triangleDistance(const CFreal* p, const CFreal* a, const CFreal* b, const CFreal* c)
+  {
+    CFreal dist = std::min(segmentDistance(p, a, b),
+			   std::min(segmentDistance(p, b, c), segmentDistance(p, c, a)));
+
+    const CFreal u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const CFreal v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    const CFreal w[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+    const CFreal n[3] = {u[1]*v[2] - u[2]*v[1], u[2]*v[0] - u[0]*v[2], u[0]*v[1] - u[1]*v[0]};
+    const CFreal n2 = n[0]*n[0] + n[1]*n[1] + n[2]*n[2];
+    const CFreal uu = u[0]*u[0] + u[1]*u[1] + u[2]*u[2];
+    const CFreal vv = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
+    // the plane of a degenerate triangle is meaningless, its edges suffice
+    if (n2 > 1e-12*uu*vv) {
+      // barycentric coordinates of the projection
+      const CFreal uv = u[0]*v[0] + u[1]*v[1] + u[2]*v[2];
+      const CFreal wu = w[0]*u[0] + w[1]*u[1] + w[2]*u[2];
+      const CFreal wv = w[0]*v[0] + w[1]*v[1] + w[2]*v[2];
+      const CFreal det = uu*vv - uv*uv;
+      const CFreal s = (vv*wu - uv*wv)/det;
+      const CFreal t = (uu*wv - uv*wu)/det;
+      if (s >= 0. && t >= 0. && s + t <= 1.) {
+	dist = std::min(dist, std::fabs(w[0]*n[0] + w[1]*n[1] + w[2]*n[2])/std::sqrt(n2));
+      }
+    }
+    return dist;
+  }
+
+  /// Distance from the point to the closest face, looping over all of them
+  CFreal bruteForceDistance(const CFreal* point) const
+  {
+    const CFreal p[3] = {point[0], point[1], (dim == DIM_3D) ? point[2] : 0.};
+    CFreal minDist = MathTools::MathConsts::CFrealMax();
+    CFuint start = 0;
+    for (CFuint iFace = 0; iFace < nbNodesInFace.size(); ++iFace) {
+      const CFuint nbNodes = nbNodesInFace[iFace];
+      // corner nodes in 3D, padded with a zero coordinate in 2D
+      CFreal x[4][3];
+      for (CFuint iNode = 0; iNode < std::min<CFuint>(nbNodes, 4); ++iNode) {
+	for (CFuint i = 0; i < 3; ++i) {
+	  x[iNode][i] = (i < dim) ? faceNodes[(start + iNode)*dim + i] : 0.;
+	}
+      }
+      CFreal dist;
+      if (nbNodes == 1) {
+	dist = segmentDistance(p, x[0], x[0]);
+      }
+      else if (nbNodes == 2 || dim == DIM_2D) {
+	dist = segmentDistance(p, x[0], x[1]);
+      }
+      else {
+	dist = triangleDistance(p, x[0], x[1], x[2]);
+	if (nbNodes == 4) {
+	  dist = std::min(dist, triangleDistance(p, x[0], x[2], x[3]));
+	}
+      }
+      minDist = std::min(minDist, dist);
+      start += nbNodes;
+    }
+    return minDist;
+  }
+
+  /// Checks the distance computed by the tree against the brute force one
+  /// for random points around the faces
+  void checkAgainstBruteForce(const WallFaceTree& tree)
+  {
+    CFuint nbWrong = 0;
+    CFreal maxError = 0.;
+    for (CFuint i = 0; i < 2000; ++i) {
+      const CFreal p[3] = {1.4*random() - 0.2, 1.4*random() - 0.7, 0.6*random() - 0.3};
+      const CFreal exact = bruteForceDistance(p);
+      const CFreal error = std::fabs(tree.getDistance(p) - exact);
+      maxError = std::max(maxError, error);
+      if (error > 1e-12*(1. + exact)) ++nbWrong;
+    }
+    BOOST_CHECK_EQUAL(nbWrong, 0u);
+    BOOST_CHECK_SMALL(maxError, 1e-12);
+  }
+
+  unsigned long seed;
+  CFuint dim;
+  vector<CFreal> faceNodes;
+  vector<CFuint> nbNodesInFace;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( WallFaceTreeSuite, WallFaceTreeFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( EmptyTree )
+{
+  WallFaceTree tree;
+  tree.build(DIM_3D, faceNodes, nbNodesInFace);
+  const CFreal p[3] = {0., 0., 0.};
+  BOOST_CHECK_EQUAL(tree.getNbPrimitives(), 0u);
+  BOOST_CHECK_EQUAL(tree.getDistance(p), MathTools::MathConsts::CFrealMax());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( SegmentsMatchBruteForce )
+{
+  makeCurve();
+  WallFaceTree tree;
+  tree.build(dim, faceNodes, nbNodesInFace);
+  BOOST_CHECK_EQUAL(tree.getNbPrimitives(), nbNodesInFace.size());
+  checkAgainstBruteForce(tree);
+
+  // on the faces the distance vanishes
+  const CFreal* a = &faceNodes[0];
+  BOOST_CHECK_SMALL(tree.getDistance(a), 1e-14);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( PolygonsMatchBruteForce )
+{
+  makeSurface();
+  WallFaceTree tree;
+  tree.build(dim, faceNodes, nbNodesInFace);
+
+  // quadrilaterals are split in two triangles
+  CFuint nbPrims = 0;
+  for (CFuint iFace = 0; iFace < nbNodesInFace.size(); ++iFace) {
+    nbPrims += (nbNodesInFace[iFace] == 4) ? 2 : 1;
+  }
+  BOOST_CHECK_EQUAL(tree.getNbPrimitives(), nbPrims);
+  checkAgainstBruteForce(tree);
+
+  // rebuilding the tree with other faces forgets the previous ones
+  faceNodes.resize(3);
+  nbNodesInFace.assign(1, 1);
+  tree.build(dim, faceNodes, nbNodesInFace);
+  const CFreal p[3] = {faceNodes[0], faceNodes[1], faceNodes[2] + 2.};
+  BOOST_CHECK_EQUAL(tree.getNbPrimitives(), 1u);
+  BOOST_CHECK_CLOSE(tree.getDistance(p), 2., 1e-12);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,340 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <cmath>
+
+#include "MathTools/MathConsts.hh"
+#include "MeshTools/WallFaceTree.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace MeshTools {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// maximum number of primitives in a leaf
+static const CFuint MAX_LEAF_SIZE = 4;
+
+/// maximum depth of the traversal stack
+static const CFuint MAX_STACK_SIZE = 128;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Orders the primitives along one axis by their centroid
+struct CentroidLess {
+  CentroidLess(const vector<CFreal>& c, const CFuint a) : centroids(c), axis(a) {}
+  bool operator() (const CFuint p1, const CFuint p2) const
+  {
+    return centroids[p1*3 + axis] < centroids[p2*3 + axis];
+  }
+  const vector<CFreal>& centroids;
+  const CFuint axis;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+static inline CFreal dot(const CFreal* a, const CFreal* b)
+{
+  return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static inline CFreal distance2(const CFreal* a, const CFreal* b)
+{
+  const CFreal d[3] = {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+  return dot(d, d);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static inline CFreal segmentDistance2(const CFreal* p, const CFreal* a, const CFreal* b)
+{
+  // projection on the segment, clamped to its end points
+  const CFreal ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  const CFreal ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+  const CFreal ab2 = dot(ab, ab);
+  const CFreal t = (ab2 > 0.) ? std::max(0., std::min(1., dot(ab, ap)/ab2)) : 0.;
+  const CFreal q[3] = {a[0] + t*ab[0], a[1] + t*ab[1], a[2] + t*ab[2]};
+  return distance2(p, q);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+WallFaceTree::WallFaceTree() :
+  Common::NonCopyable<WallFaceTree>(),
+  m_dim(DIM_3D),
+  m_nodes(),
+  m_vertices(),
+  m_nbVertices(),
+  m_primIDs(),
+  m_centroids()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+WallFaceTree::~WallFaceTree()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void WallFaceTree::build(const CFuint dim,
+                         const vector<CFreal>& faceNodes,
+                         const vector<CFuint>& nbNodesInFace)
+{
+  cf_assert(dim == DIM_2D || dim == DIM_3D);
+
+  m_dim = dim;
+  m_nodes.clear();
+  m_vertices.clear();
+  m_nbVertices.clear();
+
+  // split the faces in primitives with up to three vertices, stored in 3D
+  CFuint start = 0;
+  for (CFuint iFace = 0; iFace < nbNodesInFace.size(); ++iFace) {
+    const CFuint nbNodes = nbNodesInFace[iFace];
+    cf_assert(nbNodes > 0);
+    const CFreal* coord = &faceNodes[start*dim];
+
+    // in 2D only the end nodes of the face are used, in 3D the corners
+    const CFuint nbCorners = (nbNodes < 3 || dim == DIM_2D) ? std::min<CFuint>(nbNodes, 2) :
+      ((nbNodes == 4 || nbNodes == 8 || nbNodes == 9) ? 4 : 3);
+    const CFuint nbPrims = (nbCorners < 3) ? 1 : nbCorners - 2;
+    for (CFuint iPrim = 0; iPrim < nbPrims; ++iPrim) {
+      const CFuint nbVertices = std::min<CFuint>(nbCorners, 3);
+      // triangles share the first corner of the polygon
+      const CFuint corners[3] = {0, iPrim + 1, iPrim + 2};
+      for (CFuint v = 0; v < 3; ++v) {
+        const CFreal* x = coord + corners[std::min(v, nbVertices - 1)]*dim;
+        m_vertices.push_back(x[0]);
+        m_vertices.push_back(x[1]);
+        m_vertices.push_back((dim == DIM_3D) ? x[2] : 0.);
+      }
+      m_nbVertices.push_back(nbVertices);
+    }
+    start += nbNodes;
+  }
+  cf_assert(start*dim == faceNodes.size());
+
+  const CFuint nbPrims = m_nbVertices.size();
+  m_centroids.resize(nbPrims*3);
+  m_primIDs.resize(nbPrims);
+  for (CFuint iPrim = 0; iPrim < nbPrims; ++iPrim) {
+    m_primIDs[iPrim] = iPrim;
+    const CFreal* v = &m_vertices[iPrim*9];
+    for (CFuint i = 0; i < 3; ++i) {
+      m_centroids[iPrim*3 + i] = (v[i] + v[3 + i] + v[6 + i])/3.;
+    }
+  }
+
+  if (nbPrims > 0) {
+    m_nodes.reserve(2*nbPrims/MAX_LEAF_SIZE + 1);
+    buildNode(0, nbPrims);
+  }
+
+  vector<CFreal>().swap(m_centroids);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint WallFaceTree::buildNode(const CFuint begin, const CFuint end)
+{
+  const CFuint iNode = m_nodes.size();
+  m_nodes.push_back(TreeNode());
+
+  // bounding box of the primitives and of their centroids
+  CFreal bmin[3], bmax[3], cmin[3], cmax[3];
+  for (CFuint i = 0; i < 3; ++i) {
+    bmin[i] = cmin[i] = MathTools::MathConsts::CFrealMax();
+    bmax[i] = cmax[i] = -MathTools::MathConsts::CFrealMax();
+  }
+  for (CFuint p = begin; p < end; ++p) {
+    const CFuint iPrim = m_primIDs[p];
+    const CFreal* v = &m_vertices[iPrim*9];
+    for (CFuint i = 0; i < 3; ++i) {
+      bmin[i] = std::min(bmin[i], std::min(v[i], std::min(v[3 + i], v[6 + i])));
+      bmax[i] = std::max(bmax[i], std::max(v[i], std::max(v[3 + i], v[6 + i])));
+      cmin[i] = std::min(cmin[i], m_centroids[iPrim*3 + i]);
+      cmax[i] = std::max(cmax[i], m_centroids[iPrim*3 + i]);
+    }
+  }
+  for (CFuint i = 0; i < 3; ++i) {
+    m_nodes[iNode].bmin[i] = bmin[i];
+    m_nodes[iNode].bmax[i] = bmax[i];
+  }
+
+  if (end - begin <= MAX_LEAF_SIZE) {
+    m_nodes[iNode].start = begin;
+    m_nodes[iNode].count = end - begin;
+    return iNode;
+  }
+
+  // split at the median along the largest extent of the centroids
+  CFuint axis = 0;
+  for (CFuint i = 1; i < 3; ++i) {
+    if (cmax[i] - cmin[i] > cmax[axis] - cmin[axis]) axis = i;
+  }
+  const CFuint middle = begin + (end - begin)/2;
+  std::nth_element(m_primIDs.begin() + begin, m_primIDs.begin() + middle,
+                   m_primIDs.begin() + end, CentroidLess(m_centroids, axis));
+
+  buildNode(begin, middle);
+  const CFuint right = buildNode(middle, end);
+  m_nodes[iNode].start = right;
+  m_nodes[iNode].count = 0;
+  return iNode;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal WallFaceTree::getDistance(const CFreal* point) const
+{
+  CFreal best2 = MathTools::MathConsts::CFrealMax();
+  if (m_nodes.empty()) return best2;
+
+  const CFreal p[3] = {point[0], point[1], (m_dim == DIM_3D) ? point[2] : 0.};
+
+  // depth first traversal, visiting the closest child first and skipping
+  // the boxes farther than the closest face found so far
+  CFuint stack[MAX_STACK_SIZE];
+  CFreal stackDist2[MAX_STACK_SIZE];
+  CFuint top = 0;
+  stack[top] = 0;
+  stackDist2[top++] = getBoxDistance2(0, p);
+
+  while (top > 0) {
+    --top;
+    if (stackDist2[top] >= best2) continue;
+    const TreeNode& node = m_nodes[stack[top]];
+
+    if (node.count > 0) {
+      for (CFuint i = node.start; i < node.start + node.count; ++i) {
+        best2 = std::min(best2, getPrimitiveDistance2(m_primIDs[i], p));
+      }
+    }
+    else {
+      const CFuint left = stack[top] + 1;
+      const CFuint right = node.start;
+      const CFreal dLeft = getBoxDistance2(left, p);
+      const CFreal dRight = getBoxDistance2(right, p);
+      cf_assert(top + 2 <= MAX_STACK_SIZE);
+      // the closest child is pushed last to be visited first
+      if (dLeft < dRight) {
+        stack[top] = right; stackDist2[top++] = dRight;
+        stack[top] = left;  stackDist2[top++] = dLeft;
+      }
+      else {
+        stack[top] = left;  stackDist2[top++] = dLeft;
+        stack[top] = right; stackDist2[top++] = dRight;
+      }
+    }
+  }
+
+  return std::sqrt(best2);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal WallFaceTree::getBoxDistance2(const CFuint iNode, const CFreal* p) const
+{
+  const TreeNode& node = m_nodes[iNode];
+  CFreal d2 = 0.;
+  for (CFuint i = 0; i < 3; ++i) {
+    const CFreal d = std::max(node.bmin[i] - p[i], std::max(0., p[i] - node.bmax[i]));
+    d2 += d*d;
+  }
+  return d2;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal WallFaceTree::getPrimitiveDistance2(const CFuint iPrim, const CFreal* p) const
+{
+  const CFreal* a = &m_vertices[iPrim*9];
+  const CFreal* b = a + 3;
+  const CFreal* c = a + 6;
+  const CFuint nbVertices = m_nbVertices[iPrim];
+
+  if (nbVertices == 1) {
+    return distance2(p, a);
+  }
+
+  if (nbVertices == 2) {
+    return segmentDistance2(p, a, b);
+  }
+
+  const CFreal ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  const CFreal ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+  const CFreal d1 = dot(ab, ap);
+
+  // closest point on the triangle, found from the Voronoi region of p
+  // (C. Ericson, Real-Time Collision Detection, 2005)
+  const CFreal ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+  const CFreal d2 = dot(ac, ap);
+  if (d1 <= 0. && d2 <= 0.) return distance2(p, a);
+
+  const CFreal bp[3] = {p[0] - b[0], p[1] - b[1], p[2] - b[2]};
+  const CFreal d3 = dot(ab, bp);
+  const CFreal d4 = dot(ac, bp);
+  if (d3 >= 0. && d4 <= d3) return distance2(p, b);
+
+  const CFreal vc = d1*d4 - d3*d2;
+  if (vc <= 0. && d1 >= 0. && d3 <= 0.) {
+    const CFreal t = d1/(d1 - d3);
+    const CFreal q[3] = {a[0] + t*ab[0], a[1] + t*ab[1], a[2] + t*ab[2]};
+    return distance2(p, q);
+  }
+
+  const CFreal cp[3] = {p[0] - c[0], p[1] - c[1], p[2] - c[2]};
+  const CFreal d5 = dot(ab, cp);
+  const CFreal d6 = dot(ac, cp);
+  if (d6 >= 0. && d5 <= d6) return distance2(p, c);
+
+  const CFreal vb = d5*d2 - d1*d6;
+  if (vb <= 0. && d2 >= 0. && d6 <= 0.) {
+    const CFreal t = d2/(d2 - d6);
+    const CFreal q[3] = {a[0] + t*ac[0], a[1] + t*ac[1], a[2] + t*ac[2]};
+    return distance2(p, q);
+  }
+
+  const CFreal va = d3*d6 - d5*d4;
+  if (va <= 0. && (d4 - d3) >= 0. && (d5 - d6) >= 0.) {
+    const CFreal t = (d4 - d3)/((d4 - d3) + (d5 - d6));
+    const CFreal q[3] = {b[0] + t*(c[0] - b[0]), b[1] + t*(c[1] - b[1]), b[2] + t*(c[2] - b[2])};
+    return distance2(p, q);
+  }
+
+  const CFreal sum = va + vb + vc;
+  if (!(sum > 0.)) {
+    // degenerate triangle, the closest point is on one of its edges
+    return std::min(segmentDistance2(p, a, b),
+                    std::min(segmentDistance2(p, b, c), segmentDistance2(p, a, c)));
+  }
+
+  const CFreal v = vb/sum;
+  const CFreal w = vc/sum;
+  const CFreal q[3] = {a[0] + ab[0]*v + ac[0]*w,
+                       a[1] + ab[1]*v + ac[1]*w,
+                       a[2] + ab[2]*v + ac[2]*w};
+  return distance2(p, q);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace MeshTools
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,132 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_MeshTools_WallFaceTree_hh
+#define COOLFluiD_MeshTools_WallFaceTree_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+#include "Common/NonCopyable.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace MeshTools {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ *
+ * This class stores a set of wall faces in a bounding volume hierarchy
+ * to compute the exact distance from a point to the closest face,
+ * visiting only the boxes that can contain a closer face.
+ * Faces with one node are points, faces with two nodes are segments and
+ * faces with more nodes are polygons split in triangles, of which only the
+ * corner nodes, listed first, are used.
+ * The queries do not modify the tree and can be run concurrently.
+ *
+ * @author Thomas Wuilbaut
+ *
+ */
+class WallFaceTree : public Common::NonCopyable<WallFaceTree> {
+public:
+
+  /**
+   * Constructor.
+   */
+  WallFaceTree();
+
+  /**
+   * Default destructor
+   */
+  ~WallFaceTree();
+
+  /**
+   * Builds the tree
+   * @param dim            space dimension (2 or 3)
+   * @param faceNodes      coordinates of the nodes of all the faces, one face after the other
+   * @param nbNodesInFace  number of nodes in each face
+   */
+  void build(const CFuint dim,
+             const std::vector<CFreal>& faceNodes,
+             const std::vector<CFuint>& nbNodesInFace);
+
+  /**
+   * Gets the distance from the given point to the closest face
+   * (CFrealMax if there are no faces)
+   */
+  CFreal getDistance(const CFreal* point) const;
+
+  /**
+   * Gets the number of primitives (points, segments and triangles)
+   */
+  CFuint getNbPrimitives() const {return m_nbVertices.size();}
+
+private: // helper functions
+
+  /**
+   * Builds the subtree of the primitives [begin, end) and returns its index
+   */
+  CFuint buildNode(const CFuint begin, const CFuint end);
+
+  /**
+   * Gets the squared distance from the point to the box of a node
+   */
+  CFreal getBoxDistance2(const CFuint iNode, const CFreal* p) const;
+
+  /**
+   * Gets the squared distance from the point to the given primitive
+   */
+  CFreal getPrimitiveDistance2(const CFuint iPrim, const CFreal* p) const;
+
+private: // data
+
+  /// space dimension
+  CFuint m_dim;
+
+  /// node of the hierarchy
+  struct TreeNode {
+    /// lower corner of the bounding box
+    CFreal bmin[3];
+    /// upper corner of the bounding box
+    CFreal bmax[3];
+    /// first primitive of a leaf, or index of the second child
+    /// (the first one follows its parent)
+    CFuint start;
+    /// number of primitives of a leaf, 0 for an inner node
+    CFuint count;
+  };
+
+  /// nodes of the hierarchy, the root being the first one
+  std::vector<TreeNode> m_nodes;
+
+  /// vertex coordinates of each primitive, 3 vertices with 3 coordinates
+  std::vector<CFreal> m_vertices;
+
+  /// number of vertices of each primitive
+  std::vector<CFuint> m_nbVertices;
+
+  /// primitives sorted by tree leaf
+  std::vector<CFuint> m_primIDs;
+
+  /// centroid of each primitive, used while building the tree
+  std::vector<CFreal> m_centroids;
+
+}; // end of class WallFaceTree
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace MeshTools
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_MeshTools_WallFaceTree_hh
@@ -6,6 +6,7 @@
 #include "Environment/CFEnv.hh"
 #include "Common/OSystem.hh"
 #include "Common/BadValueException.hh"
+#include "Common/FilesystemException.hh"
 #include "Environment/DirPaths.hh"
 #include "Common/Stopwatch.hh"
 #include "Common/PE.hh"
@@ -405,13 +406,21 @@ void MutationLibrary::defineConfigOptions(Config::OptionList& options)
     Config::DynamicOption<> >("FactorOmega","Factor to reduce stiffness of chemical sorce terms.");
   options.addConfigOption< CFdouble >("GammaN","Factor of Catalycity of N.");
   options.addConfigOption< CFdouble >("GammaO","Factor of Catalycity of O.");
+  options.addConfigOption< CFdouble >
+    ("lookUpTolerance","Interpolation error allowed in the look up table (relative to the range of each quantity).");
+  options.addConfigOption< CFuint >
+    ("lookUpMaxLevels","Maximum number of refinements of the initial look up table (Tmin, Tmax, deltaT, Pmin, Pmax, deltaP), 0 to keep it as it is.");
+  options.addConfigOption< bool >("lookUpLogP","Flag telling to interpolate the look up table in log(p).");
+  options.addConfigOption< std::string >
+    ("lookUpFile","File where the look up table is saved, and read back if it exists.");
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
 MutationLibrary::MutationLibrary(const std::string& name)
   : PhysicalChemicalLibrary(name),
-    _nameToIdxVar(),
+    _lkpVarIdx(NB_LKP_VARS, -1),
+    _lkpValues(),
     _lookUpTables()
 {
   addConfigOptionsTo(this);
@@ -455,6 +464,18 @@ MutationLibrary::MutationLibrary(const std::string& name)
 
   _deltaP = 1000.0;
   setParameter("deltaP",&_deltaP);
+  
+  _lkpTolerance = 1e-4;
+  setParameter("lookUpTolerance",&_lkpTolerance);
+  
+  _lkpMaxLevels = 4;
+  setParameter("lookUpMaxLevels",&_lkpMaxLevels);
+  
+  _lkpLogP = false;
+  setParameter("lookUpLogP",&_lkpLogP);
+  
+  _lkpFileName = "";
+  setParameter("lookUpFile",&_lkpFileName);
   // IT DOESN t work with SONINE =2 The problem is somewhere inside
   // CORRECTION
   // _sonine = 2;
@@ -536,6 +557,13 @@ void MutationLibrary::setup()
   else {
     setLibrarySequentially();
   }
+
+  // the tables are filled once the library is completely set up, out of the
+  // sequential section since the processes wait for the one writing the file
+  if (_lkpVarNames.size() > 0) {
+    setLookUpTables();
+    _useLookUpTable = true;
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -674,11 +702,6 @@ void MutationLibrary:: setLibrarySequentially()
 
   PhysicalChemicalLibrary::setup();
 
-  if (_lkpVarNames.size() > 0) {
-    setLookUpTables();
-    _useLookUpTable = true;
-  }
-
   // set the species molar masses
   FORTRAN_NAME(setspeciesmolarmass)(WR1, &LWR1, MOLARMASSP);
 
@@ -716,7 +739,7 @@ void MutationLibrary:: setLibrarySequentially()
   
   // set the flag telling if the mixture is ionized
   _hasElectrons = (NE == 1) ? true : false;
- 
+  
   std::string command2 = "rm -fr data/ mutation.in";
   Common::OSystem::getInstance().executeCommand(command2);
 
@@ -1416,7 +1439,7 @@ CFdouble MutationLibrary::soundSpeed(CFdouble& temp,
     return sqrt(gamma/drhodp);
   }
   else {
-    return _lookUpTables.get(temp, pressure, _nameToIdxVar.find("a"));
+    return _lookUpTables.get(temp, pressure, getLookUpIdx(LKP_A));
   }
 }
 
@@ -1495,9 +1518,11 @@ void MutationLibrary::setDensityEnthalpyEnergy(CFdouble& temp,
     dhe[2] /= MMass;
   }
   else {
-    dhe[0] = _lookUpTables.get(temp, pressure, _nameToIdxVar.find("d"));
-    dhe[1] = _lookUpTables.get(temp, pressure, _nameToIdxVar.find("h"));
-    dhe[2] = _lookUpTables.get(temp, pressure, _nameToIdxVar.find("e"));
+    // all the tabulated quantities are interpolated at once
+    _lookUpTables.get(temp, pressure, &_lkpValues[0]);
+    dhe[0] = _lkpValues[getLookUpIdx(LKP_D)];
+    dhe[1] = _lkpValues[getLookUpIdx(LKP_H)];
+    dhe[2] = _lkpValues[getLookUpIdx(LKP_E)];
   }
 }
 
@@ -1683,7 +1708,7 @@ CFdouble MutationLibrary::density(CFdouble& temp,
     FORTRAN_NAME(density)(WR1,&LWR1,X,&ND,&rho);
     return rho;
   }
-  return _lookUpTables.get(temp, pressure, _nameToIdxVar.find("d"));
+  return _lookUpTables.get(temp, pressure, getLookUpIdx(LKP_D));
 }
 //////////////////////////////////////////////////////////////////////////////
 
@@ -1757,7 +1782,7 @@ CFdouble MutationLibrary::energy(CFdouble& temp,
     return intEnergy /= MMass;
   }
   else {
-    return _lookUpTables.get(temp, pressure, _nameToIdxVar.find("e"));
+    return _lookUpTables.get(temp, pressure, getLookUpIdx(LKP_E));
   }
 }
 
@@ -1787,7 +1812,7 @@ CFdouble MutationLibrary::enthalpy(CFdouble& temp,
     return h /= MMass;
   }
   else {
-    return _lookUpTables.get(temp, pressure, _nameToIdxVar.find("e"));
+    return _lookUpTables.get(temp, pressure, getLookUpIdx(LKP_H));
   }
 }
 
@@ -2454,31 +2479,69 @@ void MutationLibrary::getSpeciesTotEnthalpies(CFdouble& temp,
 
 //////////////////////////////////////////////////////////////////////////////
 
+/// Computes the tabulated quantities in chemical equilibrium
+class MutationLibrary::TableSampler : public Common::AdaptiveLookupTable2D::Sampler {
+public:
+
+  TableSampler(MutationLibrary* library,
+	       const vector<MutationLibrary::ComputeQuantity>& varComputeVec) :
+    m_library(library), m_varComputeVec(varComputeVec)
+  {
+  }
+  
+  void compute(CFreal x, CFreal y, CFreal* values)
+  {
+    CFdouble temp = x;
+    CFdouble pressure = y;
+    // set the composition at first
+    m_library->setComposition(temp, pressure, CFNULL);
+    for (CFuint iVar = 0; iVar < m_varComputeVec.size(); ++iVar) {
+      values[iVar] = (m_library->*m_varComputeVec[iVar])(temp, pressure);
+    }
+  }
+  
+private:
+  
+  /// library computing the quantities
+  MutationLibrary* m_library;
+  
+  /// pointers to the member functions computing each quantity
+  const vector<MutationLibrary::ComputeQuantity>& m_varComputeVec;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
 void MutationLibrary::setLookUpTables()
 {
   vector<ComputeQuantity> varComputeVec;
   varComputeVec.reserve(_lkpVarNames.size());
-
+  
   // store the pointers to member functions for
   // computing physical quantities
+  _lkpVarIdx.assign(NB_LKP_VARS, -1);
   for (CFuint i = 0; i < _lkpVarNames.size(); ++i) {
 
     if (_lkpVarNames[i] == "e") {
       varComputeVec.push_back(&MutationLibrary::energy);
+      _lkpVarIdx[LKP_E] = i;
     }
     else if (_lkpVarNames[i] == "h") {
       varComputeVec.push_back(&MutationLibrary::enthalpy);
+      _lkpVarIdx[LKP_H] = i;
     }
     else if (_lkpVarNames[i] == "a") {
       varComputeVec.push_back(&MutationLibrary::soundSpeed);
+      _lkpVarIdx[LKP_A] = i;
     }
     else if (_lkpVarNames[i] == "d") {
       varComputeVec.push_back(&MutationLibrary::density);
+      _lkpVarIdx[LKP_D] = i;
     }
     else {
       throw Common::NoSuchValueException (FromHere(), "Variable name not found");
     }
   }
+  _lkpValues.resize(_lkpVarNames.size());
 
   // set the look up tables
   setTables(varComputeVec);
@@ -2490,49 +2553,93 @@ void MutationLibrary::setTables(vector<ComputeQuantity>& varComputeVec)
 {
   Common::Stopwatch<Common::WallTime> stp;
   stp.start();
-
-  const CFuint nbT = static_cast<CFuint>
-    ((_Tmax - _Tmin)/_deltaT);
-  const CFuint nbP = static_cast<CFuint>
-    ((_pmax - _pmin)/_deltaP);
-  const CFuint nbLookUpVars = _lkpVarNames.size();
-
-  // create mapping variable names with correspondind idxs
-  _nameToIdxVar.reserve(nbLookUpVars);
-  for (CFuint iVar = 0; iVar < nbLookUpVars; ++iVar) {
-    _nameToIdxVar.insert(_lkpVarNames[iVar], iVar);
+  
+  if (_lkpFileName == "") {
+    buildTables(varComputeVec);
   }
-  _nameToIdxVar.sortKeys();
+  else {
+    // the first process writes the file if it is missing or was made with
+    // other settings, the others map it in memory once it is complete
+    const bool isWriter = (PE::GetPE().GetRank() == 0);
+    if (isWriter && !loadTables()) {
+      buildTables(varComputeVec);
+      try {
+	_lookUpTables.save(_lkpFileName);
+      }
+      catch (Common::FilesystemException& e) {
+	// the other processes do not find the file and compute the table
+	CFLog(WARN, "MutationLibrary::setTables() => " << e.what() << "\n");
+      }
+    }
+    
+    if (PE::GetPE().IsParallel()) {
+      PE::GetPE().setBarrier();
+    }
+    
+    if (!isWriter && !loadTables()) {
+      buildTables(varComputeVec);
+    }
+  }
+  
+  CFLog(VERBOSE, "MutationLibrary::setTables() took " << stp << "s\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
 
-  // compute the arrays containing all the keys for T and P
-  vector<CFdouble> vT(nbT);
-  vector<CFdouble> vP(nbP);
-  for(CFuint i = 0; i < nbT; ++i) {
-    vT[i] = _Tmin + i*_deltaT;
+bool MutationLibrary::loadTables()
+{
+  if (!_lookUpTables.load(_lkpFileName)) {
+    return false;
   }
-  for(CFuint j = 0; j < nbP; ++j) {
-    vP[j] =_pmin + j*_deltaP;
+  
+  if (!_lookUpTables.matches(_lkpVarNames, _mixtureName,
+			     _Tmin, _Tmax, getNbTableT(), _pmin, _pmax, getNbTableP(),
+			     _lkpLogP, _lkpTolerance, _lkpMaxLevels)) {
+    CFLog(WARN, "MutationLibrary::setTables() => " << _lkpFileName
+	  << " was built for other lookUpVars, mixture, ranges, deltaT, deltaP,"
+	  << " tolerance or refinement levels, the table is recomputed\n");
+    _lookUpTables.clear();
+    return false;
   }
+  
+  CFLog(NOTICE, "MutationLibrary::setTables() => read " << _lookUpTables.getNbX()
+	<< " x " << _lookUpTables.getNbY() << " table from " << _lkpFileName << "\n");
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
 
-  // initialize the table
-  _lookUpTables.initialize(vT, vP, nbLookUpVars);
+CFuint MutationLibrary::getNbTableT() const
+{
+  return std::max<CFuint>(static_cast<CFuint>((_Tmax - _Tmin)/_deltaT) + 1, 2);
+}
 
-  // insert the values
-  for(CFuint i = 0; i < nbT; ++i) {
-    for(CFuint j = 0; j < nbP; ++j) {
-      // set the composition at first
-      setComposition(vT[i],vP[j], CFNULL);
+//////////////////////////////////////////////////////////////////////////////
 
-      for (CFuint iVar = 0; iVar < nbLookUpVars; ++iVar) {
-        CFdouble result = (this->*varComputeVec[iVar])(vT[i],vP[j]);
-        _lookUpTables.insert(vT[i],vP[j],
-                             _nameToIdxVar.find(_lkpVarNames[iVar]),
-                             result);
-      }
-    }
-  }
+CFuint MutationLibrary::getNbTableP() const
+{
+  return std::max<CFuint>(static_cast<CFuint>((_pmax - _pmin)/_deltaP) + 1, 2);
+}
 
-  CFLog(VERBOSE, "MutationLibrary::setTables() took " << stp << "s\n");
+//////////////////////////////////////////////////////////////////////////////
+
+void MutationLibrary::buildTables(vector<ComputeQuantity>& varComputeVec)
+{
+  // the quantities must be computed by the library while filling the table
+  const bool useLookUpTable = _useLookUpTable;
+  _useLookUpTable = false;
+  
+  TableSampler sampler(this, varComputeVec);
+  _lookUpTables.build(sampler, _lkpVarNames.size(),
+		      _Tmin, _Tmax, getNbTableT(),
+		      _pmin, _pmax, getNbTableP(),
+		      _lkpLogP, _lkpTolerance, _lkpMaxLevels);
+  _lookUpTables.setLabels(_lkpVarNames, _mixtureName);
+  
+  _useLookUpTable = useLookUpTable;
+  
+  CFLog(NOTICE, "MutationLibrary::setTables() => " << _lookUpTables.getNbX()
+	<< " x " << _lookUpTables.getNbY() << " table computed\n");
 }
 
 //////////////////////////////////////////////////////////////////////////////
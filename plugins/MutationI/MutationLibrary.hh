@@ -8,7 +8,9 @@
 #include "MathTools/RealVector.hh"
 #include "MathTools/RealMatrix.hh"
 #include "Common/LookupTable2D.hh"
+#include "Common/AdaptiveLookupTable2D.hh"
 #include "Common/NotImplementedException.hh"
+#include "Common/NoSuchValueException.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -556,6 +558,24 @@ protected: // helper function
   typedef CFdouble (MutationLibrary::*ComputeQuantity)
     (CFdouble&, CFdouble&);
 
+  /// quantities which can be tabulated
+  enum LookUpVar {LKP_D=0, LKP_H=1, LKP_E=2, LKP_A=3, NB_LKP_VARS=4};
+
+  /// sampler computing the tabulated quantities in equilibrium
+  class TableSampler;
+
+  /**
+   * Get the index of the given quantity in the look up table
+   */
+  CFuint getLookUpIdx(const LookUpVar var) const
+  {
+    if (_lkpVarIdx[var] < 0) {
+      throw Common::NoSuchValueException
+	(FromHere(), "MutationLibrary: quantity not stored in the look up table");
+    }
+    return _lkpVarIdx[var];
+  }
+
   /**
    * Set up all the look up tables
    */
@@ -572,6 +592,28 @@ protected: // helper function
    */
   void setTables(std::vector<ComputeQuantity>& varComputeVec);
 
+  /**
+   * Read the look up tables from the file, checking that they were built
+   * with the current settings
+   * @return false if the file is missing or does not match
+   */
+  bool loadTables();
+
+  /**
+   * Compute the look up tables
+   */
+  void buildTables(std::vector<ComputeQuantity>& varComputeVec);
+
+  /**
+   * Get the number of temperatures of the initial look up table
+   */
+  CFuint getNbTableT() const;
+
+  /**
+   * Get the number of pressures of the initial look up table
+   */
+  CFuint getNbTableP() const;
+
   /**
    * Calculates the dynamic viscosity by direct method given temperature and pressure
    * @param temp temperature
@@ -625,11 +667,14 @@ protected: // helper function
   
 protected: // data to use to interface FORTRAN77
 
-  /// mapping name variable - idx
-  Common::CFMap<std::string, size_t> _nameToIdxVar;
+  /// index of each LookUpVar in the look up table (-1 if not stored)
+  std::vector<CFint> _lkpVarIdx;
+
+  /// all the tabulated quantities interpolated in one (T,p)
+  std::vector<CFreal> _lkpValues;
 
-  /// table of lookup tables
-  LkpTable _lookUpTables;
+  /// adaptive look up table storing all the quantities in (T,p)
+  Common::AdaptiveLookupTable2D _lookUpTables;
   
   /// mixture name
   std::string _mixtureName;
@@ -673,6 +718,18 @@ protected: // data to use to interface FORTRAN77
   /// Delta pressure in the table
   CFdouble _deltaP;
 
+  /// Interpolation error allowed in the look up table, relative to the range of each quantity
+  CFdouble _lkpTolerance;
+
+  /// Maximum number of refinements of the look up table
+  CFuint _lkpMaxLevels;
+
+  /// flag telling to interpolate the look up table in log(p)
+  bool _lkpLogP;
+
+  /// file where the look up table is saved and read back
+  std::string _lkpFileName;
+
   /// Lagrange-Sonine computation option (polynom order???)
   int _sonine;
 
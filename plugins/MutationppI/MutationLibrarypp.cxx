@@ -11,6 +11,10 @@
 #include "Common/StringOps.hh"
 #include <fstream>
 
+#ifdef CF_HAVE_OMP
+#include <omp.h>
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 
 using namespace std;
@@ -49,6 +53,7 @@ void MutationLibrarypp::defineConfigOptions(Config::OptionList& options)
 MutationLibrarypp::MutationLibrarypp(const std::string& name)
   : Framework::PhysicalChemicalLibrary(name),
     m_gasMixture(CFNULL),
+    m_batchMixtures(),
     m_y(),
     m_x(),
     m_yn(),
@@ -65,6 +70,9 @@ MutationLibrarypp::MutationLibrarypp(const std::string& name)
 
 MutationLibrarypp::~MutationLibrarypp()
 {
+  for (CFuint i = 0; i < m_batchMixtures.size(); ++i) {
+    deletePtr(m_batchMixtures[i]);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -106,6 +114,20 @@ void MutationLibrarypp::setLibrarySequentially2()
   mo.setStateModel("TPY");
   m_gasMixture.reset(new Mutation::Mixture(mo));
   
+  // the batched evaluation needs one independent mixture per thread,
+  // distinct from m_gasMixture whose state the point-wise calls rely on
+  CFuint nbThreads = 1;
+#ifdef CF_HAVE_OMP
+  nbThreads = omp_get_max_threads();
+#endif
+  for (CFuint i = 0; i < m_batchMixtures.size(); ++i) {
+    deletePtr(m_batchMixtures[i]);
+  }
+  m_batchMixtures.resize(nbThreads);
+  for (CFuint i = 0; i < nbThreads; ++i) {
+    m_batchMixtures[i] = new Mutation::Mixture(mo);
+  }
+  
   _NS = m_gasMixture->nSpecies();
   
   m_y.resize(_NS);
@@ -551,6 +573,66 @@ void MutationLibrarypp::transportCoeffNEQ(CFreal& temperature,
         
 //////////////////////////////////////////////////////////////////////////////
    
+void MutationLibrarypp::computeBatch(const BatchData& data)
+{
+  const CFint nbPoints = data.nbPoints;
+  
+#ifdef CF_HAVE_OMP
+  // the team never outgrows the mixtures allocated at setup
+  const int nbThreads = m_batchMixtures.size();
+#pragma omp parallel num_threads(nbThreads)
+#endif
+  {
+    CFuint threadID = 0;
+#ifdef CF_HAVE_OMP
+    threadID = omp_get_thread_num();
+#endif
+    cf_assert(threadID < m_batchMixtures.size());
+    Mutation::Mixture& mix = *m_batchMixtures[threadID];
+    
+    CFreal tp[2];
+    RealVector ys(_NS);
+    vector<CFreal> omega(_NS);
+    
+#ifdef CF_HAVE_OMP
+#pragma omp for
+#endif
+    for (CFint i = 0; i < nbPoints; ++i) {
+      tp[0] = data.temp[i];
+      tp[1] = data.pressure[i];
+      for (CFint is = 0; is < _NS; ++is) {
+	ys[is] = data.ys[is*nbPoints + i];
+      }
+      
+      // same composition as setSpeciesFractions() gives the point-wise calls
+      if (mix.hasElectrons()) {
+	setElectronFraction(ys);
+      }
+      for (CFint is = 0; is < _NS; ++is) {
+	if (ys[is] < 0.0) ys[is] = 0.0;
+      }
+      mix.setState(&tp[0], &ys[0]);
+      
+      if (data.rho != CFNULL)        {data.rho[i] = mix.density();}
+      if (data.enthalpy != CFNULL)   {data.enthalpy[i] = mix.mixtureHMass();}
+      if (data.energy != CFNULL)     {data.energy[i] = mix.mixtureEnergyMass();}
+      if (data.gamma != CFNULL)      {data.gamma[i] = mix.mixtureFrozenGamma();}
+      if (data.soundSpeed != CFNULL) {data.soundSpeed[i] = mix.frozenSoundSpeed();}
+      if (data.eta != CFNULL)        {data.eta[i] = mix.viscosity();}
+      if (data.lambda != CFNULL)     {data.lambda[i] = mix.frozenThermalConductivity();}
+      
+      if (data.omega != CFNULL) {
+	mix.netProductionRates(&omega[0]);
+	for (CFint is = 0; is < _NS; ++is) {
+	  data.omega[is*nbPoints + i] = omega[is];
+	}
+      }
+    }
+  }
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
 void MutationLibrarypp::getSourceEE(CFdouble& temperature,
 				    RealVector& tVec,
 				    CFdouble& pressure,
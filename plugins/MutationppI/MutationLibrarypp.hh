@@ -532,6 +532,14 @@ public:
 			       RealVector* hsVib,
 			       RealVector* hsEl);
   
+  /**
+   * Computes the requested properties on a whole batch of states.
+   * The state is never stored in the library: each OpenMP thread sets
+   * its points on its own gas mixture.
+   * @param data  states and output arrays
+   */
+  void computeBatch(const BatchData& data);
+  
 private: // helper function
   
   /**
@@ -544,6 +552,9 @@ protected:
   /// gas mixture pointer
   std::auto_ptr<Mutation::Mixture> m_gasMixture; 
   
+  /// gas mixtures used by computeBatch(), one per thread
+  std::vector<Mutation::Mixture*> m_batchMixtures;
+  
   /// mixture name
   std::string _mixtureName;
     
@@ -0,0 +1,152 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the batched Mutation++ evaluation"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/PE.hh"
+#include "Config/ConfigArgs.hh"
+#include "MutationppI/MutationLibrarypp.hh"
+#include "UnitTests/PEFixture.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Physics::Mutationpp;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct MutationppBatchFixture
+{
+  /// number of points in the batch
+  static const CFuint NB_POINTS = 200;
+
+  MutationppBatchFixture() : lib("Mutationpp")
+  {
+    Config::ConfigArgs args;
+    args["Mutationpp.mixtureName"] = "air5";
+    lib.configure(args);
+    lib.setup();
+  }
+
+  ~MutationppBatchFixture()
+  {
+    lib.unsetup();
+  }
+
+  /// Fill the states of the batch, spanning the dissociation range
+  void fillStates()
+  {
+    const CFuint nbSpecies = lib.getNbSpecies();
+    temp.resize(NB_POINTS);
+    pressure.resize(NB_POINTS);
+    ys.resize(nbSpecies*NB_POINTS);
+    for (CFuint i = 0; i < NB_POINTS; ++i) {
+      temp[i] = 300. + 40.*i;
+      pressure[i] = 1000. + 500.*(i % 7);
+      CFreal sum = 0.;
+      for (CFuint is = 0; is < nbSpecies; ++is) {
+	ys[is*NB_POINTS + i] = 1. + (i + 3*is) % 5;
+	sum += ys[is*NB_POINTS + i];
+      }
+      for (CFuint is = 0; is < nbSpecies; ++is) {
+	ys[is*NB_POINTS + i] /= sum;
+      }
+    }
+  }
+
+  /// Set the states and the outputs of a batch
+  void setBatch(PhysicalChemicalLibrary::BatchData& data, vector<CFreal>& out)
+  {
+    const CFuint nbSpecies = lib.getNbSpecies();
+    out.assign((6 + nbSpecies)*NB_POINTS, 0.);
+    data.nbPoints   = NB_POINTS;
+    data.temp       = &temp[0];
+    data.pressure   = &pressure[0];
+    data.ys         = &ys[0];
+    data.rho        = &out[0];
+    data.enthalpy   = &out[NB_POINTS];
+    data.energy     = &out[2*NB_POINTS];
+    data.gamma      = &out[3*NB_POINTS];
+    data.soundSpeed = &out[4*NB_POINTS];
+    data.lambda     = &out[5*NB_POINTS];
+    data.omega      = &out[6*NB_POINTS];
+  }
+
+  MutationLibrarypp lib;
+  vector<CFreal> temp;
+  vector<CFreal> pressure;
+  vector<CFreal> ys;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( MutationppBatchSuite, MutationppBatchFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( BatchMatchesPointWise )
+{
+  fillStates();
+
+  // the base class goes through the point-wise interface, one point at a time
+  PhysicalChemicalLibrary::BatchData pointData;
+  vector<CFreal> pointOut;
+  setBatch(pointData, pointOut);
+  lib.PhysicalChemicalLibrary::computeBatch(pointData);
+
+  PhysicalChemicalLibrary::BatchData batchData;
+  vector<CFreal> batchOut;
+  setBatch(batchData, batchOut);
+  lib.computeBatch(batchData);
+
+  for (CFuint i = 0; i < pointOut.size(); ++i) {
+    BOOST_CHECK_CLOSE(batchOut[i], pointOut[i], 1e-10);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( BatchKeepsPointWiseState )
+{
+  fillStates();
+
+  // a point-wise state set before a batch must survive it
+  RealVector y(lib.getNbSpecies());
+  for (CFuint is = 0; is < y.size(); ++is) {
+    y[is] = ys[is*NB_POINTS];
+  }
+  lib.setSpeciesFractions(y);
+  CFdouble T = temp[0];
+  CFdouble p = pressure[0];
+  const CFdouble rho = lib.density(T, p, CFNULL);
+  RealVector dhe(3);
+  lib.setDensityEnthalpyEnergy(T, p, dhe);
+
+  PhysicalChemicalLibrary::BatchData batchData;
+  vector<CFreal> batchOut;
+  setBatch(batchData, batchOut);
+  lib.computeBatch(batchData);
+
+  RealVector dheAfter(3);
+  lib.setDensityEnthalpyEnergy(T, p, dheAfter);
+  BOOST_CHECK_CLOSE(dheAfter[0], rho, 1e-12);
+  BOOST_CHECK_CLOSE(dheAfter[1], dhe[1], 1e-12);
+  BOOST_CHECK_CLOSE(dheAfter[2], dhe[2], 1e-12);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -4,6 +4,9 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include "Common/PE.hh"
+#include "Environment/DirPaths.hh"
+#include "Framework/PathAppender.hh"
 #include "ParaWriter.hh"
 #include "Environment/ObjectProvider.hh"
 #include "ParaViewWriter/ParaViewWriter.hh"
@@ -12,6 +15,7 @@
 
 using namespace std;
 using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Common;
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -115,6 +119,22 @@ void ParaWriter::openImpl()
   CFAUTOTRACE;
   computeFullOutputName();
   m_data->setFilename(m_fullOutputName);
+
+  // in parallel the binary VTU writer makes each process write its own
+  // piece, which must carry the rank whatever AppendRank says, and lists
+  // the pieces in an index file named as the pieces but without the rank;
+  // the other files keep the name computed above
+  if (PE::GetPE().IsParallel())
+  {
+    using namespace boost::filesystem;
+    const path fpath = Environment::DirPaths::getInstance().getResultsDir() / m_filename;
+    m_data->setPieceFilename
+      (change_extension(PathAppender::getInstance().appendAllInfo(fpath, m_appendIter, m_appendTime, true),
+                        getFormatExtension()));
+    m_data->setIndexFilename
+      (change_extension(PathAppender::getInstance().appendAllInfo(fpath, m_appendIter, m_appendTime, false),
+                        ".pvtu"));
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
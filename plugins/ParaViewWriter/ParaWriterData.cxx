@@ -47,6 +47,8 @@ void ParaWriterData::defineConfigOptions(Config::OptionList& options)
 ParaWriterData::ParaWriterData(Common::SafePtr<Framework::Method> owner)
   : OutputFormatterData(owner),
     m_filepath(),
+    m_pieceFilepath(),
+    m_indexFilepath(),
     m_updateVarStr(),
     m_updateVarSet(),
     m_stdTrsGeoBuilder()
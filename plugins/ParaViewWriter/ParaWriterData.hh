@@ -90,6 +90,42 @@ public:
     return m_filepath;
   }
 
+  /**
+   * Sets the name of the piece written by this process in parallel
+   * @param filepath path to the piece file
+   */
+  void setPieceFilename(const boost::filesystem::path& filepath)
+  {
+    m_pieceFilepath = filepath;
+  }
+
+  /**
+   * Gets the name of the piece written by this process in parallel
+   * @return path to the piece file
+   */
+  boost::filesystem::path getPieceFilename() const
+  {
+    return m_pieceFilepath;
+  }
+
+  /**
+   * Sets the name of the parallel index (.pvtu) file
+   * @param filepath path to the index file
+   */
+  void setIndexFilename(const boost::filesystem::path& filepath)
+  {
+    m_indexFilepath = filepath;
+  }
+
+  /**
+   * Gets the name of the parallel index (.pvtu) file
+   * @return path to the index file
+   */
+  boost::filesystem::path getIndexFilename() const
+  {
+    return m_indexFilepath;
+  }
+
   /**
    * Tells if to print extra values
    */
@@ -156,6 +192,12 @@ private:
   /// Filename to write solution to.
   boost::filesystem::path m_filepath;
 
+  /// Filename of the piece of this process, always carrying the rank
+  boost::filesystem::path m_pieceFilepath;
+
+  /// Filename of the parallel index of the pieces
+  boost::filesystem::path m_indexFilepath;
+
   /// Name of the update variable set
   std::string m_updateVarStr;
 
@@ -0,0 +1,218 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the appended data of the VTK XML files"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include <boost/cstdint.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "ParaViewWriter/VTKAppendedData.hh"
+
+#ifdef CF_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::IO::ParaViewWriter;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct VTKAppendedDataFixture
+{
+  typedef boost::uint64_t HeaderType;
+
+  VTKAppendedDataFixture() : floats(1000), ints(17), empty()
+  {
+    for (CFuint i = 0; i < floats.size(); ++i) floats[i] = 0.5f*i - 3.f;
+    for (CFuint i = 0; i < ints.size(); ++i) ints[i] = -7*static_cast<int>(i);
+  }
+
+  /// Writes a file with the given arrays and returns its content
+  string writeFile(const bool compress, const vector<CFreal>& doubles)
+  {
+    stringstream file;
+    VTKAppendedData appended(file, compress);
+    file << "<VTKFile type=\"UnstructuredGrid\"" << appended.getFileAttributes() << ">\n";
+    appended.declareDataArray("type=\"Float32\" Name=\"a\"");
+    appended.declareDataArray("type=\"Int32\" Name=\"b\"");
+    appended.declareDataArray("type=\"Float32\" Name=\"c\"");
+    appended.declareDataArray("type=\"Float64\" Name=\"d\"");
+    appended.beginAppendedData();
+    appended.writeBlock(floats);
+    appended.writeBlock(ints);
+    appended.writeBlock(empty);
+    appended.writeBlock(doubles);
+    appended.endAppendedData();
+    file << "</VTKFile>\n";
+    isCompressed = appended.isCompressed();
+    return file.str();
+  }
+
+  /// Gets the offsets of the DataArray elements, checking that they
+  /// are made of digits only
+  static vector<HeaderType> getOffsets(const string& content)
+  {
+    vector<HeaderType> offsets;
+    const string key = "offset=\"";
+    for (size_t pos = content.find(key); pos != string::npos; pos = content.find(key, pos)) {
+      pos += key.size();
+      const size_t end = content.find('"', pos);
+      BOOST_REQUIRE(end != string::npos);
+      const string offset = content.substr(pos, end - pos);
+      BOOST_CHECK_EQUAL(offset.find_first_not_of("0123456789"), string::npos);
+      offsets.push_back(std::strtoul(offset.c_str(), CFNULL, 10));
+    }
+    return offsets;
+  }
+
+  /// Gets the position of the first byte of the appended data
+  static size_t getDataStart(const string& content)
+  {
+    const string key = "<AppendedData encoding=\"raw\">\n   _";
+    const size_t pos = content.find(key);
+    BOOST_REQUIRE(pos != string::npos);
+    return pos + key.size();
+  }
+
+  /// Reads the uncompressed block at the given position
+  static string readBlock(const string& content, const size_t pos)
+  {
+    HeaderType size;
+    std::memcpy(&size, &content[pos], sizeof(HeaderType));
+    return content.substr(pos + sizeof(HeaderType), size);
+  }
+
+#ifdef CF_HAVE_ZLIB
+  /// Reads and uncompresses the compressed block at the given position
+  static string readCompressedBlock(const string& content, const size_t pos)
+  {
+    HeaderType nbBlocks;
+    std::memcpy(&nbBlocks, &content[pos], sizeof(HeaderType));
+    vector<HeaderType> header(3 + nbBlocks);
+    std::memcpy(&header[0], &content[pos], header.size()*sizeof(HeaderType));
+
+    string data;
+    size_t start = pos + header.size()*sizeof(HeaderType);
+    for (HeaderType iBlock = 0; iBlock < nbBlocks; ++iBlock) {
+      // the last block is shorter unless its size is 0
+      uLongf size = (iBlock + 1 == nbBlocks && header[2] > 0) ? header[2] : header[1];
+      vector<Bytef> block(size);
+      BOOST_REQUIRE_EQUAL(uncompress(&block[0], &size,
+				     reinterpret_cast<const Bytef*>(&content[start]), header[3 + iBlock]),
+			  Z_OK);
+      data.append(reinterpret_cast<const char*>(&block[0]), size);
+      start += header[3 + iBlock];
+    }
+    return data;
+  }
+#endif
+
+  /// Checks that the block at the given position holds the given values
+  template <typename T>
+  void checkBlock(const string& content, const size_t pos, const vector<T>& values)
+  {
+#ifdef CF_HAVE_ZLIB
+    const string data = isCompressed ? readCompressedBlock(content, pos) : readBlock(content, pos);
+#else
+    const string data = readBlock(content, pos);
+#endif
+    BOOST_REQUIRE_EQUAL(data.size(), values.size()*sizeof(T));
+    BOOST_CHECK(values.empty() || std::memcmp(data.data(), &values[0], data.size()) == 0);
+  }
+
+  /// Checks the XML part and the blocks of the file
+  void checkFile(const string& content, const vector<CFreal>& doubles)
+  {
+    const size_t dataStart = getDataStart(content);
+
+    // no line of the XML part ends with blanks
+    istringstream xml(content.substr(0, dataStart));
+    string line;
+    while (getline(xml, line)) {
+      BOOST_CHECK(line.empty() || line[line.size() - 1] != ' ');
+    }
+
+    const vector<HeaderType> offsets = getOffsets(content.substr(0, dataStart));
+    BOOST_REQUIRE_EQUAL(offsets.size(), 4u);
+    BOOST_CHECK_EQUAL(offsets[0], 0u);
+    for (CFuint i = 1; i < offsets.size(); ++i) {
+      BOOST_CHECK(offsets[i] > offsets[i - 1]);
+    }
+    checkBlock(content, dataStart + offsets[0], floats);
+    checkBlock(content, dataStart + offsets[1], ints);
+    checkBlock(content, dataStart + offsets[2], empty);
+    checkBlock(content, dataStart + offsets[3], doubles);
+
+    const string end = "\n  </AppendedData>\n</VTKFile>\n";
+    BOOST_CHECK_EQUAL(content.substr(content.size() - end.size()), end);
+  }
+
+  vector<float> floats;
+  vector<int> ints;
+  vector<float> empty;
+  bool isCompressed;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( VTKAppendedDataSuite, VTKAppendedDataFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( UncompressedRoundTrip )
+{
+  vector<CFreal> doubles(300);
+  for (CFuint i = 0; i < doubles.size(); ++i) doubles[i] = 1./(i + 1);
+
+  const string content = writeFile(false, doubles);
+  BOOST_CHECK(!isCompressed);
+  BOOST_CHECK(content.find("header_type=\"UInt64\"") != string::npos);
+  BOOST_CHECK(content.find("compressor") == string::npos);
+  checkFile(content, doubles);
+
+  // the blocks follow each other, each with its size
+  const vector<HeaderType> offsets = getOffsets(content.substr(0, getDataStart(content)));
+  BOOST_CHECK_EQUAL(offsets[1], sizeof(HeaderType) + floats.size()*sizeof(float));
+  BOOST_CHECK_EQUAL(offsets[3] - offsets[2], sizeof(HeaderType));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( CompressedRoundTrip )
+{
+  // several zlib blocks, the last one shorter, then exactly two blocks
+  vector<CFreal> doubles(20000);
+  for (CFuint i = 0; i < doubles.size(); ++i) doubles[i] = (i % 100)*0.25;
+
+  string content = writeFile(true, doubles);
+#ifdef CF_HAVE_ZLIB
+  BOOST_CHECK(isCompressed);
+  BOOST_CHECK(content.find("compressor=\"vtkZLibDataCompressor\"") != string::npos);
+#else
+  BOOST_CHECK(!isCompressed);
+#endif
+  checkFile(content, doubles);
+
+  doubles.resize(2*65536/sizeof(CFreal));
+  content = writeFile(true, doubles);
+  checkFile(content, doubles);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
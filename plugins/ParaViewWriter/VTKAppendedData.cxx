@@ -0,0 +1,175 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <iomanip>
+
+#include <boost/cstdint.hpp>
+
+#include "Common/CFLog.hh"
+#include "Common/ShouldNotBeHereException.hh"
+
+#ifdef CF_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "ParaViewWriter/VTKAppendedData.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace IO {
+
+    namespace ParaViewWriter {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// type of the block headers (header_type="UInt64")
+typedef boost::uint64_t HeaderType;
+
+/// size of the uncompressed blocks for the zlib compressor
+static const HeaderType ZLIB_BLOCK_SIZE = 1 << 16;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// width of the offsets, padded with zeros, enough for any 64-bit offset
+static const size_t OFFSET_WIDTH = 20;
+
+//////////////////////////////////////////////////////////////////////////////
+
+VTKAppendedData::VTKAppendedData(std::ostream& fout, const bool compress) :
+  m_out(fout),
+  m_compress(compress),
+  m_offsetPos(),
+  m_nextBlock(0),
+  m_dataStart()
+{
+#ifndef CF_HAVE_ZLIB
+  if (m_compress) {
+    CFLog(WARN, "VTKAppendedData: COOLFluiD was built without zlib, writing uncompressed data\n");
+    m_compress = false;
+  }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+VTKAppendedData::~VTKAppendedData()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::string VTKAppendedData::getFileAttributes() const
+{
+  std::string attr = " header_type=\"UInt64\"";
+  if (m_compress) {
+    attr += " compressor=\"vtkZLibDataCompressor\"";
+  }
+  return attr;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VTKAppendedData::declareDataArray(const std::string& attributes)
+{
+  m_out << "        <DataArray " << attributes << " format=\"appended\" offset=\"";
+  m_offsetPos.push_back(m_out.tellp());
+  m_out << std::string(OFFSET_WIDTH, '0') << "\"/>\n";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VTKAppendedData::beginAppendedData()
+{
+  m_out << "  <AppendedData encoding=\"raw\">\n   _";
+  m_dataStart = m_out.tellp();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VTKAppendedData::endAppendedData()
+{
+  cf_assert(m_nextBlock == m_offsetPos.size());
+  m_out << "\n  </AppendedData>\n";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void VTKAppendedData::patch(const std::streampos& pos, const T& value)
+{
+  const std::streampos end = m_out.tellp();
+  m_out.seekp(pos);
+  m_out << std::setw(OFFSET_WIDTH) << std::setfill('0') << value << std::setfill(' ');
+  m_out.seekp(end);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VTKAppendedData::writeBlock(const char* data, const size_t nbBytes)
+{
+  cf_assert(m_nextBlock < m_offsetPos.size());
+  const HeaderType offset = m_out.tellp() - m_dataStart;
+  patch(m_offsetPos[m_nextBlock++], offset);
+
+  if (!m_compress) {
+    const HeaderType size = nbBytes;
+    m_out.write(reinterpret_cast<const char*>(&size), sizeof(HeaderType));
+    m_out.write(data, nbBytes);
+    return;
+  }
+
+#ifdef CF_HAVE_ZLIB
+  // header: [nbBlocks, blockSize, lastBlockSize, compressedSize_0, ...],
+  // written once the compressed sizes are known
+  const HeaderType nbBlocks = (nbBytes + ZLIB_BLOCK_SIZE - 1)/ZLIB_BLOCK_SIZE;
+  const HeaderType lastSize = (nbBlocks > 0) ? nbBytes - (nbBlocks-1)*ZLIB_BLOCK_SIZE : 0;
+
+  vector<HeaderType> header(3 + nbBlocks);
+  header[0] = nbBlocks;
+  header[1] = ZLIB_BLOCK_SIZE;
+  header[2] = (lastSize == ZLIB_BLOCK_SIZE) ? 0 : lastSize;
+
+  const std::streampos headerPos = m_out.tellp();
+  m_out.write(reinterpret_cast<const char*>(&header[0]), header.size()*sizeof(HeaderType));
+
+  vector<Bytef> compressed(compressBound(ZLIB_BLOCK_SIZE));
+  for (HeaderType iBlock = 0; iBlock < nbBlocks; ++iBlock) {
+    const HeaderType start = iBlock*ZLIB_BLOCK_SIZE;
+    const uLong srcSize = min<HeaderType>(ZLIB_BLOCK_SIZE, nbBytes - start);
+    uLongf destSize = compressed.size();
+    if (compress2(&compressed[0], &destSize,
+                  reinterpret_cast<const Bytef*>(data + start), srcSize,
+                  Z_DEFAULT_COMPRESSION) != Z_OK) {
+      throw Common::ShouldNotBeHereException
+        (FromHere(), "VTKAppendedData: zlib compression failed");
+    }
+    header[3 + iBlock] = destSize;
+    m_out.write(reinterpret_cast<const char*>(&compressed[0]), destSize);
+  }
+
+  const std::streampos end = m_out.tellp();
+  m_out.seekp(headerPos);
+  m_out.write(reinterpret_cast<const char*>(&header[0]), header.size()*sizeof(HeaderType));
+  m_out.seekp(end);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace ParaViewWriter
+
+  } // namespace IO
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
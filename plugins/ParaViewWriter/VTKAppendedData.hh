@@ -0,0 +1,131 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_IO_ParaViewWriter_VTKAppendedData_hh
+#define COOLFluiD_IO_ParaViewWriter_VTKAppendedData_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace IO {
+
+    namespace ParaViewWriter {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class writes the DataArray elements of a VTK XML file in "appended"
+ * format and streams their binary blocks in the raw AppendedData section
+ * at the end of the file, one block at a time. The offsets of the
+ * DataArray elements are written as placeholders of fixed width, filled
+ * in with the zero padded offsets when the corresponding blocks are written.
+ * Each block is preceded by a UInt64 header: the number of bytes of the
+ * block or, if compression is enabled, the vtkZLibDataCompressor header.
+ *
+ * @author Kris Van den Abeele
+ */
+class VTKAppendedData {
+public:
+
+  /**
+   * Constructor
+   * @param fout      seekable stream of the file
+   * @param compress  compress the blocks with zlib (ignored without zlib)
+   */
+  VTKAppendedData(std::ostream& fout, const bool compress);
+
+  /**
+   * Destructor
+   */
+  ~VTKAppendedData();
+
+  /**
+   * Tells if the blocks are actually compressed
+   */
+  bool isCompressed() const {return m_compress;}
+
+  /**
+   * Attributes to add to the VTKFile element (header type and compressor)
+   */
+  std::string getFileAttributes() const;
+
+  /**
+   * Write a DataArray element whose block will be written later
+   * @param attributes  attributes of the DataArray (type, Name, ...)
+   */
+  void declareDataArray(const std::string& attributes);
+
+  /**
+   * Open the AppendedData element, once all the DataArray elements
+   * and the rest of the XML part have been written
+   */
+  void beginAppendedData();
+
+  /**
+   * Write the block of the next declared DataArray
+   * @param values  values of the DataArray
+   */
+  template <typename T>
+  void writeBlock(const std::vector<T>& values)
+  {
+    writeBlock(reinterpret_cast<const char*>(values.empty() ? CFNULL : &values[0]),
+               values.size()*sizeof(T));
+  }
+
+  /**
+   * Close the AppendedData element, once all the blocks have been written
+   */
+  void endAppendedData();
+
+private: // helper functions
+
+  /// Write the block of the next declared DataArray (with its header)
+  void writeBlock(const char* data, const size_t nbBytes);
+
+  /// Write the given offset at the given position of the file, padded to
+  /// the width of the placeholder, coming back to the end of the file afterwards
+  template <typename T>
+  void patch(const std::streampos& pos, const T& value);
+
+private: // data
+
+  /// stream of the file
+  std::ostream& m_out;
+
+  /// compress the blocks
+  bool m_compress;
+
+  /// position in the file of the offset placeholder of each DataArray
+  std::vector<std::streampos> m_offsetPos;
+
+  /// index of the next block to write
+  CFuint m_nextBlock;
+
+  /// position in the file of the beginning of the appended data
+  std::streampos m_dataStart;
+
+}; // class VTKAppendedData
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace ParaViewWriter
+
+  } // namespace IO
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_IO_ParaViewWriter_VTKAppendedData_hh
@@ -8,7 +8,11 @@
 
 #include <iomanip>
 
+#include <boost/cstdint.hpp>
+
 #include "Common/CFMap.hh"
+#include "Common/PE.hh"
+#include "Common/MPI/MPIStructDef.hh"
 #include "Environment/SingleBehaviorFactory.hh"
 #include "Environment/FileHandlerOutput.hh"
 #include "Framework/MeshData.hh"
@@ -22,6 +26,7 @@
 
 #include "ParaViewWriter/ParaViewWriter.hh"
 #include "ParaViewWriter/WriteSolution.hh"
+#include "ParaViewWriter/VTKAppendedData.hh"
 
 #include "Common/OSystem.hh"
 //////////////////////////////////////////////////////////////////////////////
@@ -49,6 +54,7 @@ writeSolutionProvider("WriteSolution");
 void WriteSolution::defineConfigOptions(Config::OptionList& options)
 {
    options.addConfigOption< std::string>("FileFormat","Format to write ParaView file.");
+   options.addConfigOption< bool >("Compress","Compress the BINARY file with zlib.");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -61,16 +67,18 @@ WriteSolution::WriteSolution(const std::string& name) : ParaWriterCom(name),
 
   m_fileFormatStr = "ASCII";
   setParameter("FileFormat",&m_fileFormatStr);
+
+  m_compress = false;
+  setParameter("Compress",&m_compress);
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
 void WriteSolution::execute()
 {
-  CFout << "Writing solution to: " << getMethodData().getFilename().string() << "\n";
-
   if(m_fileFormatStr == "ASCII")
   {
+    CFout << "Writing solution to: " << getMethodData().getFilename().string() << "\n";
     writeToFile(getMethodData().getFilename());
   }
   else
@@ -92,57 +100,45 @@ const std::string WriteSolution::getWriterName() const
 //////////////////////////////////////////////////////////////////////////////
 
 void WriteSolution::writeToBinaryFile()
-{
- CFAUTOTRACE;
-
-  throw Common::NotImplementedException (FromHere(),"Writing to binary files is not yet implemented in ParaViewWriter...");
-}
-
-//////////////////////////////////////////////////////////////////////////////
-
-void WriteSolution::writeToFileStream(std::ofstream& fout)
 {
   CFAUTOTRACE;
 
   if (!getMethodData().onlySurface())
   {
+    vector<pair<std::string, CFuint> > pointArrays;
 
-  // get the nodes datahandle
-  DataHandle < Framework::Node*, Framework::GLOBAL > nodes = socket_nodes.getDataHandle();
+    SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
+      Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
+    // in parallel each process writes its own piece of the .pvtu file
+    const path file = PE::GetPE().IsParallel() ?
+      getMethodData().getPieceFilename() : getMethodData().getFilename();
+    CFout << "Writing solution to: " << file.string() << "\n";
+    ofstream& fout = fhandle->open(file, ios_base::out | ios_base::binary);
 
-  // get iterator for nodal states datahandle
-  DataHandle<ProxyDofIterator<RealVector>*> nstatesProxy = socket_nstatesProxy.getDataHandle();
+    writeToBinaryFileStream(fout, pointArrays);
 
-  // this is a sort of handle for the nodal states
-  // (which can be stored as arrays of State*, RealVector* or
-  // RealVector but they are used as arrays of RealVector*)
-  ProxyDofIterator<RealVector>& nodalStates = *nstatesProxy[0];
-
-  // get the cells
-  SafePtr<TopologicalRegionSet> elements = MeshDataStack::getActive()->getTrs("InnerCells");
+    fhandle->close();
 
-  // get cell-node connectivity
-  SafePtr<MeshData::ConnTable> cellNodes = MeshDataStack::getActive()->getConnectivity("cellNodes_InnerCells");
-
-  // number of cells and nodes
-  const CFuint nbrCells = elements->getLocalNbGeoEnts();
-  const CFuint nbrNodes = nodes.size();
-  cf_assert(cellNodes->nbRows() == nbrCells);
+    // each process has written its own piece
+    if (PE::GetPE().IsParallel())
+    {
+      writePVTUFile(pointArrays);
+    }
+  }
 
-  // we will assume that the number of nodes is the same as
-  // the number of states but the connectivity might be different
-  //   cf_assert(nodes.size() == nodalStates.getSize());
+  // write boundary surface data
+  writeBoundarySurface();
+}
 
-  // get the element type data
-  SafePtr<vector<ElementTypeData> > elemType =  MeshDataStack::getActive()->getElementTypeData();
+//////////////////////////////////////////////////////////////////////////////
 
-  // get dimensionality, number of variables and reference length
+void WriteSolution::getVariableIdxs(vector<CFuint>& vectorComponentIdxs,
+                                    vector<CFuint>& scalarVarIdxs) const
+{
   const CFuint dim = PhysicalModelStack::getActive()->getDim();
   const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
-  const CFreal refL = PhysicalModelStack::getActive()->getImplementor()->getRefLength();
 
-  // variable that holds the indices of the variables that are vector components
-  vector<CFuint> vectorComponentIdxs(0);
+  vectorComponentIdxs.resize(0);
   /// @note this is a rather ugly piece of code, a check is made on the number of equations
   /// to avoid that vector components are searched when the physical model is a linear advection for instance
   /// this piece of code puts the velocity components (or the momentum components) in a vector
@@ -171,28 +167,399 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
     cf_assert(dim == vectorComponentIdxs.size());
   }
 
-  // variable tht holds the indices of the scalar variables
+  // indices of the scalar variables
   const CFuint nbVecComponents = vectorComponentIdxs.size();
-  const CFuint nbScalars = nbEqs-nbVecComponents;
-  vector<CFuint> scalarVarIdxs(nbScalars);
-  CFuint iScalar = 0;
+  scalarVarIdxs.resize(0);
   for  (CFuint iEq = 0; iEq < nbEqs; ++iEq)
   {
-    bool addIdx = true;
-    for (CFuint iVecComp = 0; iVecComp < nbVecComponents; ++iVecComp)
+    if (std::find(vectorComponentIdxs.begin(), vectorComponentIdxs.end(), iEq) ==
+        vectorComponentIdxs.end())
+    {
+      scalarVarIdxs.push_back(iEq);
+    }
+  }
+  cf_assert(scalarVarIdxs.size() == nbEqs-nbVecComponents);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void WriteSolution::writeToBinaryFileStream(std::ofstream& fout,
+                                            vector<pair<std::string, CFuint> >& pointArrays)
+{
+  CFAUTOTRACE;
+
+  // get the nodes datahandle
+  DataHandle < Framework::Node*, Framework::GLOBAL > nodes = socket_nodes.getDataHandle();
+
+  // get iterator for nodal states datahandle
+  DataHandle<ProxyDofIterator<RealVector>*> nstatesProxy = socket_nstatesProxy.getDataHandle();
+  ProxyDofIterator<RealVector>& nodalStates = *nstatesProxy[0];
+
+  // get the cells and the cell-node connectivity
+  SafePtr<TopologicalRegionSet> elements = MeshDataStack::getActive()->getTrs("InnerCells");
+  SafePtr<MeshData::ConnTable> cellNodes = MeshDataStack::getActive()->getConnectivity("cellNodes_InnerCells");
+
+  // number of cells and nodes
+  const CFuint nbrCells = elements->getLocalNbGeoEnts();
+  const CFuint nbrNodes = nodes.size();
+  cf_assert(cellNodes->nbRows() == nbrCells);
+
+  // get the element type data
+  SafePtr<vector<ElementTypeData> > elemType =  MeshDataStack::getActive()->getElementTypeData();
+
+  // get dimensionality, number of variables and reference length
+  const CFuint dim = PhysicalModelStack::getActive()->getDim();
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  const CFreal refL = PhysicalModelStack::getActive()->getImplementor()->getRefLength();
+
+  vector<CFuint> vectorComponentIdxs;
+  vector<CFuint> scalarVarIdxs;
+  getVariableIdxs(vectorComponentIdxs, scalarVarIdxs);
+  const CFuint nbVecComponents = vectorComponentIdxs.size();
+
+  // get ConvectiveVarSet and variable names
+  SafePtr<ConvectiveVarSet> updateVarSet = getMethodData().getUpdateVarSet();
+  const vector<std::string>& varNames = updateVarSet->getVarNames();
+  cf_assert(varNames.size() == nbEqs);
+
+  const bool printExtraValues = getMethodData().printExtraValues();
+  const vector<std::string>& extraVarNames = updateVarSet->getExtraVarNames();
+  const CFuint nbrExtraVars = (printExtraValues) ? extraVarNames.size() : 0;
+
+  // dimensionalize the nodal states (and compute the extra values) only once
+  vector<CFfloat> dimStates(nbrNodes*nbEqs);
+  vector<CFfloat> extraStates(nbrNodes*nbrExtraVars);
+  RealVector dimState(nbEqs);
+  RealVector extraValues; // size will be set in the VarSet
+  State tempState;
+  for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
+  {
+    const RealVector& nodalState = *nodalStates.getState(iNode);
+    for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
+    {
+      tempState[iEq] = nodalState[iEq];
+    }
+    tempState.setLocalID(nodalStates.getStateLocalID(iNode));
+    tempState.setSpaceCoordinates(nodes[iNode]);
+
+    if (printExtraValues)
+    {
+      updateVarSet->setDimensionalValuesPlusExtraValues(tempState, dimState, extraValues);
+      for (CFuint iVar = 0; iVar < nbrExtraVars; ++iVar)
+      {
+        extraStates[iNode*nbrExtraVars + iVar] = extraValues[iVar];
+      }
+    }
+    else
+    {
+      updateVarSet->setDimensionalValues(tempState, dimState);
+    }
+
+    for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
+    {
+      dimStates[iNode*nbEqs + iEq] = dimState[iEq];
+    }
+  }
+
+  // the datahandles with state based data
+  SafePtr<DataHandleOutput> datahandle_output = getMethodData().getDataHOutput();
+  datahandle_output->getDataHandles();
+  const vector<std::string> dh_varnames = datahandle_output->getVarNames();
+
+  const bool writeVector = (nbVecComponents > 0) && (!getMethodData().writeVectorAsComponents());
+  if (!writeVector)
+  {
+    // vector components are written as scalars
+    scalarVarIdxs.insert(scalarVarIdxs.begin(), vectorComponentIdxs.begin(), vectorComponentIdxs.end());
+  }
+
+  // the XML part comes first, with the offsets of the arrays left blank
+  // until their blocks are streamed in the appended data section
+  VTKAppendedData appended(fout, m_compress);
+
+  // open VTKFile element
+  fout << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order="
+       << (isLittleEndian() ? "\"LittleEndian\"" : "\"BigEndian\"")
+       << appended.getFileAttributes() << ">\n";
+  fout << "  <UnstructuredGrid>\n";
+  fout << "    <Piece NumberOfPoints=\"" << nbrNodes << "\" NumberOfCells=\"" << nbrCells << "\">\n";
+  fout << "      <PointData Scalars=\"" << varNames[0] << "\">\n";
+
+  // the (velocity or momentum) vectors
+  if (writeVector)
+  {
+    cf_assert(nbVecComponents >= 2);
+    const std::string& name = varNames[vectorComponentIdxs[1]];
+    appended.declareDataArray("type=\"Float32\" Name=\"" + name + "\" NumberOfComponents=\"3\"");
+    pointArrays.push_back(make_pair(name, 3u));
+  }
+
+  // the scalars
+  for (CFuint iScalar = 0; iScalar < scalarVarIdxs.size(); ++iScalar)
+  {
+    const std::string& name = varNames[scalarVarIdxs[iScalar]];
+    appended.declareDataArray("type=\"Float32\" Name=\"" + name + "\"");
+    pointArrays.push_back(make_pair(name, 1u));
+  }
+
+  // the extra variables
+  for (CFuint iVar = 0; iVar < nbrExtraVars; ++iVar)
+  {
+    appended.declareDataArray("type=\"Float32\" Name=\"" + extraVarNames[iVar] + "\"");
+    pointArrays.push_back(make_pair(extraVarNames[iVar], 1u));
+  }
+
+  // the datahandles
+  for (CFuint iVar = 0; iVar < dh_varnames.size(); ++iVar)
+  {
+    appended.declareDataArray("type=\"Float32\" Name=\"" + dh_varnames[iVar] + "\"");
+    pointArrays.push_back(make_pair(dh_varnames[iVar], 1u));
+  }
+
+  fout << "      </PointData>\n";
+
+  // node coordinates
+  fout << "      <Points>\n";
+  appended.declareDataArray("type=\"Float32\" NumberOfComponents=\"3\"");
+  fout << "      </Points>\n";
+
+  fout << "      <Cells>\n";
+  appended.declareDataArray("type=\"Int32\" Name=\"connectivity\"");
+  appended.declareDataArray("type=\"Int32\" Name=\"offsets\"");
+  appended.declareDataArray("type=\"UInt8\" Name=\"types\"");
+  fout << "      </Cells>\n";
+  fout << "    </Piece>\n";
+  fout << "  </UnstructuredGrid>\n";
+
+  // then the blocks, one array at a time and in the same order
+  appended.beginAppendedData();
+  vector<CFfloat> values;
+
+  if (writeVector)
+  {
+    values.assign(3*nbrNodes, 0.);
+    for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
     {
-      if (iEq == vectorComponentIdxs[iVecComp])
+      for (CFuint iVecComp = 0; iVecComp < nbVecComponents; ++iVecComp)
       {
-        addIdx = false;
+        values[3*iNode + iVecComp] = dimStates[iNode*nbEqs + vectorComponentIdxs[iVecComp]];
       }
     }
-    if (addIdx)
+    appended.writeBlock(values);
+  }
+
+  values.resize(nbrNodes);
+  for (CFuint iScalar = 0; iScalar < scalarVarIdxs.size(); ++iScalar)
+  {
+    const CFuint iVar = scalarVarIdxs[iScalar];
+    for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
+    {
+      values[iNode] = dimStates[iNode*nbEqs + iVar];
+    }
+    appended.writeBlock(values);
+  }
+
+  for (CFuint iVar = 0; iVar < nbrExtraVars; ++iVar)
+  {
+    for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
+    {
+      values[iNode] = extraStates[iNode*nbrExtraVars + iVar];
+    }
+    appended.writeBlock(values);
+  }
+
+  for (CFuint iVar = 0; iVar < dh_varnames.size(); ++iVar)
+  {
+    DataHandleOutput::DataHandleInfo var_info = datahandle_output->getStateData(iVar);
+    CFuint var_var = var_info.first;
+    CFuint var_nbvars = var_info.second;
+    DataHandle<CFreal> var = var_info.third;
+
+    for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
+    {
+      values[iNode] = var(nodalStates.getStateLocalID(iNode), var_var, var_nbvars);
+    }
+    appended.writeBlock(values);
+  }
+
+  values.assign(3*nbrNodes, 0.);
+  for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
+  {
+    for (CFuint iCoor = 0; iCoor < dim; ++iCoor)
+    {
+      values[3*iNode + iCoor] = (*nodes[iNode])[iCoor]*refL;
+    }
+  }
+  appended.writeBlock(values);
+
+  // free the memory of the nodal values before building the connectivity
+  vector<CFfloat>().swap(values);
+  vector<CFfloat>().swap(dimStates);
+  vector<CFfloat>().swap(extraStates);
+
+  // cell-node connectivity and offsets of the end of each cell in it
+  // (node ordering for one cell is the same for VTK as in COOLFluiD)
+  vector<boost::int32_t> offsets(nbrCells);
+  CFuint cellEndOffSet = 0;
+  for (CFuint iCell = 0; iCell < nbrCells; ++iCell)
+  {
+    cellEndOffSet += cellNodes->nbCols(iCell);
+    offsets[iCell] = cellEndOffSet;
+  }
+
+  {
+    vector<boost::int32_t> connectivity(cellEndOffSet);
+    for (CFuint iCell = 0, iConn = 0; iCell < nbrCells; ++iCell)
     {
-      scalarVarIdxs[iScalar] = iEq;
-      ++iScalar;
+      const CFuint nbrCellNodes = cellNodes->nbCols(iCell);
+      for (CFuint iNode = 0; iNode < nbrCellNodes; ++iNode, ++iConn)
+      {
+        connectivity[iConn] = (*cellNodes)(iCell,iNode);
+      }
     }
+    appended.writeBlock(connectivity);
   }
-  cf_assert(iScalar == nbScalars);
+  appended.writeBlock(offsets);
+  vector<boost::int32_t>().swap(offsets);
+
+  // cell types
+  /// @warning (element indexes (elemIdx) should increase monotonically here in order for this to be correct!!!)
+  vector<boost::uint8_t> types;
+  types.reserve(nbrCells);
+  const CFuint nbrElemTypes = elemType->size();
+  for (CFuint iElemType = 0; iElemType < nbrElemTypes; ++iElemType)
+  {
+    const CFuint nbrElems = (*elemType)[iElemType].getEndIdx() - (*elemType)[iElemType].getStartIdx();
+    const CFuint vtkCellType = getMethodData().getVTKCellTypeID((*elemType)[iElemType].getGeoShape(),(*elemType)[iElemType].getGeoOrder());
+    types.insert(types.end(), nbrElems, static_cast<boost::uint8_t>(vtkCellType));
+  }
+  appended.writeBlock(types);
+
+  appended.endAppendedData();
+  fout << "</VTKFile>\n";
+}
+
+//////////
+
+void WriteSolution::writePVTUFile(const vector<pair<std::string, CFuint> >& pointArrays)
+{
+  CFAUTOTRACE;
+
+  const path pieceFile = getMethodData().getPieceFilename();
+  const std::string pieceName = basename(pieceFile) + extension(pieceFile);
+
+  const CFuint nbProcesses = PE::GetPE().GetProcessorCount();
+  const CFuint myRank = PE::GetPE().GetRank();
+  MPI_Comm comm = PE::GetPE().GetCommunicator();
+
+  // gather the names of all the pieces on the first process
+  int nameSize = pieceName.size();
+  vector<int> nameSizes(nbProcesses, 0);
+  MPI_Gather(&nameSize, 1, Common::MPIStructDef::getMPIType(&nameSize),
+             &nameSizes[0], 1, Common::MPIStructDef::getMPIType(&nameSizes[0]), 0, comm);
+
+  vector<int> disps(nbProcesses, 0);
+  for (CFuint i = 1; i < nbProcesses; ++i)
+  {
+    disps[i] = disps[i-1] + nameSizes[i-1];
+  }
+
+  vector<char> names(disps.back() + nameSizes.back() + 1, '\0');
+  MPI_Gatherv(const_cast<char*>(pieceName.c_str()), nameSize, MPI_CHAR,
+              &names[0], &nameSizes[0], &disps[0], MPI_CHAR, 0, comm);
+
+  if (myRank != 0) return;
+
+  const path pvtuFile = getMethodData().getIndexFilename();
+
+  CFout << "Writing parallel solution index to: " << pvtuFile.string() << "\n";
+
+  SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
+    Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
+  ofstream& fout = fhandle->open(pvtuFile);
+
+  fout << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order="
+       << (isLittleEndian() ? "\"LittleEndian\"" : "\"BigEndian\"")
+       << " header_type=\"UInt64\">\n";
+  fout << "  <PUnstructuredGrid GhostLevel=\"0\">\n";
+
+  fout << "    <PPointData";
+  if (!pointArrays.empty())
+  {
+    fout << " Scalars=\"" << getMethodData().getUpdateVarSet()->getVarNames()[0] << "\"";
+  }
+  fout << ">\n";
+  for (CFuint i = 0; i < pointArrays.size(); ++i)
+  {
+    fout << "      <PDataArray type=\"Float32\" Name=\"" << pointArrays[i].first
+         << "\" NumberOfComponents=\"" << pointArrays[i].second << "\"/>\n";
+  }
+  fout << "    </PPointData>\n";
+
+  fout << "    <PPoints>\n";
+  fout << "      <PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n";
+  fout << "    </PPoints>\n";
+
+  for (CFuint i = 0; i < nbProcesses; ++i)
+  {
+    fout << "    <Piece Source=\"" << std::string(&names[disps[i]], nameSizes[i]) << "\"/>\n";
+  }
+
+  fout << "  </PUnstructuredGrid>\n";
+  fout << "</VTKFile>\n";
+
+  fhandle->close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void WriteSolution::writeToFileStream(std::ofstream& fout)
+{
+  CFAUTOTRACE;
+
+  if (!getMethodData().onlySurface())
+  {
+
+  // get the nodes datahandle
+  DataHandle < Framework::Node*, Framework::GLOBAL > nodes = socket_nodes.getDataHandle();
+
+  // get iterator for nodal states datahandle
+  DataHandle<ProxyDofIterator<RealVector>*> nstatesProxy = socket_nstatesProxy.getDataHandle();
+
+  // this is a sort of handle for the nodal states
+  // (which can be stored as arrays of State*, RealVector* or
+  // RealVector but they are used as arrays of RealVector*)
+  ProxyDofIterator<RealVector>& nodalStates = *nstatesProxy[0];
+
+  // get the cells
+  SafePtr<TopologicalRegionSet> elements = MeshDataStack::getActive()->getTrs("InnerCells");
+
+  // get cell-node connectivity
+  SafePtr<MeshData::ConnTable> cellNodes = MeshDataStack::getActive()->getConnectivity("cellNodes_InnerCells");
+
+  // number of cells and nodes
+  const CFuint nbrCells = elements->getLocalNbGeoEnts();
+  const CFuint nbrNodes = nodes.size();
+  cf_assert(cellNodes->nbRows() == nbrCells);
+
+  // we will assume that the number of nodes is the same as
+  // the number of states but the connectivity might be different
+  //   cf_assert(nodes.size() == nodalStates.getSize());
+
+  // get the element type data
+  SafePtr<vector<ElementTypeData> > elemType =  MeshDataStack::getActive()->getElementTypeData();
+
+  // get dimensionality, number of variables and reference length
+  const CFuint dim = PhysicalModelStack::getActive()->getDim();
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  const CFreal refL = PhysicalModelStack::getActive()->getImplementor()->getRefLength();
+
+  // indices of the variables that are vector components and of the scalar variables
+  vector<CFuint> vectorComponentIdxs;
+  vector<CFuint> scalarVarIdxs;
+  getVariableIdxs(vectorComponentIdxs, scalarVarIdxs);
+  const CFuint nbVecComponents = vectorComponentIdxs.size();
+  const CFuint nbScalars = scalarVarIdxs.size();
 
   // get ConvectiveVarSet
   SafePtr<ConvectiveVarSet> updateVarSet = getMethodData().getUpdateVarSet();
@@ -93,6 +93,28 @@ protected:
    */
   void writeToFileStream(std::ofstream& fout);
 
+  /**
+   * Write the MeshData to the given file stream in VTK XML
+   * appended raw binary format
+   * @param pointArrays  names and number of components of the written point data
+   */
+  void writeToBinaryFileStream(std::ofstream& fout,
+                               std::vector<std::pair<std::string, CFuint> >& pointArrays);
+
+  /**
+   * Get the indices of the variables written as components of a vector
+   * (velocity or momentum) and of the scalar variables
+   */
+  void getVariableIdxs(std::vector<CFuint>& vectorComponentIdxs,
+                       std::vector<CFuint>& scalarVarIdxs) const;
+
+  /**
+   * Write the parallel .pvtu file listing the pieces written by all the
+   * processes (collective, only the first process writes)
+   * @param pointArrays  names and number of components of the point data
+   */
+  void writePVTUFile(const std::vector<std::pair<std::string, CFuint> >& pointArrays);
+
   /**
    * Write the boundary surface data
    */
@@ -128,6 +150,9 @@ private:
   /// File format to write in (ASCII or Binary)
   std::string m_fileFormatStr;
 
+  /// compress the binary data with zlib
+  bool m_compress;
+
 }; // class WriteSolution
 
 //////////////////////////////////////////////////////////////////////////////
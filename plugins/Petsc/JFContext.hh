@@ -38,7 +38,8 @@ class JFContext {
 public: // functions
 
   /// Constructor
-  JFContext() : states(CFNULL), rhs(CFNULL), rhsVec(CFNULL) {}
+  JFContext() : states(CFNULL), rhs(CFNULL), rhsVec(CFNULL), 
+		adaptiveEps(false), statesNorm(0.), isContiguous(false) {}
   
   /// pointer to the Petsc method data 
   Common::SafePtr<PetscLSSData> petscData;
@@ -64,6 +65,17 @@ public: // functions
   /// Order of the Jacobian-free matrix vector product approximation (1 or 2)
   bool jfApprox2ndOrder;
   
+  /// flag telling to scale eps with the norms of the states and of the 
+  /// perturbation at every matrix vector product
+  bool adaptiveEps;
+  
+  /// global norm of the updatable states around which the residual is linearized
+  CFreal statesNorm;
+  
+  /// flag telling if upStatesGlobalIDs are the owned entries of the Petsc vectors
+  /// in order, so that these can be accessed directly through VecGetArray()
+  bool isContiguous;
+  
   /// Enable/Disable usage of different preconditioner matrix
 	bool differentPreconditionerMatrix;
   
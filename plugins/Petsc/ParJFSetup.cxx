@@ -51,6 +51,9 @@ BaseSetup(name)
 
   _jfApprox2ndOrder = false;
   setParameter("JFApprox2ndOrder", &_jfApprox2ndOrder);
+  
+  _adaptiveEpsilon = false;
+  setParameter("AdaptiveEpsilon", &_adaptiveEpsilon);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -66,6 +69,8 @@ void ParJFSetup::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< CFreal >("Epsilon","Epsilon for computing numerical derivative");
 
   options.addConfigOption< bool >("JFApprox2ndOrder", "2nd order of the Jacobian-free matrix vector product approximation (options: true/false)");
+  
+  options.addConfigOption< bool >("AdaptiveEpsilon", "Use Epsilon*sqrt(1+||U||)/||v|| as perturbation for each product J*v (Walker-Pernice)");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -127,6 +132,7 @@ void ParJFSetup::setMatrix(const CFuint localSize,
   ctx->spaceMethod = getMethodData().getCollaborator<SpaceMethod>();
   ctx->eps = _epsilon;
   ctx->jfApprox2ndOrder = _jfApprox2ndOrder;
+  ctx->adaptiveEps = _adaptiveEpsilon;
   ctx->differentPreconditionerMatrix = getMethodData().getDifferentPreconditionerMatrix();
 
   ctx->bkpStates.resize(nbStates*nbEqs);
@@ -72,6 +72,9 @@ private:
 
   /// Order of the Jacobian-free matrix vector product approximation (1 or 2)
   bool _jfApprox2ndOrder;
+  
+  /// flag telling to adapt epsilon at every matrix vector product
+  bool _adaptiveEpsilon;
 
 }; // class Setup
 
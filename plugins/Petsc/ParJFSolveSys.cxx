@@ -19,6 +19,7 @@
 #include "Petsc/DPLURPreconditioner.hh"
 #include "Petsc/TridiagPreconditioner.hh"
 #include "Common/PE.hh"
+#include "Common/MPI/MPIStructDef.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -89,6 +90,34 @@ void ParJFSolveSys::execute()
   cf_assert(_upLocalIDs.size() == _upStatesGlobalIDs.size());
   const CFuint vecSize = _upLocalIDs.size();
 
+  // check if the updatable entries can be accessed in the local storage 
+  // of the Petsc vectors and, if requested, compute the norm of the states
+  PetscInt low = 0;
+  PetscInt high = 0;
+  CF_CHKERRCONTINUE(VecGetOwnershipRange(getMethodData().getRhsVector().getVec(), &low, &high));
+  int isContiguous = (high - low == (PetscInt)vecSize);
+  for (CFuint i = 0; i < vecSize && isContiguous; ++i) {
+    isContiguous = (_upStatesGlobalIDs[i] == low + (PetscInt)i);
+  }
+  
+  CFreal localNorm[2] = {0., (isContiguous) ? 0. : 1.};
+  if (jfc->adaptiveEps) {
+    for(CFuint i = 0; i < nbStates; ++i) {
+      if (states[i]->isParUpdatable()) {
+	const State& currState = *states[i];
+	for(CFuint j = 0; j < nbEqs; ++j) {
+	  localNorm[0] += currState[j]*currState[j];
+	}
+      }
+    }
+  }
+  
+  // all the processors must take the same path, the other one being collective
+  CFreal globalNorm[2] = {0., 0.};
+  MPI_Allreduce(localNorm, globalNorm, 2, MPIStructDef::getMPIType(&localNorm[0]), MPI_SUM, PETSC_COMM_WORLD);
+  jfc->statesNorm = std::sqrt(globalNorm[0]);
+  jfc->isContiguous = (globalNorm[1] == 0.);
+
   PetscMatrix& mat = getMethodData().getMatrix();
   PetscMatrix& precondMat = getMethodData().getPreconditionerMatrix();
 
@@ -189,127 +218,152 @@ void ParJFSolveSys::setup()
 
 //////////////////////////////////////////////////////////////////////////////
 
-PetscErrorCode computeJFMat(Mat petscMat, Vec x, Vec y)
+/// Sets the updatable states to U + eps*v, U being the backed up states,
+/// and computes the corresponding residual
+static void computePerturbedResidual(JFContext* jfc, const CFreal* v, const CFreal eps)
 {
-  void* ctx;
-
-  CF_CHKERRCONTINUE(MatShellGetContext(petscMat, &ctx));
-
-  JFContext* jfc = (JFContext*)(ctx);
   DataHandle<State*, GLOBAL> states = jfc->states->getDataHandle(); 
-
+  DataHandle<CFreal> updateCoeff = jfc->updateCoeff->getDataHandle();
+  const RealVector& bkpStates = jfc->bkpStates; 
   const CFuint nbEqs = states[0]->size();
   const CFuint nbStates = states.size();
-
-  DataHandle<CFreal> rhs = jfc->rhs->getDataHandle(); 
-  DataHandle<CFreal> updateCoeff = jfc->updateCoeff->getDataHandle();
-  SafePtr<PetscVector> rhsVec = jfc->rhsVec;
-
-  CFreal* statesArray;
-  CF_CHKERRCONTINUE(VecGetArray(x, &statesArray));
-
-  // loop over states - doing backup of states vector
-  RealVector& bkpStates = jfc->bkpStates; 
-  RealVector& bkpUpdateCoeff = jfc->bkpUpdateCoeff;
-
-  const CFreal eps = jfc->eps;
-
+  
   CFuint idx = 0;
-
-  CFreal* rhsArray;
-  CF_CHKERRCONTINUE(VecGetArray(rhsVec->getVec(), &rhsArray));
-
-  for(CFuint i = 0; i < nbStates; ++i) 
-  {
-    if (states[i]->isParUpdatable()) 
-    {
+  for(CFuint i = 0; i < nbStates; ++i) {
+    if (states[i]->isParUpdatable()) {
       const CFuint idxTimesEq = idx*nbEqs;
       const CFuint iTimesEq = i*nbEqs;
       State& currState = *states[i];
       for(CFuint j = 0; j < nbEqs; ++j) {
-        // states = U + eps*delta_U, U = bkpStates, delta_U = statesArray
-        currState[j] = bkpStates[iTimesEq + j] + eps*statesArray[idxTimesEq + j];
+        // states = U + eps*delta_U, U = bkpStates, delta_U = v
+        currState[j] = bkpStates[iTimesEq + j] + eps*v[idxTimesEq + j];
       }
       idx++;
     }
-
-    // back up the update coefficient
-    bkpUpdateCoeff[i] = updateCoeff[i];
   }
-
+  
   // syncronize the states after the modifications
   states.beginSync();
   states.endSync();
-
+  
   // computation of F(U + eps*delta_U)
   jfc->spaceMethod->setComputeJacobianFlag(false);
-
+  
   // reset to 0. the updateCoeff storage
   updateCoeff = 0.0;
   jfc->spaceMethod->computeSpaceResidual(1.0);
   jfc->spaceMethod->computeTimeResidual(1.0);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+PetscErrorCode computeJFMat(Mat petscMat, Vec x, Vec y)
+{
+  void* ctx;
+
+  CF_CHKERRCONTINUE(MatShellGetContext(petscMat, &ctx));
 
+  JFContext* jfc = (JFContext*)(ctx);
+  DataHandle<State*, GLOBAL> states = jfc->states->getDataHandle(); 
+
+  const CFuint nbEqs = states[0]->size();
+  const CFuint nbStates = states.size();
+
+  DataHandle<CFreal> rhs = jfc->rhs->getDataHandle(); 
+  DataHandle<CFreal> updateCoeff = jfc->updateCoeff->getDataHandle();
+  SafePtr<PetscVector> rhsVec = jfc->rhsVec;
+  
+  CFreal eps = jfc->eps;
+  if (jfc->adaptiveEps) {
+    // Walker-Pernice: eps = Epsilon*sqrt(1 + ||U||)/||delta_U||
+    CFreal normV = 0.;
+    CF_CHKERRCONTINUE(VecNorm(x, NORM_2, &normV));
+    if (normV == 0.) {
+      // J*0 = 0, no residual to compute
+      CF_CHKERRCONTINUE(VecSet(y, 0.));
+      PetscFunctionReturn(0);
+    }
+    eps *= std::sqrt(1. + jfc->statesNorm)/normV;
+  }
+  
+  CFreal* statesArray;
+  CF_CHKERRCONTINUE(VecGetArray(x, &statesArray));
+
+  // loop over states - doing backup of the update coefficient
+  RealVector& bkpStates = jfc->bkpStates; 
+  RealVector& bkpUpdateCoeff = jfc->bkpUpdateCoeff;
+  for(CFuint i = 0; i < nbStates; ++i) {
+    bkpUpdateCoeff[i] = updateCoeff[i];
+  }
+  
+  CFreal* rhsArray;
+  CF_CHKERRCONTINUE(VecGetArray(rhsVec->getVec(), &rhsArray));
+  
+  // if the owned entries of y are the updatable ones in order, the result
+  // is written directly in the local storage of y, with no assembly
+  CFreal* yArray = CFNULL;
+  if (jfc->isContiguous) {
+    CF_CHKERRCONTINUE(VecGetArray(y, &yArray));
+  }
+  
+  computePerturbedResidual(jfc, statesArray, eps);
+  
+  const CFuint vecSize = jfc->upLocalIDs.size();
   if (!jfc->jfApprox2ndOrder) { // if 1st order of J-F approximation was chosen
     // final assignment into PetscVec y
-    const CFuint vecSize = jfc->upLocalIDs.size();
     const CFreal invEps = 1.0/eps;
-    for(CFuint i = 0; i < vecSize; ++i) {
-      const CFreal Fv = (rhsArray[i] - rhs[jfc->upLocalIDs[i]])*invEps;
-      VecSetValue(y, jfc->upStatesGlobalIDs[i], Fv, INSERT_VALUES);
+    if (jfc->isContiguous) {
+      for(CFuint i = 0; i < vecSize; ++i) {
+	yArray[i] = (rhsArray[i] - rhs[jfc->upLocalIDs[i]])*invEps;
+      }
+    }
+    else {
+      for(CFuint i = 0; i < vecSize; ++i) {
+	const CFreal Fv = (rhsArray[i] - rhs[jfc->upLocalIDs[i]])*invEps;
+	VecSetValue(y, jfc->upStatesGlobalIDs[i], Fv, INSERT_VALUES);
+      }
+      CF_CHKERRCONTINUE(VecAssemblyBegin(y));
+      CF_CHKERRCONTINUE(VecAssemblyEnd(y));
     }
   }
   else { // if 2nd order of J-F approximation was chosen
     // assignment of RHS(U + eps*deltaU) into PetscVec y
-    const CFuint vecSize = jfc->upLocalIDs.size();
-    for(CFuint i = 0; i < vecSize; ++i) {
-      VecSetValue(y, jfc->upStatesGlobalIDs[i], -rhs[jfc->upLocalIDs[i]], INSERT_VALUES);
-    }
-
-    CF_CHKERRCONTINUE(VecAssemblyBegin(y));
-    CF_CHKERRCONTINUE(VecAssemblyEnd(y));
-
-    idx = 0;
-    for(CFuint i = 0; i < nbStates; ++i) {
-      if (states[i]->isParUpdatable()) {
-        const CFuint idxTimesEq = idx*nbEqs;
-        const CFuint iTimesEq = i*nbEqs;
-        State& currState = *states[i];
-        for(CFuint j = 0; j < nbEqs; ++j) {
-          // states = U - eps*delta_U, U = bkpStates, delta_U = statesArray
-          currState[j] = bkpStates[iTimesEq + j] - eps*statesArray[idxTimesEq + j];
-        }
-        idx++;
+    if (jfc->isContiguous) {
+      for(CFuint i = 0; i < vecSize; ++i) {
+	yArray[i] = -rhs[jfc->upLocalIDs[i]];
       }
     }
-
-    // syncronize the states after the modifications
-    states.beginSync();
-    states.endSync();
-
-    // computation of F(U + eps*delta_U)
-    jfc->spaceMethod->setComputeJacobianFlag(false);
-
-    // reset to 0. the updateCoeff storage
-    updateCoeff = 0.0;
-    jfc->spaceMethod->computeSpaceResidual(1.0);
-    jfc->spaceMethod->computeTimeResidual(1.0);
-
-    // assignment of RHS(U - eps*deltaU) to y vector
-    for(CFuint i = 0; i < vecSize; ++i) {
-      VecSetValue(y, jfc->upStatesGlobalIDs[i], rhs[jfc->upLocalIDs[i]], ADD_VALUES);
+    else {
+      for(CFuint i = 0; i < vecSize; ++i) {
+	VecSetValue(y, jfc->upStatesGlobalIDs[i], -rhs[jfc->upLocalIDs[i]], INSERT_VALUES);
+      }
+      CF_CHKERRCONTINUE(VecAssemblyBegin(y));
+      CF_CHKERRCONTINUE(VecAssemblyEnd(y));
     }
-
-    CF_CHKERRCONTINUE(VecAssemblyBegin(y));
-    CF_CHKERRCONTINUE(VecAssemblyEnd(y));
-
-    // multiplying with 1.0/2eps
+    
+    // computation of F(U - eps*delta_U)
+    computePerturbedResidual(jfc, statesArray, -eps);
+    
+    // assignment of RHS(U - eps*deltaU) to y vector, multiplied with 1.0/2eps
     const CFreal inv2Eps = 0.5/eps;
-    CF_CHKERRCONTINUE(VecScale (y, inv2Eps));
+    if (jfc->isContiguous) {
+      for(CFuint i = 0; i < vecSize; ++i) {
+	yArray[i] = (yArray[i] + rhs[jfc->upLocalIDs[i]])*inv2Eps;
+      }
+    }
+    else {
+      for(CFuint i = 0; i < vecSize; ++i) {
+	VecSetValue(y, jfc->upStatesGlobalIDs[i], rhs[jfc->upLocalIDs[i]], ADD_VALUES);
+      }
+      CF_CHKERRCONTINUE(VecAssemblyBegin(y));
+      CF_CHKERRCONTINUE(VecAssemblyEnd(y));
+      CF_CHKERRCONTINUE(VecScale (y, inv2Eps));
+    }
+  }
+  
+  if (jfc->isContiguous) {
+    CF_CHKERRCONTINUE(VecRestoreArray(y, &yArray));
   }
-
-  CF_CHKERRCONTINUE(VecAssemblyBegin(y));
-  CF_CHKERRCONTINUE(VecAssemblyEnd(y));
-
   CF_CHKERRCONTINUE(VecRestoreArray(x, &statesArray));
   CF_CHKERRCONTINUE(VecRestoreArray(rhsVec->getVec(), &rhsArray));
 
@@ -61,6 +61,9 @@ public:
     m_radPhysicsHandlerPtr = radPhysicsHandlerPtr;
   }
 
+  /// Gets the random number generator, to set the stream of the current photon
+  RandomNumberGenerator& getRandomGenerator() {return m_rand;}
+
   CFreal getCurrentCellVolume();
   CFreal getCurrentWallArea();
 
@@ -57,6 +57,9 @@ public:
     m_radPhysicsHandlerPtr = radPhysicsHandlerPtr;
   }
 
+  /// Gets the random number generator, to set the stream of the current photon
+  RandomNumberGenerator& getRandomGenerator() {return m_rand;}
+
 protected:
   RadiationPhysics *m_radPhysicsPtr;
   RadiationPhysicsHandler *m_radPhysicsHandlerPtr;
@@ -35,6 +35,8 @@ struct PhotonData{
     CFreal KS;
     CFreal energyFraction;
     CFreal wavelength;
+    /// random stream of the photon, which travels with it across the partitions
+    RandomStream stream;
 };
 
 typedef LagrangianSolver::Particle<PhotonData> Photon;
@@ -134,6 +136,11 @@ private:
   
   bool getCellPhotonData(Photon& ray);
 
+  /// Starts the random stream of a new photon, identified by its source
+  /// and by its index among the photons of the source, so that it does not
+  /// depend on the partitioning nor on the order in which photons are traced
+  void newPhotonStream(Photon& ray, CFuint sourceID, CFuint sourceTag, CFuint photonIdx);
+
 private: 
 
   //PostProcessAverage m_postProcess;
@@ -229,6 +236,24 @@ private:
   
   RandomNumberGenerator m_rand;
 
+  /// seed of the random streams
+  CFuint m_randomSeed;
+
+  /// number of photon generations, to give different streams to each of them
+  CFuint m_nbGenerations;
+
+  /// next cell state and photon to emit
+  CFuint m_cellPhotonState, m_cellPhoton;
+
+  /// next wall ghost state and photon to emit
+  CFuint m_wallPhotonGState, m_wallPhoton;
+
+  /// global ID of the wall face of each ghost state, identifying its photons
+  vector<CFuint> m_ghostStateSourceIDs;
+
+  /// index plus one of the wall TRS of each ghost state, identifying its photons
+  vector<CFuint> m_ghostStateSourceTags;
+
   //PostProcess m_postProcess;
 
   CFuint m_sendBufferSize;
@@ -315,6 +340,7 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::defineConfigOptions(Config:
   options.addConfigOption< string >("PostProcessName","Name of the post process routine");
   options.addConfigOption< CFuint >("sendBufferSize","Size of the buffer for comunication");
   options.addConfigOption< CFuint >("nbRaysCycle","Number of rays to emmint before communication step");
+  options.addConfigOption< CFuint >("RandomSeed","Seed of the random streams of the photons.");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -356,6 +382,13 @@ RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::RadiativeTransferMonteCarlo(cons
 
   m_nbRaysCycle = m_sendBufferSize / 2;
   setParameter("nbRaysCycle", &m_nbRaysCycle);
+
+  m_randomSeed = 0;
+  setParameter("RandomSeed", &m_randomSeed);
+
+  m_nbGenerations = 0;
+  m_cellPhotonState = m_cellPhoton = 0;
+  m_wallPhotonGState = m_wallPhoton = 0;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -484,9 +517,10 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::setup()
   MPIStruct Userdatatype;//, particleDatatype;
 
   PhotonData photonData;
-  int counts[3] = {1,1,1};
-  MPIStructDef::buildMPIStruct<CFreal,CFreal,CFreal>
-          (&photonData.KS, &photonData.energyFraction, &photonData.wavelength, counts , Userdatatype);
+  int counts[5] = {1,1,1,5,1};
+  MPIStructDef::buildMPIStruct<CFreal,CFreal,CFreal,boost::uint32_t,boost::uint32_t>
+          (&photonData.KS, &photonData.energyFraction, &photonData.wavelength,
+           &photonData.stream.key[0], &photonData.stream.position, counts , Userdatatype);
 
   m_lagrangianSolver.setupParticleDatatype( Userdatatype.type );
  // particleDatatype.type = m_lagrangianSolver.getParticleDataType();
@@ -503,12 +537,24 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::setup()
   m_lagrangianSolver.setFaceTypes(wallTrsNames, boundaryTrsNames );
 
   // preallocation of memory for qradFluxWall
+  // and identification of the photons emitted by each wall face
   CFuint nbFaces = 0;
   FaceTrsGeoBuilder::GeoData& WallFacesData = m_wallFaceBuilder.getDataGE();
+  m_ghostStateSourceIDs.assign(socket_gstates.getDataHandle().size(), 0);
+  m_ghostStateSourceTags.assign(socket_gstates.getDataHandle().size(), 0);
   for(CFuint j=0; j<wallTrsNames.size(); ++j){
     SafePtr<TopologicalRegionSet> WallFaces = MeshDataStack::getActive()->getTrs(wallTrsNames[j]);
     WallFacesData.trs = WallFaces;
-    nbFaces += WallFaces->getLocalNbGeoEnts();
+    const CFuint nbFacesWall = WallFaces->getLocalNbGeoEnts();
+    for(CFuint f=0; f<nbFacesWall; ++f){
+      WallFacesData.idx = f;
+      Framework::GeometricEntity *const face = m_wallFaceBuilder.buildGE();
+      const CFuint faceGhostStateID = face->getState(1)->getLocalID();
+      m_ghostStateSourceIDs[faceGhostStateID] = WallFaces->getGlobalGeoID(f);
+      m_ghostStateSourceTags[faceGhostStateID] = j+1;
+      m_wallFaceBuilder.releaseGE();
+    }
+    nbFaces += nbFacesWall;
   }
   socket_qradFluxWall.getDataHandle().resize(nbFaces);
 
@@ -617,12 +663,14 @@ template<class PARTICLE_TRACKING>
 bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getCellPhotonData(Photon &ray){
 	
     //static CellTrsGeoBuilder::GeoData& cellData = m_cellBuilder.getDataGE();
-    static CFuint photon=0, state=0;
-    static CFuint nbStates = m_nbPhotonsState.size();
+    Framework::DataHandle<Framework::State*, Framework::GLOBAL> states
+            = socket_states.getDataHandle();
+    const CFuint nbStates = m_nbPhotonsState.size();
 
-    for(;state<nbStates; ++state)
+    for(;m_cellPhotonState<nbStates; ++m_cellPhotonState)
     {
-      for(;photon<m_nbPhotonsState[state];)
+      const CFuint state = m_cellPhotonState;
+      for(;m_cellPhoton<m_nbPhotonsState[state];)
       {
 //        cout<<"m_nbPhotonsState[state]: "<<m_nbPhotonsState[state]<<' '<<";state: "<<state<<endl;
 //        cout<<"photon: "<<photon<<endl;
@@ -635,10 +683,14 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getCellPhotonData(Photon &r
         // Calculate the wavelength
         //cout<<"wavelength= "<<ray.userData.wavelength<<endl;
 
+        newPhotonStream(ray, states[state]->getGlobalID(), 0, m_cellPhoton);
+
         //Get directions
         RealVector directions(m_dim2);
-        m_radiation->getCellDistPtr(state)->
-            getRadiatorPtr()->getRandomEmission(ray.userData.wavelength, directions );
+        Radiator* const radiator = m_radiation->getCellDistPtr(state)->getRadiatorPtr();
+        radiator->getRandomGenerator().setStream(ray.userData.stream);
+        radiator->getRandomEmission(ray.userData.wavelength, directions );
+        radiator->getRandomGenerator().getStream(ray.userData.stream);
 
         //cout<<"ray directions: ";
         for(CFuint ii=0; ii<m_dim2; ++ii){
@@ -647,13 +699,12 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getCellPhotonData(Photon &r
         //cout<<endl;
 
         //Get the beam max optical path Ks
+        m_rand.setStream(ray.userData.stream);
         ray.userData.KS = - std::log( m_rand.uniformRand() );
+        m_rand.getStream(ray.userData.stream);
         // ray.actualKS = 0;
 
         //Get cell center
-        static Framework::DataHandle<Framework::State*, Framework::GLOBAL> states
-                = socket_states.getDataHandle();
-
         Node& baricenter = (*states[state]).getCoordinates();
 
         //RealVector baricenter(_dim);
@@ -680,10 +731,10 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getCellPhotonData(Photon &r
         ray.userData.energyFraction= m_stateRadPower[state]/CFreal(m_nbPhotonsState[state]);
 
         //m_cellBuilder.releaseGE();
-        ++photon;
+        ++m_cellPhoton;
         return true;
       }
-       photon=0;
+       m_cellPhoton=0;
     }
     return false;
 }
@@ -692,12 +743,14 @@ template<class PARTICLE_TRACKING>
 bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getFacePhotonData(Photon &ray){
 
   //static CellTrsGeoBuilder::GeoData& cellData = m_cellBuilder.getDataGE();
-  static CFuint photon=0, gState=0;
-  static CFuint nbGstates = m_nbPhotonsGhostState.size();
+  Framework::DataHandle<Framework::State*, Framework::GLOBAL> states
+          = socket_states.getDataHandle();
+  const CFuint nbGstates = m_nbPhotonsGhostState.size();
 
-  for(; gState < nbGstates ; ++gState)
+  for(; m_wallPhotonGState < nbGstates ; ++m_wallPhotonGState)
   {
-    for(;photon<m_nbPhotonsGhostState[gState];)
+    const CFuint gState = m_wallPhotonGState;
+    for(;m_wallPhoton<m_nbPhotonsGhostState[gState];)
     {
       //cout<<"m_nbPhotonsState[state]: "<<m_nbPhotonsState[state]<<' '<<";state: "<<state<<endl;
       //cout<<"photon: "<<photon<<endl;
@@ -710,19 +763,20 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getFacePhotonData(Photon &r
       // Calculate the wavelength
       //cout<<"wavelength= "<<ray.userData.wavelength<<endl;
 
+      newPhotonStream(ray, m_ghostStateSourceIDs[gState], m_ghostStateSourceTags[gState], m_wallPhoton);
+
       //Get directions
 
       RealVector directions(m_dim2);
-      m_radiation->getWallDistPtr( gState )->
-          getRadiatorPtr()->getRandomEmission(ray.userData.wavelength, directions );
+      Radiator* const radiator = m_radiation->getWallDistPtr( gState )->getRadiatorPtr();
+      radiator->getRandomGenerator().setStream(ray.userData.stream);
+      radiator->getRandomEmission(ray.userData.wavelength, directions );
+      radiator->getRandomGenerator().getStream(ray.userData.stream);
 
 
       CFuint faceGeoID = m_radiation->getCurrentWallGeoID();
       CFuint cellID = m_lagrangianSolver.getWallStateId( faceGeoID );
 
-      static Framework::DataHandle<Framework::State*, Framework::GLOBAL> states
-              = socket_states.getDataHandle();
-
       Node& cellCenter = (*states[cellID]).getCoordinates();
 
 
@@ -734,6 +788,7 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getFacePhotonData(Photon &r
       //cout<<" ]; "<<endl;
 
       //Get the beam max optical path Ks
+      m_rand.setStream(ray.userData.stream);
       ray.userData.KS = - std::log( m_rand.uniformRand() );
       // ray.actualKS = 0;
 
@@ -800,16 +855,33 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getFacePhotonData(Photon &r
       ray.commonData.cellID = cellID;
 
       ray.userData.energyFraction= m_ghostStateRadPower[gState]/CFreal(m_nbPhotonsGhostState[gState]);
+      m_rand.getStream(ray.userData.stream);
 
       //m_cellBuilder.releaseGE();
-      ++photon;
+      ++m_wallPhoton;
       return true;
     }
-    photon=0;
+    m_wallPhoton=0;
   }
   return false;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+template<class PARTICLE_TRACKING>
+void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::newPhotonStream(Photon& ray,
+                                                                    CFuint sourceID,
+                                                                    CFuint sourceTag,
+                                                                    CFuint photonIdx)
+{
+  RandomStream& stream = ray.userData.stream;
+  stream.key[0] = m_randomSeed;
+  stream.key[1] = m_nbGenerations;
+  stream.id[0] = sourceID;
+  stream.id[1] = photonIdx;
+  stream.id[2] = sourceTag;
+  stream.position = 0;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 template<class PARTICLE_TRACKING>
 void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::computePhotons()
@@ -817,7 +889,10 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::computePhotons()
   CFLog(DEBUG_MAX, "RadiativeTransferMonteCarlo::computeCellRays()\n");
 
 
-  m_rand.seed(time(NULL)*(m_myProcessRank+1));
+  // the photons of each generation have their own streams
+  ++m_nbGenerations;
+  m_cellPhotonState = m_cellPhoton = 0;
+  m_wallPhotonGState = m_wallPhoton = 0;
 
 
   // CFuint totalnbPhotons =  (m_nbRaysElem )* m_radiation->getNbStates();
@@ -851,7 +926,20 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::computePhotons()
   vector< Photon > photonStack;
   photonStack.reserve(m_sendBufferSize);
   while( !done ){
+    //      CFLog(INFO, "raytrace the outer photons \n");
+    //those leaving the partition are sent at the next exchange
     recvSize = photonStack.size();
+    for(CFuint i = 0; i< photonStack.size(); ++i ){
+      //photon=photonStack[i];
+      //CFLog(INFO,"PHOTON: " << photon.cellID<<' '<<photon.userData.KS<<'\n' );
+      //printPhoton(photonStack[i]);
+      rayTracing( photonStack[i] );
+    }
+
+    //start sending the photons and generate the new ones in the meantime
+    bool isLastPhoton = (toGenerateCellPhotons + toGenerateWallPhotons == 0);
+    m_lagrangianSolver.startSincronizeParticles(isLastPhoton);
+
     //generate and raytrace the inner photons
     CFuint nbCellPhotons =
         std::min(std::max(CFint(m_nbRaysCycle) - CFint(recvSize),(CFint)0), CFint(toGenerateCellPhotons) );
@@ -881,26 +969,9 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::computePhotons()
       if (m_myProcessRank == 0)  ++*(progressBar);
     }
 
-    //      CFLog(INFO, "raytrace the outer photons \n");
-    for(CFuint i = 0; i< photonStack.size(); ++i ){
-      //photon=photonStack[i];
-      //CFLog(INFO,"PHOTON: " << photon.cellID<<' '<<photon.userData.KS<<'\n' );
-      //printPhoton(photonStack[i]);
-      rayTracing( photonStack[i] );
-    }
-
     //sincronize
     //      CFLog(INFO, "sincronizing\n");
-    bool isLastPhoton = (toGenerateCellPhotons + toGenerateWallPhotons == 0);
-    done = m_lagrangianSolver.sincronizeParticles(photonStack, isLastPhoton);
-
-    //      CFLog(INFO, "done Sincronizing; "<< "receiv_size= "<< photonStack.size()
-    //        << " photons to Generate= "<<toGenerateCellPhotons <<"\n");
-
-    //      if(m_myProcessRank == 0){
-    //       cout<<"Done sincronizing"<<endl<<"CPU "<<m_myProcessRank<< " has received: "<<photonStack.size()<<
-    //             " photons and has generated "<< totalnbPhotons-toGeneratePhotons <<" photons"<<endl;
-    //      }
+    done = m_lagrangianSolver.finishSincronizeParticles(photonStack);
   }
   delete progressBar;
 
@@ -947,7 +1018,7 @@ CFuint RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::rayTracing(Photon& beam)
 {
   CFuint nbCrossedCells = 0;
   CFuint nbIter = 0;
-  static CFint exitCellID, exitFaceID, currentCellID;
+  CFint exitCellID, exitFaceID, currentCellID;
   //CFLog(INFO, "start Raytracing\n");
 
   //CFLog(DEBUG_MAX, "RadiativeTransferMonteCarlo::rayTracing() => actualCellID = " << actualCellID << "\n");
@@ -977,7 +1048,7 @@ CFuint RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::rayTracing(Photon& beam)
     exitCellID=m_lagrangianSolver.getExitCellID();
 
     if(exitFaceID>=0){
-      static CFreal cellK, stepDistance;
+      CFreal cellK, stepDistance;
 
       stepDistance=m_lagrangianSolver.getStepDistance();
       RealVector null;
@@ -1035,7 +1106,9 @@ CFuint RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::rayTracing(Photon& beam)
 
         m_lagrangianSolver.getNormals(exitFaceID,position,normal);
 
+        m_rand.setStream(beamData.stream);
         const CFreal reflectionProbability =  m_rand.uniformRand();
+        m_rand.getStream(beamData.stream);
 
         if(reflectionProbability <= wallK){ // the photon is absorved by the wall
           //cout<<"ABSORVED!"<<endl;
@@ -1049,8 +1122,11 @@ CFuint RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::rayTracing(Photon& beam)
           //CFLog(INFO,"Reflected !!\n");
 
           RealVector exitDirection(m_dim2);
-          m_radiation->getWallDistPtr(ghostStateID)->getReflectorPtr()->getRandomDirection(
+          Reflector* const reflector = m_radiation->getWallDistPtr(ghostStateID)->getReflectorPtr();
+          reflector->getRandomGenerator().setStream(beamData.stream);
+          reflector->getRandomDirection(
                 beamData.wavelength, exitDirection, entryDirection, normal);
+          reflector->getRandomGenerator().getStream(beamData.stream);
           m_lagrangianSolver.newDirection( exitDirection );
 
           //cout<<"Entry Direction: "
@@ -6,6 +6,41 @@ namespace COOLFluiD {
 namespace RadiativeTransfer {
   using namespace std;
 
+  Philox4x32::Philox4x32() :
+    m_block(0xFFFFFFFF)
+  {
+    m_stream.key[0] = m_stream.key[1] = 0;
+    m_stream.id[0] = m_stream.id[1] = m_stream.id[2] = 0;
+    m_stream.position = 0;
+  }
+
+  void Philox4x32::generateBlock(){
+    // multipliers and key increments of the reference implementation
+    static const boost::uint64_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+    static const boost::uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+
+    m_block = m_stream.position/4;
+    boost::uint32_t c[4] = {m_block, m_stream.id[0], m_stream.id[1], m_stream.id[2]};
+    boost::uint32_t k[2] = {m_stream.key[0], m_stream.key[1]};
+
+    for (CFuint round = 0; round < 10; ++round) {
+      const boost::uint64_t p0 = M0*c[0];
+      const boost::uint64_t p1 = M1*c[2];
+      const boost::uint32_t hi0 = static_cast<boost::uint32_t>(p0 >> 32);
+      const boost::uint32_t hi1 = static_cast<boost::uint32_t>(p1 >> 32);
+      c[0] = hi1 ^ c[1] ^ k[0];
+      c[1] = static_cast<boost::uint32_t>(p1);
+      c[2] = hi0 ^ c[3] ^ k[1];
+      c[3] = static_cast<boost::uint32_t>(p0);
+      k[0] += W0;
+      k[1] += W1;
+    }
+
+    for (CFuint i = 0; i < 4; ++i) {
+      m_values[i] = c[i];
+    }
+  }
+
   CFreal RandomNumberGenerator::uniformRand(const CFreal i0, const CFreal i1){
     boost::uniform_real<CFreal> uniformDist(i0,i1);
     boost::variate_generator<typeGenerator&, boost::uniform_real<CFreal> >
@@ -14,7 +49,11 @@ namespace RadiativeTransfer {
   }
 
   void RandomNumberGenerator::seed(CFuint seedNumber){
-    m_generator.seed(seedNumber);
+    RandomStream stream = m_generator.getStream();
+    stream.key[0] = static_cast<boost::uint32_t>(seedNumber);
+    stream.key[1] = 0;
+    stream.position = 0;
+    m_generator.setStream(stream);
   }
 }
 }
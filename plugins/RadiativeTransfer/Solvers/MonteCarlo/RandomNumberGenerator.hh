@@ -2,6 +2,7 @@
 #define RANDOMNUMBERGENERATOR_HH
 
 #include "MathTools/MathFunctions.hh"
+#include <boost/cstdint.hpp>
 #include <boost/random.hpp>
 #include "Common/COOLFluiD.hh"
 #include <vector>
@@ -16,7 +17,68 @@ namespace COOLFluiD {
 
 namespace RadiativeTransfer {
 
-typedef boost::mt19937 typeGenerator; //Marsenne Twister generator
+/// State of a random stream: the numbers drawn only depend on the key,
+/// on the stream identifier and on the position in the stream, so that a
+/// stream can be continued by another generator, on another process.
+struct RandomStream {
+  /// key of the generator
+  boost::uint32_t key[2];
+  /// identifier of the stream
+  boost::uint32_t id[3];
+  /// number of 32 bit values already drawn from the stream
+  boost::uint32_t position;
+};
+
+/// Counter-based Philox4x32-10 generator (Salmon et al., SC11): the n-th
+/// block of four values of a stream is obtained by encrypting the counter
+/// (n, id) with the key, so that no sequential state has to be kept
+/// and any stream can be accessed at any position.
+class Philox4x32 {
+public:
+
+  typedef boost::uint32_t result_type;
+  static const bool has_fixed_range = false;
+
+  Philox4x32();
+
+  result_type min() const {return 0;}
+  result_type max() const {return 0xFFFFFFFF;}
+
+  /// Draws the next value of the stream
+  result_type operator()()
+  {
+    if (m_block != m_stream.position/4) generateBlock();
+    return m_values[m_stream.position++ % 4];
+  }
+
+  /// Sets the stream to continue from
+  void setStream(const RandomStream& stream)
+  {
+    m_stream = stream;
+    m_block = 0xFFFFFFFF;
+  }
+
+  /// Gets the stream at the current position
+  const RandomStream& getStream() const {return m_stream;}
+
+private:
+
+  /// Computes the block of values at the current position
+  void generateBlock();
+
+private:
+
+  /// current stream
+  RandomStream m_stream;
+
+  /// index of the block of values stored in m_values
+  boost::uint32_t m_block;
+
+  /// values of the current block
+  result_type m_values[4];
+};
+
+typedef Philox4x32 typeGenerator; //counter-based generator
 
 class RandomNumberGenerator{
 
@@ -32,6 +94,12 @@ public:
 
   void seed(CFuint seedNumber);
 
+  /// Continues drawing from the given stream
+  void setStream(const RandomStream& stream) {m_generator.setStream(stream);}
+
+  /// Gets the stream at the current position
+  void getStream(RandomStream& stream) const {stream = m_generator.getStream();}
+
 private:
 
   typeGenerator m_generator;
@@ -49,6 +49,7 @@ BaseBndFaceTermComputer::BaseBndFaceTermComputer(const std::string& name) :
   m_faceIntegrationCoefs(CFNULL),
   m_faceFlxPntsFaceLocalCoords(CFNULL),
   m_faceFlxPntCellMappedCoords(CFNULL),
+  m_metricCache(CFNULL),
   m_face(),
   m_orient(),
   m_cellVolume(),
@@ -188,8 +189,8 @@ void BaseBndFaceTermComputer::computeFaceData()
   // face ID
   const CFuint faceID = m_face->getID();
 
-  // compute face Jacobian vectors
-  vector< RealVector > faceJacobVecs = m_face->computeFaceJacobDetVectorAtMappedCoords(*m_faceFlxPntsFaceLocalCoords);
+  // get face Jacobian vectors
+  const CFreal* faceJacobVecs = m_metricCache->getFaceJacobVecs(*m_face,*m_faceFlxPntsFaceLocalCoords);
 
   // get face Jacobian vector sizes in the flux points
   DataHandle< vector< CFreal > >
@@ -206,7 +207,11 @@ void BaseBndFaceTermComputer::computeFaceData()
         m_faceJacobVecAbsSizeFlxPnts[iFlx]*(*m_faceMappedCoordDir)[m_orient];
 
     // set unit normal vector
-    m_unitNormalFlxPnts[iFlx] = faceJacobVecs[iFlx]/m_faceJacobVecAbsSizeFlxPnts[iFlx];
+    const CFreal invFaceJacobVecAbsSize = 1.0/m_faceJacobVecAbsSizeFlxPnts[iFlx];
+    for (CFuint iDim = 0; iDim < m_dim; ++iDim)
+    {
+      m_unitNormalFlxPnts[iFlx][iDim] = faceJacobVecs[iFlx*m_dim+iDim]*invFaceJacobVecAbsSize;
+    }
   }
 
   // set the face ID in the BCStateComputer
@@ -223,15 +228,12 @@ void BaseBndFaceTermComputer::computeFaceData()
 
 void BaseBndFaceTermComputer::computeNeighbourCellData()
 {
-  // get neighbouring cell
-  GeometricEntity* cell = m_face->getNeighborGeo(0);
+  // get volume of the neighbouring cell
+  m_cellVolume = m_metricCache->getFaceNghbrVolume(*m_face,0);
 
-  // compute volume
-  m_cellVolume = cell->computeVolume();
-
-  // compute Jacobian determinants
-  std::valarray<CFreal> jacobDets(m_nbrFlxPnts[m_orient]);
-  jacobDets = cell->computeGeometricShapeFunctionJacobianDeterminant((*m_faceFlxPntCellMappedCoords)[m_orient]);
+  // get Jacobian determinants
+  const CFreal* jacobDets =
+      m_metricCache->getFaceNghbrJacobDets(*m_face,0,(*m_faceFlxPntCellMappedCoords)[m_orient]);
 
   // compute inverse characteristic lengths
   for (CFuint iFlx = 0; iFlx < m_nbrFlxPnts[m_orient]; ++iFlx)
@@ -885,6 +887,9 @@ void BaseBndFaceTermComputer::setup()
   // resize m_unitNormalFlxPnts
   m_unitNormalFlxPnts.resize(nbrFlxPnts,RealVector(m_dim));
 
+  // get the geometric metrics
+  m_metricCache = getMethodData().getMetricCache();
+
   // resize m_flxPntRiemannFlux
   m_flxPntRiemannFlux.resize(nbrFlxPnts,RealVector(m_nbrEqs));
 
@@ -322,6 +322,9 @@ protected: // data
   /// local cell face - flux point cell mapped coordinate per face connection orientation
   Common::SafePtr< std::vector< std::vector< RealVector > > > m_faceFlxPntCellMappedCoords;
 
+  /// geometric metrics of the faces and cells
+  Common::SafePtr< MetricCacheSpectralFD > m_metricCache;
+
   /// current face
   Framework::GeometricEntity* m_face;
 
@@ -48,6 +48,7 @@ BaseFaceTermComputer::BaseFaceTermComputer(const std::string& name) :
   m_faceIntegrationCoefs(CFNULL),
   m_faceFlxPntsFaceLocalCoords(CFNULL),
   m_faceFlxPntCellMappedCoords(CFNULL),
+  m_metricCache(CFNULL),
   m_face(CFNULL),
   m_orient(),
   m_cellVolumes(),
@@ -166,8 +167,8 @@ void BaseFaceTermComputer::computeFaceData()
   // face ID
   const CFuint faceID = m_face->getID();
 
-  // compute face Jacobian vectors
-  vector< RealVector > faceJacobVecs = m_face->computeFaceJacobDetVectorAtMappedCoords(*m_faceFlxPntsFaceLocalCoords);
+  // get face Jacobian vectors
+  const CFreal* faceJacobVecs = m_metricCache->getFaceJacobVecs(*m_face,*m_faceFlxPntsFaceLocalCoords);
 
   // get face Jacobian vector sizes in the flux points
   DataHandle< vector< CFreal > >
@@ -186,7 +187,11 @@ void BaseFaceTermComputer::computeFaceData()
         m_faceJacobVecAbsSizeFlxPnts[iFlx]*(*m_faceMappedCoordDir)[m_orient][RIGHT];
 
     // set unit normal vector
-    m_unitNormalFlxPnts[iFlx] = faceJacobVecs[iFlx]/m_faceJacobVecAbsSizeFlxPnts[iFlx];
+    const CFreal invFaceJacobVecAbsSize = 1.0/m_faceJacobVecAbsSizeFlxPnts[iFlx];
+    for (CFuint iDim = 0; iDim < m_dim; ++iDim)
+    {
+      m_unitNormalFlxPnts[iFlx][iDim] = faceJacobVecs[iFlx*m_dim+iDim]*invFaceJacobVecAbsSize;
+    }
   }
 }
 
@@ -194,17 +199,15 @@ void BaseFaceTermComputer::computeFaceData()
 
 void BaseFaceTermComputer::computeNeighbourCellData()
 {
-  vector< std::valarray<CFreal> > jacobDets(2,std::valarray<CFreal>(m_nbrFlxPnts[m_orient]));
+  const CFreal* jacobDets[2];
   for (CFuint iSide = 0; iSide < 2; ++iSide)
   {
-    // get neighbouring cell
-    GeometricEntity* cell = m_face->getNeighborGeo(iSide);
+    // get volume
+    m_cellVolumes[iSide] = m_metricCache->getFaceNghbrVolume(*m_face,iSide);
 
-    // compute volume
-    m_cellVolumes[iSide] = cell->computeVolume();
-
-    // compute Jacobian determinants
-    jacobDets[iSide] = cell->computeGeometricShapeFunctionJacobianDeterminant((*m_faceFlxPntCellMappedCoords)[m_orient][iSide]);
+    // get Jacobian determinants
+    jacobDets[iSide] =
+        m_metricCache->getFaceNghbrJacobDets(*m_face,iSide,(*m_faceFlxPntCellMappedCoords)[m_orient][iSide]);
   }
 
   // compute inverse characteristic lengths
@@ -595,6 +598,9 @@ void BaseFaceTermComputer::setup()
   // resize m_unitNormalFlxPnts
   m_unitNormalFlxPnts.resize(nbrFlxPnts,RealVector(m_dim));
 
+  // get the geometric metrics
+  m_metricCache = getMethodData().getMetricCache();
+
   // resize m_flxPntRiemannFlux
   m_flxPntRiemannFlux.resize(nbrFlxPnts,RealVector(m_nbrEqs));
 
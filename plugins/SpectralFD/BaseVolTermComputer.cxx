@@ -45,6 +45,7 @@ BaseVolTermComputer::BaseVolTermComputer(const std::string& name) :
   m_solPntIdxsForReconstruction(CFNULL),
   m_flxPntMatrixIdxForDerivation(CFNULL),
   m_solPntIdxsForDerivation(CFNULL),
+  m_metricCache(CFNULL),
   m_cellFluxProjVects(),
   m_cellExtraVars(),
   m_solInFlxPnts(),
@@ -148,8 +149,15 @@ void BaseVolTermComputer::setVolumeTermData(CFuint iElemType)
 
 void BaseVolTermComputer::computeCellData()
 {
-  m_cellFluxProjVects = m_cell->computeMappedCoordPlaneNormalAtMappedCoords(m_intFlxPntDerivDir,
-                                                                            m_intFlxPntMappedCoord);
+  const CFreal* projVects = m_metricCache->getCellFlxPntProjVects(*m_cell,m_intFlxPntDerivDir,
+                                                                  m_intFlxPntMappedCoord);
+  for (CFuint iFlx = 0; iFlx < m_nbrFlxPnts; ++iFlx)
+  {
+    for (CFuint iDim = 0; iDim < m_dim; ++iDim, ++projVects)
+    {
+      m_cellFluxProjVects[iFlx][iDim] = *projVects;
+    }
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -464,6 +472,10 @@ void BaseVolTermComputer::setup()
   // resize m_backupPhysVar
   m_backupPhysVar.resize(maxNbrFlxPnts);
 
+  // get the geometric metrics and resize m_cellFluxProjVects
+  m_metricCache = getMethodData().getMetricCache();
+  m_cellFluxProjVects.resize(maxNbrFlxPnts,RealVector(m_dim));
+
   // setup variables for gradient computation
   if (getMethodData().hasDiffTerm())
   {
@@ -203,6 +203,9 @@ protected: // data
   /// solution point index (in the cell) for derivation
   Common::SafePtr< std::vector< std::vector< CFuint > > > m_solPntIdxsForDerivation;
 
+  /// geometric metrics of the cells
+  Common::SafePtr< MetricCacheSpectralFD > m_metricCache;
+
   /// current cell
   Framework::GeometricEntity* m_cell;
 
@@ -381,8 +381,8 @@ void ConvVolTermRHSSpectralFD::addGradVolTermsAndDivideByJacobDet()
   DataHandle< vector< RealVector > > gradients = socket_gradients.getDataHandle();
 
   // get jacobian determinants at solution points
-  const std::valarray<CFreal> jacobDet =
-      m_cell->computeGeometricShapeFunctionJacobianDeterminant(*m_solPntsLocalCoords);
+  const CFreal* jacobDet =
+      getMethodData().getMetricCache()->getCellJacobDets(*m_cell,*m_solPntsLocalCoords);
 
   const CFuint nbrSolPnts = m_gradUpdates.size();
   for (CFuint iSol = 0; iSol < nbrSolPnts; ++iSol)
@@ -112,12 +112,14 @@ void DivideByJacobDetSpectralFD::divideRHSByJacobDet()
   // get the updateCoeff
   DataHandle< CFreal > updateCoeff = socket_updateCoeff.getDataHandle();
 
+  // get the geometric metrics
+  SafePtr< MetricCacheSpectralFD > metricCache = getMethodData().getMetricCache();
+
   // get the cell volume
-  const CFreal invCellVolume = 1.0/m_cell->computeVolume();
+  const CFreal invCellVolume = 1.0/metricCache->getCellVolume(*m_cell);
 
   // get jacobian determinants at solution points
-  const std::valarray<CFreal> jacobDet =
-      m_cell->computeGeometricShapeFunctionJacobianDeterminant(*m_solPntsLocalCoords);
+  const CFreal* jacobDet = metricCache->getCellJacobDets(*m_cell,*m_solPntsLocalCoords);
 
   // get number of solution points
   const CFuint nbrSolPnts = m_cellStates->size();
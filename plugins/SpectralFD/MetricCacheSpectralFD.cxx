@@ -0,0 +1,350 @@
+#include "Framework/GeometricEntity.hh"
+#include "Framework/MeshData.hh"
+
+#include "SpectralFD/MetricCacheSpectralFD.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace SpectralFD {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MetricCacheSpectralFD::MetricCacheSpectralFD() :
+  Common::NonCopyable<MetricCacheSpectralFD>(),
+  m_isActive(false),
+  m_elemTypeStartIdxs(),
+  m_cellProjVects(),
+  m_cellJacobDets(),
+  m_cellVolumes(),
+  m_faceJacobVecs(),
+  m_faceNghbrJacobDets(),
+  m_scratch(NB_KINDS)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+MetricCacheSpectralFD::~MetricCacheSpectralFD()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void MetricCacheSpectralFD::setup(const bool isActive)
+{
+  CFAUTOTRACE;
+
+  if (!isActive)
+  {
+    setup(isActive,vector< CFuint >(),vector< CFuint >(),0);
+    return;
+  }
+
+  // cells, numbered by element type
+  SafePtr< vector<ElementTypeData> > elemType = MeshDataStack::getActive()->getElementTypeData();
+  const CFuint nbrElemTypes = elemType->size();
+  vector< CFuint > elemTypeStartIdxs(nbrElemTypes);
+  vector< CFuint > elemTypeNbElems(nbrElemTypes);
+  for (CFuint iElemType = 0; iElemType < nbrElemTypes; ++iElemType)
+  {
+    elemTypeStartIdxs[iElemType] = (*elemType)[iElemType].getStartIdx();
+    elemTypeNbElems[iElemType] = (*elemType)[iElemType].getNbElems();
+  }
+
+  // faces, in all the TRSs but the cells one
+  vector< SafePtr<TopologicalRegionSet> > trsList = MeshDataStack::getActive()->getTrsList();
+  CFuint nbrFaces = 0;
+  for (CFuint iTRS = 0; iTRS < trsList.size(); ++iTRS)
+  {
+    if (trsList[iTRS]->getName() != "InnerCells")
+    {
+      nbrFaces += trsList[iTRS]->getLocalNbGeoEnts();
+    }
+  }
+
+  setup(isActive,elemTypeStartIdxs,elemTypeNbElems,nbrFaces);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void MetricCacheSpectralFD::setup(const bool isActive,
+                                  const vector< CFuint >& elemTypeStartIdxs,
+                                  const vector< CFuint >& elemTypeNbElems,
+                                  const CFuint nbrFaces)
+{
+  cf_assert(elemTypeStartIdxs.size() == elemTypeNbElems.size());
+
+  unsetup();
+
+  m_isActive = isActive;
+  if (!m_isActive) return;
+
+  // cells, numbered by element type
+  const CFuint nbrElemTypes = elemTypeNbElems.size();
+  m_elemTypeStartIdxs = elemTypeStartIdxs;
+  m_cellProjVects.resize(nbrElemTypes);
+  m_cellJacobDets.resize(nbrElemTypes);
+  CFuint nbrCells = 0;
+  for (CFuint iElemType = 0; iElemType < nbrElemTypes; ++iElemType)
+  {
+    resize(m_cellProjVects[iElemType],elemTypeNbElems[iElemType]);
+    resize(m_cellJacobDets[iElemType],elemTypeNbElems[iElemType]);
+    nbrCells += elemTypeNbElems[iElemType];
+  }
+  resize(m_cellVolumes,nbrCells);
+
+  // faces
+  resize(m_faceJacobVecs,nbrFaces);
+  resize(m_faceNghbrJacobDets,2*nbrFaces);
+
+  CFLog(INFO, "MetricCacheSpectralFD::setup() => metrics of " << nbrCells
+        << " cells and " << nbrFaces << " faces are stored\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void MetricCacheSpectralFD::unsetup()
+{
+  m_elemTypeStartIdxs.clear();
+  m_cellProjVects.clear();
+  m_cellJacobDets.clear();
+  resize(m_cellVolumes,0);
+  resize(m_faceJacobVecs,0);
+  resize(m_faceNghbrJacobDets,0);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void MetricCacheSpectralFD::invalidate()
+{
+  for (CFuint iElemType = 0; iElemType < m_cellProjVects.size(); ++iElemType)
+  {
+    m_cellProjVects[iElemType].isStored.assign(m_cellProjVects[iElemType].isStored.size(),false);
+    m_cellJacobDets[iElemType].isStored.assign(m_cellJacobDets[iElemType].isStored.size(),false);
+  }
+  m_cellVolumes.isStored.assign(m_cellVolumes.isStored.size(),false);
+  m_faceJacobVecs.isStored.assign(m_faceJacobVecs.isStored.size(),false);
+  m_faceNghbrJacobDets.isStored.assign(m_faceNghbrJacobDets.isStored.size(),false);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+const CFreal* MetricCacheSpectralFD::getCellFlxPntProjVects(GeometricEntity& cell,
+                                                            const vector< CFuint >& dirs,
+                                                            const vector< RealVector >& mappedCoords)
+{
+  EntityMetrics* metrics = CFNULL;
+  CFuint idx = 0;
+  if (m_isActive)
+  {
+    CFuint iElemType;
+    getCellIdx(cell,iElemType,idx);
+    metrics = &m_cellProjVects[iElemType];
+    if (metrics->stride > 0 && metrics->isStored[idx])
+    {
+      return &metrics->values[idx*metrics->stride];
+    }
+  }
+
+  const vector< RealVector > projVects = cell.computeMappedCoordPlaneNormalAtMappedCoords(dirs,mappedCoords);
+  return storeVectors(projVects,metrics,idx,m_scratch[CELL_PROJ_VECTS]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+const CFreal* MetricCacheSpectralFD::getCellJacobDets(GeometricEntity& cell,
+                                                      const vector< RealVector >& mappedCoords)
+{
+  CFreal* storage = CFNULL;
+  if (m_isActive)
+  {
+    CFuint iElemType, idx;
+    getCellIdx(cell,iElemType,idx);
+    EntityMetrics& metrics = m_cellJacobDets[iElemType];
+    if (metrics.stride > 0 && metrics.isStored[idx])
+    {
+      return &metrics.values[idx*metrics.stride];
+    }
+    metrics.isStored[idx] = true;
+    storage = getStorage(metrics,idx,mappedCoords.size());
+  }
+  else
+  {
+    m_scratch[CELL_JACOB_DETS].resize(mappedCoords.size());
+    storage = &m_scratch[CELL_JACOB_DETS][0];
+  }
+
+  const valarray<CFreal> jacobDets = cell.computeGeometricShapeFunctionJacobianDeterminant(mappedCoords);
+  for (CFuint iPnt = 0; iPnt < mappedCoords.size(); ++iPnt)
+  {
+    storage[iPnt] = jacobDets[iPnt];
+  }
+  return storage;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal MetricCacheSpectralFD::getCellVolume(GeometricEntity& cell)
+{
+  if (!m_isActive)
+  {
+    return cell.computeVolume();
+  }
+
+  const CFuint cellID = cell.getID();
+  if (m_cellVolumes.stride == 0 || !m_cellVolumes.isStored[cellID])
+  {
+    m_cellVolumes.isStored[cellID] = true;
+    *getStorage(m_cellVolumes,cellID,1) = cell.computeVolume();
+  }
+  return m_cellVolumes.values[cellID];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+const CFreal* MetricCacheSpectralFD::getFaceJacobVecs(GeometricEntity& face,
+                                                      const vector< RealVector >& mappedCoords)
+{
+  EntityMetrics* metrics = CFNULL;
+  const CFuint faceID = face.getID();
+  if (m_isActive)
+  {
+    metrics = &m_faceJacobVecs;
+    if (metrics->stride > 0 && metrics->isStored[faceID])
+    {
+      return &metrics->values[faceID*metrics->stride];
+    }
+  }
+
+  const vector< RealVector > jacobVecs = face.computeFaceJacobDetVectorAtMappedCoords(mappedCoords);
+  return storeVectors(jacobVecs,metrics,faceID,m_scratch[FACE_JACOB_VECS]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+const CFreal* MetricCacheSpectralFD::getFaceNghbrJacobDets(GeometricEntity& face,
+                                                           const CFuint iSide,
+                                                           const vector< RealVector >& mappedCoords)
+{
+  cf_assert(iSide < 2);
+  CFreal* storage = CFNULL;
+  if (m_isActive)
+  {
+    const CFuint idx = 2*face.getID() + iSide;
+    if (m_faceNghbrJacobDets.stride > 0 && m_faceNghbrJacobDets.isStored[idx])
+    {
+      return &m_faceNghbrJacobDets.values[idx*m_faceNghbrJacobDets.stride];
+    }
+    m_faceNghbrJacobDets.isStored[idx] = true;
+    storage = getStorage(m_faceNghbrJacobDets,idx,mappedCoords.size());
+  }
+  else
+  {
+    vector< CFreal >& scratch = m_scratch[FACE_NGHBR_JACOB_DETS + iSide];
+    scratch.resize(mappedCoords.size());
+    storage = &scratch[0];
+  }
+
+  const valarray<CFreal> jacobDets =
+      face.getNeighborGeo(iSide)->computeGeometricShapeFunctionJacobianDeterminant(mappedCoords);
+  for (CFuint iPnt = 0; iPnt < mappedCoords.size(); ++iPnt)
+  {
+    storage[iPnt] = jacobDets[iPnt];
+  }
+  return storage;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal MetricCacheSpectralFD::getFaceNghbrVolume(GeometricEntity& face, const CFuint iSide)
+{
+  return getCellVolume(*face.getNeighborGeo(iSide));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void MetricCacheSpectralFD::resize(EntityMetrics& metrics, const CFuint nbEntities)
+{
+  metrics.values.clear();
+  metrics.isStored.assign(nbEntities,false);
+  metrics.stride = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal* MetricCacheSpectralFD::getStorage(EntityMetrics& metrics,
+                                          const CFuint idx,
+                                          const CFuint nbValues)
+{
+  if (metrics.stride == 0)
+  {
+    metrics.stride = nbValues;
+    metrics.values.resize(metrics.isStored.size()*nbValues);
+  }
+  cf_assert(metrics.stride == nbValues);
+  cf_assert(idx < metrics.isStored.size());
+  return &metrics.values[idx*metrics.stride];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void MetricCacheSpectralFD::getCellIdx(GeometricEntity& cell,
+                                       CFuint& iElemType,
+                                       CFuint& idx) const
+{
+  const CFuint cellID = cell.getID();
+  iElemType = m_elemTypeStartIdxs.size() - 1;
+  while (m_elemTypeStartIdxs[iElemType] > cellID)
+  {
+    cf_assert(iElemType > 0);
+    --iElemType;
+  }
+  idx = cellID - m_elemTypeStartIdxs[iElemType];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+const CFreal* MetricCacheSpectralFD::storeVectors(const vector< RealVector >& vectors,
+                                                  EntityMetrics* metrics,
+                                                  const CFuint idx,
+                                                  vector< CFreal >& scratch)
+{
+  const CFuint nbValues = vectors.size()*(vectors.empty() ? 0 : vectors[0].size());
+  CFreal* storage = CFNULL;
+  if (metrics != CFNULL)
+  {
+    metrics->isStored[idx] = true;
+    storage = getStorage(*metrics,idx,nbValues);
+  }
+  else
+  {
+    scratch.resize(nbValues);
+    storage = &scratch[0];
+  }
+
+  CFreal* value = storage;
+  for (CFuint iVec = 0; iVec < vectors.size(); ++iVec)
+  {
+    const CFuint size = vectors[iVec].size();
+    for (CFuint i = 0; i < size; ++i, ++value)
+    {
+      *value = vectors[iVec][i];
+    }
+  }
+  return storage;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace SpectralFD
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,167 @@
+#ifndef COOLFluiD_Numerics_SpectralFD_MetricCacheSpectralFD_hh
+#define COOLFluiD_Numerics_SpectralFD_MetricCacheSpectralFD_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/NonCopyable.hh"
+#include "MathTools/RealVector.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework { class GeometricEntity; }
+
+  namespace SpectralFD {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class provides the geometric metrics of the cells and faces needed by
+ * the volume and face term computers. When it is active, the metrics of an
+ * entity are computed at the first request and stored in contiguous arrays
+ * (one per element type for the cells), until the mesh changes. When it is
+ * not active, the metrics are recomputed at every request, and the returned
+ * values are valid until the next request of the same metric.
+ *
+ * @author Kris Van den Abeele
+ */
+class MetricCacheSpectralFD : public Common::NonCopyable<MetricCacheSpectralFD> {
+
+public:  // methods
+
+  /// Constructor
+  MetricCacheSpectralFD();
+
+  /// Destructor
+  ~MetricCacheSpectralFD();
+
+  /// Set up the storage for the cells and faces of the current mesh
+  /// @param isActive  the metrics are stored
+  void setup(const bool isActive);
+
+  /// Set up the storage for the given numbers of cells and faces
+  /// @param isActive            the metrics are stored
+  /// @param elemTypeStartIdxs   ID of the first cell of each element type
+  /// @param elemTypeNbElems     number of cells of each element type
+  /// @param nbrFaces            number of faces
+  void setup(const bool isActive,
+             const std::vector< CFuint >& elemTypeStartIdxs,
+             const std::vector< CFuint >& elemTypeNbElems,
+             const CFuint nbrFaces);
+
+  /// Release the storage
+  void unsetup();
+
+  /// Mark all the stored metrics as out of date, e.g. after the mesh has moved
+  void invalidate();
+
+  /// @return true if the metrics are stored
+  bool isActive() const
+  {
+    return m_isActive;
+  }
+
+  /// Get the projection vectors of the given mapped coordinate directions
+  /// in the given points of a cell, (nbPoints x dim) values
+  const CFreal* getCellFlxPntProjVects(Framework::GeometricEntity& cell,
+                                       const std::vector< CFuint >& dirs,
+                                       const std::vector< RealVector >& mappedCoords);
+
+  /// Get the Jacobian determinants in the given points of a cell
+  const CFreal* getCellJacobDets(Framework::GeometricEntity& cell,
+                                 const std::vector< RealVector >& mappedCoords);
+
+  /// Get the volume of a cell
+  CFreal getCellVolume(Framework::GeometricEntity& cell);
+
+  /// Get the face Jacobian vectors in the given points of a face,
+  /// (nbPoints x dim) values
+  const CFreal* getFaceJacobVecs(Framework::GeometricEntity& face,
+                                 const std::vector< RealVector >& mappedCoords);
+
+  /// Get the Jacobian determinants of the neighbouring cell on the given side
+  /// of a face in the given points (mapped coordinates of the cell)
+  const CFreal* getFaceNghbrJacobDets(Framework::GeometricEntity& face,
+                                      const CFuint iSide,
+                                      const std::vector< RealVector >& mappedCoords);
+
+  /// Get the volume of the neighbouring cell on the given side of a face
+  CFreal getFaceNghbrVolume(Framework::GeometricEntity& face, const CFuint iSide);
+
+private: // types
+
+  /// kinds of metrics, to keep the values of each kind separate when they
+  /// are not stored
+  enum MetricKind {CELL_PROJ_VECTS=0, CELL_JACOB_DETS=1, FACE_JACOB_VECS=2,
+                   FACE_NGHBR_JACOB_DETS=3, NB_KINDS=5};
+
+  /// metrics of a set of entities, the same number of values for each entity
+  struct EntityMetrics {
+    /// values of all the entities, one after the other
+    std::vector< CFreal > values;
+    /// flag telling if the values of each entity are stored
+    std::vector< bool > isStored;
+    /// number of values of each entity
+    CFuint stride;
+  };
+
+private: // helper functions
+
+  /// Resize the given metrics for nbEntities entities
+  static void resize(EntityMetrics& metrics, const CFuint nbEntities);
+
+  /// Get the storage of the values of an entity, allocating the storage of
+  /// all the entities at the first call
+  static CFreal* getStorage(EntityMetrics& metrics, const CFuint idx, const CFuint nbValues);
+
+  /// Get the element type and the index within the element type of a cell
+  void getCellIdx(Framework::GeometricEntity& cell, CFuint& iElemType, CFuint& idx) const;
+
+  /// Copy the given vectors in the storage of an entity, or in the given
+  /// scratch storage if metrics is CFNULL
+  /// @return the storage of the values
+  static const CFreal* storeVectors(const std::vector< RealVector >& vectors,
+                                    EntityMetrics* metrics,
+                                    const CFuint idx,
+                                    std::vector< CFreal >& scratch);
+
+private: // data
+
+  /// the metrics are stored
+  bool m_isActive;
+
+  /// start index of the cells of each element type
+  std::vector< CFuint > m_elemTypeStartIdxs;
+
+  /// flux point projection vectors of the cells of each element type
+  std::vector< EntityMetrics > m_cellProjVects;
+
+  /// Jacobian determinants of the cells of each element type
+  std::vector< EntityMetrics > m_cellJacobDets;
+
+  /// volumes of the cells
+  EntityMetrics m_cellVolumes;
+
+  /// Jacobian vectors of the faces
+  EntityMetrics m_faceJacobVecs;
+
+  /// Jacobian determinants of the neighbouring cells of the faces, two per face
+  EntityMetrics m_faceNghbrJacobDets;
+
+  /// storage of each kind of metrics used when they are not stored (the
+  /// Jacobian determinants of the neighbours of a face taking one per side)
+  std::vector< std::vector< CFreal > > m_scratch;
+
+}; // class MetricCacheSpectralFD
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace SpectralFD
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_SpectralFD_MetricCacheSpectralFD_hh
@@ -150,6 +150,9 @@ protected: // interface implementation functions
   Common::Signal::return_t afterMeshUpdateActionImpl(Common::Signal::arg_t eAfter)
   {
     CFAUTOTRACE;
+    // the stored geometric metrics refer to the old mesh, whose numbers of
+    // cells and faces may differ from the new one
+    m_data->getMetricCache()->setup(m_data->cacheMetrics());
     return Common::Signal::return_t ();
   }
 
@@ -45,6 +45,7 @@ void SpectralFDMethodData::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< std::vector<std::string> >("BcTypes","Types of the boundary condition commands.");
   options.addConfigOption< std::vector<std::string> >("BcNames","Names of the boundary condition commands.");
   options.addConfigOption< bool >("ComputeVolumeForEachState" ,"Boolean telling whether to create a socket with the volume for each state, needed for some unsteady algorithms.");
+  options.addConfigOption< bool >("CacheMetrics" ,"Boolean telling whether to compute the geometric metrics of the cells and faces once and store them, for static meshes or meshes that move rarely.");
   options.addConfigOption< std::string >("InterpolationType","string defining the interpolation type to use (standard or optimized)");
 }
 
@@ -88,6 +89,8 @@ SpectralFDMethodData::SpectralFDMethodData(Common::SafePtr<Framework::Method> ow
   m_hasDiffTerm(),
   m_resFactor(),
   m_createVolumesSocketBool(),
+  m_cacheMetrics(),
+  m_metricCache(),
   m_interpolationType(),
   m_3StepsTMSparams(),
   m_updateToSolutionVecTrans()
@@ -116,6 +119,9 @@ SpectralFDMethodData::SpectralFDMethodData(Common::SafePtr<Framework::Method> ow
   m_createVolumesSocketBool = false;
   setParameter("ComputeVolumeForEachState", &m_createVolumesSocketBool);
 
+  m_cacheMetrics = false;
+  setParameter("CacheMetrics", &m_cacheMetrics);
+
   m_interpolationType = "standard";
   setParameter("InterpolationType", &m_interpolationType);
 
@@ -445,6 +451,8 @@ void SpectralFDMethodData::configureBCStateComputers( Config::ConfigArgs& args )
 
 void SpectralFDMethodData::unsetup()
 {
+  m_metricCache.unsetup();
+
   SpaceMethodData::unsetup();
 }
 
@@ -484,6 +492,9 @@ void SpectralFDMethodData::setup()
   // setup StatesReconstructor
   m_statesReconstructor->setup();
 
+  // setup the storage of the geometric metrics
+  m_metricCache.setup(m_cacheMetrics);
+
   // set the hasDiffTerm boolean
   /// @note it would be better to check a name related to the DiffusiveVarSet here
   m_hasDiffTerm = (_diffusiveVarStr != "Null");
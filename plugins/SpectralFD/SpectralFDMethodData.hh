@@ -18,6 +18,7 @@
 #include "Framework/VarSetMatrixTransformer.hh"
 
 #include "SpectralFD/CellToFaceGEBuilder.hh"
+#include "SpectralFD/MetricCacheSpectralFD.hh"
 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -250,6 +251,18 @@ public: // functions
     return m_createVolumesSocketBool;
   }
 
+  /// @return true if the geometric metrics are computed once and stored
+  bool cacheMetrics() const
+  {
+    return m_cacheMetrics;
+  }
+
+  /// @return the geometric metrics of the cells and faces
+  Common::SafePtr< MetricCacheSpectralFD > getMetricCache()
+  {
+    return &m_metricCache;
+  }
+
   std::string getInterpolationType()
   {
     return m_interpolationType;
@@ -434,6 +447,12 @@ private:  // data
   /// boolean telling wheter the socket containing the volume for each state (!= cell) has to be created
   bool m_createVolumesSocketBool;
 
+  /// boolean telling whether the geometric metrics are computed once and stored
+  bool m_cacheMetrics;
+
+  /// geometric metrics of the cells and faces
+  MetricCacheSpectralFD m_metricCache;
+
   /// string defining the interpolation type to use ("standard" or "optimized")
   std::string m_interpolationType;
 
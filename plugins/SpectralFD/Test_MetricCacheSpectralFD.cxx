@@ -0,0 +1,275 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the geometric metrics cache of SpectralFD"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#include "Environment/ObjectProvider.hh"
+#include "Framework/Cell.hh"
+#include "Framework/Face.hh"
+#include "Framework/Framework.hh"
+#include "Framework/Namespace.hh"
+#include "Framework/Node.hh"
+#include "Framework/NullPhysicalModelImpl.hh"
+#include "Framework/PhysicalModel.hh"
+#include "ShapeFunctions/LagrangeShapeFunctionLineP1.hh"
+#include "ShapeFunctions/LagrangeShapeFunctionQuadP1.hh"
+
+#include "SpectralFD/MetricCacheSpectralFD.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::ShapeFunctions;
+using namespace COOLFluiD::SpectralFD;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Physical model without equations, giving the dimension of the mesh to
+/// the shape functions
+class NullPhysicalModel2D : public NullPhysicalModelImpl {
+public:
+
+  NullPhysicalModel2D(const std::string& name) : NullPhysicalModelImpl(name) {}
+
+  CFuint getDimension() const { return DIM_2D; }
+};
+
+Environment::ObjectProvider<NullPhysicalModel2D, PhysicalModelImpl, FrameworkLib, 1>
+nullPhysicalModel2DProvider("NullPhysicalModel2D");
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Activates the 2D physical model once for the whole module
+struct PhysicalModelFixture
+{
+  PhysicalModelFixture() : nsp("MetricCacheTest")
+  {
+    nsp.setPhysicalModelName("MetricCacheTest");
+    PhysicalModelStack& stack = PhysicalModelStack::getInstance();
+    stack.setEnabled(true);
+    stack.createUnique(nsp.getPhysicalModelName())->
+      setPhysicalModelImpl(nullPhysicalModel2DProvider.create("NullPhysicalModel2D"));
+    stack.push(&nsp);
+  }
+
+  ~PhysicalModelFixture()
+  {
+    PhysicalModelStack& stack = PhysicalModelStack::getInstance();
+    stack.pop();
+    stack.deleteAllEntries();
+  }
+
+  Namespace nsp;
+};
+
+BOOST_GLOBAL_FIXTURE( PhysicalModelFixture );
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Two distorted quadrilaterals sharing one face
+struct MetricCacheFixture
+{
+  typedef Cell< LagrangeShapeFunctionQuadP1, LagrangeShapeFunctionQuadP1 > QuadCell;
+  typedef Face< LagrangeShapeFunctionLineP1, LagrangeShapeFunctionLineP1 > LineFace;
+
+  MetricCacheFixture() :
+    nodes(),
+    face(),
+    dirs(),
+    cellCoords(),
+    faceCoords(),
+    cellNghbrCoords(2)
+  {
+    const CFreal xy[6][2] = {{0.,0.}, {1.,0.}, {2.2,0.2}, {0.,1.}, {1.1,1.1}, {2.,1.3}};
+    for (CFuint iNode = 0; iNode < 6; ++iNode)
+    {
+      RealVector coord(DIM_2D);
+      coord[XX] = xy[iNode][XX];
+      coord[YY] = xy[iNode][YY];
+      nodes.push_back(new Framework::Node(coord,false));
+    }
+
+    const CFuint cellNodes[2][4] = {{0,1,4,3}, {1,2,5,4}};
+    for (CFuint iCell = 0; iCell < 2; ++iCell)
+    {
+      cells[iCell].setID(iCell);
+      for (CFuint iNode = 0; iNode < 4; ++iNode)
+      {
+        cells[iCell].addNode(nodes[cellNodes[iCell][iNode]]);
+      }
+    }
+
+    face.setID(0);
+    face.addNode(nodes[1]);
+    face.addNode(nodes[4]);
+    vector< GeometricEntity* > nghbrs(2);
+    nghbrs[0] = &cells[0];
+    nghbrs[1] = &cells[1];
+    face.setNeighborGeos(nghbrs);
+
+    dirs.push_back(0);
+    dirs.push_back(1);
+    dirs.push_back(0);
+    cellCoords.push_back(mappedCoord(-0.5,0.3));
+    cellCoords.push_back(mappedCoord(0.2,-0.7));
+    cellCoords.push_back(mappedCoord(0.9,0.9));
+
+    RealVector faceCoord(DIM_1D);
+    faceCoord[KSI] = -0.6;
+    faceCoords.push_back(faceCoord);
+    faceCoord[KSI] = 0.4;
+    faceCoords.push_back(faceCoord);
+
+    // the face is the right side of the first cell and the left side of the
+    // second one
+    cellNghbrCoords[0].push_back(mappedCoord(1.,-0.6));
+    cellNghbrCoords[0].push_back(mappedCoord(1.,0.4));
+    cellNghbrCoords[1].push_back(mappedCoord(-1.,-0.6));
+    cellNghbrCoords[1].push_back(mappedCoord(-1.,0.4));
+  }
+
+  ~MetricCacheFixture()
+  {
+    for (CFuint iNode = 0; iNode < nodes.size(); ++iNode)
+    {
+      delete nodes[iNode];
+    }
+  }
+
+  static RealVector mappedCoord(const CFreal ksi, const CFreal eta)
+  {
+    RealVector coord(DIM_2D);
+    coord[KSI] = ksi;
+    coord[ETA] = eta;
+    return coord;
+  }
+
+  /// Sets up the given cache for the two cells, of one element type, and
+  /// the face
+  static void setup(MetricCacheSpectralFD& cache, const bool isActive)
+  {
+    cache.setup(isActive,vector< CFuint >(1,0),vector< CFuint >(1,2),1);
+  }
+
+  /// Checks that the metrics of both caches are the same
+  void checkSameMetrics(MetricCacheSpectralFD& cache, MetricCacheSpectralFD& refCache)
+  {
+    for (CFuint iCell = 0; iCell < 2; ++iCell)
+    {
+      // the values are copied, those of the cache without storage being
+      // overwritten at the next request
+      const CFreal* projVects = refCache.getCellFlxPntProjVects(cells[iCell],dirs,cellCoords);
+      const vector< CFreal > refProjVects(projVects, projVects + DIM_2D*cellCoords.size());
+      projVects = cache.getCellFlxPntProjVects(cells[iCell],dirs,cellCoords);
+      for (CFuint i = 0; i < refProjVects.size(); ++i)
+      {
+        BOOST_CHECK_CLOSE(projVects[i], refProjVects[i], 1e-12);
+      }
+
+      const CFreal* jacobDets = refCache.getCellJacobDets(cells[iCell],cellCoords);
+      const vector< CFreal > refJacobDets(jacobDets, jacobDets + cellCoords.size());
+      jacobDets = cache.getCellJacobDets(cells[iCell],cellCoords);
+      for (CFuint i = 0; i < refJacobDets.size(); ++i)
+      {
+        BOOST_CHECK_CLOSE(jacobDets[i], refJacobDets[i], 1e-12);
+      }
+
+      BOOST_CHECK_CLOSE(cache.getCellVolume(cells[iCell]), refCache.getCellVolume(cells[iCell]), 1e-12);
+    }
+
+    const CFreal* jacobVecs = refCache.getFaceJacobVecs(face,faceCoords);
+    const vector< CFreal > refJacobVecs(jacobVecs, jacobVecs + DIM_2D*faceCoords.size());
+    jacobVecs = cache.getFaceJacobVecs(face,faceCoords);
+    for (CFuint i = 0; i < refJacobVecs.size(); ++i)
+    {
+      BOOST_CHECK_CLOSE(jacobVecs[i], refJacobVecs[i], 1e-12);
+    }
+
+    for (CFuint iSide = 0; iSide < 2; ++iSide)
+    {
+      const CFreal* nghbrJacobDets = refCache.getFaceNghbrJacobDets(face,iSide,cellNghbrCoords[iSide]);
+      const vector< CFreal > refNghbrJacobDets(nghbrJacobDets, nghbrJacobDets + faceCoords.size());
+      nghbrJacobDets = cache.getFaceNghbrJacobDets(face,iSide,cellNghbrCoords[iSide]);
+      for (CFuint i = 0; i < refNghbrJacobDets.size(); ++i)
+      {
+        BOOST_CHECK_CLOSE(nghbrJacobDets[i], refNghbrJacobDets[i], 1e-12);
+      }
+
+      BOOST_CHECK_CLOSE(cache.getFaceNghbrVolume(face,iSide),
+                        refCache.getFaceNghbrVolume(face,iSide), 1e-12);
+    }
+  }
+
+  vector< Framework::Node* > nodes;
+  QuadCell cells[2];
+  LineFace face;
+  vector< CFuint > dirs;
+  vector< RealVector > cellCoords;
+  vector< RealVector > faceCoords;
+  vector< vector< RealVector > > cellNghbrCoords;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( MetricCacheSpectralFDSuite, MetricCacheFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( CachedMatchesUncached )
+{
+  MetricCacheSpectralFD cache;
+  MetricCacheSpectralFD refCache;
+  setup(cache,true);
+  setup(refCache,false);
+  BOOST_CHECK(cache.isActive());
+  BOOST_CHECK(!refCache.isActive());
+
+  // first request, when the metrics are computed and stored, then requests
+  // answered from the storage
+  checkSameMetrics(cache,refCache);
+  checkSameMetrics(cache,refCache);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( StoredUntilInvalidated )
+{
+  MetricCacheSpectralFD cache;
+  MetricCacheSpectralFD refCache;
+  setup(cache,true);
+  setup(refCache,false);
+
+  const CFreal volume = cache.getCellVolume(cells[1]);
+  (*nodes[2])[XX] += 0.5;
+  BOOST_CHECK_EQUAL(cache.getCellVolume(cells[1]), volume);
+  BOOST_CHECK(refCache.getCellVolume(cells[1]) > volume);
+
+  cache.invalidate();
+  checkSameMetrics(cache,refCache);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( SetupAfterMeshUpdate )
+{
+  MetricCacheSpectralFD cache;
+  MetricCacheSpectralFD refCache;
+  setup(refCache,false);
+
+  // mesh with the first cell only, then with both
+  cache.setup(true,vector< CFuint >(1,0),vector< CFuint >(1,1),0);
+  BOOST_CHECK_CLOSE(cache.getCellVolume(cells[0]), refCache.getCellVolume(cells[0]), 1e-12);
+
+  setup(cache,true);
+  checkSameMetrics(cache,refCache);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,316 @@
+#include <algorithm>
+
+#include "MathTools/MathConsts.hh"
+#include "SubSystemCoupler/FaceBoxTree.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace SubSystemCoupler {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// maximum number of faces in a leaf
+static const CFuint MAX_LEAF_SIZE = 4;
+
+/// maximum depth of the traversal stack
+static const CFuint MAX_STACK_SIZE = 128;
+
+/// relative tolerance on the distances to keep the candidates whose box
+/// touches the bound on the distance of the closest face
+static const CFreal DISTANCE_TOLERANCE = 1e-10;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Orders the faces along one axis by the center of their box
+struct BoxCenterLess {
+  BoxCenterLess(const vector<CFreal>& b, const CFuint a) : boxes(b), axis(a) {}
+  bool operator() (const CFuint f1, const CFuint f2) const
+  {
+    return boxes[f1*6 + axis] + boxes[f1*6 + 3 + axis] <
+      boxes[f2*6 + axis] + boxes[f2*6 + 3 + axis];
+  }
+  const vector<CFreal>& boxes;
+  const CFuint axis;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+FaceBoxTree::FaceBoxTree() :
+  Common::NonCopyable<FaceBoxTree>(),
+  m_dim(DIM_3D),
+  m_nodes(),
+  m_boxes(),
+  m_faceIDs()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+FaceBoxTree::~FaceBoxTree()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FaceBoxTree::build(const CFuint dim, const vector<CFreal>& boxes)
+{
+  cf_assert(dim == DIM_2D || dim == DIM_3D);
+  cf_assert(boxes.size() % (2*dim) == 0);
+
+  m_dim = dim;
+  const CFuint nbFaces = boxes.size()/(2*dim);
+  m_faceIDs.resize(nbFaces);
+  for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+    m_faceIDs[iFace] = iFace;
+  }
+
+  m_nodes.clear();
+  refit(boxes);
+
+  // the hierarchy is built on the boxes of the faces, the boxes of the
+  // nodes being computed afterwards as in refit()
+  if (nbFaces > 0) {
+    m_nodes.reserve(2*nbFaces/MAX_LEAF_SIZE + 1);
+    buildNode(0, nbFaces);
+    computeNodeBoxes();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FaceBoxTree::refit(const vector<CFreal>& boxes)
+{
+  const CFuint nbFaces = m_faceIDs.size();
+  cf_assert(boxes.size() == nbFaces*2*m_dim);
+
+  // boxes are stored in 3D
+  m_boxes.resize(nbFaces*6);
+  for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+    for (CFuint i = 0; i < 3; ++i) {
+      m_boxes[iFace*6 + i]     = (i < m_dim) ? boxes[iFace*2*m_dim + i] : 0.;
+      m_boxes[iFace*6 + 3 + i] = (i < m_dim) ? boxes[iFace*2*m_dim + m_dim + i] : 0.;
+    }
+  }
+
+  computeNodeBoxes();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint FaceBoxTree::buildNode(const CFuint begin, const CFuint end)
+{
+  const CFuint iNode = m_nodes.size();
+  m_nodes.push_back(TreeNode());
+
+  if (end - begin <= MAX_LEAF_SIZE) {
+    m_nodes[iNode].start = begin;
+    m_nodes[iNode].count = end - begin;
+    return iNode;
+  }
+
+  // split at the median along the largest extent of the box centers
+  CFreal cmin[3], cmax[3];
+  for (CFuint i = 0; i < 3; ++i) {
+    cmin[i] = MathTools::MathConsts::CFrealMax();
+    cmax[i] = -MathTools::MathConsts::CFrealMax();
+  }
+  for (CFuint f = begin; f < end; ++f) {
+    const CFreal* box = &m_boxes[m_faceIDs[f]*6];
+    for (CFuint i = 0; i < 3; ++i) {
+      const CFreal center = 0.5*(box[i] + box[3 + i]);
+      cmin[i] = std::min(cmin[i], center);
+      cmax[i] = std::max(cmax[i], center);
+    }
+  }
+
+  CFuint axis = 0;
+  for (CFuint i = 1; i < 3; ++i) {
+    if (cmax[i] - cmin[i] > cmax[axis] - cmin[axis]) axis = i;
+  }
+  const CFuint middle = begin + (end - begin)/2;
+  std::nth_element(m_faceIDs.begin() + begin, m_faceIDs.begin() + middle,
+                   m_faceIDs.begin() + end, BoxCenterLess(m_boxes, axis));
+
+  buildNode(begin, middle);
+  const CFuint right = buildNode(middle, end);
+  m_nodes[iNode].start = right;
+  m_nodes[iNode].count = 0;
+  return iNode;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FaceBoxTree::computeNodeBoxes()
+{
+  // children always come after their parent, so that going backwards
+  // each node is updated after its children
+  for (CFuint iNode = m_nodes.size(); iNode > 0; --iNode) {
+    TreeNode& node = m_nodes[iNode - 1];
+    for (CFuint i = 0; i < 3; ++i) {
+      node.bmin[i] = MathTools::MathConsts::CFrealMax();
+      node.bmax[i] = -MathTools::MathConsts::CFrealMax();
+    }
+
+    if (node.count > 0) {
+      for (CFuint f = node.start; f < node.start + node.count; ++f) {
+        const CFreal* box = &m_boxes[m_faceIDs[f]*6];
+        for (CFuint i = 0; i < 3; ++i) {
+          node.bmin[i] = std::min(node.bmin[i], box[i]);
+          node.bmax[i] = std::max(node.bmax[i], box[3 + i]);
+        }
+      }
+    }
+    else {
+      const TreeNode& left = m_nodes[iNode];
+      const TreeNode& right = m_nodes[node.start];
+      for (CFuint i = 0; i < 3; ++i) {
+        node.bmin[i] = std::min(left.bmin[i], right.bmin[i]);
+        node.bmax[i] = std::max(left.bmax[i], right.bmax[i]);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FaceBoxTree::getBoxDistances2(const CFreal* bmin, const CFreal* bmax, const CFreal* p,
+                                   CFreal& minDist2, CFreal& maxDist2) const
+{
+  minDist2 = 0.;
+  maxDist2 = 0.;
+  for (CFuint i = 0; i < 3; ++i) {
+    const CFreal dLow = p[i] - bmin[i];
+    const CFreal dHigh = bmax[i] - p[i];
+    if (dLow < 0.) minDist2 += dLow*dLow;
+    if (dHigh < 0.) minDist2 += dHigh*dHigh;
+    const CFreal dMax = std::max(std::abs(dLow), std::abs(dHigh));
+    maxDist2 += dMax*dMax;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FaceBoxTree::findCandidates(const CFreal* point, vector<CFuint>& faces) const
+{
+  faces.clear();
+  if (m_nodes.empty()) return;
+
+  const CFreal p[3] = {point[0], point[1], (m_dim == DIM_3D) ? point[2] : 0.};
+
+  // every box contains at least one face entirely, so that the furthest
+  // point of any box bounds the distance of the closest face: the faces
+  // whose box is closer than the smallest of these bounds are candidates
+  CFreal bound2 = MathTools::MathConsts::CFrealMax();
+  vector<CFreal> faceDist2;
+
+  CFuint stack[MAX_STACK_SIZE];
+  CFuint top = 0;
+  stack[top++] = 0;
+
+  while (top > 0) {
+    const CFuint iNode = stack[--top];
+    const TreeNode& node = m_nodes[iNode];
+    CFreal minDist2 = 0.;
+    CFreal maxDist2 = 0.;
+    getBoxDistances2(node.bmin, node.bmax, p, minDist2, maxDist2);
+    if (minDist2 > bound2*(1. + DISTANCE_TOLERANCE)) continue;
+    bound2 = std::min(bound2, maxDist2);
+
+    if (node.count > 0) {
+      for (CFuint f = node.start; f < node.start + node.count; ++f) {
+        const CFuint iFace = m_faceIDs[f];
+        getBoxDistances2(&m_boxes[iFace*6], &m_boxes[iFace*6 + 3], p, minDist2, maxDist2);
+        bound2 = std::min(bound2, maxDist2);
+        if (minDist2 <= bound2*(1. + DISTANCE_TOLERANCE)) {
+          faces.push_back(iFace);
+          faceDist2.push_back(minDist2);
+        }
+      }
+    }
+    else {
+      cf_assert(top + 2 <= MAX_STACK_SIZE);
+      stack[top++] = node.start;
+      stack[top++] = iNode + 1;
+    }
+  }
+
+  // the bound may have decreased after some faces have been kept
+  const CFreal maxDist2 = bound2*(1. + DISTANCE_TOLERANCE);
+  CFuint nbCandidates = 0;
+  for (CFuint i = 0; i < faces.size(); ++i) {
+    if (faceDist2[i] <= maxDist2) faces[nbCandidates++] = faces[i];
+  }
+  faces.resize(nbCandidates);
+  std::sort(faces.begin(), faces.end());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void computeFaceBoxes(const vector<SafePtr<TopologicalRegionSet> >& trs,
+                      SafePtr<GeometricEntityPool<StdTrsGeoBuilder> > geoBuilder,
+                      const bool withStates,
+                      vector<CFreal>& boxes)
+{
+  boxes.clear();
+  StdTrsGeoBuilder::GeoData& geoData = geoBuilder->getDataGE();
+
+  for (CFuint iTRS = 0; iTRS < trs.size(); ++iTRS) {
+    const CFuint nbGeos = trs[iTRS]->getLocalNbGeoEnts();
+    geoData.trs = trs[iTRS];
+
+    for (CFuint iGeoEnt = 0; iGeoEnt < nbGeos; ++iGeoEnt) {
+      geoData.idx = iGeoEnt;
+      GeometricEntity& currFace = *geoBuilder->buildGE();
+
+      const CFuint dim = currFace.getNode(0)->size();
+      const CFuint start = boxes.size();
+      boxes.resize(start + 2*dim);
+      for (CFuint iDim = 0; iDim < dim; ++iDim) {
+        boxes[start + iDim] = MathTools::MathConsts::CFrealMax();
+        boxes[start + dim + iDim] = -MathTools::MathConsts::CFrealMax();
+      }
+
+      const CFuint nbNodes = currFace.nbNodes();
+      for (CFuint iNode = 0; iNode < nbNodes; ++iNode) {
+        const Node& node = *currFace.getNode(iNode);
+        for (CFuint iDim = 0; iDim < dim; ++iDim) {
+          boxes[start + iDim] = std::min(boxes[start + iDim], node[iDim]);
+          boxes[start + dim + iDim] = std::max(boxes[start + dim + iDim], node[iDim]);
+        }
+      }
+
+      if (withStates) {
+        const CFuint nbStates = currFace.nbStates();
+        for (CFuint iState = 0; iState < nbStates; ++iState) {
+          const Node& coord = currFace.getState(iState)->getCoordinates();
+          for (CFuint iDim = 0; iDim < dim; ++iDim) {
+            boxes[start + iDim] = std::min(boxes[start + iDim], coord[iDim]);
+            boxes[start + dim + iDim] = std::max(boxes[start + dim + iDim], coord[iDim]);
+          }
+        }
+      }
+
+      geoBuilder->releaseGE();
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace SubSystemCoupler
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
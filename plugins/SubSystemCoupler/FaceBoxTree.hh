@@ -0,0 +1,151 @@
+#ifndef COOLFluiD_Numerics_SubSystemCoupler_FaceBoxTree_hh
+#define COOLFluiD_Numerics_SubSystemCoupler_FaceBoxTree_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+#include "Common/NonCopyable.hh"
+#include "Common/SafePtr.hh"
+#include "Framework/TopologicalRegionSet.hh"
+#include "Framework/GeometricEntityPool.hh"
+#include "Framework/StdTrsGeoBuilder.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace SubSystemCoupler {
+
+//////////////////////////////////////////////////////////////////////////////
+
+  /**
+   * This class stores the bounding boxes of a set of faces in a bounding
+   * volume hierarchy to find, for a given point, the few faces that can
+   * be the closest one.
+   * When the faces move without changing the connectivity, the boxes
+   * are updated with refit(), which keeps the hierarchy and only
+   * recomputes the boxes of its nodes.
+   * The queries do not modify the tree and can be run concurrently.
+   *
+   * @author Thomas Wuilbaut
+   *
+   */
+class FaceBoxTree : public Common::NonCopyable<FaceBoxTree> {
+public:
+
+  /**
+   * Constructor.
+   */
+  FaceBoxTree();
+
+  /**
+   * Destructor.
+   */
+  ~FaceBoxTree();
+
+  /**
+   * Builds the tree
+   * @param dim    space dimension (2 or 3)
+   * @param boxes  lower corner followed by upper corner of the box of each face
+   */
+  void build(const CFuint dim, const std::vector<CFreal>& boxes);
+
+  /**
+   * Updates the boxes of the faces, which must be as many as in build()
+   * @param boxes  lower corner followed by upper corner of the box of each face
+   */
+  void refit(const std::vector<CFreal>& boxes);
+
+  /**
+   * Gets the number of faces
+   */
+  CFuint getNbFaces() const {return m_faceIDs.size();}
+
+  /**
+   * Gets, sorted in ascending order, the faces whose box is not further
+   * from the point than the closest face can be, so that the face closest
+   * to the point is always one of them.
+   * @param point  coordinates of the point
+   * @param faces  candidate faces
+   */
+  void findCandidates(const CFreal* point, std::vector<CFuint>& faces) const;
+
+private: // helper functions
+
+  /**
+   * Builds the subtree of the faces [begin, end) and returns its index
+   */
+  CFuint buildNode(const CFuint begin, const CFuint end);
+
+  /**
+   * Computes the boxes of all the nodes from the boxes of the faces
+   */
+  void computeNodeBoxes();
+
+  /**
+   * Gets the squared distance from the point to the closest and
+   * to the furthest point of the given box
+   */
+  void getBoxDistances2(const CFreal* bmin, const CFreal* bmax, const CFreal* p,
+                        CFreal& minDist2, CFreal& maxDist2) const;
+
+private: // data
+
+  /// space dimension
+  CFuint m_dim;
+
+  /// node of the hierarchy
+  struct TreeNode {
+    /// lower corner of the bounding box
+    CFreal bmin[3];
+    /// upper corner of the bounding box
+    CFreal bmax[3];
+    /// first face of a leaf, or index of the second child
+    /// (the first one follows its parent)
+    CFuint start;
+    /// number of faces of a leaf, 0 for an inner node
+    CFuint count;
+  };
+
+  /// nodes of the hierarchy, the root being the first one
+  std::vector<TreeNode> m_nodes;
+
+  /// boxes of the faces, lower corner followed by upper corner in 3D
+  std::vector<CFreal> m_boxes;
+
+  /// faces sorted by tree leaf
+  std::vector<CFuint> m_faceIDs;
+
+}; // class FaceBoxTree
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Computes the bounding boxes of all the local faces of the given TRSs,
+ * one TRS after the other, in the format taken by FaceBoxTree
+ * @param trs           list of TRSs
+ * @param geoBuilder    builder of the faces
+ * @param withStates    flag telling to include the coordinates of the states in the boxes
+ * @param boxes         lower corner followed by upper corner of the box of each face
+ */
+void computeFaceBoxes
+(const std::vector<Common::SafePtr<Framework::TopologicalRegionSet> >& trs,
+ Common::SafePtr<Framework::GeometricEntityPool<Framework::StdTrsGeoBuilder> > geoBuilder,
+ const bool withStates,
+ std::vector<CFreal>& boxes);
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace SubSystemCoupler
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_SubSystemCoupler_FaceBoxTree_hh
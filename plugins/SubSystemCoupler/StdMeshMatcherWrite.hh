@@ -7,6 +7,7 @@
 #include "Framework/GeometricEntity.hh"
 #include "Framework/MeshData.hh"
 #include "Framework/DynamicDataSocketSet.hh"
+#include "SubSystemCoupler/FaceBoxTree.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -30,6 +31,12 @@ namespace COOLFluiD {
 class StdMeshMatcherWrite : public CouplerCom {
 public:
 
+  /**
+   * Defines the Config Option's of this class
+   * @param options a OptionList where to add the Option's
+   */
+  static void defineConfigOptions(Config::OptionList& options);
+
   /**
    * Constructor.
    */
@@ -74,6 +81,19 @@ protected: // data
    */
   virtual void writeIsAcceptedFile(const std::string dataHandleName);
 
+  /**
+   * Numbers the faces of the TRSs of this command and, if they are pruned,
+   * builds the search tree over them, or only updates its boxes if the
+   * faces are the same as before
+   */
+  void updateFaceTree();
+
+  /**
+   * Finds the faces that can be the closest one to each of the given points
+   */
+  void findFaceCandidates(Framework::DataHandle<RealVector>& coords,
+                          std::vector<std::vector<CFuint> >& faceCandidates);
+
 protected: // data
 
   /// the dynamic sockets in this Command
@@ -97,6 +117,19 @@ protected: // data
 
   RealVector _shapeFunctionAtCoord;
 
+  /// search tree over the faces of the TRSs of this command
+  FaceBoxTree _faceTree;
+
+  /// first face of each TRS in the search tree, followed by the number of faces
+  std::vector<CFuint> _faceTrsStart;
+
+  /// faces that can be the closest one to the point being paired,
+  /// sorted in ascending order
+  std::vector<CFuint> _candidateFaces;
+
+  /// flag telling to pair the points only with the faces found by the search tree
+  bool _pruneFaces;
+
 }; // class StdMeshMatcherWrite
 
 //////////////////////////////////////////////////////////////////////////////
@@ -39,6 +39,7 @@ MethodCommandProvider<StdMeshMatcherWrite2, SubSysCouplerData, SubSystemCouplerM
 void StdMeshMatcherWrite2::defineConfigOptions(Config::OptionList& options)
 {
    options.addConfigOption< bool> ("MatchModifiedMesh","Match mesh moved by the value of the states.");
+   options.addConfigOption< bool> ("PruneFaces","Only pair the points with the faces whose bounding box can contain the closest point to them (default). If false, all the faces are searched, as before the search tree, possibly pairing a point with a face the point projects on but farther than the closest one.");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -47,12 +48,18 @@ StdMeshMatcherWrite2::StdMeshMatcherWrite2(const std::string& name) :
   CouplerCom(name),
   _sockets(),
   _matchingFace(static_cast<Framework::TopologicalRegionSet*>(CFNULL),CFNULL),
-  _shapeFunctionAtCoord()
+  _shapeFunctionAtCoord(),
+  _faceTree(),
+  _faceTrsStart(),
+  _candidateFaces()
 {
    addConfigOptionsTo(this);
 
   _shiftStates = false;
    setParameter("MatchModifiedMesh",&_shiftStates);
+
+  _pruneFaces = true;
+   setParameter("PruneFaces",&_pruneFaces);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -141,6 +148,8 @@ void StdMeshMatcherWrite2::executeWrite(const CFuint iProc)
 
   if(_shiftStates) shiftStatesCoord();
 
+  updateFaceTree();
+
   /// Get the names of the interfaces, subsystems
   const std::string interfaceName = getCommandGroupName();
   vector<std::string> otherTrsNames = getMethodData().getCoupledSubSystemsTRSNames(interfaceName);
@@ -192,6 +201,12 @@ void StdMeshMatcherWrite2::executeWrite(const CFuint iProc)
       // Counter for the number of rejected states
       CFuint rejectedStates = 0;
 
+      // Find the faces that can be the closest to each state
+      std::vector<std::vector<CFuint> > faceCandidates;
+      if (_pruneFaces) {
+        findFaceCandidates(interfaceCoords, faceCandidates);
+      }
+
       // For each state, find the interpolated value
       // on the other boundary
       boost::progress_display progress (otherNbStates);
@@ -205,6 +220,9 @@ void StdMeshMatcherWrite2::executeWrite(const CFuint iProc)
 
         const RealVector coord = interfaceCoords[iState];
         RealVector coordProj(coord.size());
+        if (_pruneFaces) {
+          _candidateFaces.swap(faceCandidates[iState]);
+        }
 
         // Pair each fluid point with the closest wet structural element
         nodeToElementPairing(coord,stateID,coordProj);
@@ -400,7 +418,8 @@ RealVector vectorD(dim);
   bool projectedOnAFace(false);
   bool found(false);
 
-  /// Loop over all the faces of all the TRS's of this command
+  /// Loop over the faces of all the TRS's of this command that can be
+  /// the closest to the point, sorted by TRS
   vector< SafePtr<TopologicalRegionSet> > trs = getTrsList();
   vector< SafePtr<TopologicalRegionSet> >::iterator iTRS;
 
@@ -409,15 +428,18 @@ RealVector vectorD(dim);
 
   StdTrsGeoBuilder::GeoData& geoData = geoBuilder->getDataGE();
 CFLogDebugMed("Trying to match coord: " << coord << "\n");
+  CFuint iCandidate = 0;
   for (iTRS = trs.begin(); iTRS != trs.end(); ++iTRS)
   {
-    const CFuint nbGeos = (*iTRS)->getLocalNbGeoEnts();
+    const CFuint startFace = _faceTrsStart[iTRS - trs.begin()];
+    const CFuint endFace = _faceTrsStart[iTRS - trs.begin() + 1];
     const std::string currentTRSName = (*iTRS)->getName();
     geoData.trs = (*iTRS);
 CFLogDebugMed( "Looping on face of TRS: " << currentTRSName << "\n");
-    for(CFuint iGeoEnt = 0; iGeoEnt < nbGeos; ++iGeoEnt)
+    for(; iCandidate < _candidateFaces.size() && _candidateFaces[iCandidate] < endFace; ++iCandidate)
     {
       // build the GeometricEntity
+      const CFuint iGeoEnt = _candidateFaces[iCandidate] - startFace;
       geoData.idx = iGeoEnt;
       GeometricEntity& currFace = *geoBuilder->buildGE();
 
@@ -674,6 +696,67 @@ CFout << "distanceToFace: "<< distanceToFace  << "\n";*/
 
 //////////////////////////////////////////////////////////////////////////////
 
+void StdMeshMatcherWrite2::updateFaceTree()
+{
+  CFAUTOTRACE;
+
+  vector< SafePtr<TopologicalRegionSet> > trs = getTrsList();
+
+  _faceTrsStart.resize(trs.size() + 1);
+  _faceTrsStart[0] = 0;
+  for (CFuint iTRS = 0; iTRS < trs.size(); ++iTRS) {
+    _faceTrsStart[iTRS + 1] = _faceTrsStart[iTRS] + trs[iTRS]->getLocalNbGeoEnts();
+  }
+
+  // without pruning, every point is paired with all the faces, in order,
+  // since the face chosen first can be any face the point projects on
+  if (!_pruneFaces) {
+    _candidateFaces.resize(_faceTrsStart.back());
+    for (CFuint iFace = 0; iFace < _candidateFaces.size(); ++iFace) {
+      _candidateFaces[iFace] = iFace;
+    }
+    return;
+  }
+
+  std::vector<CFreal> boxes;
+  computeFaceBoxes(trs, getMethodData().getStdTrsGeoBuilder(), true, boxes);
+
+  // the faces only move between two matchings, so that the hierarchy
+  // can be kept and only the boxes have to be updated
+  const CFuint nbFaces = _faceTrsStart.back();
+  if (nbFaces > 0 && _faceTree.getNbFaces() == nbFaces) {
+    _faceTree.refit(boxes);
+  }
+  else {
+    _faceTree.build(PhysicalModelStack::getActive()->getDim(), boxes);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdMeshMatcherWrite2::findFaceCandidates(DataHandle<RealVector>& coords,
+                                              std::vector<std::vector<CFuint> >& faceCandidates)
+{
+  CFAUTOTRACE;
+
+  // the queries are independent and the tree is only read
+  const CFint nbPoints = coords.size();
+  faceCandidates.resize(nbPoints);
+#ifdef CF_HAVE_OMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+  for (CFint iPoint = 0; iPoint < nbPoints; ++iPoint) {
+    const RealVector& coord = coords[iPoint];
+    CFreal point[3] = {0., 0., 0.};
+    for (CFuint iDim = 0; iDim < coord.size(); ++iDim) {
+      point[iDim] = coord[iDim];
+    }
+    _faceTree.findCandidates(point, faceCandidates[iPoint]);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void StdMeshMatcherWrite2::writeIsAcceptedFile(const std::string dataHandleName)
 {
   CFAUTOTRACE;
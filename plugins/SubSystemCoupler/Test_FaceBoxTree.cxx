@@ -0,0 +1,169 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the face search tree of the mesh matchers"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+
+#include "MathTools/MathConsts.hh"
+#include "SubSystemCoupler/FaceBoxTree.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Numerics::SubSystemCoupler;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct FaceBoxTreeFixture
+{
+  FaceBoxTreeFixture() : seed(12345) {}
+
+  /// Deterministic pseudo-random number in [0, 1)
+  CFreal random()
+  {
+    seed = (seed*1103515245u + 12345u) % 2147483648u;
+    return seed/2147483648.;
+  }
+
+  /// Segments along a wavy curve, with a few duplicated and degenerate ones
+  void makeSegments(const CFreal amplitude)
+  {
+    const CFuint nbSegments = 500;
+    nodes.resize(2*(nbSegments + 1));
+    for (CFuint i = 0; i <= nbSegments; ++i) {
+      const CFreal x = static_cast<CFreal>(i)/nbSegments;
+      nodes[2*i]     = x;
+      nodes[2*i + 1] = amplitude*std::sin(20.*x) + 0.01*random();
+    }
+    segments.clear();
+    for (CFuint i = 0; i < nbSegments; ++i) {
+      segments.push_back(i);
+      segments.push_back(i + 1);
+      if (i % 97 == 0) {
+	segments.push_back(i);
+	segments.push_back(i + 1);
+      }
+      if (i % 131 == 0) {
+	segments.push_back(i);
+	segments.push_back(i);
+      }
+    }
+    boxes.clear();
+    for (CFuint s = 0; s < segments.size()/2; ++s) {
+      const CFreal* a = &nodes[2*segments[2*s]];
+      const CFreal* b = &nodes[2*segments[2*s + 1]];
+      boxes.push_back(std::min(a[0], b[0]));
+      boxes.push_back(std::min(a[1], b[1]));
+      boxes.push_back(std::max(a[0], b[0]));
+      boxes.push_back(std::max(a[1], b[1]));
+    }
+  }
+
+  /// Squared distance from the point to the given segment
+  CFreal segmentDist2(const CFuint s, const CFreal* p) const
+  {
+    const CFreal* a = &nodes[2*segments[2*s]];
+    const CFreal* b = &nodes[2*segments[2*s + 1]];
+    const CFreal ab[2] = {b[0] - a[0], b[1] - a[1]};
+    const CFreal len2 = ab[0]*ab[0] + ab[1]*ab[1];
+    CFreal t = (len2 > 0.) ? ((p[0] - a[0])*ab[0] + (p[1] - a[1])*ab[1])/len2 : 0.;
+    t = std::min(std::max(t, 0.), 1.);
+    const CFreal d[2] = {a[0] + t*ab[0] - p[0], a[1] + t*ab[1] - p[1]};
+    return d[0]*d[0] + d[1]*d[1];
+  }
+
+  /// Checks that the segments closest to each point are all candidates
+  /// and that the candidates are sorted
+  void checkClosestAreCandidates(const FaceBoxTree& tree)
+  {
+    CFuint nbMissing = 0;
+    CFuint nbUnsorted = 0;
+    vector<CFuint> faces;
+    for (CFuint i = 0; i < 2000; ++i) {
+      const CFreal p[2] = {1.4*random() - 0.2, 1.4*random() - 0.7};
+      tree.findCandidates(p, faces);
+      if (!std::equal(faces.begin() + (faces.empty() ? 0 : 1), faces.end(), faces.begin(),
+		      std::greater<CFuint>())) {
+	++nbUnsorted;
+      }
+
+      CFreal minDist2 = MathTools::MathConsts::CFrealMax();
+      for (CFuint s = 0; s < segments.size()/2; ++s) {
+	minDist2 = std::min(minDist2, segmentDist2(s, p));
+      }
+      for (CFuint s = 0; s < segments.size()/2; ++s) {
+	if (segmentDist2(s, p) == minDist2 &&
+	    !std::binary_search(faces.begin(), faces.end(), s)) {
+	  ++nbMissing;
+	}
+      }
+    }
+    BOOST_CHECK_EQUAL(nbMissing, 0u);
+    BOOST_CHECK_EQUAL(nbUnsorted, 0u);
+  }
+
+  unsigned long seed;
+  vector<CFreal> nodes;
+  vector<CFuint> segments;
+  vector<CFreal> boxes;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( FaceBoxTreeSuite, FaceBoxTreeFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( ClosestFacesAreCandidates )
+{
+  makeSegments(0.2);
+  FaceBoxTree tree;
+  tree.build(DIM_2D, boxes);
+  BOOST_CHECK_EQUAL(tree.getNbFaces(), boxes.size()/4);
+  checkClosestAreCandidates(tree);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( RefitMatchesBuild )
+{
+  makeSegments(0.2);
+  FaceBoxTree tree;
+  tree.build(DIM_2D, boxes);
+
+  // the same faces moved: the refitted tree must still find the closest ones
+  makeSegments(-0.3);
+  tree.refit(boxes);
+  checkClosestAreCandidates(tree);
+
+  FaceBoxTree rebuilt;
+  rebuilt.build(DIM_2D, boxes);
+  vector<CFuint> faces;
+  vector<CFuint> rebuiltFaces;
+  CFuint nbDifferent = 0;
+  for (CFuint i = 0; i < 500; ++i) {
+    const CFreal p[2] = {random(), random() - 0.5};
+    tree.findCandidates(p, faces);
+    rebuilt.findCandidates(p, rebuiltFaces);
+    // both trees keep the faces whose box is within the same bound
+    if (faces != rebuiltFaces) ++nbDifferent;
+  }
+  BOOST_CHECK_EQUAL(nbDifferent, 0u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
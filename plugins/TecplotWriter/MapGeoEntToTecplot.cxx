@@ -184,13 +184,31 @@ void
 MapGeoEntToTecplot::writeGeoEntConn(std::ofstream& file,
 				               std::valarray<CFuint>& stateIDs,
 				               const GeoEntityInfo& geoinfo)
+{
+  getGeoEntConn(stateIDs, geoinfo, m_conn);
+
+  // one line per sub entity
+  const CFuint nbNodesInSubEnt = m_conn.size()/computeNbSubEntities(geoinfo);
+  for (CFuint i = 0; i < m_conn.size(); ++i) {
+    if (i > 0) {
+      file << ((i % nbNodesInSubEnt == 0) ? "\n" : " ");
+    }
+    file << m_conn[i];
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void
+MapGeoEntToTecplot::getGeoEntConn(std::valarray<CFuint>& stateIDs,
+                                  const GeoEntityInfo& geoinfo,
+                                  std::vector<CFuint>& conn)
 {
   cf_assert(geoinfo.solOrder > CFPolyOrder::ORDER0);
 
   CFuint nbVertices = geoinfo.nbStates > 1 ? geoinfo.nbStates : geoinfo.nbNodes;
 
-
-  std::string result;
+  conn.clear();
 
   switch(geoinfo.dimension)
   {
@@ -204,16 +222,16 @@ MapGeoEntToTecplot::writeGeoEntConn(std::ofstream& file,
         {
 
         case 3:  // TRIANGLE
-          file << stateIDs[0] << " "
-               << stateIDs[1] << " "
-               << stateIDs[2];
+          conn.push_back(stateIDs[0]);
+          conn.push_back(stateIDs[1]);
+          conn.push_back(stateIDs[2]);
         break;
 
         case 4: // QUADRILATERAL
-          file << stateIDs[0] << " "
-               << stateIDs[1] << " "
-               << stateIDs[2] << " "
-               << stateIDs[3];
+          conn.push_back(stateIDs[0]);
+          conn.push_back(stateIDs[1]);
+          conn.push_back(stateIDs[2]);
+          conn.push_back(stateIDs[3]);
         break;
 
         default:
@@ -229,17 +247,17 @@ MapGeoEntToTecplot::writeGeoEntConn(std::ofstream& file,
         {
 
         case 6:  // TRIANGLE
-          file << stateIDs[0] << " " << stateIDs[3] << " " << stateIDs[5] << "\n";
-          file << stateIDs[3] << " " << stateIDs[1] << " " << stateIDs[4] << "\n";
-          file << stateIDs[5] << " " << stateIDs[4] << " " << stateIDs[2] << "\n";
-          file << stateIDs[3] << " " << stateIDs[4] << " " << stateIDs[5] ;
+          conn.push_back(stateIDs[0]); conn.push_back(stateIDs[3]); conn.push_back(stateIDs[5]);
+          conn.push_back(stateIDs[3]); conn.push_back(stateIDs[1]); conn.push_back(stateIDs[4]);
+          conn.push_back(stateIDs[5]); conn.push_back(stateIDs[4]); conn.push_back(stateIDs[2]);
+          conn.push_back(stateIDs[3]); conn.push_back(stateIDs[4]); conn.push_back(stateIDs[5]);
         break;
 
         case 9: // QUADRILATERAL
-          file << stateIDs[0] << " " << stateIDs[4] << " " << stateIDs[8] << " " << stateIDs[7] << "\n";
-          file << stateIDs[4] << " " << stateIDs[1] << " " << stateIDs[5] << " " << stateIDs[8] << "\n";
-          file << stateIDs[7] << " " << stateIDs[8] << " " << stateIDs[6] << " " << stateIDs[3] << "\n";
-          file << stateIDs[8] << " " << stateIDs[5] << " " << stateIDs[2] << " " << stateIDs[6];
+          conn.push_back(stateIDs[0]); conn.push_back(stateIDs[4]); conn.push_back(stateIDs[8]); conn.push_back(stateIDs[7]);
+          conn.push_back(stateIDs[4]); conn.push_back(stateIDs[1]); conn.push_back(stateIDs[5]); conn.push_back(stateIDs[8]);
+          conn.push_back(stateIDs[7]); conn.push_back(stateIDs[8]); conn.push_back(stateIDs[6]); conn.push_back(stateIDs[3]);
+          conn.push_back(stateIDs[8]); conn.push_back(stateIDs[5]); conn.push_back(stateIDs[2]); conn.push_back(stateIDs[6]);
         break;
 
         default:
@@ -255,15 +273,15 @@ MapGeoEntToTecplot::writeGeoEntConn(std::ofstream& file,
         {
 
         case 10:  // TRIANGLE
-          file << stateIDs[0] << " " << stateIDs[3] << " " << stateIDs[8] << "\n";
-          file << stateIDs[4] << " " << stateIDs[1] << " " << stateIDs[5] << "\n";
-          file << stateIDs[7] << " " << stateIDs[6] << " " << stateIDs[2] << "\n";
-          file << stateIDs[9] << " " << stateIDs[5] << " " << stateIDs[6] << "\n";
-          file << stateIDs[8] << " " << stateIDs[9] << " " << stateIDs[7] << "\n";
-          file << stateIDs[3] << " " << stateIDs[4] << " " << stateIDs[9] << "\n";
-          file << stateIDs[9] << " " << stateIDs[8] << " " << stateIDs[3] << "\n";
-          file << stateIDs[5] << " " << stateIDs[9] << " " << stateIDs[4] << "\n";
-          file << stateIDs[6] << " " << stateIDs[7] << " " << stateIDs[9] ;
+          conn.push_back(stateIDs[0]); conn.push_back(stateIDs[3]); conn.push_back(stateIDs[8]);
+          conn.push_back(stateIDs[4]); conn.push_back(stateIDs[1]); conn.push_back(stateIDs[5]);
+          conn.push_back(stateIDs[7]); conn.push_back(stateIDs[6]); conn.push_back(stateIDs[2]);
+          conn.push_back(stateIDs[9]); conn.push_back(stateIDs[5]); conn.push_back(stateIDs[6]);
+          conn.push_back(stateIDs[8]); conn.push_back(stateIDs[9]); conn.push_back(stateIDs[7]);
+          conn.push_back(stateIDs[3]); conn.push_back(stateIDs[4]); conn.push_back(stateIDs[9]);
+          conn.push_back(stateIDs[9]); conn.push_back(stateIDs[8]); conn.push_back(stateIDs[3]);
+          conn.push_back(stateIDs[5]); conn.push_back(stateIDs[9]); conn.push_back(stateIDs[4]);
+          conn.push_back(stateIDs[6]); conn.push_back(stateIDs[7]); conn.push_back(stateIDs[9]);
         break;
 
         default:
@@ -292,50 +310,50 @@ MapGeoEntToTecplot::writeGeoEntConn(std::ofstream& file,
 
           case 4: // TETRAHEDRON
 
-            file << stateIDs[0] << " "
-                 << stateIDs[1] << " "
-                 << stateIDs[2] << " "
-                 << stateIDs[3];
+            conn.push_back(stateIDs[0]);
+            conn.push_back(stateIDs[1]);
+            conn.push_back(stateIDs[2]);
+            conn.push_back(stateIDs[3]);
 
           break;
 
           case 5: // BRICK with nodes coalesced 5,6,7->4
 
-            file << stateIDs[0] << " "
-                 << stateIDs[1] << " "
-                 << stateIDs[2] << " "
-                 << stateIDs[3] << " "
-                 << stateIDs[4] << " "
-                 << stateIDs[4] << " "
-                 << stateIDs[4] << " "
-                 << stateIDs[4];
+            conn.push_back(stateIDs[0]);
+            conn.push_back(stateIDs[1]);
+            conn.push_back(stateIDs[2]);
+            conn.push_back(stateIDs[3]);
+            conn.push_back(stateIDs[4]);
+            conn.push_back(stateIDs[4]);
+            conn.push_back(stateIDs[4]);
+            conn.push_back(stateIDs[4]);
 
           break;
 
           case 6: // BRICK with nodes 2->3 and 6->7 coalesced
 
-            file << stateIDs[0] << " "
-                 << stateIDs[1] << " "
-                 << stateIDs[2] << " "
-                 << stateIDs[2] << " "
-                 << stateIDs[3] << " "
-                 << stateIDs[4] << " "
-                 << stateIDs[5] << " "
-                 << stateIDs[5];
+            conn.push_back(stateIDs[0]);
+            conn.push_back(stateIDs[1]);
+            conn.push_back(stateIDs[2]);
+            conn.push_back(stateIDs[2]);
+            conn.push_back(stateIDs[3]);
+            conn.push_back(stateIDs[4]);
+            conn.push_back(stateIDs[5]);
+            conn.push_back(stateIDs[5]);
 
 
           break;
 
           case 8: // BRICK
 
-            file << stateIDs[0] << " "
-                 << stateIDs[1] << " "
-                 << stateIDs[2] << " "
-                 << stateIDs[3] << " "
-                 << stateIDs[4] << " "
-                 << stateIDs[5] << " "
-                 << stateIDs[6] << " "
-                 << stateIDs[7];
+            conn.push_back(stateIDs[0]);
+            conn.push_back(stateIDs[1]);
+            conn.push_back(stateIDs[2]);
+            conn.push_back(stateIDs[3]);
+            conn.push_back(stateIDs[4]);
+            conn.push_back(stateIDs[5]);
+            conn.push_back(stateIDs[6]);
+            conn.push_back(stateIDs[7]);
 
           break;
 
@@ -354,13 +372,13 @@ MapGeoEntToTecplot::writeGeoEntConn(std::ofstream& file,
 
           case 10: // TETRAHEDRON
 
-            file << stateIDs[1] << " " << stateIDs[5] << " " << stateIDs[4] << " " << stateIDs[7] << "\n";
-            file << stateIDs[5] << " " << stateIDs[2] << " " << stateIDs[6] << " " << stateIDs[8] << "\n";
-            file << stateIDs[4] << " " << stateIDs[5] << " " << stateIDs[0] << " " << stateIDs[7] << "\n";
-            file << stateIDs[0] << " " << stateIDs[5] << " " << stateIDs[6] << " " << stateIDs[8] << "\n";
-            file << stateIDs[5] << " " << stateIDs[7] << " " << stateIDs[8] << " " << stateIDs[0] << "\n";
-            file << stateIDs[7] << " " << stateIDs[8] << " " << stateIDs[9] << " " << stateIDs[3] << "\n";
-            file << stateIDs[0] << " " << stateIDs[8] << " " << stateIDs[9] << " " << stateIDs[7] ;
+            conn.push_back(stateIDs[1]); conn.push_back(stateIDs[5]); conn.push_back(stateIDs[4]); conn.push_back(stateIDs[7]);
+            conn.push_back(stateIDs[5]); conn.push_back(stateIDs[2]); conn.push_back(stateIDs[6]); conn.push_back(stateIDs[8]);
+            conn.push_back(stateIDs[4]); conn.push_back(stateIDs[5]); conn.push_back(stateIDs[0]); conn.push_back(stateIDs[7]);
+            conn.push_back(stateIDs[0]); conn.push_back(stateIDs[5]); conn.push_back(stateIDs[6]); conn.push_back(stateIDs[8]);
+            conn.push_back(stateIDs[5]); conn.push_back(stateIDs[7]); conn.push_back(stateIDs[8]); conn.push_back(stateIDs[0]);
+            conn.push_back(stateIDs[7]); conn.push_back(stateIDs[8]); conn.push_back(stateIDs[9]); conn.push_back(stateIDs[3]);
+            conn.push_back(stateIDs[0]); conn.push_back(stateIDs[8]); conn.push_back(stateIDs[9]); conn.push_back(stateIDs[7]);
           break;
 
         default:
@@ -9,6 +9,8 @@
 
 //////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+
 #include "Framework/MapGeoEntToFormat.hh"
 
 #include "TecplotWriter/TecplotWriterAPI.hh"
@@ -43,6 +45,13 @@ public:
   			               std::valarray<CFuint>& stateIDs,
   			               const Framework::GeoEntityInfo& geoinfo);
 
+  /// Gets the element connectivity in the Tecplot numbering, with the
+  /// nodes of all the sub entities stored contiguously.
+  /// Useful to write the connectivity in binary format.
+  void getGeoEntConn(std::valarray<CFuint>& stateIDs,
+                     const Framework::GeoEntityInfo& geoinfo,
+                     std::vector<CFuint>& conn);
+
   /// Computes in how many sub entities the given GeometricEntity
   /// should be partitioned for representation in the Tecplot format.
   /// If the format supports high-order entities, then the result will probably be 1,
@@ -58,6 +67,11 @@ public:
     return "MapGeoEntToTecplot";
   }
 
+private:
+
+  /// temporary connectivity used by writeGeoEntConn()
+  std::vector<CFuint> m_conn;
+
 }; // end of class MapGeoEntToTecplot
 
 //////////////////////////////////////////////////////////////////////////////
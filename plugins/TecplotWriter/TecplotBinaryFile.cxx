@@ -0,0 +1,289 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+
+#include "Common/CFLog.hh"
+#include "Common/BadValueException.hh"
+
+#include "TecplotWriter/TecplotBinaryFile.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+    namespace TecplotWriter {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// marker preceding each zone, both in the header and in the data section
+static const float ZONE_MARKER = 299.0f;
+
+/// marker closing the header section
+static const float EOH_MARKER = 357.0f;
+
+/// variable data format for double precision values
+static const boost::int32_t DOUBLE_FORMAT = 2;
+
+//////////////////////////////////////////////////////////////////////////////
+
+TecplotBinaryFile::TecplotBinaryFile(const std::string& title,
+                                     const std::vector<std::string>& varNames) :
+  m_title(title),
+  m_varNames(varNames),
+  m_zones(),
+  m_nextZone(0),
+  m_values(),
+  m_connectivity()
+{
+  // the names may come quoted as in the ASCII header
+  for (CFuint i = 0; i < m_varNames.size(); ++i) {
+    std::string& n = m_varNames[i];
+    n.erase(std::remove(n.begin(), n.end(), '\"'), n.end());
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+TecplotBinaryFile::~TecplotBinaryFile()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TecplotBinaryFile::addZone(const std::string& name,
+                                const std::string& zoneType,
+                                const CFint strandID,
+                                const CFdouble solutionTime,
+                                const std::vector<bool>& isCellCentered,
+                                const CFuint nbNodes,
+                                const CFuint nbElems)
+{
+  cf_assert(isCellCentered.empty() || isCellCentered.size() == getNbVars());
+
+  // the type is checked before declaring the zone, to leave the file
+  // unchanged if it is not supported
+  boost::int32_t type = 0;
+  if      (zoneType == "FELINESEG")       type = 1;
+  else if (zoneType == "FETRIANGLE")      type = 2;
+  else if (zoneType == "FEQUADRILATERAL") type = 3;
+  else if (zoneType == "FETETRAHEDRON")   type = 4;
+  else if (zoneType == "FEBRICK")         type = 5;
+  else {
+    throw BadValueException (FromHere(), "TecplotBinaryFile: unsupported zone type " + zoneType);
+  }
+
+  m_zones.push_back(Zone());
+  Zone& zone = m_zones.back();
+
+  zone.zoneType       = type;
+  zone.name           = name;
+  zone.strandID       = strandID;
+  zone.solutionTime   = solutionTime;
+  zone.isCellCentered = isCellCentered;
+  zone.nbNodes        = nbNodes;
+  zone.nbElems        = nbElems;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TecplotBinaryFile::addZoneAuxData(const std::string& name, const std::string& value)
+{
+  cf_assert(!m_zones.empty());
+  m_zones.back().auxData.push_back(make_pair(name, value));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TecplotBinaryFile::writeHeader(std::ostream& fout)
+{
+  CFAUTOTRACE;
+
+  fout.write("#!TDV112", 8);
+  writeInt32(fout, 1);   // byte order
+  writeInt32(fout, 0);   // full file type
+  writeString(fout, m_title);
+  writeInt32(fout, m_varNames.size());
+  for (CFuint iVar = 0; iVar < m_varNames.size(); ++iVar) {
+    writeString(fout, m_varNames[iVar]);
+  }
+
+  for (CFuint iZone = 0; iZone < m_zones.size(); ++iZone) {
+    const Zone& zone = m_zones[iZone];
+
+    writeFloat32(fout, ZONE_MARKER);
+    writeString(fout, zone.name);
+    writeInt32(fout, -1);  // parent zone
+    writeInt32(fout, zone.strandID);
+    writeFloat64(fout, zone.solutionTime);
+    writeInt32(fout, -1);  // zone color, not used
+    writeInt32(fout, zone.zoneType);
+
+    writeInt32(fout, zone.isCellCentered.empty() ? 0 : 1);
+    for (CFuint iVar = 0; iVar < zone.isCellCentered.size(); ++iVar) {
+      writeInt32(fout, zone.isCellCentered[iVar] ? 1 : 0);
+    }
+
+    writeInt32(fout, 0);   // no raw face neighbors
+    writeInt32(fout, 0);   // no user defined face neighbor connections
+    writeInt32(fout, zone.nbNodes);
+    writeInt32(fout, zone.nbElems);
+    writeInt32(fout, 0);   // I, J, K cell dimensions, reserved
+    writeInt32(fout, 0);
+    writeInt32(fout, 0);
+
+    for (CFuint iAux = 0; iAux < zone.auxData.size(); ++iAux) {
+      writeInt32(fout, 1);
+      writeString(fout, zone.auxData[iAux].first);
+      writeInt32(fout, 0); // string value
+      writeString(fout, zone.auxData[iAux].second);
+    }
+    writeInt32(fout, 0);   // no more auxiliary data
+  }
+
+  writeFloat32(fout, EOH_MARKER);
+
+  m_nextZone = 0;
+  prepareZoneData();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TecplotBinaryFile::prepareZoneData()
+{
+  m_values.resize(getNbVars());
+  if (m_nextZone >= m_zones.size()) return;
+
+  const Zone& zone = m_zones[m_nextZone];
+  for (CFuint iVar = 0; iVar < getNbVars(); ++iVar) {
+    const bool cc = !zone.isCellCentered.empty() && zone.isCellCentered[iVar];
+    m_values[iVar].reserve(cc ? zone.nbElems : zone.nbNodes);
+  }
+  m_connectivity.reserve(zone.nbElems*getNbNodesPerElem());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::vector<CFdouble>& TecplotBinaryFile::getValues(const CFuint iVar)
+{
+  cf_assert(m_nextZone < m_zones.size());
+  cf_assert(iVar < getNbVars());
+  return m_values[iVar];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::vector<boost::int32_t>& TecplotBinaryFile::getConnectivity()
+{
+  cf_assert(m_nextZone < m_zones.size());
+  return m_connectivity;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint TecplotBinaryFile::getNbNodesPerElem() const
+{
+  cf_assert(m_nextZone < m_zones.size());
+  static const CFuint nbNodesPerElem[] = {0, 2, 3, 4, 4, 8};
+  return nbNodesPerElem[m_zones[m_nextZone].zoneType];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TecplotBinaryFile::writeZoneData(std::ostream& fout)
+{
+  CFAUTOTRACE;
+
+  cf_assert(m_nextZone < m_zones.size());
+  const Zone& zone = m_zones[m_nextZone];
+
+  writeFloat32(fout, ZONE_MARKER);
+  for (CFuint iVar = 0; iVar < getNbVars(); ++iVar) {
+    writeInt32(fout, DOUBLE_FORMAT);
+  }
+  writeInt32(fout, 0);   // no passive variables
+  writeInt32(fout, 0);   // no variable sharing
+  writeInt32(fout, -1);  // no connectivity sharing
+
+  for (CFuint iVar = 0; iVar < getNbVars(); ++iVar) {
+    const vector<CFdouble>& values = m_values[iVar];
+    const bool cc = !zone.isCellCentered.empty() && zone.isCellCentered[iVar];
+    if (values.size() != (cc ? zone.nbElems : zone.nbNodes)) {
+      throw BadValueException
+        (FromHere(), "TecplotBinaryFile: wrong number of values for variable " +
+         m_varNames[iVar] + " in zone " + zone.name);
+    }
+    const CFdouble minValue = values.empty() ? 0. : *min_element(values.begin(), values.end());
+    const CFdouble maxValue = values.empty() ? 0. : *max_element(values.begin(), values.end());
+    writeFloat64(fout, minValue);
+    writeFloat64(fout, maxValue);
+  }
+
+  for (CFuint iVar = 0; iVar < getNbVars(); ++iVar) {
+    const vector<CFdouble>& values = m_values[iVar];
+    if (!values.empty()) {
+      fout.write(reinterpret_cast<const char*>(&values[0]), values.size()*sizeof(CFdouble));
+    }
+  }
+
+  if (!m_connectivity.empty()) {
+    fout.write(reinterpret_cast<const char*>(&m_connectivity[0]),
+               m_connectivity.size()*sizeof(boost::int32_t));
+  }
+
+  // release the storage of this zone before filling the next one
+  for (CFuint iVar = 0; iVar < getNbVars(); ++iVar) {
+    vector<CFdouble>().swap(m_values[iVar]);
+  }
+  vector<boost::int32_t>().swap(m_connectivity);
+
+  ++m_nextZone;
+  prepareZoneData();
+}
+
+//////////
+
+void TecplotBinaryFile::writeInt32(std::ostream& fout, const boost::int32_t value)
+{
+  fout.write(reinterpret_cast<const char*>(&value), sizeof(boost::int32_t));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TecplotBinaryFile::writeFloat32(std::ostream& fout, const float value)
+{
+  fout.write(reinterpret_cast<const char*>(&value), sizeof(float));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TecplotBinaryFile::writeFloat64(std::ostream& fout, const double value)
+{
+  fout.write(reinterpret_cast<const char*>(&value), sizeof(double));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void TecplotBinaryFile::writeString(std::ostream& fout, const std::string& str)
+{
+  for (CFuint i = 0; i < str.size(); ++i) {
+    writeInt32(fout, static_cast<unsigned char>(str[i]));
+  }
+  writeInt32(fout, 0);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace TecplotWriter
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
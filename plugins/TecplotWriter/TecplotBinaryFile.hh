@@ -0,0 +1,151 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_TecplotWriter_TecplotBinaryFile_hh
+#define COOLFluiD_TecplotWriter_TecplotBinaryFile_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include "Common/COOLFluiD.hh"
+
+#include "TecplotWriter/TecplotWriterAPI.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+    namespace TecplotWriter {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class writes finite element zones in the native binary Tecplot
+/// format (version 112, "#!TDV112"), which Tecplot 360 and its readers load
+/// without going through the TecIO library.
+/// All the zones are declared first and written in the header, then their
+/// data is written one zone at a time, so that only the values of the
+/// current zone are held in memory.
+/// All the zones are written in BLOCK packing with double precision values
+/// and zero based connectivity.
+/// @author Tiago Quintino
+class TecplotWriter_API TecplotBinaryFile {
+public:
+
+  /// Constructor
+  /// @param title     title of the data set
+  /// @param varNames  names of the variables, coordinates first
+  TecplotBinaryFile(const std::string& title,
+                    const std::vector<std::string>& varNames);
+
+  /// Destructor
+  ~TecplotBinaryFile();
+
+  /// Gets the number of variables in each zone
+  CFuint getNbVars() const { return m_varNames.size(); }
+
+  /// Declares a finite element zone, to which the following calls to
+  /// addZoneAuxData() refer. Must be called before writeHeader().
+  /// @param name            title of the zone
+  /// @param zoneType        Tecplot zone type (FETRIANGLE, FEBRICK, ...)
+  /// @param strandID        strand of the zone, -1 for a static zone
+  /// @param solutionTime    solution time of the zone
+  /// @param isCellCentered  location of each variable, nodal if empty
+  /// @param nbNodes         number of nodes in the zone
+  /// @param nbElems         number of elements in the zone
+  void addZone(const std::string& name,
+               const std::string& zoneType,
+               const CFint strandID,
+               const CFdouble solutionTime,
+               const std::vector<bool>& isCellCentered,
+               const CFuint nbNodes,
+               const CFuint nbElems);
+
+  /// Adds an auxiliary name/value pair to the last declared zone
+  void addZoneAuxData(const std::string& name, const std::string& value);
+
+  /// Writes the header with all the declared zones to the given stream,
+  /// which should be opened in binary mode
+  void writeHeader(std::ostream& fout);
+
+  /// Gets the storage for the values of a variable in the zone to write next,
+  /// to be filled with one value per node or per element
+  std::vector<CFdouble>& getValues(const CFuint iVar);
+
+  /// Gets the storage for the zero based connectivity of the zone to write next
+  std::vector<boost::int32_t>& getConnectivity();
+
+  /// Gets the number of nodes per element of the zone to write next
+  CFuint getNbNodesPerElem() const;
+
+  /// Writes the data of the next zone, in the order of declaration,
+  /// and releases its storage
+  void writeZoneData(std::ostream& fout);
+
+private: // helper functions
+
+  /// Reserves the storage of the zone to write next
+  void prepareZoneData();
+
+  /// Writes a 32 bits integer
+  static void writeInt32(std::ostream& fout, const boost::int32_t value);
+
+  /// Writes a 32 bits float
+  static void writeFloat32(std::ostream& fout, const float value);
+
+  /// Writes a 64 bits float
+  static void writeFloat64(std::ostream& fout, const double value);
+
+  /// Writes a null terminated string, one 32 bits integer per character
+  static void writeString(std::ostream& fout, const std::string& str);
+
+private: // data
+
+  /// finite element zone description
+  struct Zone {
+    std::string name;
+    boost::int32_t zoneType;
+    boost::int32_t strandID;
+    CFdouble solutionTime;
+    std::vector<bool> isCellCentered;
+    CFuint nbNodes;
+    CFuint nbElems;
+    std::vector<std::pair<std::string, std::string> > auxData;
+  };
+
+  /// title of the data set
+  std::string m_title;
+
+  /// names of the variables
+  std::vector<std::string> m_varNames;
+
+  /// zones of the data set
+  std::vector<Zone> m_zones;
+
+  /// index of the zone whose data is written next
+  CFuint m_nextZone;
+
+  /// values of each variable of the zone to write next
+  std::vector<std::vector<CFdouble> > m_values;
+
+  /// connectivity of the zone to write next
+  std::vector<boost::int32_t> m_connectivity;
+
+}; // class TecplotBinaryFile
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace TecplotWriter
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_TecplotWriter_TecplotBinaryFile_hh
@@ -0,0 +1,274 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the binary Tecplot files"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/BadValueException.hh"
+#include "TecplotWriter/TecplotBinaryFile.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::TecplotWriter;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Reads back the records of a #!TDV112 file, as described in the
+/// Tecplot 360 data format guide
+struct TecplotReader
+{
+  TecplotReader(const string& content) : in(content) {}
+
+  boost::int32_t readInt32()
+  {
+    boost::int32_t value = 0;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    BOOST_REQUIRE(in.good());
+    return value;
+  }
+
+  float readFloat32()
+  {
+    float value = 0.f;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    BOOST_REQUIRE(in.good());
+    return value;
+  }
+
+  double readFloat64()
+  {
+    double value = 0.;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    BOOST_REQUIRE(in.good());
+    return value;
+  }
+
+  string readString()
+  {
+    string str;
+    for (boost::int32_t c = readInt32(); c != 0; c = readInt32()) {
+      str += static_cast<char>(c);
+    }
+    return str;
+  }
+
+  bool atEnd()
+  {
+    return in.peek() == char_traits<char>::eof();
+  }
+
+  istringstream in;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct TecplotBinaryFileFixture
+{
+  TecplotBinaryFileFixture() : varNames()
+  {
+    varNames.push_back("\"x\"");
+    varNames.push_back("\"y\"");
+    varNames.push_back("\"rho\"");
+  }
+
+  /// Writes two zones: nodal triangles with auxiliary data, then
+  /// quadrilaterals with a cell centered variable
+  string writeFile()
+  {
+    TecplotBinaryFile file("Test data", varNames);
+    file.addZone("triangles", "FETRIANGLE", -1, 0., vector<bool>(), 4, 2);
+    file.addZoneAuxData("Iter", "12");
+    file.addZoneAuxData("Method", "FVM");
+
+    vector<bool> cellCentered(3, false);
+    cellCentered[2] = true;
+    file.addZone("quads", "FEQUADRILATERAL", 3, 1.5, cellCentered, 6, 2);
+
+    ostringstream out;
+    file.writeHeader(out);
+
+    BOOST_CHECK_EQUAL(file.getNbNodesPerElem(), 3u);
+    const CFdouble tri[3][4] = {{0., 1., 1., 0.}, {0., 0., 1., 1.}, {1., -2., 3., 0.5}};
+    for (CFuint iVar = 0; iVar < 3; ++iVar) {
+      file.getValues(iVar).assign(tri[iVar], tri[iVar] + 4);
+    }
+    const boost::int32_t triConn[6] = {0, 1, 2, 0, 2, 3};
+    file.getConnectivity().assign(triConn, triConn + 6);
+    file.writeZoneData(out);
+
+    BOOST_CHECK_EQUAL(file.getNbNodesPerElem(), 4u);
+    const CFdouble quad[2][6] = {{0., 1., 2., 0., 1., 2.}, {0., 0., 0., 1., 1., 1.}};
+    for (CFuint iVar = 0; iVar < 2; ++iVar) {
+      file.getValues(iVar).assign(quad[iVar], quad[iVar] + 6);
+    }
+    file.getValues(2).push_back(7.);
+    file.getValues(2).push_back(-7.);
+    const boost::int32_t quadConn[8] = {0, 1, 4, 3, 1, 2, 5, 4};
+    file.getConnectivity().assign(quadConn, quadConn + 8);
+    file.writeZoneData(out);
+
+    return out.str();
+  }
+
+  vector<string> varNames;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( TecplotBinaryFileSuite, TecplotBinaryFileFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( HeaderRecords )
+{
+  TecplotReader reader(writeFile());
+
+  char magic[8];
+  reader.in.read(magic, 8);
+  BOOST_CHECK_EQUAL(string(magic, 8), "#!TDV112");
+  BOOST_CHECK_EQUAL(reader.readInt32(), 1);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readString(), "Test data");
+
+  // the quotes of the names are removed
+  BOOST_REQUIRE_EQUAL(reader.readInt32(), 3);
+  BOOST_CHECK_EQUAL(reader.readString(), "x");
+  BOOST_CHECK_EQUAL(reader.readString(), "y");
+  BOOST_CHECK_EQUAL(reader.readString(), "rho");
+
+  // first zone: static nodal triangles with two auxiliary data
+  BOOST_CHECK_EQUAL(reader.readFloat32(), 299.f);
+  BOOST_CHECK_EQUAL(reader.readString(), "triangles");
+  BOOST_CHECK_EQUAL(reader.readInt32(), -1);
+  BOOST_CHECK_EQUAL(reader.readInt32(), -1);
+  BOOST_CHECK_EQUAL(reader.readFloat64(), 0.);
+  BOOST_CHECK_EQUAL(reader.readInt32(), -1);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 2);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 4);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 2);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 1);
+  BOOST_CHECK_EQUAL(reader.readString(), "Iter");
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readString(), "12");
+  BOOST_CHECK_EQUAL(reader.readInt32(), 1);
+  BOOST_CHECK_EQUAL(reader.readString(), "Method");
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readString(), "FVM");
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+
+  // second zone: transient quadrilaterals with the variable locations
+  BOOST_CHECK_EQUAL(reader.readFloat32(), 299.f);
+  BOOST_CHECK_EQUAL(reader.readString(), "quads");
+  BOOST_CHECK_EQUAL(reader.readInt32(), -1);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 3);
+  BOOST_CHECK_EQUAL(reader.readFloat64(), 1.5);
+  BOOST_CHECK_EQUAL(reader.readInt32(), -1);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 3);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 1);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 1);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 6);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 2);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+  BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+
+  BOOST_CHECK_EQUAL(reader.readFloat32(), 357.f);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( ZoneRecords )
+{
+  const string content = writeFile();
+
+  // skip the header up to its end marker, looked for on 4 bytes boundaries
+  const float eoh = 357.f;
+  size_t dataStart = 8;
+  while (dataStart + 4 <= content.size() &&
+         content.compare(dataStart, 4, reinterpret_cast<const char*>(&eoh), 4) != 0) {
+    dataStart += 4;
+  }
+  BOOST_REQUIRE(dataStart + 4 < content.size());
+  TecplotReader reader(content.substr(dataStart + 4));
+
+  // each zone: double precision variables, no sharing, the ranges of
+  // the variables then their values in block and the zero based connectivity
+  const CFuint nbValues[2][3] = {{4, 4, 4}, {6, 6, 2}};
+  const CFdouble ranges[2][3][2] = {{{0., 1.}, {0., 1.}, {-2., 3.}},
+                                    {{0., 2.}, {0., 1.}, {-7., 7.}}};
+  const CFdouble values[2][3][6] = {{{0., 1., 1., 0.}, {0., 0., 1., 1.}, {1., -2., 3., 0.5}},
+                                    {{0., 1., 2., 0., 1., 2.}, {0., 0., 0., 1., 1., 1.}, {7., -7.}}};
+  const CFuint connSize[2] = {6, 8};
+  const boost::int32_t conn[2][8] = {{0, 1, 2, 0, 2, 3}, {0, 1, 4, 3, 1, 2, 5, 4}};
+
+  for (CFuint iZone = 0; iZone < 2; ++iZone) {
+    BOOST_CHECK_EQUAL(reader.readFloat32(), 299.f);
+    for (CFuint iVar = 0; iVar < 3; ++iVar) {
+      BOOST_CHECK_EQUAL(reader.readInt32(), 2);
+    }
+    BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+    BOOST_CHECK_EQUAL(reader.readInt32(), 0);
+    BOOST_CHECK_EQUAL(reader.readInt32(), -1);
+    for (CFuint iVar = 0; iVar < 3; ++iVar) {
+      BOOST_CHECK_EQUAL(reader.readFloat64(), ranges[iZone][iVar][0]);
+      BOOST_CHECK_EQUAL(reader.readFloat64(), ranges[iZone][iVar][1]);
+    }
+    for (CFuint iVar = 0; iVar < 3; ++iVar) {
+      for (CFuint i = 0; i < nbValues[iZone][iVar]; ++i) {
+        BOOST_CHECK_EQUAL(reader.readFloat64(), values[iZone][iVar][i]);
+      }
+    }
+    for (CFuint i = 0; i < connSize[iZone]; ++i) {
+      BOOST_CHECK_EQUAL(reader.readInt32(), conn[iZone][i]);
+    }
+  }
+  BOOST_CHECK(reader.atEnd());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( BadZones )
+{
+  TecplotBinaryFile file("Test data", varNames);
+  BOOST_CHECK_THROW(file.addZone("polygons", "FEPOLYGON", -1, 0., vector<bool>(), 4, 1),
+                    Common::BadValueException);
+
+  file.addZone("segments", "FELINESEG", -1, 0., vector<bool>(), 3, 2);
+  ostringstream out;
+  file.writeHeader(out);
+  BOOST_CHECK_EQUAL(file.getNbNodesPerElem(), 2u);
+
+  // one value missing for the last variable
+  for (CFuint iVar = 0; iVar < 3; ++iVar) {
+    file.getValues(iVar).assign(3 - iVar/2, 1.);
+  }
+  BOOST_CHECK_THROW(file.writeZoneData(out), Common::BadValueException);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -11,6 +11,7 @@
 #include "Common/PE.hh"
 
 #include "Common/CFMap.hh"
+#include "Common/StringOps.hh"
 #include "Environment/FileHandlerOutput.hh"
 
 #include "Common/OSystem.hh"
@@ -30,6 +31,7 @@
 #include "TecplotWriter/TecplotWriter.hh"
 #include "TecplotWriter/WriteSolutionBlock.hh"
 #include "TecplotWriter/MapGeoEntToTecplot.hh"
+#include "TecplotWriter/TecplotBinaryFile.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -121,8 +123,212 @@ const std::string WriteSolutionBlock::getWriterName() const
 
 void WriteSolutionBlock::writeToBinaryFile()
 {
- CFAUTOTRACE;
- throw Common::NotImplementedException (FromHere(),"Writing binary file is not implemented");
+  CFAUTOTRACE;
+
+  SafePtr<SubSystemStatus> subSysStatus = SubSystemStatusStack::getActive();
+  SafePtr<ConvectiveVarSet> updateVarSet = getMethodData().getUpdateVarSet();
+  SafePtr<DataHandleOutput> datahandle_output = getMethodData().getDataHOutput();
+
+  if (!getMethodData().onlySurface())
+  {
+
+  datahandle_output->getDataHandles();
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+
+  const CFuint dim   = m_dimension;
+  const CFuint nbEqs = m_nbEqs;
+  const CFreal refL  = m_refLenght;
+  const bool printExtra = getMethodData().shouldPrintExtraValues();
+
+  // variables in the same order as in the ASCII header
+  vector<std::string> varNames;
+  for (CFuint i = 0; i < dim; ++i) {
+    varNames.push_back("x" + StringOps::to_str(i));
+  }
+  varNames.insert(varNames.end(), updateVarSet->getVarNames().begin(), updateVarSet->getVarNames().end());
+  const CFuint nbExtraVars = printExtra ? updateVarSet->getExtraVarNames().size() : 0;
+  if (printExtra) {
+    varNames.insert(varNames.end(), updateVarSet->getExtraVarNames().begin(), updateVarSet->getExtraVarNames().end());
+  }
+  const std::vector< std::string > dh_varnames = datahandle_output->getVarNames();
+  varNames.insert(varNames.end(), dh_varnames.begin(), dh_varnames.end());
+  const std::vector< std::string > dh_ccvarnames = datahandle_output->getCCVarNames();
+  const std::vector< std::string > dh_cctrs = datahandle_output->getCCVarTrs();
+  cf_assert(dh_ccvarnames.size() == dh_cctrs.size());
+  varNames.insert(varNames.end(), dh_ccvarnames.begin(), dh_ccvarnames.end());
+
+  const CFuint ccStart = dim + nbEqs + nbExtraVars + dh_varnames.size();
+  vector<bool> isCellCentered(varNames.size(), false);
+  for (CFuint i = ccStart; i < varNames.size(); ++i) {
+    isCellCentered[i] = true;
+  }
+
+  TecplotBinaryFile tecFile("COOLFluiD Mesh Data", varNames);
+
+  RealVector dimensional_state(nbEqs);
+  RealVector extra_values; // size will be set in the VarSet
+  vector<CFuint> conn;
+
+  std::vector<SafePtr<TopologicalRegionSet> > trsList =
+    MeshDataStack::getActive()->getTrsList();
+
+  // each process writes its own file: the zones are declared in a first
+  // pass, which writes the header, and their data is written one zone at
+  // a time in a second pass
+  Common::SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
+    Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
+  ofstream& fout = fhandle->open(getMethodData().getFilename(), ios_base::out | ios_base::binary);
+
+  for (CFuint pass = 0; pass < 2; ++pass)
+  {
+    for(CFuint iTrs= 0; iTrs < trsList.size(); ++iTrs)
+    {
+      SafePtr<TopologicalRegionSet> trs = trsList[iTrs];
+
+      if((trs->hasTag("inner")) && (trs->hasTag("cell")))
+      {
+        SafePtr<vector<ElementTypeData> > elementType =
+          MeshDataStack::getActive()->getElementTypeData(trs->getName());
+
+        // one zone per element type
+        for (CFuint iType = 0; iType < elementType->size(); ++iType)
+        {
+          ElementTypeData& eType = (*elementType)[iType];
+          const CFuint nbCellsInType = eType.getNbElems();
+
+          // Tecplot doesn't handle zones with 0 elements
+          if (nbCellsInType == 0) continue;
+
+          GeoEntityInfo geoinfo;
+          geoinfo.nbStates  = eType.getNbStates();
+          geoinfo.geoOrder  = eType.getGeoOrder();
+          geoinfo.solOrder  = eType.getSolOrder();
+          geoinfo.dimension = dim;
+
+          const CFuint nbStatesInType = geoinfo.nbStates;
+          std::valarray<CFuint> elem_state_IDs (nbStatesInType);
+
+          // unique states of the elements of this type
+          vector<CFuint> all_states_in_type;
+          all_states_in_type.reserve(nbCellsInType*nbStatesInType);
+          for (CFuint iCell = eType.getStartIdx(); iCell < eType.getEndIdx(); ++iCell) {
+            cf_assert(nbStatesInType == trs->getNbStatesInGeo(iCell));
+            for (CFuint istate = 0; istate < nbStatesInType; ++istate) {
+              all_states_in_type.push_back(trs->getStateID(iCell,istate));
+            }
+          }
+          sort(all_states_in_type.begin(), all_states_in_type.end(), std::less<CFuint>());
+          all_states_in_type.erase(unique(all_states_in_type.begin(), all_states_in_type.end()),
+                                   all_states_in_type.end());
+          const CFuint nbStatesInZone = all_states_in_type.size();
+
+          const CFuint nbSubCellsInType = m_mapgeoent.computeNbSubEntities(geoinfo);
+          const CFuint nbsubcells = nbCellsInType * nbSubCellsInType;
+
+          if (pass == 0) {
+            tecFile.addZone("P" + StringOps::to_str(PE::GetPE().GetRank()) + " ZONE" +
+                            StringOps::to_str(iType) + " " + eType.getShape(),
+                            m_mapgeoent.identifyGeoEnt(geoinfo), -1, 0.,
+                            isCellCentered, nbStatesInZone, nbsubcells);
+            if (getMethodData().getAppendAuxData()) {
+              tecFile.addZoneAuxData("CPU", StringOps::to_str(PE::GetPE().GetRank()));
+              tecFile.addZoneAuxData("TRS", trs->getName());
+              tecFile.addZoneAuxData("Filename", basename(getMethodData().getFilename()) +
+                                     extension(getMethodData().getFilename()));
+              tecFile.addZoneAuxData("ElementType", eType.getShape());
+              tecFile.addZoneAuxData("Iter", StringOps::to_str(subSysStatus->getNbIter()));
+              tecFile.addZoneAuxData("PhysTime", StringOps::to_str(subSysStatus->getCurrentTimeDim()));
+            }
+            continue;
+          }
+
+          // zero based IDs in the zone, as required by the binary format
+          CFMap<CFuint,CFuint> localID_to_zoneID;
+          localID_to_zoneID.reserve(nbStatesInZone);
+          for (CFuint istate = 0; istate < nbStatesInZone; ++istate) {
+            localID_to_zoneID.insert(all_states_in_type[istate], istate);
+          }
+          localID_to_zoneID.sortKeys();
+
+          // coordinates, dimensional solution and extra values, state by state
+          for (CFuint is = 0; is < nbStatesInZone; ++is) {
+            const State& curr_state = *states[all_states_in_type[is]];
+            for (CFuint iDim = 0; iDim < dim; ++iDim) {
+              tecFile.getValues(iDim).push_back(curr_state.getCoordinates()[iDim] * refL);
+            }
+
+            if (printExtra) {
+              updateVarSet->setDimensionalValuesPlusExtraValues(curr_state, dimensional_state, extra_values);
+            }
+            else {
+              updateVarSet->setDimensionalValues(curr_state, dimensional_state);
+            }
+
+            for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+              tecFile.getValues(dim + iEq).push_back(dimensional_state[iEq]);
+            }
+            for (CFuint iEx = 0; iEx < nbExtraVars; ++iEx) {
+              tecFile.getValues(dim + nbEqs + iEx).push_back(extra_values[iEx]);
+            }
+          }
+
+          // datahandles with state based data
+          for (CFuint idh = 0; idh < dh_varnames.size(); ++idh) {
+            DataHandleOutput::DataHandleInfo dh_info = datahandle_output->getStateData(idh);
+            CFuint dh_var = dh_info.first;
+            CFuint dh_nbvars = dh_info.second;
+            DataHandle<CFreal> dh = dh_info.third;
+
+            vector<CFdouble>& values = tecFile.getValues(dim + nbEqs + nbExtraVars + idh);
+            for (CFuint is = 0; is < nbStatesInZone; ++is) {
+              values.push_back(dh(all_states_in_type[is], dh_var, dh_nbvars));
+            }
+          }
+
+          // datahandles with cell based data, zero if not defined in this TRS
+          for (CFuint idh = 0; idh < dh_ccvarnames.size(); ++idh) {
+            vector<CFdouble>& values = tecFile.getValues(ccStart + idh);
+            if (trs->getName() == dh_cctrs[idh]) {
+              DataHandleOutput::DataHandleInfo dh_info = datahandle_output->getCCData(idh);
+              CFuint dh_var = dh_info.first;
+              CFuint dh_nbvars = dh_info.second;
+              DataHandle<CFreal> dh = dh_info.third;
+              for (CFuint iCell = eType.getStartIdx(); iCell < eType.getEndIdx(); ++iCell) {
+                for (CFuint jsubcell = 0; jsubcell < nbSubCellsInType; ++jsubcell) {
+                  values.push_back(dh(iCell*nbSubCellsInType + jsubcell, dh_var, dh_nbvars));
+                }
+              }
+            }
+            else {
+              values.assign(nbsubcells, 0.);
+            }
+          }
+
+          // connectivity
+          vector<boost::int32_t>& zoneConn = tecFile.getConnectivity();
+          for (CFuint iCell = eType.getStartIdx(); iCell < eType.getEndIdx(); ++iCell) {
+            for(CFuint n = 0; n < nbStatesInType; ++n) {
+              elem_state_IDs[n] = localID_to_zoneID.find(trs->getStateID(iCell, n));
+            }
+            m_mapgeoent.getGeoEntConn(elem_state_IDs, geoinfo, conn);
+            zoneConn.insert(zoneConn.end(), conn.begin(), conn.end());
+          }
+          tecFile.writeZoneData(fout);
+        } // loop over element types in TRS
+      } //end if inner cells
+    } //end loop over trs
+
+    if (pass == 0) {
+      tecFile.writeHeader(fout);
+    }
+  } // end loop over passes
+
+  fhandle->close();
+
+  } // if only surface
+
+  // write boundary surface data
+  writeBoundarySurface();
 }
 
 //////////////////////////////////////////////////////////////////////////////
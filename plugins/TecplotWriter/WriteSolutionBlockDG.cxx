@@ -11,6 +11,7 @@
 #include "Common/PE.hh"
 
 #include "Common/CFMap.hh"
+#include "Common/StringOps.hh"
 #include "Environment/FileHandlerOutput.hh"
 
 #include "Common/OSystem.hh"
@@ -32,6 +33,7 @@
 #include "TecplotWriter/TecplotWriter.hh"
 #include "TecplotWriter/WriteSolutionBlockDG.hh"
 #include "TecplotWriter/MapGeoEntToTecplot.hh"
+#include "TecplotWriter/TecplotBinaryFile.hh"
 
 #include "Framework/FaceToCellGEBuilder.hh"
 
@@ -130,8 +132,160 @@ const std::string WriteSolutionBlockDG::getWriterName() const
 
 void WriteSolutionBlockDG::writeToBinaryFile()
 {
- CFAUTOTRACE;
- throw Common::NotImplementedException (FromHere(),"Writing binary file is not implemented");
+  CFAUTOTRACE;
+
+  SafePtr<SubSystemStatus> subSysStatus = SubSystemStatusStack::getActive();
+
+  if (!getMethodData().onlySurface())
+  {
+
+  DataHandle < RealVector > techNodesCoordinates = socket_techNodesCoordinates.getDataHandle();
+  DataHandle < std::vector< CFuint > > techNodesToStates = socket_techNodesToStates.getDataHandle();
+  DataHandle < CFuint > techStatesToNodes = socket_techStatesToNodes.getDataHandle();
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+
+  const CFuint dim   = m_dimension;
+  const CFuint nbEqs = m_nbEqs;
+  const CFreal refL  = m_refLenght;
+
+  // variables in the same order as in the ASCII header
+  vector<std::string> varNames;
+  for (CFuint i = 0; i < dim; ++i) {
+    varNames.push_back("x" + StringOps::to_str(i));
+  }
+  for (CFuint i = 0 ;  i < nbEqs; ++i) {
+    varNames.push_back("W" + StringOps::to_str(i));
+  }
+
+  TecplotBinaryFile tecFile("COOLFluiD Mesh Data", varNames);
+
+  State hlpState;
+  vector<CFuint> conn;
+
+  std::vector<SafePtr<TopologicalRegionSet> > trsList =
+    MeshDataStack::getActive()->getTrsList();
+
+  // each process writes its own file: the zones are declared in a first
+  // pass, which writes the header, and their data is written one zone at
+  // a time in a second pass
+  Common::SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
+    Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
+  ofstream& fout = fhandle->open(getMethodData().getFilename(), ios_base::out | ios_base::binary);
+
+  for (CFuint pass = 0; pass < 2; ++pass)
+  {
+    for(CFuint iTrs= 0; iTrs < trsList.size(); ++iTrs)
+    {
+      SafePtr<TopologicalRegionSet> trs = trsList[iTrs];
+
+      if((trs->hasTag("inner")) && (trs->hasTag("cell")))
+      {
+        SafePtr<vector<ElementTypeData> > elementType =
+          MeshDataStack::getActive()->getElementTypeData(trs->getName());
+
+        // one zone per element type
+        for (CFuint iType = 0; iType < elementType->size(); ++iType)
+        {
+          ElementTypeData& eType = (*elementType)[iType];
+          const CFuint nbCellsInType = eType.getNbElems();
+
+          // Tecplot doesn't handle zones with 0 elements
+          if (nbCellsInType == 0) continue;
+
+          GeoEntityInfo geoinfo;
+          geoinfo.nbStates  = eType.getNbStates();
+          geoinfo.nbNodes   = eType.getNbNodes();
+          geoinfo.geoOrder  = eType.getGeoOrder();
+          geoinfo.solOrder  = eType.getSolOrder();
+          geoinfo.dimension = dim;
+
+          const CFuint nbStatesInType = geoinfo.nbStates;
+          std::valarray<CFuint> elem_state_IDs (nbStatesInType);
+
+          // unique visualization nodes of the elements of this type
+          vector<CFuint> all_nodes_in_type;
+          all_nodes_in_type.reserve(nbCellsInType*nbStatesInType);
+          for (CFuint iCell = eType.getStartIdx(); iCell < eType.getEndIdx(); ++iCell) {
+            cf_assert(nbStatesInType == trs->getNbStatesInGeo(iCell));
+            for (CFuint istate = 0; istate < nbStatesInType; ++istate) {
+              all_nodes_in_type.push_back(techStatesToNodes[trs->getStateID(iCell,istate)]);
+            }
+          }
+          sort(all_nodes_in_type.begin(), all_nodes_in_type.end(), std::less<CFuint>());
+          all_nodes_in_type.erase(unique(all_nodes_in_type.begin(), all_nodes_in_type.end()),
+                                  all_nodes_in_type.end());
+          const CFuint nbNodesInZone = all_nodes_in_type.size();
+
+          const CFuint nbsubcells = nbCellsInType * m_mapgeoent.computeNbSubEntities(geoinfo);
+
+          if (pass == 0) {
+            tecFile.addZone("P" + StringOps::to_str(PE::GetPE().GetRank()) + " ZONE" +
+                            StringOps::to_str(iType) + " " + eType.getShape(),
+                            m_mapgeoent.identifyGeoEnt(geoinfo), -1, 0.,
+                            vector<bool>(), nbNodesInZone, nbsubcells);
+            if (getMethodData().getAppendAuxData()) {
+              tecFile.addZoneAuxData("CPU", StringOps::to_str(PE::GetPE().GetRank()));
+              tecFile.addZoneAuxData("TRS", trs->getName());
+              tecFile.addZoneAuxData("Filename", basename(getMethodData().getFilename()) +
+                                     extension(getMethodData().getFilename()));
+              tecFile.addZoneAuxData("ElementType", eType.getShape());
+              tecFile.addZoneAuxData("Iter", StringOps::to_str(subSysStatus->getNbIter()));
+              tecFile.addZoneAuxData("PhysTime", StringOps::to_str(subSysStatus->getCurrentTimeDim()));
+            }
+            continue;
+          }
+
+          // zero based IDs in the zone, as required by the binary format
+          CFMap<CFuint,CFuint> localID_to_zoneID;
+          localID_to_zoneID.reserve(nbNodesInZone);
+          for (CFuint iNode = 0; iNode < nbNodesInZone; ++iNode) {
+            localID_to_zoneID.insert(all_nodes_in_type[iNode], iNode);
+          }
+          localID_to_zoneID.sortKeys();
+
+          // coordinates and average of the states sharing each node
+          for (CFuint iNode = 0; iNode < nbNodesInZone; ++iNode) {
+            const vector<CFuint>& nodeStates = techNodesToStates[all_nodes_in_type[iNode]];
+            const CFuint nbStates = nodeStates.size();
+            hlpState = 0;
+            for(CFuint iState = 0; iState < nbStates; ++iState) {
+              hlpState += *(states[nodeStates[iState]]);
+            }
+            hlpState /= nbStates;
+
+            for (CFuint iDim = 0; iDim < dim; ++iDim) {
+              tecFile.getValues(iDim).push_back(techNodesCoordinates[all_nodes_in_type[iNode]][iDim]*refL);
+            }
+            for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+              tecFile.getValues(dim + iEq).push_back(hlpState[iEq]);
+            }
+          }
+
+          // connectivity
+          vector<boost::int32_t>& zoneConn = tecFile.getConnectivity();
+          for (CFuint iCell = eType.getStartIdx(); iCell < eType.getEndIdx(); ++iCell) {
+            for(CFuint n = 0; n < nbStatesInType; ++n) {
+              elem_state_IDs[n] = localID_to_zoneID.find(techStatesToNodes[trs->getStateID(iCell, n)]);
+            }
+            m_mapgeoent.getGeoEntConn(elem_state_IDs, geoinfo, conn);
+            zoneConn.insert(zoneConn.end(), conn.begin(), conn.end());
+          }
+          tecFile.writeZoneData(fout);
+        } // loop over element types in TRS
+      } //end if inner cells
+    } //end loop over trs
+
+    if (pass == 0) {
+      tecFile.writeHeader(fout);
+    }
+  } // end loop over passes
+
+  fhandle->close();
+
+  } // if only surface
+
+  // write boundary surface data
+  writeBoundarySurface();
 }
 
 //////////////////////////////////////////////////////////////////////////////
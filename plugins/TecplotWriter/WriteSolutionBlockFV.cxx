@@ -11,6 +11,7 @@
 #include "Common/PE.hh"
 
 #include "Common/CFMap.hh"
+#include "Common/StringOps.hh"
 #include "Environment/FileHandlerOutput.hh"
 
 #include "Common/OSystem.hh"
@@ -31,6 +32,7 @@
 #include "TecplotWriter/TecplotWriter.hh"
 #include "TecplotWriter/WriteSolutionBlockFV.hh"
 #include "TecplotWriter/MapGeoEntToTecplot.hh"
+#include "TecplotWriter/TecplotBinaryFile.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -128,8 +130,227 @@ const std::string WriteSolutionBlockFV::getWriterName() const
 
 void WriteSolutionBlockFV::writeToBinaryFile()
 {
- CFAUTOTRACE;
- throw Common::NotImplementedException (FromHere(),"Writing binary file is not implemented");
+  CFAUTOTRACE;
+
+  // the boundary surface is only available in ASCII
+  if (getMethodData().onlySurface()) {
+    writeToFile(getMethodData().getFilename());
+    return;
+  }
+
+  SafePtr<SubSystemStatus> subSysStatus = SubSystemStatusStack::getActive();
+  SafePtr<ConvectiveVarSet> updateVarSet = getMethodData().getUpdateVarSet();
+  SafePtr<ConvectiveVarSet> outputVarSet = getMethodData().getOutputVarSet();
+  SafePtr<VarSetTransformer> updateToOutput = getMethodData().getUpdateToOutputVarSetTransformer();
+  SafePtr<DataHandleOutput> datahandle_output = getMethodData().getDataHOutput();
+  datahandle_output->getDataHandles();
+
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle < Framework::Node* , Framework::GLOBAL > nodes = socket_nodes.getDataHandle();
+  DataHandle<ProxyDofIterator<RealVector>*> nstatesProxy =
+    socket_nstatesProxy.getDataHandle();
+  ProxyDofIterator<RealVector>& nodalStates = *nstatesProxy[0];
+
+  const CFuint dim   = m_dimension;
+  const CFuint nbEqs = m_nbEqs;
+  const CFreal refL  = m_refLenght;
+
+  // variables in the same order as in the ASCII header
+  m_nodalvars = datahandle_output->getVarNames();
+  m_ccvars    = datahandle_output->getCCVarNames();
+  const std::vector< std::string > dh_cctrs = datahandle_output->getCCVarTrs();
+
+  vector<std::string> varNames;
+  for (CFuint i = 0; i < dim; ++i) {
+    varNames.push_back("x" + StringOps::to_str(i));
+  }
+  varNames.insert(varNames.end(), outputVarSet->getVarNames().begin(), outputVarSet->getVarNames().end());
+  varNames.insert(varNames.end(), m_nodalvars.begin(), m_nodalvars.end());
+  varNames.insert(varNames.end(), m_ccvars.begin(), m_ccvars.end());
+
+  vector<bool> isCellCentered(varNames.size(), false);
+  for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+    isCellCentered[dim + iEq] = !m_nodalOutputVar;
+  }
+  for (CFuint i = 0; i < m_ccvars.size(); ++i) {
+    isCellCentered[dim + nbEqs + m_nodalvars.size() + i] = true;
+  }
+
+  TecplotBinaryFile tecFile("COOLFluiD Mesh Data", varNames);
+
+  const CFreal solutiontime = subSysStatus->getCurrentTimeDim() > 0 ?
+    subSysStatus->getCurrentTimeDim() : subSysStatus->getNbIter();
+
+  RealVector output_dimensional_state(nbEqs);
+  vector<CFuint> conn;
+
+  std::vector<SafePtr<TopologicalRegionSet> > trsList =
+    MeshDataStack::getActive()->getTrsList();
+
+  // each process writes its own file: the zones are declared in a first
+  // pass, which writes the header, and their data is written one zone at
+  // a time in a second pass
+  Common::SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
+    Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
+  ofstream& fout = fhandle->open(getMethodData().getFilename(), ios_base::out | ios_base::binary);
+
+  for (CFuint pass = 0; pass < 2; ++pass)
+  {
+    for(CFuint iTrs= 0; iTrs < trsList.size(); ++iTrs)
+    {
+      SafePtr<TopologicalRegionSet> trs = trsList[iTrs];
+
+      if((trs->hasTag("inner")) && (trs->hasTag("cell")))
+      {
+        SafePtr<vector<ElementTypeData> > elementType =
+          MeshDataStack::getActive()->getElementTypeData(trs->getName());
+
+        // one zone per element type
+        for (CFuint iType = 0; iType < elementType->size(); ++iType)
+        {
+          ElementTypeData& eType = (*elementType)[iType];
+          const CFuint nbCellsInType = eType.getNbElems();
+
+          // Tecplot doesn't handle zones with 0 elements
+          if (nbCellsInType == 0) continue;
+
+          GeoEntityInfo geoinfo;
+          geoinfo.nbStates  = eType.getNbStates();
+          geoinfo.nbNodes   = eType.getNbNodes() ;
+          geoinfo.geoOrder  = eType.getGeoOrder();
+          geoinfo.solOrder  = CFPolyOrder::ORDER1;
+          geoinfo.dimension = dim;
+
+          const CFuint nbNodesInType = geoinfo.nbNodes;
+          std::valarray<CFuint> elem_node_IDs (nbNodesInType);
+
+          // unique nodes of the elements of this type
+          vector<CFuint> all_nodes_in_type;
+          all_nodes_in_type.reserve(nbCellsInType*nbNodesInType);
+          for (CFuint iCell = eType.getStartIdx(); iCell < eType.getEndIdx(); ++iCell) {
+            cf_assert(nbNodesInType == trs->getNbNodesInGeo(iCell));
+            for (CFuint inode = 0; inode < nbNodesInType; ++inode) {
+              all_nodes_in_type.push_back(trs->getNodeID(iCell,inode));
+            }
+          }
+          sort(all_nodes_in_type.begin(), all_nodes_in_type.end(), std::less<CFuint>());
+          all_nodes_in_type.erase(unique(all_nodes_in_type.begin(), all_nodes_in_type.end()),
+                                  all_nodes_in_type.end());
+          const CFuint nbNodesInZone = all_nodes_in_type.size();
+
+          const CFuint nbSubCellsInType = m_mapgeoent.computeNbSubEntities(geoinfo);
+          const CFuint nbsubcells = nbCellsInType * nbSubCellsInType;
+
+          if (pass == 0) {
+            tecFile.addZone("P" + StringOps::to_str(PE::GetPE().GetRank()) + " ZONE" +
+                            StringOps::to_str(iType) + " " + eType.getShape(),
+                            m_mapgeoent.identifyGeoEnt(geoinfo), 1, solutiontime,
+                            isCellCentered, nbNodesInZone, nbsubcells);
+            if (getMethodData().getAppendAuxData()) {
+              tecFile.addZoneAuxData("CPU", StringOps::to_str(PE::GetPE().GetRank()));
+              tecFile.addZoneAuxData("TRS", trs->getName());
+              tecFile.addZoneAuxData("Filename", basename(getMethodData().getFilename()) +
+                                     extension(getMethodData().getFilename()));
+              tecFile.addZoneAuxData("ElementType", eType.getShape());
+              tecFile.addZoneAuxData("Iter", StringOps::to_str(subSysStatus->getNbIter()));
+              tecFile.addZoneAuxData("PhysTime", StringOps::to_str(subSysStatus->getCurrentTimeDim()));
+            }
+            continue;
+          }
+
+          // zero based IDs in the zone, as required by the binary format
+          CFMap<CFuint,CFuint> local_to_zoneID;
+          local_to_zoneID.reserve(nbNodesInZone);
+          for (CFuint inode = 0; inode < nbNodesInZone; ++inode) {
+            local_to_zoneID.insert(all_nodes_in_type[inode], inode);
+          }
+          local_to_zoneID.sortKeys();
+
+          // coordinates
+          for (CFuint iDim = 0; iDim < dim; ++iDim) {
+            vector<CFdouble>& values = tecFile.getValues(iDim);
+            for (CFuint inode = 0; inode < nbNodesInZone; ++inode) {
+              values.push_back((*nodes[all_nodes_in_type[inode]])[iDim] * refL);
+            }
+          }
+
+          // dimensional solution, transformed once per node or cell and
+          // repeated in all the subcells of the cell
+          if (m_nodalOutputVar) {
+            for (CFuint inode = 0; inode < nbNodesInZone; ++inode) {
+              updateVarSet->setDimensionalValues(*nodalStates.getState(all_nodes_in_type[inode]), *m_dimensionalState);
+              output_dimensional_state = *updateToOutput->transform(m_dimensionalState);
+              for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+                tecFile.getValues(dim + iEq).push_back(output_dimensional_state[iEq]);
+              }
+            }
+          }
+          else {
+            for (CFuint iCell = eType.getStartIdx(); iCell < eType.getEndIdx(); ++iCell) {
+              updateVarSet->setDimensionalValues(*states[iCell], *m_dimensionalState);
+              output_dimensional_state = *updateToOutput->transform(m_dimensionalState);
+              for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+                tecFile.getValues(dim + iEq).insert(tecFile.getValues(dim + iEq).end(),
+                                                    nbSubCellsInType, output_dimensional_state[iEq]);
+              }
+            }
+          }
+
+          // datahandles with state based data
+          for (CFuint idh = 0; idh < m_nodalvars.size(); ++idh) {
+            DataHandleOutput::DataHandleInfo dh_info = datahandle_output->getStateData(idh);
+            CFuint dh_var = dh_info.first;
+            CFuint dh_nbvars = dh_info.second;
+            DataHandle<CFreal> dh = dh_info.third;
+
+            vector<CFdouble>& values = tecFile.getValues(dim + nbEqs + idh);
+            for (CFuint inode = 0; inode < nbNodesInZone; ++inode) {
+              const CFuint stateID = nodalStates.getStateLocalID(all_nodes_in_type[inode]);
+              values.push_back(dh(stateID, dh_var, dh_nbvars));
+            }
+          }
+
+          // datahandles with cell based data, zero if not defined in this TRS
+          for (CFuint idh = 0; idh < m_ccvars.size(); ++idh) {
+            vector<CFdouble>& values = tecFile.getValues(dim + nbEqs + m_nodalvars.size() + idh);
+            if (trs->getName() == dh_cctrs[idh]) {
+              DataHandleOutput::DataHandleInfo dh_info = datahandle_output->getCCData(idh);
+              CFuint dh_var = dh_info.first;
+              CFuint dh_nbvars = dh_info.second;
+              DataHandle<CFreal> dh = dh_info.third;
+              for (CFuint iCell = eType.getStartIdx(); iCell < eType.getEndIdx(); ++iCell) {
+                for (CFuint jsubcell = 0; jsubcell < nbSubCellsInType; ++jsubcell) {
+                  values.push_back(dh(iCell*nbSubCellsInType + jsubcell, dh_var, dh_nbvars));
+                }
+              }
+            }
+            else {
+              values.assign(nbsubcells, 0.);
+            }
+          }
+
+          // connectivity
+          vector<boost::int32_t>& zoneConn = tecFile.getConnectivity();
+          for (CFuint iCell = eType.getStartIdx(); iCell < eType.getEndIdx(); ++iCell) {
+            for(CFuint n = 0; n < nbNodesInType; ++n) {
+              elem_node_IDs[n] = local_to_zoneID.find(trs->getNodeID(iCell, n));
+            }
+            m_mapgeoent.getGeoEntConn(elem_node_IDs, geoinfo, conn);
+            zoneConn.insert(zoneConn.end(), conn.begin(), conn.end());
+          }
+          tecFile.writeZoneData(fout);
+        } // loop over element types in TRS
+      } //end if inner cells
+    } //end loop over trs
+
+    if (pass == 0) {
+      tecFile.writeHeader(fout);
+    }
+  } // end loop over passes
+
+  fhandle->close();
+
+  writeSurfaceFile();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -457,21 +678,28 @@ void WriteSolutionBlockFV::writeToFileStream(std::ofstream& fout)
   }
   else
   {
-    if (!getMethodData().getSurfaceTRSsToWrite().empty()) {
-      path cfgpath = getMethodData().getFilename();
-      path filepath = cfgpath.branch_path() / ( basename(cfgpath) + "-surf" + extension(cfgpath) );
-
-      Common::SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
-        Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
-      ofstream& fout = fhandle->open(filepath);
-      writeBoundarySurface(fout);
-    }
+    writeSurfaceFile();
   }
 
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
+void WriteSolutionBlockFV::writeSurfaceFile()
+{
+  if (!getMethodData().getSurfaceTRSsToWrite().empty()) {
+    path cfgpath = getMethodData().getFilename();
+    path filepath = cfgpath.branch_path() / ( basename(cfgpath) + "-surf" + extension(cfgpath) );
+
+    Common::SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
+      Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
+    ofstream& fout = fhandle->open(filepath);
+    writeBoundarySurface(fout);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void WriteSolutionBlockFV::setup()
 {
   CFAUTOTRACE;
@@ -84,6 +84,9 @@ protected: // functions
   /// Write the boundary surface data
   void writeBoundarySurface(std::ofstream& fout);
 
+  /// Write the boundary surface data in a separate "-surf" file, if requested
+  void writeSurfaceFile();
+
   /// Get the name of the writer
   const std::string getWriterName() const;
 
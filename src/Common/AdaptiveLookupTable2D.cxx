@@ -0,0 +1,613 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include <boost/cstdint.hpp>
+
+#include "Common/AdaptiveLookupTable2D.hh"
+#include "Common/BadValueException.hh"
+#include "Common/FilesystemException.hh"
+
+#if defined(CF_HAVE_ALLOC_MMAP) && defined(CF_HAVE_UNISTD_H)
+#  define CF_LOOKUP_TABLE_MMAP
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/types.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// header of the table files, followed by the labels (the NUL-terminated
+/// variable names and source, padded to a multiple of 8 bytes),
+/// the x nodes, the y nodes and the values
+struct LookupTableFileHeader {
+  char magic[8];
+  boost::uint32_t version;
+  boost::uint32_t nbVars;
+  boost::uint32_t nbX;
+  boost::uint32_t nbY;
+  boost::uint32_t logY;
+  boost::uint32_t labelsSize;
+  boost::uint32_t nbX0;
+  boost::uint32_t nbY0;
+  boost::uint32_t maxLevels;
+  boost::uint32_t padding;
+  double xmin;
+  double xmax;
+  double ymin;
+  double ymax;
+  double tolerance;
+};
+
+/// identifier of the table files
+static const char LOOKUP_TABLE_MAGIC[8] = "CFLKP2D";
+
+/// version of the table files
+static const boost::uint32_t LOOKUP_TABLE_VERSION = 3;
+
+/// maximum number of buckets per axis
+static const CFuint MAX_NB_BUCKETS = 1 << 20;
+
+//////////////////////////////////////////////////////////////////////////////
+
+AdaptiveLookupTable2D::AdaptiveLookupTable2D() :
+  Common::NonCopyable<AdaptiveLookupTable2D>(),
+  m_nbVars(0),
+  m_logY(false),
+  m_xmin(0.),
+  m_xmax(0.),
+  m_ymin(0.),
+  m_ymax(0.),
+  m_nbX0(0),
+  m_nbY0(0),
+  m_tolerance(0.),
+  m_maxLevels(0),
+  m_varNames(),
+  m_source(),
+  m_x(),
+  m_y(),
+  m_invDx(),
+  m_invDy(),
+  m_xBuckets(),
+  m_yBuckets(),
+  m_invBucketX(0.),
+  m_invBucketY(0.),
+  m_storage(),
+  m_values(CFNULL),
+  m_mapped(CFNULL),
+  m_mappedSize(0)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+AdaptiveLookupTable2D::~AdaptiveLookupTable2D()
+{
+  clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AdaptiveLookupTable2D::clear()
+{
+#ifdef CF_LOOKUP_TABLE_MMAP
+  if (m_mapped != CFNULL) {
+    munmap(m_mapped, m_mappedSize);
+  }
+#endif
+  m_mapped = CFNULL;
+  m_mappedSize = 0;
+  m_values = CFNULL;
+  m_nbVars = 0;
+  m_xmin = m_xmax = m_ymin = m_ymax = m_tolerance = 0.;
+  m_nbX0 = m_nbY0 = m_maxLevels = 0;
+  m_varNames.clear();
+  m_source.clear();
+  vector<CFreal>().swap(m_storage);
+  m_x.clear();
+  m_y.clear();
+  m_invDx.clear();
+  m_invDy.clear();
+  m_xBuckets.clear();
+  m_yBuckets.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal AdaptiveLookupTable2D::toY(const CFreal y) const
+{
+  return (m_logY) ? std::log(std::max(y, numeric_limits<CFreal>::min())) : y;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal AdaptiveLookupTable2D::fromY(const CFreal t) const
+{
+  return (m_logY) ? std::exp(t) : t;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AdaptiveLookupTable2D::build(Sampler& sampler,
+                                  const CFuint nbVars,
+                                  const CFreal xmin, const CFreal xmax, const CFuint nbX,
+                                  const CFreal ymin, const CFreal ymax, const CFuint nbY,
+                                  const bool logY,
+                                  const CFreal tolerance,
+                                  const CFuint maxLevels)
+{
+  if (nbVars == 0 || nbX < 2 || nbY < 2 || !(xmax > xmin) || !(ymax > ymin) ||
+      (logY && !(ymin > 0.))) {
+    throw BadValueException(FromHere(), "AdaptiveLookupTable2D::build() => invalid table ranges");
+  }
+
+  clear();
+  m_nbVars = nbVars;
+  m_logY = logY;
+  m_xmin = xmin;
+  m_xmax = xmax;
+  m_ymin = ymin;
+  m_ymax = ymax;
+  m_nbX0 = nbX;
+  m_nbY0 = nbY;
+  m_tolerance = tolerance;
+  m_maxLevels = maxLevels;
+
+  m_x.resize(nbX);
+  for (CFuint i = 0; i < nbX; ++i) {
+    m_x[i] = xmin + (xmax - xmin)*i/(nbX - 1);
+  }
+  const CFreal ty0 = toY(ymin);
+  const CFreal ty1 = toY(ymax);
+  m_y.resize(nbY);
+  for (CFuint j = 0; j < nbY; ++j) {
+    m_y[j] = ty0 + (ty1 - ty0)*j/(nbY - 1);
+  }
+
+  m_storage.resize(nbX*nbY*nbVars);
+  for (CFuint j = 0; j < nbY; ++j) {
+    for (CFuint i = 0; i < nbX; ++i) {
+      sampler.compute(m_x[i], fromY(m_y[j]), &m_storage[(j*nbX + i)*nbVars]);
+    }
+  }
+
+  vector<CFreal> scale(nbVars);
+  vector<CFreal> sample(nbVars);
+  for (CFuint level = 0; level < maxLevels; ++level) {
+    const CFuint nX = m_x.size();
+    const CFuint nY = m_y.size();
+
+    // the error of each variable is measured relatively to its range
+    for (CFuint iVar = 0; iVar < nbVars; ++iVar) {
+      CFreal vmin = m_storage[iVar];
+      CFreal vmax = m_storage[iVar];
+      for (CFuint n = 1; n < nX*nY; ++n) {
+        vmin = std::min(vmin, m_storage[n*nbVars + iVar]);
+        vmax = std::max(vmax, m_storage[n*nbVars + iVar]);
+      }
+      scale[iVar] = (vmax > vmin) ? 1./(vmax - vmin) : 1./std::max(std::abs(vmax), 1.);
+    }
+
+    // sample the middle of each x interval along all the y nodes:
+    // the interval is split if the interpolation there is not accurate enough
+    vector<vector<CFreal> > midX(nX - 1);
+    CFuint nbSplitX = 0;
+    for (CFuint i = 0; i < nX - 1; ++i) {
+      const CFreal xm = 0.5*(m_x[i] + m_x[i+1]);
+      vector<CFreal> column(nY*nbVars);
+      CFreal error = 0.;
+      for (CFuint j = 0; j < nY; ++j) {
+        CFreal* v = &column[j*nbVars];
+        sampler.compute(xm, fromY(m_y[j]), v);
+        const CFreal* v0 = &m_storage[(j*nX + i)*nbVars];
+        for (CFuint iVar = 0; iVar < nbVars; ++iVar) {
+          error = std::max(error, std::abs(v[iVar] - 0.5*(v0[iVar] + v0[nbVars + iVar]))*scale[iVar]);
+        }
+      }
+      if (error > tolerance) {
+        midX[i].swap(column);
+        ++nbSplitX;
+      }
+    }
+
+    // same along y
+    vector<vector<CFreal> > midY(nY - 1);
+    CFuint nbSplitY = 0;
+    for (CFuint j = 0; j < nY - 1; ++j) {
+      const CFreal ym = fromY(0.5*(m_y[j] + m_y[j+1]));
+      vector<CFreal> row(nX*nbVars);
+      CFreal error = 0.;
+      for (CFuint i = 0; i < nX; ++i) {
+        CFreal* v = &row[i*nbVars];
+        sampler.compute(m_x[i], ym, v);
+        const CFreal* v0 = &m_storage[(j*nX + i)*nbVars];
+        const CFreal* v1 = &m_storage[((j+1)*nX + i)*nbVars];
+        for (CFuint iVar = 0; iVar < nbVars; ++iVar) {
+          error = std::max(error, std::abs(v[iVar] - 0.5*(v0[iVar] + v1[iVar]))*scale[iVar]);
+        }
+      }
+      if (error > tolerance) {
+        midY[j].swap(row);
+        ++nbSplitY;
+      }
+    }
+
+    if (nbSplitX == 0 && nbSplitY == 0) break;
+
+    // new axes: old nodes are flagged with their index,
+    // new middle nodes with the index of the split interval + nX (or nY)
+    vector<CFreal> newX;
+    vector<CFuint> srcX;
+    newX.reserve(nX + nbSplitX);
+    srcX.reserve(nX + nbSplitX);
+    for (CFuint i = 0; i < nX; ++i) {
+      newX.push_back(m_x[i]);
+      srcX.push_back(i);
+      if (i < nX - 1 && !midX[i].empty()) {
+        newX.push_back(0.5*(m_x[i] + m_x[i+1]));
+        srcX.push_back(nX + i);
+      }
+    }
+
+    vector<CFreal> newY;
+    vector<CFuint> srcY;
+    newY.reserve(nY + nbSplitY);
+    srcY.reserve(nY + nbSplitY);
+    for (CFuint j = 0; j < nY; ++j) {
+      newY.push_back(m_y[j]);
+      srcY.push_back(j);
+      if (j < nY - 1 && !midY[j].empty()) {
+        newY.push_back(0.5*(m_y[j] + m_y[j+1]));
+        srcY.push_back(nY + j);
+      }
+    }
+
+    // fill the new grid reusing all the values already sampled
+    const CFuint newNX = newX.size();
+    const CFuint newNY = newY.size();
+    vector<CFreal> newValues(newNX*newNY*nbVars);
+    for (CFuint jn = 0; jn < newNY; ++jn) {
+      for (CFuint in = 0; in < newNX; ++in) {
+        CFreal* v = &newValues[(jn*newNX + in)*nbVars];
+        const CFuint i = srcX[in];
+        const CFuint j = srcY[jn];
+        const CFreal* src = CFNULL;
+        if (i < nX && j < nY) {
+          src = &m_storage[(j*nX + i)*nbVars];
+        }
+        else if (j < nY) {
+          src = &midX[i - nX][j*nbVars];
+        }
+        else if (i < nX) {
+          src = &midY[j - nY][i*nbVars];
+        }
+
+        if (src != CFNULL) {
+          std::copy(src, src + nbVars, v);
+        }
+        else {
+          sampler.compute(newX[in], fromY(newY[jn]), v);
+        }
+      }
+    }
+
+    m_x.swap(newX);
+    m_y.swap(newY);
+    m_storage.swap(newValues);
+  }
+
+  m_values = &m_storage[0];
+  setupAxes();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AdaptiveLookupTable2D::setupAxes()
+{
+  setupAxis(m_x, m_invDx, m_xBuckets, m_invBucketX);
+  setupAxis(m_y, m_invDy, m_yBuckets, m_invBucketY);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AdaptiveLookupTable2D::setupAxis(const vector<CFreal>& axis,
+                                      vector<CFreal>& invDelta,
+                                      vector<CFuint>& buckets,
+                                      CFreal& invBucketSize)
+{
+  cf_assert(axis.size() > 1);
+  const CFuint nbIntervals = axis.size() - 1;
+
+  invDelta.resize(nbIntervals);
+  CFreal minDelta = axis.back() - axis.front();
+  for (CFuint i = 0; i < nbIntervals; ++i) {
+    const CFreal delta = axis[i+1] - axis[i];
+    cf_assert(delta > 0.);
+    invDelta[i] = 1./delta;
+    minDelta = std::min(minDelta, delta);
+  }
+
+  // buckets smaller than the smallest interval contain at most one node,
+  // so the interval is found with at most one step from the bucket's one
+  const CFreal range = axis.back() - axis.front();
+  const CFuint nbBuckets = std::min
+    (static_cast<CFuint>(std::ceil(range/minDelta)) + 1, MAX_NB_BUCKETS);
+  invBucketSize = nbBuckets/range;
+
+  buckets.resize(nbBuckets);
+  CFuint i = 0;
+  for (CFuint b = 0; b < nbBuckets; ++b) {
+    const CFreal t = axis.front() + b/invBucketSize;
+    while (i < nbIntervals - 1 && t >= axis[i+1]) ++i;
+    buckets[b] = i;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+inline CFuint AdaptiveLookupTable2D::findInterval(const vector<CFreal>& axis,
+                                                  const vector<CFreal>& invDelta,
+                                                  const vector<CFuint>& buckets,
+                                                  const CFreal invBucketSize,
+                                                  CFreal t,
+                                                  CFreal& w)
+{
+  const CFuint last = axis.size() - 2;
+  t = std::min(std::max(t, axis.front()), axis.back());
+  const CFuint b = std::min(static_cast<CFuint>((t - axis.front())*invBucketSize),
+                            static_cast<CFuint>(buckets.size() - 1));
+  CFuint i = buckets[b];
+  while (i < last && t >= axis[i+1]) ++i;
+  w = (t - axis[i])*invDelta[i];
+  return i;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AdaptiveLookupTable2D::get(const CFreal x, const CFreal y, CFreal* values) const
+{
+  cf_assert(!isEmpty());
+
+  CFreal wx = 0.;
+  CFreal wy = 0.;
+  const CFuint ix = findInterval(m_x, m_invDx, m_xBuckets, m_invBucketX, x, wx);
+  const CFuint iy = findInterval(m_y, m_invDy, m_yBuckets, m_invBucketY, toY(y), wy);
+
+  const CFuint nbVars = m_nbVars;
+  const CFreal* v00 = m_values + (iy*m_x.size() + ix)*nbVars;
+  const CFreal* v10 = v00 + nbVars;
+  const CFreal* v01 = v00 + m_x.size()*nbVars;
+  const CFreal* v11 = v01 + nbVars;
+
+  const CFreal w00 = (1. - wx)*(1. - wy);
+  const CFreal w10 = wx*(1. - wy);
+  const CFreal w01 = (1. - wx)*wy;
+  const CFreal w11 = wx*wy;
+  for (CFuint iVar = 0; iVar < nbVars; ++iVar) {
+    values[iVar] = w00*v00[iVar] + w10*v10[iVar] + w01*v01[iVar] + w11*v11[iVar];
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal AdaptiveLookupTable2D::get(const CFreal x, const CFreal y, const CFuint iVar) const
+{
+  cf_assert(!isEmpty());
+  cf_assert(iVar < m_nbVars);
+
+  CFreal wx = 0.;
+  CFreal wy = 0.;
+  const CFuint ix = findInterval(m_x, m_invDx, m_xBuckets, m_invBucketX, x, wx);
+  const CFuint iy = findInterval(m_y, m_invDy, m_yBuckets, m_invBucketY, toY(y), wy);
+
+  const CFuint nbVars = m_nbVars;
+  const CFreal* v00 = m_values + (iy*m_x.size() + ix)*nbVars + iVar;
+  const CFreal* v01 = v00 + m_x.size()*nbVars;
+  return (1. - wy)*((1. - wx)*v00[0] + wx*v00[nbVars]) +
+    wy*((1. - wx)*v01[0] + wx*v01[nbVars]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AdaptiveLookupTable2D::setLabels(const std::vector<std::string>& varNames,
+                                      const std::string& source)
+{
+  cf_assert(!isEmpty());
+  if (varNames.size() != m_nbVars) {
+    throw BadValueException(FromHere(), "AdaptiveLookupTable2D::setLabels() => wrong number of variable names");
+  }
+  m_varNames = varNames;
+  m_source = source;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool AdaptiveLookupTable2D::matches(const std::vector<std::string>& varNames,
+                                    const std::string& source,
+                                    const CFreal xmin, const CFreal xmax, const CFuint nbX,
+                                    const CFreal ymin, const CFreal ymax, const CFuint nbY,
+                                    const bool logY,
+                                    const CFreal tolerance,
+                                    const CFuint maxLevels) const
+{
+  // the bounds and the tolerance are stored exactly, so they are compared exactly
+  return !isEmpty() && m_varNames == varNames && m_source == source &&
+    m_xmin == xmin && m_xmax == xmax && m_nbX0 == nbX &&
+    m_ymin == ymin && m_ymax == ymax && m_nbY0 == nbY &&
+    m_logY == logY && m_tolerance == tolerance && m_maxLevels == maxLevels;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AdaptiveLookupTable2D::save(const std::string& fileName) const
+{
+  cf_assert(!isEmpty());
+
+  string labels;
+  for (CFuint i = 0; i < m_varNames.size(); ++i) {
+    labels.append(m_varNames[i]).push_back('\0');
+  }
+  labels.append(m_source).push_back('\0');
+  labels.resize((labels.size() + 7)/8*8, '\0');
+
+  LookupTableFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, LOOKUP_TABLE_MAGIC, sizeof(header.magic));
+  header.version    = LOOKUP_TABLE_VERSION;
+  header.nbVars     = m_nbVars;
+  header.nbX        = m_x.size();
+  header.nbY        = m_y.size();
+  header.logY       = m_logY ? 1 : 0;
+  header.labelsSize = labels.size();
+  header.nbX0       = m_nbX0;
+  header.nbY0       = m_nbY0;
+  header.maxLevels  = m_maxLevels;
+  header.xmin       = m_xmin;
+  header.xmax       = m_xmax;
+  header.ymin       = m_ymin;
+  header.ymax       = m_ymax;
+  header.tolerance  = m_tolerance;
+
+  // readers only ever see the complete file, once it is renamed
+  const string tmpName = fileName + ".tmp";
+  {
+    ofstream fout(tmpName.c_str(), ios::binary);
+    if (!fout) {
+      throw FilesystemException(FromHere(), "AdaptiveLookupTable2D::save() => cannot open " + tmpName);
+    }
+
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fout.write(labels.data(), labels.size());
+    fout.write(reinterpret_cast<const char*>(&m_x[0]), m_x.size()*sizeof(CFreal));
+    fout.write(reinterpret_cast<const char*>(&m_y[0]), m_y.size()*sizeof(CFreal));
+    fout.write(reinterpret_cast<const char*>(m_values),
+               m_x.size()*m_y.size()*m_nbVars*sizeof(CFreal));
+    fout.close();
+    if (!fout) {
+      std::remove(tmpName.c_str());
+      throw FilesystemException(FromHere(), "AdaptiveLookupTable2D::save() => cannot write " + tmpName);
+    }
+  }
+
+  if (std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    std::remove(tmpName.c_str());
+    throw FilesystemException(FromHere(), "AdaptiveLookupTable2D::save() => cannot rename " +
+                              tmpName + " to " + fileName);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool AdaptiveLookupTable2D::load(const std::string& fileName)
+{
+  clear();
+
+  ifstream fin(fileName.c_str(), ios::binary);
+  if (!fin) return false;
+
+  LookupTableFileHeader header;
+  fin.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!fin ||
+      std::memcmp(header.magic, LOOKUP_TABLE_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != LOOKUP_TABLE_VERSION ||
+      header.nbVars == 0 || header.nbX < 2 || header.nbY < 2 ||
+      header.labelsSize == 0 || header.labelsSize % 8 != 0) {
+    return false;
+  }
+
+  // the labels must hold nbVars names and the source, all terminated
+  vector<char> labels(header.labelsSize);
+  fin.read(&labels[0], labels.size());
+  if (!fin || labels.back() != '\0') return false;
+  vector<string> names;
+  for (CFuint pos = 0; names.size() < header.nbVars + 1; ) {
+    if (pos >= labels.size()) return false;
+    names.push_back(string(&labels[pos]));
+    pos += names.back().size() + 1;
+  }
+
+  m_nbVars = header.nbVars;
+  m_logY = (header.logY != 0);
+  m_xmin = header.xmin;
+  m_xmax = header.xmax;
+  m_ymin = header.ymin;
+  m_ymax = header.ymax;
+  m_nbX0 = header.nbX0;
+  m_nbY0 = header.nbY0;
+  m_tolerance = header.tolerance;
+  m_maxLevels = header.maxLevels;
+  m_source = names.back();
+  names.pop_back();
+  m_varNames.swap(names);
+  m_x.resize(header.nbX);
+  m_y.resize(header.nbY);
+  fin.read(reinterpret_cast<char*>(&m_x[0]), m_x.size()*sizeof(CFreal));
+  fin.read(reinterpret_cast<char*>(&m_y[0]), m_y.size()*sizeof(CFreal));
+
+  const size_t offset = sizeof(header) + header.labelsSize +
+    (m_x.size() + m_y.size())*sizeof(CFreal);
+  const size_t nbValues = static_cast<size_t>(m_x.size())*m_y.size()*m_nbVars;
+  fin.seekg(0, ios::end);
+  if (!fin || static_cast<size_t>(fin.tellg()) != offset + nbValues*sizeof(CFreal)) {
+    clear();
+    return false;
+  }
+
+#ifdef CF_LOOKUP_TABLE_MMAP
+  // the pages of the mapped file are shared by all the processes reading it
+  const int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    const size_t size = offset + nbValues*sizeof(CFreal);
+    void* ptr = mmap(CFNULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr != MAP_FAILED) {
+      m_mapped = ptr;
+      m_mappedSize = size;
+      m_values = reinterpret_cast<const CFreal*>(static_cast<const char*>(ptr) + offset);
+    }
+  }
+#endif
+
+  if (m_values == CFNULL) {
+    m_storage.resize(nbValues);
+    fin.seekg(offset, ios::beg);
+    fin.read(reinterpret_cast<char*>(&m_storage[0]), nbValues*sizeof(CFreal));
+    if (!fin) {
+      clear();
+      return false;
+    }
+    m_values = &m_storage[0];
+  }
+
+  setupAxes();
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
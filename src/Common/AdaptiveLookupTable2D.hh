@@ -0,0 +1,238 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Common_AdaptiveLookupTable2D_hh
+#define COOLFluiD_Common_AdaptiveLookupTable2D_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+#include "Common/NonCopyable.hh"
+#include "Common/CommonAPI.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a table of several variables depending on two keys
+/// (x,y), sampled on a non uniform tensor product grid which is refined
+/// adaptively until the bilinear interpolation matches the sampled function
+/// within a given tolerance.
+/// All the variables of a node are stored contiguously, so that one call to
+/// get() interpolates all of them from the same four nodes. The interval
+/// containing a key is found in constant time through a uniform bucket array
+/// finer than the smallest interval, without searching.
+/// The table can be saved to a binary file and loaded back by mapping the
+/// file in memory, which lets all the processes of a node share one copy.
+/// The file records the names of the variables, the source of the data,
+/// the ranges, the initial grid, the tolerance and the number of refinement
+/// passes, so that a table built for other settings can be detected with
+/// matches().
+/// get() does not modify the table and can be called concurrently.
+/// @author Andrea Lani
+class Common_API AdaptiveLookupTable2D : public Common::NonCopyable<AdaptiveLookupTable2D> {
+public:
+
+  /// Interface to the function to tabulate
+  class Common_API Sampler {
+  public:
+
+    /// Destructor
+    virtual ~Sampler() {}
+
+    /// Computes all the variables in (x,y)
+    /// @param values  array of size getNbVars() to fill
+    virtual void compute(CFreal x, CFreal y, CFreal* values) = 0;
+  };
+
+  /// Constructor
+  AdaptiveLookupTable2D();
+
+  /// Destructor
+  ~AdaptiveLookupTable2D();
+
+  /// Builds the table by sampling the given function
+  /// @param sampler     function to tabulate
+  /// @param nbVars      number of variables computed by the sampler
+  /// @param xmin, xmax  range of the first key
+  /// @param nbX         number of nodes of the initial grid along x
+  /// @param ymin, ymax  range of the second key
+  /// @param nbY         number of nodes of the initial grid along y
+  /// @param logY        interpolate in log(y) instead of y
+  /// @param tolerance   maximum interpolation error, relative to the range of each variable
+  /// @param maxLevels   maximum number of refinement passes
+  void build(Sampler& sampler,
+             const CFuint nbVars,
+             const CFreal xmin, const CFreal xmax, const CFuint nbX,
+             const CFreal ymin, const CFreal ymax, const CFuint nbY,
+             const bool logY,
+             const CFreal tolerance,
+             const CFuint maxLevels);
+
+  /// Interpolates all the variables in (x,y).
+  /// Keys outside the table are clamped to its bounds.
+  /// @param values  array of size getNbVars() to fill
+  void get(const CFreal x, const CFreal y, CFreal* values) const;
+
+  /// Interpolates one variable in (x,y)
+  CFreal get(const CFreal x, const CFreal y, const CFuint iVar) const;
+
+  /// Names the variables and the source of the data (e.g. the mixture),
+  /// to be called after build(): both are saved with the table
+  /// @param varNames  names of the getNbVars() variables, in order
+  /// @param source    description of the tabulated function
+  void setLabels(const std::vector<std::string>& varNames, const std::string& source);
+
+  /// Tells if the table was built with the given settings and labels
+  /// @return false if any of them differs, or if the table is empty
+  /// @see build() for the meaning of the settings
+  bool matches(const std::vector<std::string>& varNames,
+               const std::string& source,
+               const CFreal xmin, const CFreal xmax, const CFuint nbX,
+               const CFreal ymin, const CFreal ymax, const CFuint nbY,
+               const bool logY,
+               const CFreal tolerance,
+               const CFuint maxLevels) const;
+
+  /// Writes the table to a binary file. The file is written under a
+  /// temporary name and renamed, so that it never appears incomplete.
+  void save(const std::string& fileName) const;
+
+  /// Reads a table written by save(), mapping the file in memory when
+  /// possible
+  /// @return false if the file cannot be opened or is not a valid table
+  bool load(const std::string& fileName);
+
+  /// Releases the memory of the table
+  void clear();
+
+  /// Tells if the table holds some data
+  bool isEmpty() const {return m_values == CFNULL;}
+
+  /// Gets the number of variables
+  CFuint getNbVars() const {return m_nbVars;}
+
+  /// Gets the number of nodes along x
+  CFuint getNbX() const {return m_x.size();}
+
+  /// Gets the number of nodes along y
+  CFuint getNbY() const {return m_y.size();}
+
+private: // helper functions
+
+  /// Finds the interval of the axis containing t, clamped to its bounds
+  /// @param t      key, updated with its clamped value
+  /// @param w      weight of the upper node of the interval
+  static CFuint findInterval(const std::vector<CFreal>& axis,
+                             const std::vector<CFreal>& invDelta,
+                             const std::vector<CFuint>& buckets,
+                             const CFreal invBucketSize,
+                             CFreal t,
+                             CFreal& w);
+
+  /// Sets up the inverse interval sizes and the buckets of one axis
+  static void setupAxis(const std::vector<CFreal>& axis,
+                        std::vector<CFreal>& invDelta,
+                        std::vector<CFuint>& buckets,
+                        CFreal& invBucketSize);
+
+  /// Sets up the search data of both axes
+  void setupAxes();
+
+  /// Transforms y in the interpolation coordinate
+  CFreal toY(const CFreal y) const;
+
+  /// Transforms the interpolation coordinate in y
+  CFreal fromY(const CFreal t) const;
+
+private: // data
+
+  /// number of variables
+  CFuint m_nbVars;
+
+  /// interpolate in log(y)
+  bool m_logY;
+
+  /// requested range of x
+  CFreal m_xmin;
+  CFreal m_xmax;
+
+  /// requested range of y
+  CFreal m_ymin;
+  CFreal m_ymax;
+
+  /// number of nodes of the initial grid along x
+  CFuint m_nbX0;
+
+  /// number of nodes of the initial grid along y
+  CFuint m_nbY0;
+
+  /// requested interpolation tolerance
+  CFreal m_tolerance;
+
+  /// maximum number of refinement passes
+  CFuint m_maxLevels;
+
+  /// names of the variables
+  std::vector<std::string> m_varNames;
+
+  /// description of the tabulated function
+  std::string m_source;
+
+  /// nodes along x
+  std::vector<CFreal> m_x;
+
+  /// nodes along y (or log(y))
+  std::vector<CFreal> m_y;
+
+  /// inverse of the sizes of the intervals along x
+  std::vector<CFreal> m_invDx;
+
+  /// inverse of the sizes of the intervals along y
+  std::vector<CFreal> m_invDy;
+
+  /// interval containing the left end of each bucket along x
+  std::vector<CFuint> m_xBuckets;
+
+  /// interval containing the left end of each bucket along y
+  std::vector<CFuint> m_yBuckets;
+
+  /// inverse of the bucket size along x
+  CFreal m_invBucketX;
+
+  /// inverse of the bucket size along y
+  CFreal m_invBucketY;
+
+  /// values owned by the table, [(iy*nbX + ix)*nbVars + iVar]
+  std::vector<CFreal> m_storage;
+
+  /// values, either m_storage or the mapped file
+  const CFreal* m_values;
+
+  /// start of the mapped file
+  void* m_mapped;
+
+  /// size of the mapped file
+  size_t m_mappedSize;
+
+}; // end of class AdaptiveLookupTable2D
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Common_AdaptiveLookupTable2D_hh
@@ -0,0 +1,35 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/CommPatternManager.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+CommPatternManager::CommPatternManager() :
+  ScalableGhostMap    ( false ),
+  PersistentGhostSync ( false ) {}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CommPatternManager& CommPatternManager::getInstance()
+{
+  static CommPatternManager commpattern_manager;
+  return commpattern_manager;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,53 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Common_CommPatternManager_hh
+#define COOLFluiD_Common_CommPatternManager_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Common/COOLFluiD.hh"
+#include "Common/NonCopyable.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Manager of the algorithms used by the parallel communication patterns
+/// (ghost map construction and ghost synchronization)
+/// @author Tiago Quintino
+class Common_API CommPatternManager : public Common::NonCopyable <CommPatternManager> {
+public:
+
+  /// Constructor
+  CommPatternManager();
+
+  /// Gets the instance of the manager
+  static CommPatternManager& getInstance ();
+
+  /// build the ghost maps through a distributed directory of global indices
+  /// instead of broadcasting every ghost list to every process
+  bool ScalableGhostMap;
+
+  /// synchronize the ghost points through persistent requests on packed
+  /// buffers, exchanging only with the actual neighbor processes
+  bool PersistentGhostSync;
+
+}; // class CommPatternManager
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Common_CommPatternManager_hh
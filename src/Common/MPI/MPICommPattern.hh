@@ -41,11 +41,13 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <cstring>
 
 #include "Common/COOLFluiD.hh"
 #include "Common/PE.hh"
 #include "Common/ArrayAllocator.hh"
 #include "Common/CFLog.hh"
+#include "Common/CommPatternManager.hh"
 #include "Common/MPI/MPIDataTypeHandler.hh"
 #include "Common/MPI/ParVectorException.hh"
 #include "Common/MPI/MPIException.hh"
@@ -259,6 +261,23 @@ private:
   std::vector<MPI_Request> _ReceiveRequests;
   std::vector<MPI_Request> _SendRequests;
 
+  /// Persistent synchronisation (only with CommPatternManager::PersistentGhostSync):
+  /// ranks we actually exchange ghost points with
+  std::vector<int> _SendRanks;
+  std::vector<int> _ReceiveRanks;
+
+  /// Start (in elements) of each neighbor's chunk in the packed buffers
+  /// (one more entry than neighbors)
+  std::vector<IndexType> _SendOffset;
+  std::vector<IndexType> _ReceiveOffset;
+
+  /// Packed contiguous send/receive buffers
+  std::vector<char> _SendBuffer;
+  std::vector<char> _ReceiveBuffer;
+
+  /// Persistent requests: first the receives, then the sends
+  std::vector<MPI_Request> _PersistentRequests;
+
   /// Data of the CGLobal map
   std::vector<IndexType> _CGlobal;
 
@@ -285,9 +304,33 @@ private:
   void Sync_BuildReceiveList ();
   void Sync_BuildReceiveTypes ();
 
+  /// Scalable ghost map builder: the owners of the ghost points are found
+  /// through a distributed directory (partitioned by global index ranges)
+  /// and the requests are sent only to the owners.
+  /// This fills both the send and the receive lists.
+  void Sync_DirectoryLookup ();
+
+  /// Sparse all-to-all exchange of index lists
+  /// @param Send     list of indices to send to each rank
+  /// @param Receive  list of indices received from each rank
+  void Sync_SparseExchange (const std::vector<std::vector<IndexType> > & Send,
+                            std::vector<std::vector<IndexType> > & Receive) const;
+
   void Sync_BuildTypeHelper (const std::vector<std::vector<IndexType> > & V,
                                    std::vector<MPI_Datatype> & MPIType ) const;
 
+  /// Build the compacted neighbor lists, the packed buffers and the
+  /// persistent requests out of the send and receive lists
+  void Sync_BuildPersistent ();
+
+  /// Free the persistent requests (if any)
+  void Sync_FreePersistent ();
+
+  /// Build the compacted neighbor list and chunk offsets of a ghost list
+  void Sync_PersistentHelper (const std::vector<std::vector<IndexType> > & V,
+                              std::vector<int> & Ranks,
+                              std::vector<IndexType> & Offset) const;
+
   /// Find functions (for internal use)
   /// These take advantage of a index map if one is present
   IndexType FindLocal (IndexType GlobalIndex) const;
@@ -962,6 +1005,177 @@ void MPICommPattern<DATA>::BuildCGlobal ()
       delete[] (Storage);
     }
 
+    template <typename DATA>
+    void MPICommPattern<DATA>::Sync_SparseExchange
+    (const std::vector<std::vector<IndexType> > & Send,
+     std::vector<std::vector<IndexType> > & Receive) const
+    {
+      cf_assert (Send.size() == static_cast<CFuint>(_CommSize));
+
+      // Only the message sizes are exchanged with every rank,
+      // the data itself goes to the actual partners
+      std::vector<int> SendCount (_CommSize, 0);
+      std::vector<int> ReceiveCount (_CommSize, 0);
+      for (int i=0; i<_CommSize; i++)
+	SendCount[i] = Send[i].size();
+
+      Common::CheckMPIStatus(MPI_Alltoall (&SendCount[0], 1, MPI_INT,
+					   &ReceiveCount[0], 1, MPI_INT, _Communicator));
+
+      Receive.clear();
+      Receive.resize (_CommSize);
+
+      std::vector<MPI_Request> Requests;
+      Requests.reserve (2*_CommSize);
+      for (int i=0; i<_CommSize; i++)
+      {
+	  if (!ReceiveCount[i])
+	    continue;
+
+	  Receive[i].resize (ReceiveCount[i]);
+	  if (i==_CommRank)
+	  {
+	      std::copy (Send[i].begin(), Send[i].end(), Receive[i].begin());
+	      continue;
+	  }
+
+	  Requests.push_back (MPI_REQUEST_NULL);
+	  Common::CheckMPIStatus(MPI_Irecv (&Receive[i][0], ReceiveCount[i],
+					    MPIDataTypeHandler::GetType<IndexType>(),
+					    i, _MPI_TAG_BUILDGHOSTMAP, _Communicator,
+					    &Requests.back()));
+      }
+
+      for (int i=0; i<_CommSize; i++)
+      {
+	  if (!SendCount[i] || i==_CommRank)
+	    continue;
+
+	  Requests.push_back (MPI_REQUEST_NULL);
+	  Common::CheckMPIStatus(MPI_Isend (const_cast<IndexType*>(&Send[i][0]), SendCount[i],
+					    MPIDataTypeHandler::GetType<IndexType>(),
+					    i, _MPI_TAG_BUILDGHOSTMAP, _Communicator,
+					    &Requests.back()));
+      }
+
+      if (!Requests.empty())
+	Common::CheckMPIStatus(MPI_Waitall (Requests.size(), &Requests[0], MPI_STATUSES_IGNORE));
+    }
+
+    template <typename DATA>
+    void MPICommPattern<DATA>::Sync_DirectoryLookup ()
+    {
+      const IndexType NoOwner = _CommSize;
+
+      // The directory is partitioned in blocks of contiguous global indices:
+      // directory rank d holds the owners of [d*BlockSize, (d+1)*BlockSize)
+      IndexType LocalMax = 0;
+      if (!_IndexMap.empty())
+	LocalMax = std::max(LocalMax, _IndexMap.rbegin()->first + 1);
+      if (!_GhostMap.empty())
+	LocalMax = std::max(LocalMax, _GhostMap.rbegin()->first + 1);
+
+      IndexType GlobalMax = 0;
+      Common::CheckMPIStatus (MPI_Allreduce (&LocalMax, &GlobalMax, 1,
+					     MPIStructDef::getMPIType(&LocalMax),
+					     MPI_MAX, _Communicator));
+
+      const IndexType BlockSize = GlobalMax/_CommSize + 1;
+      const IndexType FirstInBlock = _CommRank*BlockSize;
+
+      // Register the locally owned points in the directory
+      std::vector<std::vector<IndexType> > Send (_CommSize);
+      std::vector<std::vector<IndexType> > Receive;
+      for (typename TIndexMap::const_iterator Iter=_IndexMap.begin();
+	   Iter!=_IndexMap.end(); ++Iter)
+	Send[Iter->first/BlockSize].push_back(Iter->first);
+
+      Sync_SparseExchange (Send, Receive);
+
+      std::vector<IndexType> Directory (BlockSize, NoOwner);
+      for (int i=0; i<_CommSize; i++)
+      {
+	  for (CFuint j=0; j<Receive[i].size(); j++)
+	  {
+	      cf_assert (Receive[i][j] >= FirstInBlock);
+	      cf_assert (Receive[i][j] - FirstInBlock < BlockSize);
+	      Directory[Receive[i][j] - FirstInBlock] = i;
+	  }
+      }
+
+      // Ask the directory who owns our ghost points.
+      // Since the ghost map is sorted and the directory blocks are
+      // ordered, the queries concatenated over the ranks are sorted too
+      for (int i=0; i<_CommSize; i++)
+	Send[i].clear();
+      for (typename TGhostMap::const_iterator Iter=_GhostMap.begin();
+	   Iter!=_GhostMap.end(); ++Iter)
+	Send[Iter->first/BlockSize].push_back(Iter->first);
+
+      std::vector<std::vector<IndexType> > Queries;
+      Sync_SparseExchange (Send, Queries);
+
+      for (int i=0; i<_CommSize; i++)
+      {
+	  for (CFuint j=0; j<Queries[i].size(); j++)
+	  {
+	      cf_assert (Queries[i][j] - FirstInBlock < BlockSize);
+	      Queries[i][j] = Directory[Queries[i][j] - FirstInBlock];
+	  }
+      }
+
+      std::vector<std::vector<IndexType> > Owners;
+      Sync_SparseExchange (Queries, Owners);
+
+      // Now send the requests to the owners only: the order of the
+      // requests defines both our receive list and their send list
+      std::vector<std::vector<IndexType> > Requests (_CommSize);
+      std::ostringstream Missing;
+      for (int i=0; i<_CommSize; i++)
+      {
+	  cf_assert (Owners[i].size() == Send[i].size());
+	  for (CFuint j=0; j<Send[i].size(); j++)
+	  {
+	      const IndexType Owner = Owners[i][j];
+	      if (Owner == NoOwner)
+	      {
+		  Missing << Send[i][j] << " ";
+		  continue;
+	      }
+
+	      Requests[Owner].push_back (Send[i][j]);
+	      _GhostReceiveList[Owner].push_back (_GhostMap.find(Send[i][j])->second);
+	  }
+      }
+
+      // All the ranks must leave before the next collective exchange,
+      // otherwise the ones with no missing ghosts would wait there forever
+      int LocalMissing = Missing.str().empty() ? 0 : 1;
+      int GlobalMissing = 0;
+      Common::CheckMPIStatus (MPI_Allreduce (&LocalMissing, &GlobalMissing, 1,
+					     MPI_INT, MPI_MAX, _Communicator));
+      if (GlobalMissing)
+      {
+	  const std::string Msg = (LocalMissing) ?
+	    "Missing ghost elements (globalID): " + Missing.str() + "\n" :
+	    std::string("Missing ghost elements on another rank\n");
+	  throw NotFoundException (FromHere(), Msg.c_str());
+      }
+
+      std::vector<std::vector<IndexType> > Needed;
+      Sync_SparseExchange (Requests, Needed);
+
+      for (int i=0; i<_CommSize; i++)
+      {
+	  for (CFuint j=0; j<Needed[i].size(); j++)
+	  {
+	      typename TIndexMap::const_iterator Iter = _IndexMap.find(Needed[i][j]);
+	      cf_assert (Iter != _IndexMap.end());
+	      _GhostSendList[i].push_back (Iter->second);
+	  }
+      }
+    }
+
     template <typename DATA>
     void MPICommPattern<DATA>::Sync_BuildReceiveList ()
     {
@@ -1066,14 +1280,25 @@ void MPICommPattern<DATA>::BuildCGlobal ()
 	  _GhostReceiveList[j].clear();
       }
 
-      // Broadcast needed points
-      Sync_BroadcastNeeded ();
+      if (CommPatternManager::getInstance().ScalableGhostMap)
+      {
+	  // Ask the owners through the distributed directory
+	  Sync_DirectoryLookup ();
+
+	  // Build send datatype
+	  Sync_BuildSendTypes();
+      }
+      else
+      {
+	  // Broadcast needed points
+	  Sync_BroadcastNeeded ();
 
-      // Build send datatype
-      Sync_BuildSendTypes();
+	  // Build send datatype
+	  Sync_BuildSendTypes();
 
-      // Now building receive lists
-      Sync_BuildReceiveList ();
+	  // Now building receive lists
+	  Sync_BuildReceiveList ();
+      }
 
       // Check if all ghost elements were found...
       IndexType GhostFound = 0;
@@ -1117,6 +1342,13 @@ void MPICommPattern<DATA>::BuildCGlobal ()
       // Build receive datatype
       Sync_BuildReceiveTypes ();
 
+      // Replace the per-sync Isend/Irecv by persistent requests
+      Sync_FreePersistent ();
+      if (CommPatternManager::getInstance().PersistentGhostSync)
+      {
+	  Sync_BuildPersistent ();
+      }
+
 #ifdef CF_ENABLE_PARALLEL_DEBUG
       WriteCommPattern ();
 #endif
@@ -1181,6 +1413,82 @@ void MPICommPattern<DATA>::BuildCGlobal ()
       Sync_BuildTypeHelper (_GhostSendList, _SendTypes);
     }
 
+//////////////////////////////////////////////////////////////////////////////
+
+    template <typename DATA>
+    void MPICommPattern<DATA>::Sync_PersistentHelper
+    (const std::vector<std::vector<IndexType> > & V,
+     std::vector<int> & Ranks,
+     std::vector<IndexType> & Offset) const
+    {
+      Ranks.clear();
+      Offset.assign(1, 0);
+      for (int i=0; i<_CommSize; i++)
+      {
+	  if (i==_CommRank || V[i].empty())
+	      continue;
+
+	  Ranks.push_back(i);
+	  Offset.push_back(Offset.back() + V[i].size());
+      }
+    }
+
+//////////////////////////////////////////////////////////////////////////////
+
+    template <typename DATA>
+    void MPICommPattern<DATA>::Sync_BuildPersistent ()
+    {
+      Sync_PersistentHelper (_GhostSendList, _SendRanks, _SendOffset);
+      Sync_PersistentHelper (_GhostReceiveList, _ReceiveRanks, _ReceiveOffset);
+
+      // the buffers never move after this point, unlike the vector data
+      // (which can be reallocated by grow()), so the requests can be reused
+      _SendBuffer.resize(std::max<size_t>(_SendOffset.back()*_ElementSize, 1));
+      _ReceiveBuffer.resize(std::max<size_t>(_ReceiveOffset.back()*_ElementSize, 1));
+
+      const CFuint NbReceives = _ReceiveRanks.size();
+      const CFuint NbSends = _SendRanks.size();
+      _PersistentRequests.resize(NbReceives + NbSends);
+
+      for (CFuint i=0; i<NbReceives; i++)
+      {
+	  const IndexType Start = _ReceiveOffset[i];
+	  const int Count = (_ReceiveOffset[i+1] - Start)*_ElementSize;
+	  Common::CheckMPIStatus(MPI_Recv_init (&_ReceiveBuffer[Start*_ElementSize], Count,
+						MPI_BYTE, _ReceiveRanks[i], _MPI_TAG_SYNC,
+						_Communicator, &_PersistentRequests[i]));
+      }
+
+      for (CFuint i=0; i<NbSends; i++)
+      {
+	  const IndexType Start = _SendOffset[i];
+	  const int Count = (_SendOffset[i+1] - Start)*_ElementSize;
+	  Common::CheckMPIStatus(MPI_Send_init (&_SendBuffer[Start*_ElementSize], Count,
+						MPI_BYTE, _SendRanks[i], _MPI_TAG_SYNC,
+						_Communicator, &_PersistentRequests[NbReceives+i]));
+      }
+
+      CFLog(VERBOSE, "MPICommPattern<DATA>::Sync_BuildPersistent() => "
+	    << NbSends << " send and " << NbReceives << " receive neighbors\n");
+    }
+
+//////////////////////////////////////////////////////////////////////////////
+
+    template <typename DATA>
+    void MPICommPattern<DATA>::Sync_FreePersistent ()
+    {
+      for (CFuint i=0; i<_PersistentRequests.size(); i++)
+      {
+	  if (_PersistentRequests[i]!=MPI_REQUEST_NULL)
+	      MPI_Request_free (&_PersistentRequests[i]);
+      }
+      _PersistentRequests.clear();
+      _SendRanks.clear();
+      _ReceiveRanks.clear();
+      _SendOffset.clear();
+      _ReceiveOffset.clear();
+    }
+
 //////////////////////////////////////////////////////////////////////////////
 
     /*==============================================================
@@ -1396,6 +1704,23 @@ typename MPICommPattern<DATA>::IndexType MPICommPattern<DATA>::AllocNext ()
     {
       cf_assert (_InitMPIOK);
 
+      if (!_PersistentRequests.empty())
+      {
+	  // Pack the points to send, then (re)start all the requests at once
+	  const char* Data = reinterpret_cast<const char*>(m_data->ptr());
+	  for (CFuint i=0; i<_SendRanks.size(); i++)
+	  {
+	      const std::vector<IndexType>& List = _GhostSendList[_SendRanks[i]];
+	      char* Buf = &_SendBuffer[_SendOffset[i]*_ElementSize];
+	      for (CFuint j=0; j<List.size(); j++, Buf += _ElementSize)
+		  std::memcpy (Buf, Data + List[j]*_ElementSize, _ElementSize);
+	  }
+
+	  Common::CheckMPIStatus(MPI_Startall (_PersistentRequests.size(),
+					       &_PersistentRequests[0]));
+	  return;
+      }
+
       //
       // TODO: dit kan beter
       //   Onnodig om over de hele lijst te lopen
@@ -1435,6 +1760,23 @@ typename MPICommPattern<DATA>::IndexType MPICommPattern<DATA>::AllocNext ()
     {
       cf_assert (_InitMPIOK);
 
+      if (!_PersistentRequests.empty())
+      {
+	  Common::CheckMPIStatus(MPI_Waitall (_PersistentRequests.size(),
+					      &_PersistentRequests[0], MPI_STATUSES_IGNORE));
+
+	  // Unpack the received ghost points
+	  char* Data = reinterpret_cast<char*>(m_data->ptr());
+	  for (CFuint i=0; i<_ReceiveRanks.size(); i++)
+	  {
+	      const std::vector<IndexType>& List = _GhostReceiveList[_ReceiveRanks[i]];
+	      const char* Buf = &_ReceiveBuffer[_ReceiveOffset[i]*_ElementSize];
+	      for (CFuint j=0; j<List.size(); j++, Buf += _ElementSize)
+		  std::memcpy (Data + List[j]*_ElementSize, Buf, _ElementSize);
+	  }
+	  return;
+      }
+
       // In feite is volgende niet nodig aangezien receives niet kunnen
       // klaar zijn alvorens de sends klaar zijn
 
@@ -1577,6 +1919,8 @@ typename MPICommPattern<DATA>::IndexType MPICommPattern<DATA>::AllocNext ()
       //    MPI_Waitall (_CommSize, _ReceiveRequests, MPI_STATUSES_IGNORE);
       //    MPI_Waitall (_CommSize, _ReceiveRequests, MPI_STATUSES_IGNORE);
 
+      Sync_FreePersistent ();
+
       for (int i = 0; i <_CommSize; i++) {
        	if (_SendTypes[i]!=MPI_DATATYPE_NULL) {
 	  MPI_Type_free (&_SendTypes[i]);
@@ -0,0 +1,335 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include "Common/PE.hh"
+#include "Common/CFLog.hh"
+#include "Common/Profiler.hh"
+#include "Common/TimePolicies.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+Profiler::Profiler() :
+  Active   ( false ),
+  DumpRate ( 0 ),
+  FileName ( "profile" ),
+  m_regions(1),
+  m_current(0),
+  m_counters(CFNULL),
+  m_values()
+{
+  m_regions[0].parent = 0;
+  m_regions[0].nbCalls = 0;
+  m_regions[0].time = 0.;
+  m_regions[0].start = 0.;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Profiler::~Profiler()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Profiler& Profiler::getInstance()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal Profiler::getTime()
+{
+#ifdef CF_HAVE_MPI
+  return MPI_Wtime();
+#elif defined CF_HAVE_GETTIMEOFDAY
+  timeval t;
+  gettimeofday(&t, CFNULL);
+  return t.tv_sec + 1e-6*t.tv_usec;
+#else
+  return static_cast<CFreal>(std::clock())/CLOCKS_PER_SEC;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void Profiler::beginRegion(const char* name)
+{
+  // look for the region among the ones enclosed by the current one
+  const vector<CFuint>& children = m_regions[m_current].children;
+  CFuint r = 0;
+  for (CFuint i = 0; i < children.size(); ++i) {
+    if (m_regions[children[i]].name == name) {
+      r = children[i];
+      break;
+    }
+  }
+
+  if (r == 0) {
+    r = m_regions.size();
+    m_regions.push_back(Region());
+    Region& region = m_regions.back();
+    region.name = name;
+    region.parent = m_current;
+    region.nbCalls = 0;
+    region.time = 0.;
+    region.start = 0.;
+    const CFuint nbCounters = (m_counters != CFNULL) ? m_counters->getNbCounters() : 0;
+    region.counters.assign(nbCounters, 0.);
+    region.startCounters.assign(nbCounters, 0.);
+    m_regions[m_current].children.push_back(r);
+  }
+
+  Region& region = m_regions[r];
+  region.nbCalls++;
+  if (m_counters != CFNULL) {
+    m_counters->read(&region.startCounters[0]);
+  }
+  m_current = r;
+
+  // the time is taken last, not to count the profiler itself
+  region.start = getTime();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void Profiler::endRegion()
+{
+  const CFreal stop = getTime();
+
+  cf_assert(m_current != 0);
+  Region& region = m_regions[m_current];
+  region.time += stop - region.start;
+  if (m_counters != CFNULL) {
+    m_counters->read(&m_values[0]);
+    for (CFuint i = 0; i < m_values.size(); ++i) {
+      region.counters[i] += m_values[i] - region.startCounters[i];
+    }
+  }
+  m_current = region.parent;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void Profiler::setCounters(ProfilerCounters* counters)
+{
+  m_counters = counters;
+  const CFuint nbCounters = (m_counters != CFNULL) ? m_counters->getNbCounters() : 0;
+  m_values.assign(nbCounters, 0.);
+  for (CFuint r = 0; r < m_regions.size(); ++r) {
+    m_regions[r].counters.assign(nbCounters, 0.);
+    m_regions[r].startCounters.assign(nbCounters, 0.);
+  }
+  reset();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void Profiler::reset()
+{
+  for (CFuint r = 0; r < m_regions.size(); ++r) {
+    Region& region = m_regions[r];
+    region.nbCalls = 0;
+    region.time = 0.;
+    region.counters.assign(region.counters.size(), 0.);
+  }
+
+  // the open regions start again from now
+  const CFreal now = getTime();
+  for (CFuint r = m_current; r != 0; r = m_regions[r].parent) {
+    m_regions[r].nbCalls = 1;
+    m_regions[r].start = now;
+    if (m_counters != CFNULL) {
+      m_counters->read(&m_regions[r].startCounters[0]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::string Profiler::getPath(const CFuint r) const
+{
+  if (r == 0) return "";
+  const std::string parentPath = getPath(m_regions[r].parent);
+  return (parentPath.empty()) ? m_regions[r].name : parentPath + "/" + m_regions[r].name;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Statistics of the values (calls, time, counters) of a region among the processes
+struct RegionStats {
+  /// number of processes having the region
+  CFuint nbRanks;
+  /// minimum values
+  vector<CFreal> min;
+  /// maximum values
+  vector<CFreal> max;
+  /// sum of the values
+  vector<CFreal> sum;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+void Profiler::dump(const std::string& fileName)
+{
+  const CFuint nbCounters = m_values.size();
+
+  // the open regions are accounted up to now
+  const CFreal now = getTime();
+  vector<CFreal> openTime(m_regions.size(), 0.);
+  vector<CFreal> openCounters(m_regions.size()*nbCounters, 0.);
+  if (m_counters != CFNULL) {
+    m_counters->read(&m_values[0]);
+  }
+  for (CFuint r = m_current; r != 0; r = m_regions[r].parent) {
+    openTime[r] = now - m_regions[r].start;
+    for (CFuint i = 0; i < nbCounters; ++i) {
+      openCounters[r*nbCounters + i] = m_values[i] - m_regions[r].startCounters[i];
+    }
+  }
+
+  // one line per region: path, number of calls, time and counters
+  ostringstream local;
+  local.precision(12);
+  for (CFuint r = 1; r < m_regions.size(); ++r) {
+    const Region& region = m_regions[r];
+    local << getPath(r) << "\t" << region.nbCalls << "\t" << region.time + openTime[r];
+    for (CFuint i = 0; i < nbCounters; ++i) {
+      local << "\t" << region.counters[i] + openCounters[r*nbCounters + i];
+    }
+    local << "\n";
+  }
+  string lines = local.str();
+
+  CFuint nbProcs = 1;
+#ifdef CF_HAVE_MPI
+  if (PE::GetPE().IsParallel()) {
+    MPI_Comm comm = PE::GetPE().GetCommunicator();
+    const int rank = PE::GetPE().GetRank();
+    nbProcs = PE::GetPE().GetProcessorCount();
+
+    int localSize = lines.size();
+    vector<int> sizes(nbProcs, 0);
+    MPI_Gather(&localSize, 1, MPI_INT, &sizes[0], 1, MPI_INT, 0, comm);
+
+    vector<int> displs(nbProcs, 0);
+    for (CFuint p = 1; p < nbProcs; ++p) {
+      displs[p] = displs[p-1] + sizes[p-1];
+    }
+    vector<char> all((rank == 0) ? displs[nbProcs-1] + sizes[nbProcs-1] + 1 : 1, '\0');
+    MPI_Gatherv(const_cast<char*>(lines.c_str()), localSize, MPI_CHAR,
+		&all[0], &sizes[0], &displs[0], MPI_CHAR, 0, comm);
+
+    if (rank != 0) return;
+    lines.assign(all.begin(), all.end()-1);
+  }
+#endif
+
+  // statistics among the processes, the regions keeping the order of
+  // their first appearance
+  vector<string> paths;
+  vector<RegionStats> stats;
+  map<string, CFuint> pathIdx;
+
+  // values of each line: calls, time, counters
+  const CFuint nbValues = 2 + nbCounters;
+  vector<CFreal> values(nbValues);
+  istringstream in(lines);
+  string line;
+  while (getline(in, line)) {
+    istringstream fields(line);
+    string path;
+    getline(fields, path, '\t');
+    for (CFuint v = 0; v < nbValues; ++v) {
+      fields >> values[v];
+    }
+
+    map<string, CFuint>::iterator it = pathIdx.find(path);
+    if (it == pathIdx.end()) {
+      it = pathIdx.insert(make_pair(path, CFuint(paths.size()))).first;
+      paths.push_back(path);
+      stats.push_back(RegionStats());
+      RegionStats& s = stats.back();
+      s.nbRanks = 0;
+      s.min = values;
+      s.max = values;
+      s.sum.assign(nbValues, 0.);
+    }
+
+    RegionStats& s = stats[it->second];
+    s.nbRanks++;
+    for (CFuint v = 0; v < nbValues; ++v) {
+      s.min[v] = std::min(s.min[v], values[v]);
+      s.max[v] = std::max(s.max[v], values[v]);
+      s.sum[v] += values[v];
+    }
+  }
+
+  vector<string> names(nbValues);
+  names[0] = "calls";
+  names[1] = "time";
+  for (CFuint i = 0; i < nbCounters; ++i) {
+    names[2+i] = m_counters->getCounterName(i);
+  }
+
+  ofstream json((fileName + ".json").c_str());
+  json.precision(8);
+  json << "{\n  \"processes\": " << nbProcs << ",\n  \"regions\": [";
+  for (CFuint r = 0; r < paths.size(); ++r) {
+    const RegionStats& s = stats[r];
+    json << ((r == 0) ? "\n" : ",\n");
+    json << "    { \"path\": \"" << paths[r] << "\", \"ranks\": " << s.nbRanks;
+    for (CFuint v = 0; v < nbValues; ++v) {
+      json << ", \"" << names[v] << "\": { \"min\": " << s.min[v]
+	   << ", \"avg\": " << s.sum[v]/s.nbRanks
+	   << ", \"max\": " << s.max[v] << " }";
+    }
+    json << " }";
+  }
+  json << "\n  ]\n}\n";
+
+  ofstream csv((fileName + ".csv").c_str());
+  csv.precision(8);
+  csv << "path,ranks";
+  for (CFuint v = 0; v < nbValues; ++v) {
+    csv << "," << names[v] << "_min," << names[v] << "_avg," << names[v] << "_max";
+  }
+  csv << "\n";
+  for (CFuint r = 0; r < paths.size(); ++r) {
+    const RegionStats& s = stats[r];
+    csv << paths[r] << "," << s.nbRanks;
+    for (CFuint v = 0; v < nbValues; ++v) {
+      csv << "," << s.min[v] << "," << s.sum[v]/s.nbRanks << "," << s.max[v];
+    }
+    csv << "\n";
+  }
+
+  CFLog(INFO, "Profiler::dump() => profile written in " << fileName << ".json/.csv\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
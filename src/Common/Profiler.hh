@@ -0,0 +1,173 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Common_Profiler_hh
+#define COOLFluiD_Common_Profiler_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+#include "Common/NonCopyable.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Source of counters (e.g. hardware counters) recorded by the Profiler
+/// for each region, in addition to the wall time
+/// @author Tiago Quintino
+class Common_API ProfilerCounters {
+public:
+
+  /// Destructor
+  virtual ~ProfilerCounters() {}
+
+  /// Get the number of counters
+  virtual CFuint getNbCounters() const = 0;
+
+  /// Get the name of the given counter
+  virtual std::string getCounterName(const CFuint i) const = 0;
+
+  /// Read the current value of all the counters
+  virtual void read(CFreal* values) = 0;
+
+}; // class ProfilerCounters
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Hierarchical profiler of the code regions, each region being identified
+/// by its name and by the regions enclosing it. For every region the number
+/// of calls, the wall time and the optional counters are accumulated. The
+/// regions must be opened and closed by the master thread only.
+/// @author Tiago Quintino
+class Common_API Profiler : public Common::NonCopyable <Profiler> {
+public:
+
+  /// Constructor
+  Profiler();
+
+  /// Destructor
+  ~Profiler();
+
+  /// Gets the instance of the profiler
+  static Profiler& getInstance ();
+
+  /// Open a region inside the current one
+  void beginRegion(const char* name);
+
+  /// Close the current region
+  void endRegion();
+
+  /// Set the source of the counters, which is not owned by the profiler,
+  /// and reset the collected data
+  void setCounters(ProfilerCounters* counters);
+
+  /// Reset the collected data
+  void reset();
+
+  /// Aggregate the data of all the processes, with minimum, average and
+  /// maximum among the processes, and write them in fileName.json and
+  /// fileName.csv. This is collective on all processes.
+  void dump(const std::string& fileName);
+
+  /// regions are timed
+  bool Active;
+
+  /// number of iterations between dumps of the profile (0 for end of run only)
+  CFuint DumpRate;
+
+  /// name of the profile files, without extension
+  std::string FileName;
+
+private: // helper functions
+
+  /// Get the current time
+  static CFreal getTime();
+
+  /// Get the path of the given region, from the outermost enclosing one
+  std::string getPath(const CFuint r) const;
+
+private: // data
+
+  /// data of a region
+  struct Region {
+    /// name
+    std::string name;
+    /// index of the enclosing region
+    CFuint parent;
+    /// indices of the enclosed regions
+    std::vector<CFuint> children;
+    /// number of calls
+    CFuint nbCalls;
+    /// accumulated time
+    CFreal time;
+    /// time at the opening of the region
+    CFreal start;
+    /// accumulated counters
+    std::vector<CFreal> counters;
+    /// counters at the opening of the region
+    std::vector<CFreal> startCounters;
+  };
+
+  /// regions, the first one enclosing all the others
+  std::vector<Region> m_regions;
+
+  /// index of the current region
+  CFuint m_current;
+
+  /// source of the counters
+  ProfilerCounters* m_counters;
+
+  /// current values of the counters
+  std::vector<CFreal> m_values;
+
+}; // class Profiler
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Profiles the scope in which it is declared as a region of the Profiler,
+/// costing a single test when profiling is not active
+/// @author Tiago Quintino
+class ProfileRegion : public Common::NonCopyable <ProfileRegion> {
+public:
+
+  /// Constructor
+  /// @param name  name of the region, e.g. "SpaceMethod::computeSpaceResidual"
+  explicit ProfileRegion(const char* name) :
+    m_active(Profiler::getInstance().Active)
+  {
+    if (m_active) Profiler::getInstance().beginRegion(name);
+  }
+
+  /// Destructor
+  ~ProfileRegion()
+  {
+    if (m_active) Profiler::getInstance().endRegion();
+  }
+
+private:
+
+  /// flag telling if the region is timed
+  bool m_active;
+
+}; // class ProfileRegion
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Common_Profiler_hh
@@ -23,6 +23,8 @@
 #include "Common/CFLog.hh"
 #include "Common/SignalHandler.hh"
 #include "Common/OSystem.hh"
+#include "Common/CommPatternManager.hh"
+#include "Common/Profiler.hh"
 
 #include "Environment/SingleBehaviorFactory.hh"
 #include "Environment/DirPaths.hh"
@@ -68,6 +70,11 @@ void CFEnv::defineConfigOptions(Config::OptionList& options)
    options.addConfigOption< bool >    ("VerboseEvents",     "If Events have verbose output");
    options.addConfigOption< bool >    ("ErrorOnUnusedConfig","Signal error when some user provided config parameters are not used");
    options.addConfigOption< std::string >("MainLoggerFileName", "Name of main log file");
+   options.addConfigOption< bool >    ("ScalableGhostMap",  "Build the parallel ghost maps through a distributed directory instead of global broadcasts");
+   options.addConfigOption< bool >    ("PersistentGhostSync", "Synchronize the ghost points with persistent requests on packed buffers");
+   options.addConfigOption< bool >    ("Profiling",         "Time the methods, the synchronizations and the I/O in a hierarchical profile");
+   options.addConfigOption< CFuint >  ("ProfilingRate",     "Number of iterations between dumps of the profile (0 for end of run only)");
+   options.addConfigOption< std::string >("ProfilingFile",  "Name of the profile files (.json and .csv) in the results directory");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -89,6 +96,13 @@ CFEnv::CFEnv() : Config::ConfigObject("CFEnv"),
   setParameter("ExceptionDumps",        &(ExceptionManager::getInstance().ExceptionDumps));
   setParameter("ExceptionAborts",       &(ExceptionManager::getInstance().ExceptionAborts));
 
+  setParameter("ScalableGhostMap",      &(CommPatternManager::getInstance().ScalableGhostMap));
+  setParameter("PersistentGhostSync",   &(CommPatternManager::getInstance().PersistentGhostSync));
+
+  setParameter("Profiling",             &(Profiler::getInstance().Active));
+  setParameter("ProfilingRate",         &(Profiler::getInstance().DumpRate));
+  setParameter("ProfilingFile",         &(Profiler::getInstance().FileName));
+
   setParameter("OnlyCPU0Writes",        &(m_env_vars->OnlyCPU0Writes));
   setParameter("RegistSignalHandlers",  &(m_env_vars->RegistSignalHandlers));
   setParameter("VerboseEvents",         &(m_env_vars->VerboseEvents));
@@ -11,6 +11,7 @@
 
 #include "Common/ProcessInfo.hh"
 #include "Common/OSystem.hh"
+#include "Common/Profiler.hh"
 #include "Environment/FileHandlerOutput.hh"
 
 #include "Environment/CFEnv.hh"
@@ -20,6 +21,7 @@
 #include "Framework/PathAppender.hh"
 #include "Framework/ConvergenceMethod.hh"
 #include "Framework/ConvergenceMethodData.hh"
+#include "Framework/SpaceMethodData.hh"
 #include "Framework/SubSystemStatus.hh"
 
 //////////////////////////////////////////////////////////////////////////////
@@ -73,6 +75,7 @@ ConvergenceMethod::ConvergenceMethod(const std::string& name)
     m_lss(),
     m_statedata(CFNULL),
     m_nodedata(CFNULL),
+    m_deferredStateSync(false),
     m_stopwatch()
 {
   // define which functions might be called dynamic
@@ -146,6 +149,7 @@ void ConvergenceMethod::takeStep()
 
   if (m_stopwatch.isNotRunning()) { m_stopwatch.start(); }
 
+  Common::ProfileRegion profile("ConvergenceMethod::takeStep");
   takeStepImpl();
   if ( hasToUpdateConv() ) updateConvergenceFile();
 
@@ -292,12 +296,12 @@ void ConvergenceMethod::syncGlobalDataComputeResidual(const bool computeResidual
   pushNamespace();
 
   const bool isParallel = Common::PE::GetPE().IsParallel();
-  Common::Stopwatch<Common::WallTime> syncTimer;
+  const bool syncStates = isParallel && !isStateSyncInResidual();
+  Common::ProfileRegion profile("ConvergenceMethod::syncGlobalDataComputeResidual");
 
   // after each update the states have to be syncronized
-  if (isParallel)
+  if (syncStates)
   {
-    syncTimer.start();
     m_statedata->beginSync ();
   }
 
@@ -306,10 +310,18 @@ void ConvergenceMethod::syncGlobalDataComputeResidual(const bool computeResidual
     getConvergenceMethodData()->updateResidual();
   }
 
-  if (isParallel)
+  if (syncStates)
   {
     m_statedata->endSync();
-    syncTimer.stop();
+  }
+
+  if (isParallel && !syncStates)
+  {
+    deferStateSync();
+  }
+  else
+  {
+    m_deferredStateSync = false;
   }
 
   popNamespace();
@@ -327,13 +339,13 @@ void ConvergenceMethod::syncAllAndComputeResidual(const bool computeResidual)
   pushNamespace();
 
   const bool isParallel = Common::PE::GetPE().IsParallel();
-  Common::Stopwatch<Common::WallTime> syncTimer;
+  const bool syncStates = isParallel && !isStateSyncInResidual();
+  Common::ProfileRegion profile("ConvergenceMethod::syncAllAndComputeResidual");
 
   // after each update the states have to be syncronized
   if (isParallel)
   {
-    syncTimer.start();
-    m_statedata->beginSync ();
+    if (syncStates) m_statedata->beginSync ();
     m_nodedata->beginSync ();
   }
 
@@ -344,9 +356,17 @@ void ConvergenceMethod::syncAllAndComputeResidual(const bool computeResidual)
 
   if (isParallel)
   {
-    m_statedata->endSync();
+    if (syncStates) m_statedata->endSync();
     m_nodedata->endSync();
-    syncTimer.stop();
+  }
+
+  if (isParallel && !syncStates)
+  {
+    deferStateSync();
+  }
+  else
+  {
+    m_deferredStateSync = false;
   }
 
   popNamespace();
@@ -354,6 +374,50 @@ void ConvergenceMethod::syncAllAndComputeResidual(const bool computeResidual)
 
 //////////////////////////////////////////////////////////////////////////////
 
+void ConvergenceMethod::deferStateSync()
+{
+  // the skipped synchronization is done by the next residual, which has
+  // to ask again for skipping the following one
+  MultiMethodHandle<SpaceMethod> sm = getConvergenceMethodData()->getSpaceMethod();
+  for (CFuint i = 0; i < sm.size(); ++i) {
+    sm[i]->getSpaceMethodData()->setSyncStatesInResidual(false);
+  }
+  m_deferredStateSync = true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ConvergenceMethod::syncDeferredStates()
+{
+  CFAUTOTRACE;
+
+  if (!m_deferredStateSync) return;
+
+  pushNamespace();
+
+  Common::ProfileRegion profile("ConvergenceMethod::syncDeferredStates");
+  m_statedata->beginSync();
+  m_statedata->endSync();
+  m_deferredStateSync = false;
+
+  popNamespace();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool ConvergenceMethod::isStateSyncInResidual()
+{
+  MultiMethodHandle<SpaceMethod> sm = getConvergenceMethodData()->getSpaceMethod();
+  if (!sm.isNotNull()) return false;
+  
+  for (CFuint i = 0; i < sm.size(); ++i) {
+    if (!sm[i]->getSpaceMethodData()->syncStatesInResidual()) return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void ConvergenceMethod::writeOnScreen()
 {
   CFAUTOTRACE;
@@ -116,6 +116,11 @@ public: // methods
 
   bool outputSpaceResidual() const {return m_outputSpaceResidual;}
 
+  /// Synchronize the ghost states if their synchronization after the last
+  /// update has been left to the next residual, as needed before the
+  /// states are written or processed
+  void syncDeferredStates();
+
 protected: // interface implementation functions
 
   /// Set the convergence method
@@ -147,6 +152,10 @@ protected: // helper functions
   /// Syncronize the states and compute the residual
   void syncGlobalDataComputeResidual(const bool computeResidual);
 
+  /// Check if the space methods synchronize the ghost states themselves
+  /// while computing the residual
+  bool isStateSyncInResidual();
+
   /// Prepare the convergence file
   void prepareConvergenceFile();
 
@@ -158,6 +167,10 @@ protected: // functions
   /// Adds the ActionListener's of this EventListener to the EventHandler
   virtual void registActionListeners();
 
+  /// Record that the state synchronization after an update has been
+  /// skipped, the space methods having to ask again for skipping the next one
+  void deferStateSync();
+
   /// Declares which functions can be called dynamically
   virtual void build_dynamic_functions();
 
@@ -180,6 +193,10 @@ private: // member data
   /// handle to the global nodes
   DataHandle<Node*,GLOBAL>* m_nodedata;
 
+  /// flag telling that the ghost states have not been synchronized after
+  /// the last update, this being left to the next residual
+  bool m_deferredStateSync;
+
   /// stopwatch to keep the track of the time spent converging
   Common::Stopwatch<Common::WallTime>  m_stopwatch;
 
@@ -11,6 +11,7 @@
 
 #include "Common/PE.hh"
 #include "Common/ParallelException.hh"
+#include "Common/Profiler.hh"
 
 #include "Common/Stopwatch.hh"
 
@@ -166,6 +167,7 @@ public:
   void beginSync ()
   {
     cf_assert(_globalPtr != NULL);
+    Common::ProfileRegion profile("DataHandle::beginSync");
     _globalPtr->BeginSync ();
   }
   
@@ -173,6 +175,7 @@ public:
   void endSync ()
   {
     cf_assert(_globalPtr != NULL);
+    Common::ProfileRegion profile("DataHandle::endSync");
     _globalPtr->EndSync ();
   }
 
@@ -4,6 +4,7 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include "Common/Profiler.hh"
 #include "Framework/DataProcessingMethod.hh"
 #include "Framework/SubSystemStatus.hh"
 #include "Environment/CFEnv.hh"
@@ -93,6 +94,7 @@ void DataProcessingMethod::processData()
   pushNamespace();
   
   if (SubSystemStatusStack::getActive()->getNbIter() < m_stopIter) {
+    Common::ProfileRegion profile("DataProcessingMethod::processData");
     processDataImpl();
   }
   
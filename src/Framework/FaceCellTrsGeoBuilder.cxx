@@ -28,7 +28,10 @@ namespace COOLFluiD {
 FaceCellTrsGeoBuilder::FaceCellTrsGeoBuilder() : 
   CellTrsGeoBuilder(), 
   socket_cellFlag("Null"),
-  m_fcdata()
+  m_fcdata(),
+  m_faceStencil(),
+  m_cellStencil(),
+  m_hasStencils(false)
 {
 }
 
@@ -46,6 +49,10 @@ GeometricEntity* FaceCellTrsGeoBuilder::buildGE()
   cf_assert(_isSocketsSet);
   cf_assert(_isSetup);
   
+  if (m_hasStencils) {
+    return buildGEFromStencils();
+  }
+  
   DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
   DataHandle<State*> gstates = socket_gstates.getDataHandle();
   DataHandle < Framework::Node*, Framework::GLOBAL > nodes = socket_nodes.getDataHandle();
@@ -154,6 +161,170 @@ GeometricEntity* FaceCellTrsGeoBuilder::buildGE()
   return currFace;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+GeometricEntity* FaceCellTrsGeoBuilder::buildGEFromStencils()
+{
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle<State*> gstates = socket_gstates.getDataHandle();
+  DataHandle < Framework::Node*, Framework::GLOBAL > nodes = socket_nodes.getDataHandle();
+  DataHandle < bool > cellFlag = socket_cellFlag.getDataHandle();
+  
+  const GeoStencil& fs = m_faceStencil;
+  const GeoStencil& cs = m_cellStencil;
+  
+  // cache the data
+  const bool isBFace = m_fcdata.isBFace;
+  cf_assert(m_fcdata.faces.isNotNull());
+  const CFuint faceID = m_fcdata.faces->getLocalGeoID(m_fcdata.idx);
+  cf_assert(faceID < fs.geoType.size());
+  
+  const CFuint geoType = fs.geoType[faceID];
+  GeometricEntity *const currFace = _poolData[geoType][_countGeo[geoType]++];
+  currFace->setID(faceID);
+  
+  // set nodes in current face
+  const CFuint faceStart = fs.nodeStart[faceID];
+  const CFuint nbGeoNodes = fs.nodeStart[faceID+1] - faceStart;
+  for (CFuint in = 0; in < nbGeoNodes; ++in) {
+    currFace->setNode(in, nodes[fs.nodeIDs[faceStart + in]]);
+  }
+  
+  // set cells on both sides of  the face
+  for (CFuint iCell = 0; iCell < 2; ++iCell) {
+    const CFuint stateID = fs.stateIDs[2*faceID + iCell];
+    State *const state = (iCell == 0 || !isBFace) ? states[stateID] : gstates[stateID];
+    currFace->setState(iCell, state); 
+    
+    if (!state->isGhost()) {
+      if (m_fcdata.allCells || (!cellFlag[stateID])) {
+	// here we assume cellID = stateID !!!!
+	const CFuint cellType = cs.geoType[stateID]; 
+	GeometricEntity *const cell = _poolData[cellType][_countGeo[cellType]++];
+	cell->setID(stateID);
+	cell->setState(0, states[stateID]);
+	
+	const CFuint cellStart = cs.nodeStart[stateID];
+	const CFuint nbCellNodes = cs.nodeStart[stateID+1] - cellStart;
+	for (CFuint in = 0; in < nbCellNodes; ++in) {
+	  cell->setNode(in, nodes[cs.nodeIDs[cellStart + in]]);
+	}
+	_builtGeos.push_back(cell);
+	
+	// create all the neighbor faces for the current cell
+	const CFuint nbFacesInCell = _cellFaces->nbCols(stateID);
+	cf_assert(nbFacesInCell == cell->nbNeighborGeos());
+	
+	for (CFuint iFace = 0; iFace < nbFacesInCell; ++iFace) {
+	  const CFuint nbFaceID = (*_cellFaces)(stateID, iFace);
+	  const CFuint faceType = fs.geoType[nbFaceID];
+	  GeometricEntity *const face = _poolData[faceType][_countGeo[faceType]++];
+	  face->setID(nbFaceID);
+	  
+	  // place the cell-centered states in those faces
+	  face->setState(0, states[fs.stateIDs[2*nbFaceID]]);
+	  const CFuint sID1 = fs.stateIDs[2*nbFaceID + 1];
+	  face->setState(1, (!fs.isBGeo[nbFaceID]) ? states[sID1] : gstates[sID1]);
+	  
+	  // place the nodes in those faces
+	  const CFuint nbFaceStart = fs.nodeStart[nbFaceID];
+	  const CFuint nbFaceNodes = fs.nodeStart[nbFaceID+1] - nbFaceStart;
+	  for (CFuint in = 0; in < nbFaceNodes; ++in) {
+	    face->setNode(in, nodes[fs.nodeIDs[nbFaceStart + in]]);
+	  }
+	  
+	  cell->setNeighborGeo(iFace, face);
+	  _builtGeos.push_back(face);
+	}
+	
+	currFace->setNeighborGeo(iCell, cell);  
+      }
+    }
+  }
+  
+  _builtGeos.push_back(currFace);
+  return currFace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FaceCellTrsGeoBuilder::compileStencils()
+{
+  CFAUTOTRACE;
+  
+  cf_assert(_isSetup);
+  
+  clearStencils();
+  
+  // faces of all the TRSs, ordered by local ID
+  const CFuint nbFaces = _mapGeoToTrs->getNbGeos();
+  m_faceStencil.geoType.resize(nbFaces, 0);
+  m_faceStencil.nodeStart.resize(nbFaces + 1, 0);
+  m_faceStencil.stateIDs.resize(2*nbFaces, 0);
+  m_faceStencil.isBGeo.resize(nbFaces, false);
+  for (CFuint faceID = 0; faceID < nbFaces; ++faceID) {
+    SafePtr<TopologicalRegionSet> faceTrs = _mapGeoToTrs->getTrs(faceID);
+    if (faceTrs.isNotNull()) {
+      const CFuint faceIdx = _mapGeoToTrs->getIdxInTrs(faceID);
+      m_faceStencil.geoType[faceID] = faceTrs->getGeoType(faceIdx);
+      m_faceStencil.isBGeo[faceID] = _mapGeoToTrs->isBGeo(faceID);
+      
+      const CFuint nbStatesInFace = faceTrs->getNbStatesInGeo(faceIdx);
+      for (CFuint is = 0; is < std::min<CFuint>(nbStatesInFace, 2); ++is) {
+	m_faceStencil.stateIDs[2*faceID + is] = faceTrs->getStateID(faceIdx, is);
+      }
+      
+      const CFuint nbFaceNodes = faceTrs->getNbNodesInGeo(faceIdx);
+      for (CFuint in = 0; in < nbFaceNodes; ++in) {
+	m_faceStencil.nodeIDs.push_back(faceTrs->getNodeID(faceIdx, in));
+      }
+    }
+    m_faceStencil.nodeStart[faceID + 1] = m_faceStencil.nodeIDs.size();
+  }
+  
+  // cells, whose local IDs coincide with the state IDs
+  SafePtr<TopologicalRegionSet> cells = MeshDataStack::getActive()->getTrs("InnerCells");
+  const CFuint nbCells = cells->getLocalNbGeoEnts();
+  m_cellStencil.geoType.resize(nbCells, 0);
+  m_cellStencil.nodeStart.resize(nbCells + 1, 0);
+  for (CFuint iCell = 0; iCell < nbCells; ++iCell) {
+    cf_assert(cells->getNbStatesInGeo(iCell) == 1);
+    m_cellStencil.geoType[iCell] = cells->getGeoType(iCell);
+    
+    const CFuint nbCellNodes = cells->getNbNodesInGeo(iCell);
+    for (CFuint in = 0; in < nbCellNodes; ++in) {
+      m_cellStencil.nodeIDs.push_back(cells->getNodeID(iCell, in));
+    }
+    m_cellStencil.nodeStart[iCell + 1] = m_cellStencil.nodeIDs.size();
+  }
+  
+  m_hasStencils = true;
+  
+  CFLog(VERBOSE, "FaceCellTrsGeoBuilder::compileStencils() => " << nbFaces 
+	<< " faces, " << nbCells << " cells\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FaceCellTrsGeoBuilder::clearStencils()
+{
+  m_faceStencil.clear();
+  m_cellStencil.clear();
+  m_hasStencils = false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FaceCellTrsGeoBuilder::GeoStencil::clear()
+{
+  // swap with empty arrays to release the memory
+  std::vector<CFuint>().swap(geoType);
+  std::vector<CFuint>().swap(nodeStart);
+  std::vector<CFuint>().swap(nodeIDs);
+  std::vector<CFuint>().swap(stateIDs);
+  std::vector<bool>().swap(isBGeo);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
   } // namespace Framework
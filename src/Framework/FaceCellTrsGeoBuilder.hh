@@ -85,14 +85,63 @@ public:
   /// in the correspondng TopologicalRegionSet
   Framework::GeometricEntity* buildGE();
   
+  /// Compile the face and cell stencils (geometric types, node and state IDs,
+  /// boundary flags) into flat arrays indexed by the face and cell local IDs.
+  /// Afterwards buildGE() reads them instead of querying the TopologicalRegionSet's.
+  /// The stencils only depend on the mesh topology: they stay valid while the
+  /// mesh moves, but they must be compiled again after the mesh is adapted.
+  /// @pre setup() has been called
+  void compileStencils();
+  
+  /// Drop the compiled stencils and go back to the TopologicalRegionSet's
+  void clearStencils();
+  
+  /// Tells if buildGE() uses the compiled stencils
+  bool hasCompiledStencils() const {return m_hasStencils;}
+  
 private:
   
+  /// Build the GeometricEntity from the compiled stencils
+  Framework::GeometricEntity* buildGEFromStencils();
+  
+  /// Connectivity of a set of GeometricEntity's stored in flat arrays,
+  /// the nodes being in compressed row format
+  struct GeoStencil {
+    
+    /// geometric type of each entity
+    std::vector<CFuint> geoType;
+    
+    /// start of the nodes of each entity in nodeIDs (size nbGeos+1)
+    std::vector<CFuint> nodeStart;
+    
+    /// node IDs of all the entities
+    std::vector<CFuint> nodeIDs;
+    
+    /// left and right state IDs of each face
+    std::vector<CFuint> stateIDs;
+    
+    /// flag telling if the face is on the boundary
+    std::vector<bool> isBGeo;
+    
+    /// clear all the arrays, releasing the memory
+    void clear();
+  };
+  
   /// socket for cell flags
   Framework::DataSocketSink<bool> socket_cellFlag;
   
   /// data of this builder
   FaceCellTrsGeoBuilder::GeoData  m_fcdata;
   
+  /// compiled stencils of the faces, indexed by the face local ID
+  GeoStencil m_faceStencil;
+  
+  /// compiled stencils of the cells, indexed by the cell local ID
+  GeoStencil m_cellStencil;
+  
+  /// flag telling if the stencils have been compiled
+  bool m_hasStencils;
+  
 }; // end of class FaceCellTrsGeoBuilder
 
 //////////////////////////////////////////////////////////////////////////////
@@ -4,6 +4,7 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include "Common/Profiler.hh"
 #include "Framework/LinearSystemSolver.hh"
 #include "Framework/PhysicalModel.hh"
 #include "Framework/NamespaceSwitcher.hh"
@@ -131,6 +132,7 @@ void LinearSystemSolver::solveSys()
 
   pushNamespace();
 
+  Common::ProfileRegion profile("LinearSystemSolver::solveSys");
   solveSysImpl();
 
   popNamespace();
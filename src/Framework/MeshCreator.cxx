@@ -7,6 +7,7 @@
 #include "Common/ProcessInfo.hh"
 #include "Common/OSystem.hh"
 #include "Common/BadValueException.hh"
+#include "Common/Profiler.hh"
 
 #include "Framework/MeshCreator.hh"
 #include "Framework/SpaceMethod.hh"
@@ -86,6 +87,7 @@ void MeshCreator::generateMeshData()
   CFLog(NOTICE,"MeshCreator [" << getName() << "] Generate or Read Mesh\n");
   CFLog(NOTICE,"\nMemory usage before building mesh: " << Common::OSystem::getInstance().getProcessInfo()->memoryUsage() << "\n\n");
 
+  Common::ProfileRegion profile("MeshCreator::generateMeshData");
   generateMeshDataImpl();
 
   CFLog(NOTICE,"\nMemory usage after building mesh: " << Common::OSystem::getInstance().getProcessInfo()->memoryUsage() << "\n");
@@ -107,6 +109,7 @@ void MeshCreator::processMeshData()
 
   /// @todo this could be a post generation hook not directly accessible from
   ///       the interface, maybe controled by commands
+  Common::ProfileRegion profile("MeshCreator::processMeshData");
   processMeshDataImpl();
 
   popNamespace();
@@ -126,6 +129,7 @@ void MeshCreator::buildMeshData()
   CFLog(NOTICE,"-------------------------------------------------------------\n");
   CFLog(NOTICE,"MeshCreator [" << getName() << "] Building Mesh Data\n");
 
+  Common::ProfileRegion profile("MeshCreator::buildMeshData");
   buildMeshDataImpl();
 
   CFLog(NOTICE,"-------------------------------------------------------------\n");
@@ -6,6 +6,8 @@
 
 #include <boost/filesystem/convenience.hpp>
 
+#include "Common/Profiler.hh"
+
 #include "Framework/OutputFormatter.hh"
 #include "Environment/DirPaths.hh"
 #include "Framework/SubSystemStatus.hh"
@@ -180,6 +182,7 @@ void OutputFormatter::write()
 
   pushNamespace();
 
+  Common::ProfileRegion profile("OutputFormatter::write");
   writeImpl();
 
   popNamespace();
@@ -4,6 +4,8 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <algorithm>
+
 #include "PhysicalChemicalLibrary.hh"
 
 //////////////////////////////////////////////////////////////////////////////
@@ -64,6 +66,75 @@ void PhysicalChemicalLibrary::configure ( Config::ConfigArgs& args )
   PhysicalPropertyLibrary::configure(args);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+void PhysicalChemicalLibrary::computeBatch(const BatchData& data)
+{
+  const CFuint nbPoints = data.nbPoints;
+  const CFuint nbTv = (data.tVec != CFNULL) ? _nbTvib + _nbTe : 0;
+  
+  RealVector ys(_NS);
+  // single temperature models get T as vibrational temperature in the source
+  RealVector tVec(std::max<CFuint>(nbTv, 1));
+  RealVector dhe(3 + _nbTvib + _nbTe);
+  RealVector omega(_NS);
+  RealMatrix jacobian;
+  
+  for (CFuint i = 0; i < nbPoints; ++i) {
+    CFdouble temp = data.temp[i];
+    CFdouble pressure = data.pressure[i];
+    for (CFint is = 0; is < _NS; ++is) {
+      ys[is] = data.ys[is*nbPoints + i];
+    }
+    tVec[0] = temp;
+    for (CFuint it = 0; it < nbTv; ++it) {
+      tVec[it] = data.tVec[it*nbPoints + i];
+    }
+    CFreal* const tv = (nbTv > 0) ? &tVec[0] : CFNULL;
+    
+    setSpeciesFractions(ys);
+    CFdouble rho = density(temp, pressure, tv);
+    if (data.rho != CFNULL) {
+      data.rho[i] = rho;
+    }
+    
+    if (data.enthalpy != CFNULL || data.energy != CFNULL) {
+      if (nbTv > 0) {
+	setDensityEnthalpyEnergy(temp, tVec, pressure, dhe);
+      }
+      else {
+	setDensityEnthalpyEnergy(temp, pressure, dhe);
+      }
+      if (data.enthalpy != CFNULL) {data.enthalpy[i] = dhe[1];}
+      if (data.energy != CFNULL)   {data.energy[i] = dhe[2];}
+    }
+    
+    if (data.gamma != CFNULL || data.soundSpeed != CFNULL) {
+      CFdouble gamma = 0.;
+      CFdouble soundSpeed = 0.;
+      frozenGammaAndSoundSpeed(temp, pressure, rho, gamma, soundSpeed,
+			       (nbTv > 0) ? &tVec : CFNULL);
+      if (data.gamma != CFNULL)      {data.gamma[i] = gamma;}
+      if (data.soundSpeed != CFNULL) {data.soundSpeed[i] = soundSpeed;}
+    }
+    
+    if (data.eta != CFNULL) {
+      data.eta[i] = eta(temp, pressure, tv);
+    }
+    
+    if (data.lambda != CFNULL) {
+      data.lambda[i] = lambdaNEQ(temp, pressure);
+    }
+    
+    if (data.omega != CFNULL) {
+      getMassProductionTerm(temp, tVec, pressure, rho, ys, false, omega, jacobian);
+      for (CFint is = 0; is < _NS; ++is) {
+	data.omega[is*nbPoints + i] = omega[is];
+      }
+    }
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
   
 } // namespace Framework
@@ -84,6 +84,64 @@ public:
 
   };
 
+  /// Batch of thermodynamic states and of the properties to compute on them,
+  /// stored as structure of arrays in memory owned by the caller.
+  /// The entries of the point i are temp[i], pressure[i], ys[is*nbPoints + i]
+  /// and, for multi-temperature models, tVec[iTv*nbPoints + i].
+  /// The outputs left to CFNULL are not computed.
+  class Framework_API BatchData {
+  public:
+
+    BatchData() :
+      nbPoints(0), temp(CFNULL), pressure(CFNULL), ys(CFNULL), tVec(CFNULL),
+      rho(CFNULL), enthalpy(CFNULL), energy(CFNULL), gamma(CFNULL),
+      soundSpeed(CFNULL), eta(CFNULL), lambda(CFNULL), omega(CFNULL)
+    {
+    }
+
+    ~BatchData(){}
+
+    /// number of points in the batch
+    CFuint nbPoints;
+
+    /// temperatures [nbPoints]
+    const CFreal* temp;
+
+    /// pressures [nbPoints]
+    const CFreal* pressure;
+
+    /// species mass fractions [NS*nbPoints]
+    const CFreal* ys;
+
+    /// vibrational and electron temperatures [(nbTvib+nbTe)*nbPoints], can be CFNULL
+    const CFreal* tVec;
+
+    /// output: densities [nbPoints]
+    CFreal* rho;
+
+    /// output: mixture enthalpies per unit mass [nbPoints]
+    CFreal* enthalpy;
+
+    /// output: mixture internal energies per unit mass [nbPoints]
+    CFreal* energy;
+
+    /// output: frozen specific heat ratios [nbPoints]
+    CFreal* gamma;
+
+    /// output: frozen speeds of sound [nbPoints]
+    CFreal* soundSpeed;
+
+    /// output: dynamic viscosities [nbPoints]
+    CFreal* eta;
+
+    /// output: thermal conductivities [nbPoints]
+    CFreal* lambda;
+
+    /// output: species mass production terms [NS*nbPoints]
+    CFreal* omega;
+
+  };
+
   /// Defines the Config Option's of this class
   /// @param options a OptionList where to add the Option's
   static void defineConfigOptions(Config::OptionList& options);
@@ -513,6 +571,14 @@ public:
 				       RealVector* hsVib = CFNULL,
 				       RealVector* hsEl = CFNULL) = 0;
   
+  /// Computes the requested properties on a whole batch of states.
+  /// The default implementation goes through the point-wise interface,
+  /// one point after the other, overwriting the composition and the state
+  /// stored in the library: libraries which can evaluate independent states
+  /// without shared mutable data should override it.
+  /// @param data  states and output arrays, see BatchData
+  virtual void computeBatch(const BatchData& data);
+  
   /// Temperature of free electrons
   CFdouble getTe(CFdouble temp, CFreal* tVec)
   {
@@ -7,6 +7,7 @@
 #include "Common/NotImplementedException.hh"
 #include "Common/BadValueException.hh"
 #include "Common/EventHandler.hh"
+#include "Common/Profiler.hh"
 
 #include "Environment/CFEnv.hh"
 
@@ -129,6 +130,7 @@ void SpaceMethod::initializeSolution()
   pushNamespace();
   
   getSpaceMethodData()->setIsRestart(m_restart); 
+  Common::ProfileRegion profile("SpaceMethod::initializeSolution");
   initializeSolutionImpl(m_restart);
   
   popNamespace();
@@ -147,6 +149,7 @@ void SpaceMethod::prepareComputation()
 
   pushNamespace();
 
+  Common::ProfileRegion profile("SpaceMethod::prepareComputation");
   prepareComputationImpl();
 
   popNamespace();
@@ -163,6 +166,7 @@ void SpaceMethod::computeSpaceResidual(CFreal factor)
 
   pushNamespace();
 
+  Common::ProfileRegion profile("SpaceMethod::computeSpaceResidual");
   computeSpaceResidualImpl(factor);
 
   popNamespace();
@@ -179,6 +183,7 @@ void SpaceMethod::computeTimeResidual(CFreal factor)
 
   pushNamespace();
 
+  Common::ProfileRegion profile("SpaceMethod::computeTimeResidual");
   computeTimeResidualImpl(factor);
 
   popNamespace();
@@ -195,6 +200,7 @@ void SpaceMethod::applyBC()
 
   pushNamespace();
 
+  Common::ProfileRegion profile("SpaceMethod::applyBC");
   applyBCImpl();
 
   popNamespace();
@@ -211,6 +217,7 @@ void SpaceMethod::postProcessSolution()
 
   pushNamespace();
 
+  Common::ProfileRegion profile("SpaceMethod::postProcessSolution");
   postProcessSolutionImpl();
 
   popNamespace();
@@ -259,6 +266,7 @@ void SpaceMethod::computeSpaceRhsForStatesSet(CFreal factor)
 
   pushNamespace();
 
+  Common::ProfileRegion profile("SpaceMethod::computeSpaceRhsForStatesSet");
   computeSpaceRhsForStatesSetImpl(factor);
 
   popNamespace();
@@ -275,6 +283,7 @@ void SpaceMethod::computeTimeRhsForStatesSet(CFreal factor)
 
   pushNamespace();
 
+  Common::ProfileRegion profile("SpaceMethod::computeTimeRhsForStatesSet");
   computeTimeRhsForStatesSetImpl(factor);
 
   popNamespace();
@@ -291,6 +300,7 @@ void SpaceMethod::extrapolateStatesToNodes()
 
   pushNamespace();
 
+  Common::ProfileRegion profile("SpaceMethod::extrapolateStatesToNodes");
   extrapolateStatesToNodesImpl();
 
   popNamespace();
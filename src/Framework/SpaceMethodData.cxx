@@ -46,7 +46,8 @@ SpaceMethodData::SpaceMethodData(Common::SafePtr<Method> owner)
     _iPerturbVar(0),
     _fillPreconditionerMatrix(false),
     _computeJacobian(true),
-    _sysMatFrozen(false)
+    _sysMatFrozen(false),
+    _syncStatesInResidual(false)
 {
   addConfigOptionsTo(this);
   
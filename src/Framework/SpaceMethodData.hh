@@ -176,6 +176,14 @@ public:
     return _freezeSysMatEverIter;
   }
   
+  /// Flag telling if the ghost states are synchronized while computing the
+  /// residual, so that the ConvergenceMethod doesn't need to do it.
+  /// It is reset by the ConvergenceMethod after each skipped synchronization.
+  bool syncStatesInResidual() const {return _syncStatesInResidual;}
+  
+  /// Set the flag telling if the ghost states are synchronized while computing the residual
+  void setSyncStatesInResidual(bool flag) {_syncStatesInResidual = flag;}
+  
   /// get flag telling if the flux is being perturbed
   bool isPerturb() const {return _isPerturb;}
   
@@ -248,6 +256,9 @@ protected:
 
   /// Strategy to freeze system matrix
   bool _freezeSysMatEverIter;
+  
+  /// flag telling if the ghost states are synchronized while computing the residual
+  bool _syncStatesInResidual;
     
   /// string for configuration of the update variables
   std::string _updateVarStr;
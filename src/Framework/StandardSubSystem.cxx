@@ -9,6 +9,7 @@
 #include "Common/CFLog.hh"
 #include "Common/NullPointerException.hh"
 #include "Common/EventHandler.hh"
+#include "Common/Profiler.hh"
 
 #include "Environment/FileHandlerOutput.hh"
 #include "Environment/DirPaths.hh"
@@ -622,16 +623,25 @@ void StandardSubSystem::run()
   setGlobalData();
   Stopwatch<WallTime> stopTimer;
   stopTimer.start();
+  
+  Common::ProfileRegion profile("StandardSubSystem::run");
 
   // Transfer of the data for the subsystems coupling
   // here, write the data to the other subsystems
   m_couplerMethod.apply(mem_fun<void,CouplerMethod>(&CouplerMethod::dataTransferWrite));
 
   for ( ; (!m_stopCondControler->isAchieved(SubSystemStatusStack::getActive()->getConvergenceStatus())) && (!m_forcedStop); ) {
-
+    
+    Common::ProfileRegion iterProfile("StandardSubSystem::iteration");
+    
     // read the interactive parameters
     getInteractiveParamReader()->readFile();
 
+    // the processing and the adaptation need up to date ghost states
+    if (m_dataPreProcessing.size() > 0 || m_meshAdapterMethod.size() > 0) {
+      syncDeferredStates();
+    }
+    
     CFLog(VERBOSE, "StandardSubSystem::run() => m_dataPreProcessing.apply()\n");
     // pre-process the data
     m_dataPreProcessing.apply(mem_fun<void,DataProcessingMethod>
@@ -653,6 +663,11 @@ void StandardSubSystem::run()
     m_convergenceMethod.apply(root_mem_fun<void,ConvergenceMethod>
                               (&ConvergenceMethod::takeStep));
     
+    if (m_errorEstimatorMethod.size() > 0 || m_dataPostProcessing.size() > 0 ||
+        m_couplerMethod.size() > 0 || m_meshAdapterMethod.size() > 0) {
+      syncDeferredStates();
+    }
+    
     CFLog(VERBOSE, "StandardSubSystem::run() => m_errorEstimatorMethod.apply()\n");
     // estimate errors
     m_errorEstimatorMethod.apply(mem_fun<void,ErrorEstimatorMethod>
@@ -681,7 +696,9 @@ void StandardSubSystem::run()
     // write solution to file
     bool dontforce = false;
     writeSolution(dontforce);
-
+    
+    dumpProfile(dontforce);
+    
   } // end for convergence loop
   
   CFLog(VERBOSE, "StandardSubSystem::run() => m_errorEstimatorMethod.apply()\n");
@@ -782,6 +799,7 @@ void StandardSubSystem::unsetup()
 
   bool force = true;
   writeSolution(force);
+  dumpProfile(force);
 
   CFLog(VERBOSE, "StandardSubSystem::unsetup() => OutputFormatter\n");
   // unset all the methods
@@ -995,6 +1013,7 @@ void StandardSubSystem::writeSolution(const bool force_write )
     {
       if(m_outputFormat[i]->isSaveNow( force_write ) )
       {
+        syncDeferredStates();
         Stopwatch<WallTime> stopTimer;
         stopTimer.start();
         m_outputFormat[i]->open ();
@@ -1092,6 +1111,30 @@ void StandardSubSystem::dumpStates()
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+void StandardSubSystem::syncDeferredStates()
+{
+  for (CFuint i = 0; i < m_convergenceMethod.size(); ++i) {
+    m_convergenceMethod[i]->syncDeferredStates();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StandardSubSystem::dumpProfile(const bool force)
+{
+  Common::Profiler& profiler = Common::Profiler::getInstance();
+  if (!profiler.Active) return;
+  
+  const CFuint nbIter = SubSystemStatusStack::getActive()->getNbIter();
+  if (force || (profiler.DumpRate > 0 && nbIter % profiler.DumpRate == 0)) {
+    const boost::filesystem::path fpath = 
+      Environment::DirPaths::getInstance().getResultsDir() / profiler.FileName;
+    profiler.dump(fpath.string());
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
   } // namespace Framework
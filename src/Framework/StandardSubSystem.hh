@@ -132,6 +132,14 @@ protected: // functions
   /// Dump the states to file
   void dumpStates();
   
+  /// Synchronize the ghost states whose synchronization has been left by
+  /// the convergence methods to the next residual
+  void syncDeferredStates();
+  
+  /// Dump the profile to file, if profiling is active
+  /// @param force  dump even if this is not a dumping iteration
+  void dumpProfile(const bool force);
+  
 protected: // data
 
   /// Duration of the simulation of this SubSystem
@@ -9,8 +9,6 @@
 
 //////////////////////////////////////////////////////////////////////////////
 
-#include <valarray>
-
 #include "MathTools/RealVector.hh"
 #include "MathTools/RealMatrix.hh"
 
@@ -22,7 +20,9 @@ namespace COOLFluiD {
 
 //////////////////////////////////////////////////////////////////////////////
 
-/// This class inverts a matrix using LU decomposition
+/// This class inverts a matrix using LU decomposition.
+/// The work storage has fixed size, so that all the loops have compile-time
+/// bounds and no memory is allocated.
 /// @author Tiago Quintino
 template < unsigned int SIZE >
 struct LUInverterT {
@@ -32,7 +32,10 @@ public:
   LUInverterT ();
 
   /// Invert the given matrix a and put the result in x
-  void invert (const RealMatrix& a, RealMatrix& x);
+  void invert (const RealMatrix& a, RealMatrix& x) {invertImpl(a,x);}
+
+  /// Invert the given fixed size matrix a and put the result in x
+  void invert (const CFMat<CFreal,SIZE,SIZE>& a, CFMat<CFreal,SIZE,SIZE>& x) {invertImpl(a,x);}
 
   /// Factorize the matrix
   void factorizeLU();
@@ -40,15 +43,21 @@ public:
   /// Solve with forward and backward substitution
   void solveForwBack();
 
+private: // helper functions
+
+  /// Invert the given matrix a and put the result in x
+  template <typename MATRIX>
+  void invertImpl (const MATRIX& a, MATRIX& x);
+
 private: // data
   /// storage of indexes
-  std::valarray<CFuint> m_indx;
+  CFuint                         m_indx[SIZE];
   /// temporary vector
-  RealVector              m_tmp_col;
+  CFreal                         m_tmp_col[SIZE];
   /// temporary vector
-  RealVector              m_vv;
+  CFreal                         m_vv[SIZE];
   /// temporary copy of input matrix
-  RealMatrix              m_a;
+  CFMat<CFreal,SIZE,SIZE>        m_a;
 
 }; // end of class LUInverter
 
@@ -25,6 +25,21 @@ MatrixInverter::create(const CFuint& size, const bool& isDiagonal)
   {
     switch(size)
     {
+    case(9):
+      return new InverterT<9>();
+      break;
+    case(8):
+      return new InverterT<8>();
+      break;
+    case(7):
+      return new InverterT<7>();
+      break;
+    case(6):
+      return new InverterT<6>();
+      break;
+    case(5):
+      return new InverterT<5>();
+      break;
     case(4):
       return new InverterT<4>();
       break;
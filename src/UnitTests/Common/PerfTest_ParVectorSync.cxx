@@ -0,0 +1,168 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Performance Test Module For ParVector synchronization"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/PE.hh"
+#include "Common/Stopwatch.hh"
+#include "Common/CommPatternManager.hh"
+#include "Common/MPI/ParVector.hh"
+#include "UnitTests/PEFixture.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct ParVectorSyncFixture
+{
+  /// number of locally owned points
+  static const CFuint NB_LOCAL = 20000;
+
+  /// number of ghost points taken from each neighbor
+  static const CFuint NB_GHOSTS = 2000;
+
+  /// number of timed synchronizations
+  static const CFuint NB_SYNCS = 500;
+
+  /// number of timed runs of each sync mode
+  static const CFuint NB_RUNS = 4;
+
+  ParVectorSyncFixture()
+  {
+    m_rank = PE::GetPE().GetRank();
+    m_size = PE::GetPE().GetProcessorCount();
+  }
+
+  /// Build a vector with nbEqs values per point, whose ghosts come from the
+  /// previous and next ranks only (as for a slab decomposition), synchronize
+  /// it a number of times and check the ghost values
+  /// @return the wall time spent in the synchronizations
+  CFreal syncVector(const CFuint nbEqs, const bool persistent)
+  {
+    CommPatternManager::getInstance().PersistentGhostSync = persistent;
+
+    const CFuint elemSize = nbEqs*sizeof(CFreal);
+    ParVector<CFreal> v(0., 0, elemSize);
+    v.reserve(NB_LOCAL + 2*NB_GHOSTS, elemSize);
+
+    for (CFuint i = 0; i < NB_LOCAL; ++i) {
+      v.AddLocalPoint(m_rank*NB_LOCAL + i);
+    }
+
+    std::vector<CFuint> ghostGlobal;
+    std::vector<CFuint> ghostLocal;
+    if (m_size > 1) {
+      const CFuint prev = (m_rank + m_size - 1) % m_size;
+      const CFuint next = (m_rank + 1) % m_size;
+      for (CFuint i = 0; i < NB_GHOSTS; ++i) {
+	ghostGlobal.push_back(prev*NB_LOCAL + NB_LOCAL - 1 - i);
+	if (next != prev) {
+	  ghostGlobal.push_back(next*NB_LOCAL + i);
+	}
+      }
+    }
+    for (CFuint i = 0; i < ghostGlobal.size(); ++i) {
+      ghostLocal.push_back(v.AddGhostPoint(ghostGlobal[i]));
+    }
+
+    v.BuildGhostMap();
+
+    MPI_Barrier(PE::GetPE().GetCommunicator());
+
+    Stopwatch<WallTime> stp;
+    CFuint nbWrong = 0;
+    for (CFuint iSync = 0; iSync < NB_SYNCS; ++iSync) {
+      for (CFuint i = 0; i < NB_LOCAL; ++i) {
+	CFreal *const p = &v(i);
+	for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+	  p[iEq] = value(m_rank*NB_LOCAL + i, iEq, iSync);
+	}
+      }
+
+      stp.resume();
+      v.BeginSync();
+      v.EndSync();
+      stp.stop();
+
+      for (CFuint i = 0; i < ghostLocal.size(); ++i) {
+	const CFreal *const p = &v(ghostLocal[i]);
+	for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+	  if (p[iEq] != value(ghostGlobal[i], iEq, iSync)) {++nbWrong;}
+	}
+      }
+    }
+
+    BOOST_CHECK_EQUAL(nbWrong, 0u);
+    return stp.read();
+  }
+
+  /// value stored in a given point at a given synchronization
+  CFreal value(const CFuint globalID, const CFuint iEq, const CFuint iSync) const
+  {
+    return globalID*10. + iEq + iSync*0.5;
+  }
+
+  /// print the timings of both sync modes
+  void compare(const std::string& name, const CFuint nbEqs)
+  {
+    // interleave the two modes (swapping which one goes first) and keep
+    // the best timing of each
+    CFreal tDefault = std::numeric_limits<CFreal>::max();
+    CFreal tPersistent = std::numeric_limits<CFreal>::max();
+    for (CFuint iRun = 0; iRun < NB_RUNS; ++iRun) {
+      const bool persistentFirst = (iRun % 2 == 1);
+      for (CFuint iMode = 0; iMode < 2; ++iMode) {
+	const bool persistent = (persistentFirst == (iMode == 0));
+	CFreal& t = (persistent) ? tPersistent : tDefault;
+	t = std::min(t, syncVector(nbEqs, persistent));
+      }
+    }
+    CommPatternManager::getInstance().PersistentGhostSync = false;
+
+    if (m_rank == 0) {
+      std::cout << name << " (" << nbEqs << " values, " << m_size << " procs, "
+		<< NB_SYNCS << " syncs): default = " << tDefault
+		<< " s, persistent = " << tPersistent << " s\n";
+    }
+  }
+
+  CFuint m_rank;
+  CFuint m_size;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( ParVectorSyncSuite, ParVectorSyncFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( StateSync )
+{
+  compare("states", 5);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( NodeSync )
+{
+  compare("nodes", 3);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,165 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test Module For AdaptiveLookupTable2D"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdio>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/AdaptiveLookupTable2D.hh"
+#include "Common/BadValueException.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Smooth function with a steep front along x, like a dissociation region
+struct FrontSampler : public AdaptiveLookupTable2D::Sampler
+{
+  FrontSampler() : nbCalls(0) {}
+
+  void compute(CFreal x, CFreal y, CFreal* values)
+  {
+    ++nbCalls;
+    values[0] = std::tanh((x - 4000.)/200.) + 1e-6*y;
+    values[1] = x*std::log(y);
+  }
+
+  CFuint nbCalls;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( AdaptiveLookupTable2D_TestSuite )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( RefinedTableMeetsTolerance )
+{
+  FrontSampler f;
+  AdaptiveLookupTable2D table;
+  const CFreal tol = 1e-3;
+  table.build(f, 2, 300., 10000., 10, 100., 1e6, 5, true, tol, 12);
+
+  BOOST_CHECK_EQUAL(table.getNbVars(), 2u);
+  BOOST_CHECK(table.getNbX() > 10);
+
+  // the error is checked against the variable ranges, well inside the table
+  CFreal exact[2];
+  CFreal values[2];
+  CFreal maxError = 0.;
+  for (CFuint i = 0; i < 97; ++i) {
+    for (CFuint j = 0; j < 31; ++j) {
+      const CFreal x = 300. + 9700.*(i + 0.37)/97.;
+      const CFreal y = 100.*std::pow(1e4, (j + 0.61)/31.);
+      f.compute(x, y, exact);
+      table.get(x, y, values);
+      maxError = std::max(maxError, std::abs(values[0] - exact[0])/2.);
+      BOOST_CHECK_CLOSE(table.get(x, y, 0u), values[0], 1e-10);
+    }
+  }
+  BOOST_CHECK(maxError < 4.*tol);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( ClampsOutsideTheBounds )
+{
+  FrontSampler f;
+  AdaptiveLookupTable2D table;
+  table.build(f, 2, 300., 10000., 10, 100., 1e6, 5, true, 1e-3, 4);
+
+  CFreal inside[2];
+  CFreal outside[2];
+  table.get(10000., 1e6, inside);
+  table.get(20000., 1e7, outside);
+  BOOST_CHECK_EQUAL(inside[0], outside[0]);
+  BOOST_CHECK_EQUAL(inside[1], outside[1]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( SaveAndLoad )
+{
+  FrontSampler f;
+  AdaptiveLookupTable2D table;
+  table.build(f, 2, 300., 10000., 10, 100., 1e6, 5, true, 1e-3, 6);
+
+  const std::string fileName = "test-adaptive-lookup-table.lkp";
+  table.save(fileName);
+
+  AdaptiveLookupTable2D loaded;
+  BOOST_CHECK(loaded.load(fileName));
+  BOOST_CHECK_EQUAL(loaded.getNbX(), table.getNbX());
+  BOOST_CHECK_EQUAL(loaded.getNbY(), table.getNbY());
+
+  CFreal v1[2];
+  CFreal v2[2];
+  for (CFuint i = 0; i < 50; ++i) {
+    const CFreal x = 300. + 190.*i;
+    const CFreal y = 100. + 2e4*i;
+    table.get(x, y, v1);
+    loaded.get(x, y, v2);
+    BOOST_CHECK_EQUAL(v1[0], v2[0]);
+    BOOST_CHECK_EQUAL(v1[1], v2[1]);
+  }
+
+  loaded.clear();
+  std::remove(fileName.c_str());
+  BOOST_CHECK(!loaded.load(fileName));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( LoadedTableKeepsItsSettings )
+{
+  FrontSampler f;
+  AdaptiveLookupTable2D table;
+  table.build(f, 2, 300., 10000., 10, 100., 1e6, 5, true, 1e-3, 2);
+
+  std::vector<std::string> names;
+  names.push_back("a");
+  names.push_back("b");
+  BOOST_CHECK_THROW(table.setLabels(std::vector<std::string>(1, "a"), "front"),
+                    BadValueException);
+  table.setLabels(names, "front");
+
+  const std::string fileName = "test-adaptive-lookup-table-labels.lkp";
+  table.save(fileName);
+
+  AdaptiveLookupTable2D loaded;
+  BOOST_REQUIRE(loaded.load(fileName));
+  std::remove(fileName.c_str());
+  BOOST_CHECK(loaded.matches(names, "front", 300., 10000., 10, 100., 1e6, 5, true, 1e-3, 2));
+
+  // any other setting must be detected
+  std::vector<std::string> swapped(names.rbegin(), names.rend());
+  BOOST_CHECK(!loaded.matches(swapped, "front", 300., 10000., 10, 100., 1e6, 5, true, 1e-3, 2));
+  BOOST_CHECK(!loaded.matches(names, "other", 300., 10000., 10, 100., 1e6, 5, true, 1e-3, 2));
+  BOOST_CHECK(!loaded.matches(names, "front", 200., 10000., 10, 100., 1e6, 5, true, 1e-3, 2));
+  BOOST_CHECK(!loaded.matches(names, "front", 300., 20000., 10, 100., 1e6, 5, true, 1e-3, 2));
+  BOOST_CHECK(!loaded.matches(names, "front", 300., 10000., 20, 100., 1e6, 5, true, 1e-3, 2));
+  BOOST_CHECK(!loaded.matches(names, "front", 300., 10000., 10, 10., 1e6, 5, true, 1e-3, 2));
+  BOOST_CHECK(!loaded.matches(names, "front", 300., 10000., 10, 100., 1e7, 5, true, 1e-3, 2));
+  BOOST_CHECK(!loaded.matches(names, "front", 300., 10000., 10, 100., 1e6, 9, true, 1e-3, 2));
+  BOOST_CHECK(!loaded.matches(names, "front", 300., 10000., 10, 100., 1e6, 5, false, 1e-3, 2));
+  BOOST_CHECK(!loaded.matches(names, "front", 300., 10000., 10, 100., 1e6, 5, true, 1e-4, 2));
+  BOOST_CHECK(!loaded.matches(names, "front", 300., 10000., 10, 100., 1e6, 5, true, 1e-3, 3));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
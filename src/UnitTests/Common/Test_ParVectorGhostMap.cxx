@@ -0,0 +1,170 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the ParVector ghost map construction"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/PE.hh"
+#include "Common/MPI/ParVectorException.hh"
+#include "Common/CommPatternManager.hh"
+#include "Common/MPI/ParVector.hh"
+#include "UnitTests/PEFixture.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct ParVectorGhostMapFixture
+{
+  /// number of locally owned points
+  static const CFuint NB_LOCAL = 300;
+
+  ParVectorGhostMapFixture()
+  {
+    m_rank = PE::GetPE().GetRank();
+    m_size = PE::GetPE().GetProcessorCount();
+  }
+
+  ~ParVectorGhostMapFixture()
+  {
+    CommPatternManager::getInstance().ScalableGhostMap = false;
+  }
+
+  /// owner of a global index: the indices are dealt round robin, leaving
+  /// out every seventh one, so that the owned indices are not contiguous
+  CFuint owner(const CFuint globalID) const {return (globalID/7) % m_size;}
+
+  /// global indices owned by the given rank
+  void ownedPoints(const CFuint rank, std::vector<CFuint>& points) const
+  {
+    points.clear();
+    for (CFuint g = 0; points.size() < NB_LOCAL; ++g) {
+      if (g % 7 != 6 && owner(g) == rank) {points.push_back(g);}
+    }
+  }
+
+  /// Fill a vector with the owned points of this rank and with ghosts
+  /// taken from every other rank, possibly adding a point nobody owns
+  void fillVector(ParVector<CFreal>& v, std::vector<CFuint>& ghostGlobal,
+		  std::vector<CFuint>& ghostLocal, const bool addMissing) const
+  {
+    std::vector<CFuint> points;
+    ownedPoints(m_rank, points);
+    for (CFuint i = 0; i < points.size(); ++i) {
+      v.AddLocalPoint(points[i]);
+    }
+
+    // a different stride for each neighbor, in decreasing global order
+    for (CFuint p = 0; p < m_size; ++p) {
+      if (p == m_rank) continue;
+      ownedPoints(p, points);
+      for (CFuint i = points.size(); i > 0; i -= (p+m_rank) % 3 + 1) {
+	ghostGlobal.push_back(points[i-1]);
+	if (i <= (p+m_rank) % 3 + 1) break;
+      }
+    }
+    if (addMissing) {
+      ghostGlobal.push_back(6);
+    }
+
+    for (CFuint i = 0; i < ghostGlobal.size(); ++i) {
+      ghostLocal.push_back(v.AddGhostPoint(ghostGlobal[i]));
+    }
+  }
+
+  /// Build the ghost map with the given algorithm, synchronize and check
+  /// the ghost values
+  void buildAndSync(const bool scalable,
+		    std::vector<std::vector<CFuint> >& sendList,
+		    std::vector<std::vector<CFuint> >& recvList)
+  {
+    CommPatternManager::getInstance().ScalableGhostMap = scalable;
+
+    ParVector<CFreal> v(0., 0, sizeof(CFreal));
+    std::vector<CFuint> ghostGlobal;
+    std::vector<CFuint> ghostLocal;
+    fillVector(v, ghostGlobal, ghostLocal, false);
+
+    v.BuildGhostMap();
+    sendList = v.GetGhostSendList();
+    recvList = v.GetGhostReceiveList();
+
+    std::vector<CFuint> points;
+    ownedPoints(m_rank, points);
+    for (CFuint i = 0; i < points.size(); ++i) {
+      v(i) = points[i] + 0.5;
+    }
+
+    v.BeginSync();
+    v.EndSync();
+
+    CFuint nbWrong = 0;
+    for (CFuint i = 0; i < ghostLocal.size(); ++i) {
+      if (v(ghostLocal[i]) != ghostGlobal[i] + 0.5) {++nbWrong;}
+    }
+    BOOST_CHECK_EQUAL(nbWrong, 0u);
+  }
+
+  CFuint m_rank;
+  CFuint m_size;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( ParVectorGhostMapSuite, ParVectorGhostMapFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( DirectoryLookupMatchesBroadcast )
+{
+  std::vector<std::vector<CFuint> > sendBcast;
+  std::vector<std::vector<CFuint> > recvBcast;
+  buildAndSync(false, sendBcast, recvBcast);
+
+  std::vector<std::vector<CFuint> > sendDir;
+  std::vector<std::vector<CFuint> > recvDir;
+  buildAndSync(true, sendDir, recvDir);
+
+  // both algorithms order the ghosts by global index
+  BOOST_REQUIRE_EQUAL(sendDir.size(), m_size);
+  BOOST_REQUIRE_EQUAL(recvDir.size(), m_size);
+  for (CFuint p = 0; p < m_size; ++p) {
+    BOOST_CHECK(sendDir[p] == sendBcast[p]);
+    BOOST_CHECK(recvDir[p] == recvBcast[p]);
+    if (p != m_rank) {
+      BOOST_CHECK(!recvDir[p].empty());
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( DirectoryLookupMissingGhost )
+{
+  // only the first rank asks for a point nobody owns: all the ranks must
+  // throw instead of waiting in the next exchange
+  CommPatternManager::getInstance().ScalableGhostMap = true;
+
+  ParVector<CFreal> v(0., 0, sizeof(CFreal));
+  std::vector<CFuint> ghostGlobal;
+  std::vector<CFuint> ghostLocal;
+  fillVector(v, ghostGlobal, ghostLocal, m_rank == 0);
+
+  BOOST_CHECK_THROW(v.BuildGhostMap(), NotFoundException);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,266 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the Profiler"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/PE.hh"
+#include "Common/Profiler.hh"
+#include "UnitTests/PEFixture.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Counter whose value is set by the test, so that the values accumulated
+/// in the regions are exact, unlike the wall time
+class TickCounter : public ProfilerCounters {
+public:
+
+  TickCounter() : ticks(0.) {}
+
+  CFuint getNbCounters() const { return 1; }
+
+  std::string getCounterName(const CFuint i) const { return "ticks"; }
+
+  void read(CFreal* values) { values[0] = ticks; }
+
+  CFreal ticks;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct ProfilerFixture
+{
+  /// values of a region in the CSV file: calls and ticks, each with
+  /// minimum, average and maximum among the processes
+  struct Row {
+    CFuint ranks;
+    CFreal calls[3];
+    CFreal ticks[3];
+  };
+
+  ProfilerFixture() :
+    rank(PE::GetPE().GetRank()),
+    nbProcs(PE::GetPE().GetProcessorCount())
+  {
+    ostringstream name;
+    name << "profiler-np" << nbProcs;
+    fileName = name.str();
+    profiler.setCounters(&counter);
+  }
+
+  ~ProfilerFixture()
+  {
+    if (rank == 0) {
+      remove((fileName + ".json").c_str());
+      remove((fileName + ".csv").c_str());
+    }
+  }
+
+  /// Dumps the profile and reads back the CSV file on rank 0
+  /// @return the paths of the regions, in the order of the file
+  vector<string> dump(vector<Row>& rows)
+  {
+    profiler.dump(fileName);
+
+    vector<string> paths;
+    rows.clear();
+    if (rank != 0) return paths;
+
+    ifstream csv((fileName + ".csv").c_str());
+    string line;
+    getline(csv, line);
+    BOOST_CHECK_EQUAL(line, "path,ranks,calls_min,calls_avg,calls_max,time_min,time_avg,time_max,ticks_min,ticks_avg,ticks_max");
+    while (getline(csv, line)) {
+      for (CFuint i = 0; i < line.size(); ++i) {
+	if (line[i] == ',') line[i] = ' ';
+      }
+      istringstream fields(line);
+      string path;
+      Row row;
+      CFreal time[3];
+      fields >> path >> row.ranks
+	     >> row.calls[0] >> row.calls[1] >> row.calls[2]
+	     >> time[0] >> time[1] >> time[2]
+	     >> row.ticks[0] >> row.ticks[1] >> row.ticks[2];
+      BOOST_CHECK(!fields.fail());
+      BOOST_CHECK(time[0] >= 0. && time[0] <= time[1] && time[1] <= time[2]);
+      paths.push_back(path);
+      rows.push_back(row);
+    }
+    return paths;
+  }
+
+  CFuint rank;
+  CFuint nbProcs;
+  string fileName;
+  TickCounter counter;
+  Profiler profiler;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( ProfilerSuite, ProfilerFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( RegionNesting )
+{
+  profiler.beginRegion("A");
+  counter.ticks = 10.;
+  profiler.beginRegion("B");
+  counter.ticks = 13.;
+  profiler.endRegion();
+  counter.ticks = 20.;
+  profiler.beginRegion("B");
+  counter.ticks = 25.;
+  profiler.endRegion();
+  counter.ticks = 30.;
+  profiler.endRegion();
+
+  // a region of the same name outside A is a different region
+  profiler.beginRegion("B");
+  counter.ticks = 31.;
+  profiler.endRegion();
+
+  vector<Row> rows;
+  const vector<string> paths = dump(rows);
+  if (rank != 0) return;
+
+  BOOST_REQUIRE_EQUAL(paths.size(), 3u);
+  BOOST_CHECK_EQUAL(paths[0], "A");
+  BOOST_CHECK_EQUAL(paths[1], "A/B");
+  BOOST_CHECK_EQUAL(paths[2], "B");
+
+  BOOST_CHECK_EQUAL(rows[0].calls[0], 1.);
+  BOOST_CHECK_EQUAL(rows[0].ticks[0], 30.);
+  BOOST_CHECK_EQUAL(rows[1].calls[0], 2.);
+  BOOST_CHECK_EQUAL(rows[1].ticks[0], 8.);
+  BOOST_CHECK_EQUAL(rows[2].calls[0], 1.);
+  BOOST_CHECK_EQUAL(rows[2].ticks[0], 1.);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( ResetWithOpenRegions )
+{
+  profiler.beginRegion("Closed");
+  counter.ticks = 4.;
+  profiler.endRegion();
+
+  profiler.beginRegion("A");
+  profiler.beginRegion("B");
+  counter.ticks = 10.;
+  profiler.endRegion();
+  profiler.beginRegion("B");
+  counter.ticks = 20.;
+
+  // the open regions count again from now, as called once
+  profiler.reset();
+  counter.ticks = 22.;
+  profiler.endRegion();
+  counter.ticks = 25.;
+  profiler.endRegion();
+
+  vector<Row> rows;
+  const vector<string> paths = dump(rows);
+  if (rank != 0) return;
+
+  BOOST_REQUIRE_EQUAL(paths.size(), 3u);
+  BOOST_CHECK_EQUAL(paths[0], "Closed");
+  BOOST_CHECK_EQUAL(rows[0].calls[0], 0.);
+  BOOST_CHECK_EQUAL(rows[0].ticks[0], 0.);
+  BOOST_CHECK_EQUAL(paths[1], "A");
+  BOOST_CHECK_EQUAL(rows[1].calls[0], 1.);
+  BOOST_CHECK_EQUAL(rows[1].ticks[0], 5.);
+  BOOST_CHECK_EQUAL(paths[2], "A/B");
+  BOOST_CHECK_EQUAL(rows[2].calls[0], 1.);
+  BOOST_CHECK_EQUAL(rows[2].ticks[0], 2.);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( DumpOpenRegions )
+{
+  profiler.beginRegion("A");
+  counter.ticks = 7.;
+
+  // the open region is accounted up to the dump, and goes on afterwards
+  vector<Row> rows;
+  vector<string> paths = dump(rows);
+  if (rank == 0) {
+    BOOST_REQUIRE_EQUAL(paths.size(), 1u);
+    BOOST_CHECK_EQUAL(rows[0].calls[0], 1.);
+    BOOST_CHECK_EQUAL(rows[0].ticks[0], 7.);
+  }
+
+  counter.ticks = 9.;
+  profiler.endRegion();
+  paths = dump(rows);
+  if (rank == 0) {
+    BOOST_REQUIRE_EQUAL(paths.size(), 1u);
+    BOOST_CHECK_EQUAL(rows[0].ticks[0], 9.);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( AggregationAmongProcesses )
+{
+  // each process calls the region rank+1 times, for rank+1 ticks each
+  for (CFuint i = 0; i <= rank; ++i) {
+    profiler.beginRegion("All");
+    counter.ticks += rank + 1;
+    profiler.endRegion();
+  }
+
+  // a region of the last process only
+  if (rank == nbProcs-1) {
+    profiler.beginRegion("Last");
+    counter.ticks += 3.;
+    profiler.endRegion();
+  }
+
+  vector<Row> rows;
+  const vector<string> paths = dump(rows);
+  if (rank != 0) return;
+
+  BOOST_REQUIRE_EQUAL(paths.size(), 2u);
+  BOOST_CHECK_EQUAL(paths[0], "All");
+  BOOST_CHECK_EQUAL(rows[0].ranks, nbProcs);
+  BOOST_CHECK_EQUAL(rows[0].calls[0], 1.);
+  BOOST_CHECK_CLOSE(rows[0].calls[1], 0.5*(nbProcs + 1), 1e-6);
+  BOOST_CHECK_EQUAL(rows[0].calls[2], CFreal(nbProcs));
+  BOOST_CHECK_EQUAL(rows[0].ticks[0], 1.);
+  BOOST_CHECK_CLOSE(rows[0].ticks[1], (nbProcs + 1)*(2.*nbProcs + 1)/6., 1e-6);
+  BOOST_CHECK_EQUAL(rows[0].ticks[2], CFreal(nbProcs*nbProcs));
+
+  // the statistics involve only the processes having the region
+  BOOST_CHECK_EQUAL(paths[1], "Last");
+  BOOST_CHECK_EQUAL(rows[1].ranks, 1u);
+  BOOST_CHECK_EQUAL(rows[1].calls[0], 1.);
+  BOOST_CHECK_EQUAL(rows[1].calls[2], 1.);
+  BOOST_CHECK_EQUAL(rows[1].ticks[1], 3.);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
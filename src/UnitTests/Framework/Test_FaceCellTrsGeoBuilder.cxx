@@ -0,0 +1,412 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Unit Test Module For the face-cell GeometricEntity builder"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <memory>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Framework/DataSocketSource.hh"
+#include "Framework/FaceCellTrsGeoBuilder.hh"
+#include "Framework/GeometricEntityPool.hh"
+#include "Framework/GeometricEntityRegister.hh"
+#include "Framework/IndexList.hh"
+#include "Framework/MapGeoToTrsAndIdx.hh"
+#include "Framework/MeshData.hh"
+#include "Framework/Namespace.hh"
+#include "Framework/Node.hh"
+#include "Framework/State.hh"
+#include "Framework/TopologicalRegionSet.hh"
+#include "UnitTests/PEFixture.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Structured mesh of NX x NY quadrilaterals, whose faces are split in the
+/// TRSs InnerFaces, Bottom and Others, with local IDs not following the
+/// order of the TRSs
+struct FaceCellGeoFixture
+{
+  typedef ConnectivityTable<CFuint> ConnTable;
+
+  /// face of the mesh, with its left and right cells
+  struct FaceDef {
+    CFuint nodes[2];
+    CFuint cells[2];
+    bool isBFace;
+  };
+
+  enum { NX = 3, NY = 2 };
+
+  FaceCellGeoFixture() :
+    nsp("FaceCellGeoTest"),
+    gstatesSource(new DataSocketSource<State*>("gstates")),
+    cellFlagSource(new DataSocketSource<bool>("cellFlag")),
+    cellFaces(),
+    mapFaces(),
+    faces(),
+    faceTrs(),
+    nodes(),
+    states(),
+    ghostStates()
+  {
+    nsp.setMeshDataName(nsp.getName());
+    MeshDataStack& meshStack = MeshDataStack::getInstance();
+    meshStack.setEnabled(true);
+    meshData = meshStack.createUnique(nsp.getName());
+    meshStack.push(&nsp);
+
+    GeometricEntityRegister& geoReg = GeometricEntityRegister::getInstance();
+    const CFuint cellType = geoReg.regist("CellQuadLagrangeP1LagrangeP0");
+    const CFuint faceType = geoReg.regist("FaceLineLagrangeP1LagrangeP0");
+
+    // the DataBroker allocates the sources in the MeshData of their namespace
+    // and connects them to the sinks copied into the builder
+    vector<SafePtr<BaseDataSocketSource> > meshSockets = meshData->getProvidedSockets();
+    for (CFuint i = 0; i < meshSockets.size(); ++i) {
+      meshSockets[i]->setNamespace(nsp.getName());
+    }
+    gstatesSource->setNamespace(nsp.getName());
+    cellFlagSource->setNamespace(nsp.getName());
+
+    // nodes and cell centered states, filled like CFmeshReaderSource does
+    IndexList<Framework::Node>::getList().reset();
+    DataHandle<Node*,GLOBAL> nodeHandle = meshData->getNodeDataSocketSink().getDataHandle();
+    nodeHandle.reserve((NX + 1)*(NY + 1), DIM_2D*sizeof(CFreal));
+    nodeHandle.resize((NX + 1)*(NY + 1));
+    for (CFuint j = 0; j <= NY; ++j) {
+      for (CFuint i = 0; i <= NX; ++i) {
+        RealVector coord(DIM_2D);
+        coord[XX] = i;
+        coord[YY] = j;
+        nodes.push_back(new Framework::Node(coord, true));
+        nodeHandle[nodes.size() - 1] = nodes.back();
+        IndexList<Framework::Node>::getList().createID(nodes.back());
+      }
+    }
+
+    IndexList<State>::getList().reset();
+    DataHandle<State*,GLOBAL> stateHandle = meshData->getStateDataSocketSink().getDataHandle();
+    stateHandle.reserve(NX*NY, sizeof(CFreal));
+    stateHandle.resize(NX*NY);
+    vector<vector<CFuint> > cellNodes(NX*NY);
+    for (CFuint j = 0; j < NY; ++j) {
+      for (CFuint i = 0; i < NX; ++i) {
+        states.push_back(new State(RealVector(1)));
+        stateHandle[states.size() - 1] = states.back();
+        IndexList<State>::getList().createID(states.back());
+
+        vector<CFuint>& cn = cellNodes[j*NX + i];
+        cn.push_back(j*(NX + 1) + i);
+        cn.push_back(j*(NX + 1) + i + 1);
+        cn.push_back((j + 1)*(NX + 1) + i + 1);
+        cn.push_back((j + 1)*(NX + 1) + i);
+      }
+    }
+
+    // faces in the order of the cells and of their faces, a ghost state
+    // on the other side of each boundary face
+    map<pair<CFuint,CFuint>, CFuint> faceOfNodes;
+    vector<vector<CFuint> > facesOfCell(NX*NY, vector<CFuint>(4));
+    for (CFuint iCell = 0; iCell < NX*NY; ++iCell) {
+      for (CFuint iFace = 0; iFace < 4; ++iFace) {
+        const CFuint n0 = cellNodes[iCell][iFace];
+        const CFuint n1 = cellNodes[iCell][(iFace + 1) % 4];
+        const pair<CFuint,CFuint> key(min(n0, n1), max(n0, n1));
+        if (faceOfNodes.count(key) == 0) {
+          FaceDef face = {{n0, n1}, {iCell, 0}, true};
+          faceOfNodes[key] = faces.size();
+          faces.push_back(face);
+        }
+        else {
+          FaceDef& face = faces[faceOfNodes[key]];
+          face.cells[1] = iCell;
+          face.isBFace = false;
+        }
+        facesOfCell[iCell][iFace] = faceOfNodes[key];
+      }
+    }
+
+    DataHandle<State*> gstateHandle = gstatesSource->getDataHandle();
+    const CFuint nbFaces = faces.size();
+    for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+      if (faces[iFace].isBFace) {
+        faces[iFace].cells[1] = ghostStates.size();
+        ghostStates.push_back(new State(RealVector(1), true));
+        ghostStates.back()->setLocalID(faces[iFace].cells[1]);
+      }
+    }
+    gstateHandle.resize(ghostStates.size());
+    for (CFuint i = 0; i < ghostStates.size(); ++i) {
+      gstateHandle[i] = ghostStates[i];
+    }
+
+    DataHandle<bool> cellFlag = cellFlagSource->getDataHandle();
+    cellFlag.resize(NX*NY);
+    for (CFuint iCell = 0; iCell < NX*NY; ++iCell) {
+      cellFlag[iCell] = (iCell % 2 == 1);
+    }
+
+    // local IDs of the faces scattered among the TRSs
+    localFaceIDs.resize(nbFaces);
+    for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+      localFaceIDs[iFace] = (7*iFace) % nbFaces;
+    }
+    BOOST_REQUIRE(nbFaces % 7 != 0);
+
+    valarray<CFuint> fourCols(4, NX*NY);
+    cellFaces.resize(fourCols);
+    for (CFuint iCell = 0; iCell < NX*NY; ++iCell) {
+      for (CFuint iFace = 0; iFace < 4; ++iFace) {
+        cellFaces(iCell, iFace) = localFaceIDs[facesOfCell[iCell][iFace]];
+      }
+    }
+
+    // TRSs, owned by the MeshData
+    vector<CFuint> cellIDs(NX*NY);
+    for (CFuint iCell = 0; iCell < NX*NY; ++iCell) cellIDs[iCell] = iCell;
+    vector<vector<CFuint> > cellStates(NX*NY, vector<CFuint>(1));
+    for (CFuint iCell = 0; iCell < NX*NY; ++iCell) cellStates[iCell][0] = iCell;
+    meshData->addTrs(createTrs("InnerCells", cellType, cellIDs, cellNodes, cellStates, 0));
+
+    vector<vector<CFuint> > trsFaces(3);
+    for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+      const FaceDef& face = faces[iFace];
+      const bool isBottom = face.isBFace && (*nodes[face.nodes[0]])[YY] == 0. &&
+        (*nodes[face.nodes[1]])[YY] == 0.;
+      trsFaces[face.isBFace ? (isBottom ? 1 : 2) : 0].push_back(iFace);
+    }
+    const string trsNames[3] = {"InnerFaces", "Bottom", "Others"};
+    mapFaces.resize(nbFaces);
+    for (CFuint iTrs = 0; iTrs < 3; ++iTrs) {
+      vector<CFuint> localIDs;
+      vector<vector<CFuint> > fNodes;
+      vector<vector<CFuint> > fStates;
+      for (CFuint i = 0; i < trsFaces[iTrs].size(); ++i) {
+        const FaceDef& face = faces[trsFaces[iTrs][i]];
+        localIDs.push_back(localFaceIDs[trsFaces[iTrs][i]]);
+        fNodes.push_back(vector<CFuint>(face.nodes, face.nodes + 2));
+        fStates.push_back(vector<CFuint>(face.cells, face.cells + 2));
+      }
+      TopologicalRegionSet* trs = createTrs(trsNames[iTrs], faceType, localIDs, fNodes, fStates, 1 + iTrs);
+      meshData->addTrs(trs);
+      faceTrs.push_back(trs);
+      for (CFuint i = 0; i < localIDs.size(); ++i) {
+        mapFaces.setMappingData(localIDs[i], trs, i, iTrs > 0);
+      }
+    }
+
+    meshData->storeConnectivity("cellFaces", &cellFaces);
+    meshData->storeMapGeoToTrs("MapFacesToTrs", &mapFaces);
+  }
+
+  ~FaceCellGeoFixture()
+  {
+    // the sockets are deallocated from the storage of the MeshData
+    gstatesSource.reset();
+    cellFlagSource.reset();
+    meshData->removeConnectivity("cellFaces");
+    MeshDataStack& meshStack = MeshDataStack::getInstance();
+    meshStack.pop();
+    meshStack.deleteAllEntries();
+
+    for (CFuint i = 0; i < 4; ++i) delete geo2nodes[i];
+    for (CFuint i = 0; i < 4; ++i) delete geo2states[i];
+    for (CFuint i = 0; i < nodes.size(); ++i) delete nodes[i];
+    for (CFuint i = 0; i < states.size(); ++i) delete states[i];
+    for (CFuint i = 0; i < ghostStates.size(); ++i) delete ghostStates[i];
+  }
+
+  /// Creates a TRS of one TopologicalRegion with the given connectivity
+  TopologicalRegionSet* createTrs(const string& name,
+                                  const CFuint geoType,
+                                  const vector<CFuint>& localIDs,
+                                  const vector<vector<CFuint> >& geoNodes,
+                                  const vector<vector<CFuint> >& geoStates,
+                                  const CFuint iConn)
+  {
+    const CFuint nbGeos = localIDs.size();
+    valarray<CFuint> nbNodes(nbGeos);
+    valarray<CFuint> nbStates(nbGeos);
+    for (CFuint i = 0; i < nbGeos; ++i) {
+      nbNodes[i] = geoNodes[i].size();
+      nbStates[i] = geoStates[i].size();
+    }
+    geo2nodes[iConn] = new ConnTable(nbNodes);
+    geo2states[iConn] = new ConnTable(nbStates);
+    for (CFuint i = 0; i < nbGeos; ++i) {
+      for (CFuint j = 0; j < nbNodes[i]; ++j) (*geo2nodes[iConn])(i, j) = geoNodes[i][j];
+      for (CFuint j = 0; j < nbStates[i]; ++j) (*geo2states[iConn])(i, j) = geoStates[i][j];
+    }
+
+    TopologicalRegionSet* trs = new TopologicalRegionSet(name, new vector<TopologicalRegion*>());
+    trs->setGeo2NodesConn(geo2nodes[iConn]);
+    trs->setGeo2StatesConn(geo2states[iConn]);
+    trs->setGeoTypes(new vector<CFuint>(nbGeos, geoType));
+    trs->setGeoEntsLocalIdx(new vector<CFuint>(localIDs));
+    trs->setGeoEntsGlobalIdx(new vector<CFuint>(localIDs));
+    trs->setGlobalNbGeoEnts(nbGeos);
+    return trs;
+  }
+
+  /// Builds the face of the given TRS and describes the built entities
+  /// by their IDs and the addresses of their nodes, states and neighbors
+  vector<const void*> buildAndDescribe(GeometricEntityPool<FaceCellTrsGeoBuilder>& builder,
+                                       const CFuint iTrs,
+                                       const CFuint idx,
+                                       const bool allCells)
+  {
+    FaceCellTrsGeoBuilder::GeoData& data = builder.getDataGE();
+    data.cells = meshData->getTrs("InnerCells");
+    data.faces = faceTrs[iTrs];
+    data.isBFace = (iTrs > 0);
+    data.allCells = allCells;
+    data.idx = idx;
+
+    vector<const void*> desc;
+    GeometricEntity* const face = builder.buildGE();
+    describe(face, desc);
+
+    DataHandle<bool> cellFlag = cellFlagSource->getDataHandle();
+    for (CFuint iSide = 0; iSide < 2; ++iSide) {
+      const State* const state = face->getState(iSide);
+      if (state->isGhost() || (!allCells && cellFlag[state->getLocalID()])) continue;
+      const GeometricEntity* const cell = face->getNeighborGeo(iSide);
+      describe(cell, desc);
+      for (CFuint iFace = 0; iFace < cell->nbNeighborGeos(); ++iFace) {
+        describe(cell->getNeighborGeo(iFace), desc);
+      }
+    }
+    builder.releaseGE();
+    return desc;
+  }
+
+  /// Connects the builder to the sockets of the mesh
+  void setupBuilder(GeometricEntityPool<FaceCellTrsGeoBuilder>& builder)
+  {
+    builder.setup();
+    builder.getGeoBuilder()->setDataSockets(meshData->getStateDataSocketSink(),
+                                            DataSocketSink<State*>(*gstatesSource),
+                                            meshData->getNodeDataSocketSink());
+    builder.getGeoBuilder()->setCellFlagSocket(DataSocketSink<bool>(*cellFlagSource));
+  }
+
+  /// Describes one GeometricEntity
+  static void describe(const GeometricEntity* geo, vector<const void*>& desc)
+  {
+    desc.push_back(reinterpret_cast<const void*>(static_cast<size_t>(geo->getID())));
+    for (CFuint i = 0; i < geo->nbNodes(); ++i) desc.push_back(geo->getNode(i));
+    for (CFuint i = 0; i < geo->nbStates(); ++i) desc.push_back(geo->getState(i));
+  }
+
+  /// Checks that the compiled stencils build the same entities as the TRSs
+  void checkSameAsTrs(GeometricEntityPool<FaceCellTrsGeoBuilder>& builder, const bool allCells)
+  {
+    SafePtr<FaceCellTrsGeoBuilder> geoBuilder = builder.getGeoBuilder();
+    for (CFuint iTrs = 0; iTrs < faceTrs.size(); ++iTrs) {
+      for (CFuint idx = 0; idx < faceTrs[iTrs]->getLocalNbGeoEnts(); ++idx) {
+        geoBuilder->clearStencils();
+        const vector<const void*> reference = buildAndDescribe(builder, iTrs, idx, allCells);
+        geoBuilder->compileStencils();
+        BOOST_CHECK(geoBuilder->hasCompiledStencils());
+        const vector<const void*> compiled = buildAndDescribe(builder, iTrs, idx, allCells);
+        BOOST_CHECK(compiled == reference);
+      }
+    }
+  }
+
+  Namespace nsp;
+  SafePtr<MeshData> meshData;
+  auto_ptr<DataSocketSource<State*> > gstatesSource;
+  auto_ptr<DataSocketSource<bool> > cellFlagSource;
+  ConnTable cellFaces;
+  ConnTable* geo2nodes[4];
+  ConnTable* geo2states[4];
+  MapGeoToTrsAndIdx mapFaces;
+  vector<FaceDef> faces;
+  vector<CFuint> localFaceIDs;
+  vector<TopologicalRegionSet*> faceTrs;
+  vector<Framework::Node*> nodes;
+  vector<State*> states;
+  vector<State*> ghostStates;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( FaceCellTrsGeoBuilderSuite, FaceCellGeoFixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( StencilsMatchTrs )
+{
+  GeometricEntityPool<FaceCellTrsGeoBuilder> builder;
+  setupBuilder(builder);
+
+  // all the cells, then only those whose flag is not set
+  checkSameAsTrs(builder, true);
+  checkSameAsTrs(builder, false);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( StencilsMatchMesh )
+{
+  GeometricEntityPool<FaceCellTrsGeoBuilder> builder;
+  setupBuilder(builder);
+  builder.getGeoBuilder()->compileStencils();
+
+  // the built face and cells are those of the mesh
+  FaceCellTrsGeoBuilder::GeoData& data = builder.getDataGE();
+  data.cells = meshData->getTrs("InnerCells");
+  data.allCells = true;
+  for (CFuint iFace = 0; iFace < faces.size(); ++iFace) {
+    const FaceDef& def = faces[iFace];
+    data.faces = mapFaces.getTrs(localFaceIDs[iFace]);
+    data.idx = mapFaces.getIdxInTrs(localFaceIDs[iFace]);
+    data.isBFace = def.isBFace;
+
+    GeometricEntity* const face = builder.buildGE();
+    BOOST_CHECK_EQUAL(face->getID(), localFaceIDs[iFace]);
+    BOOST_CHECK_EQUAL(face->getNode(0), nodes[def.nodes[0]]);
+    BOOST_CHECK_EQUAL(face->getNode(1), nodes[def.nodes[1]]);
+    BOOST_CHECK_EQUAL(face->getState(0), states[def.cells[0]]);
+    BOOST_CHECK_EQUAL(face->getState(1), def.isBFace ? ghostStates[def.cells[1]] : states[def.cells[1]]);
+
+    const CFuint nbCells = def.isBFace ? 1 : 2;
+    for (CFuint iSide = 0; iSide < nbCells; ++iSide) {
+      const GeometricEntity* const cell = face->getNeighborGeo(iSide);
+      BOOST_CHECK_EQUAL(cell->getID(), def.cells[iSide]);
+      BOOST_CHECK_EQUAL(cell->getState(0), states[def.cells[iSide]]);
+      // the face is one of the neighbors of its cells
+      CFuint nbMatches = 0;
+      for (CFuint i = 0; i < cell->nbNeighborGeos(); ++i) {
+        if (cell->getNeighborGeo(i)->getID() == face->getID()) ++nbMatches;
+      }
+      BOOST_CHECK_EQUAL(nbMatches, 1u);
+    }
+    builder.releaseGE();
+  }
+
+  builder.getGeoBuilder()->clearStencils();
+  BOOST_CHECK(!builder.getGeoBuilder()->hasCompiledStencils());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,48 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_UnitTests_PEFixture_hh
+#define COOLFluiD_UnitTests_PEFixture_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/PE.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace UnitTests {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Starts and stops the parallel environment once for the whole module.
+/// This header registers the fixture as global, so it must be included by
+/// one source file only of each test module.
+struct PEFixture
+{
+  PEFixture()
+  {
+    Common::PE::InitPE(&boost::unit_test::framework::master_test_suite().argc,
+		       &boost::unit_test::framework::master_test_suite().argv);
+  }
+
+  ~PEFixture() { Common::PE::DonePE(); }
+};
+
+BOOST_GLOBAL_FIXTURE( PEFixture );
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace UnitTests
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_UnitTests_PEFixture_hh